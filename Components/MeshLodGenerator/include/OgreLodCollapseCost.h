@@ -44,9 +44,18 @@ namespace Ogre
 class _OgreLodExport LodCollapseCost {
 public:
     virtual ~LodCollapseCost() {}
-    /// This is called after the LodInputProvider has initialized LodData.
+    /** This is called after the LodInputProvider has initialized LodData.
+    @remarks
+        The costs of the vertices are computed concurrently on the threads of the WorkQueue,
+        so computeVertexCollapseCost and computeEdgeCollapseCost must not modify anything
+        but the edges of the given vertex. initVertexCollapseCost is then called for every
+        vertex in order on the calling thread.
+    */
     virtual void initCollapseCosts(LodData* data);
-    /// Called from initCollapseCosts for every edge.
+    /** Adds a single vertex to the heap.
+    @remarks
+        During initCollapseCosts this uses the cost computed there, otherwise it computes it.
+    */
     virtual void initVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
     /// Called when edge cost gets invalid.
     virtual void updateVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
@@ -57,6 +66,17 @@ public:
 protected:
     // Helper functions:
     bool isBorderVertex(const LodData::Vertex* vertex) const;
+    /// Processes the elements [0, count) on the threads of the WorkQueue of Root, if there is one.
+    static void parallelFor(size_t count, const std::function<void(size_t, size_t)>& func);
+private:
+    struct InitialCost
+    {
+        Real cost;
+        LodData::Vertex* collapseTo;
+        InitialCost() : cost(LodData::UNINITIALIZED_COLLAPSE_COST), collapseTo(NULL) {}
+    };
+    /// Vertex costs computed by initCollapseCosts, indexed like LodData::mVertexList
+    std::vector<InitialCost> mInitialCosts;
 };
 /** @} */
 /** @} */
@@ -64,7 +64,7 @@ struct _OgreLodExport LodData {
     typedef std::vector<Vertex> VertexList;
     typedef std::vector<Triangle> TriangleList;
     typedef std::unordered_set<Vertex*, VertexHash, VertexEqual> UniqueVertexSet;
-    typedef std::multimap<Real, Vertex*> CollapseCostHeap;
+    class CollapseCostHeap;
 
     typedef VectorSet<Edge, 8> VEdges;
     typedef VectorSet<Triangle*, 7> VTriangles;
@@ -104,7 +104,7 @@ struct _OgreLodExport LodData {
         
         Vertex* collapseTo;
         bool seam;
-        CollapseCostHeap::iterator costHeapPosition; /// Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+        size_t costHeapPosition; /// Index of the vertex in mCollapseCostHeap, which allows fast remove and update.
 
         void addEdge(const Edge& edge);
         void removeEdge(const Edge& edge);
@@ -146,6 +146,61 @@ struct _OgreLodExport LodData {
 
     typedef std::vector<IndexBufferInfo> IndexBufferInfoList;
 
+    /** Indexed binary min-heap of the vertices, ordered by their collapse cost.
+    @remarks
+        Every vertex in the heap knows its position (Vertex::costHeapPosition), so its cost
+        can be changed in place and it can be removed in O(log n). Vertices with equal cost
+        are ordered by the time their cost was last set, which gives the same collapse order
+        as a std::multimap keyed by the cost.
+    */
+    class _OgreLodExport CollapseCostHeap {
+    public:
+        /// Value of Vertex::costHeapPosition for vertices, which are not in the heap.
+        static const size_t INVALID_POSITION = ~static_cast<size_t>(0);
+
+        CollapseCostHeap() : mSerial(0) {}
+
+        size_t size() const { return mEntries.size(); }
+        bool empty() const { return mEntries.empty(); }
+        void clear() { mEntries.clear(); mSerial = 0; }
+        void reserve(size_t count) { mEntries.reserve(count); }
+
+        /// Returns the vertex with the smallest collapse cost.
+        Vertex* top() const { return mEntries.front().vertex; }
+        /// Returns the smallest collapse cost.
+        Real topCost() const { return mEntries.front().cost; }
+        /// Returns the vertex at the given position. Allows iterating all vertices in the heap.
+        Vertex* getVertex(size_t position) const { return mEntries[position].vertex; }
+        /// Returns the cost of the vertex or UNINITIALIZED_COLLAPSE_COST if it is not in the heap.
+        Real getCost(const Vertex* vertex) const;
+
+        /// Adds a vertex, which is not in the heap yet.
+        void push(Vertex* vertex, Real cost);
+        /// Changes the cost of a vertex in the heap.
+        void update(Vertex* vertex, Real cost);
+        /// Removes a vertex from the heap, if it is in there.
+        void erase(Vertex* vertex);
+
+    private:
+        struct Entry {
+            Real cost;
+            size_t serial;
+            Vertex* vertex;
+
+            bool operator< (const Entry& other) const
+            {
+                return cost < other.cost || (cost == other.cost && serial < other.serial);
+            }
+        };
+
+        void siftUp(size_t position);
+        void siftDown(size_t position);
+        void place(const Entry& entry, size_t position);
+
+        std::vector<Entry> mEntries;
+        size_t mSerial;
+    };
+
     /// Provides position based vertex lookup. Position is the real identifier of a vertex.
     UniqueVertexSet mUniqueVertexSet;
 
@@ -27,28 +27,45 @@
  */
 
 #include "OgreMeshLodPrecompiledHeaders.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre
 {
     void LodCollapseCost::initCollapseCosts( LodData* data )
     {
-        data->mCollapseCostHeap.clear();
-        LodData::VertexList::iterator it = data->mVertexList.begin();
-        LodData::VertexList::iterator itEnd = data->mVertexList.end();
-        for (; it != itEnd; it++) {
-            if (!it->edges.empty()) {
-                initVertexCollapseCost(data, &*it);
+        LodData::CollapseCostHeap& heap = data->mCollapseCostHeap;
+        heap.clear();
+        heap.reserve(data->mVertexList.size());
+
+        // Every vertex only writes the costs of its own edges, so all of them can be computed at once.
+        // initVertexCollapseCost picks the results up below.
+        mInitialCosts.assign(data->mVertexList.size(), InitialCost());
+        parallelFor(mInitialCosts.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                LodData::Vertex* vertex = &data->mVertexList[i];
+                if (!vertex->edges.empty()) {
+                    computeVertexCollapseCost(data, vertex, mInitialCosts[i].cost, mInitialCosts[i].collapseTo);
+                }
+            }
+        });
+
+        // Push in vertex order, so vertices with equal cost are collapsed in a deterministic order.
+        for (size_t i = 0; i < mInitialCosts.size(); i++) {
+            LodData::Vertex* vertex = &data->mVertexList[i];
+            if (!vertex->edges.empty()) {
+                initVertexCollapseCost(data, vertex);
             } else {
 #if OGRE_DEBUG_MODE
-                LogManager::getSingleton().stream() << "In " << data->mMeshName << " never used vertex found with ID: " << data->mCollapseCostHeap.size() << ". "
+                LogManager::getSingleton().stream() << "In " << data->mMeshName << " never used vertex found with ID: " << heap.size() << ". "
                     << "Vertex position: ("
-                    << it->position.x << ", "
-                    << it->position.y << ", "
-                    << it->position.z << ") "
+                    << vertex->position.x << ", "
+                    << vertex->position.y << ", "
+                    << vertex->position.z << ") "
                     << "It will be excluded from Lod level calculations.";
 #endif
             }
         }
+        mInitialCosts.clear();
     }
 
     void LodCollapseCost::computeVertexCollapseCost( LodData* data, LodData::Vertex* vertex, Real& collapseCost, LodData::Vertex*& collapseTo )
@@ -68,10 +85,17 @@ namespace Ogre
 
         Real collapseCost = LodData::UNINITIALIZED_COLLAPSE_COST;
         LodData::Vertex* collapseTo = NULL;
-        computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
+        size_t index = mInitialCosts.empty() ? 0 : vertex - &data->mVertexList[0];
+        if (index < mInitialCosts.size()) {
+            // already computed by initCollapseCosts
+            collapseCost = mInitialCosts[index].cost;
+            collapseTo = mInitialCosts[index].collapseTo;
+        } else {
+            computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
+        }
 
         vertex->collapseTo = collapseTo;
-        vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+        data->mCollapseCostHeap.push(vertex, collapseCost);
     }
 
     void LodCollapseCost::updateVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
@@ -80,16 +104,16 @@ namespace Ogre
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
-        if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first) {
-            OgreAssert(vertex->costHeapPosition != data->mCollapseCostHeap.end(), "");
-            data->mCollapseCostHeap.erase(vertex->costHeapPosition);
+        LodData::CollapseCostHeap& heap = data->mCollapseCostHeap;
+        if (vertex->collapseTo != collapseTo || collapseCost != heap.getCost(vertex)) {
+            OgreAssert(vertex->costHeapPosition != LodData::CollapseCostHeap::INVALID_POSITION, "");
             if (collapseCost != LodData::UNINITIALIZED_COLLAPSE_COST) {
                 vertex->collapseTo = collapseTo;
-                vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+                heap.update(vertex, collapseCost);
             } else {
+                heap.erase(vertex);
 #if OGRE_DEBUG_MODE
                 vertex->collapseTo = NULL;
-                vertex->costHeapPosition = data->mCollapseCostHeap.end();
 #endif
             }
         }
@@ -106,5 +130,14 @@ namespace Ogre
         }
         return false;
     }
-}
 
+    void LodCollapseCost::parallelFor(size_t count, const std::function<void(size_t, size_t)>& func)
+    {
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+        if (queue) {
+            queue->parallelFor(count, 256, func);
+        } else {
+            func(0, count);
+        }
+    }
+}
@@ -41,13 +41,17 @@ namespace Ogre
     void LodCollapseCostQuadric::initCollapseCosts( LodData* data )
     {
         mTrianglePlaneQuadricList.resize(data->mTriangleList.size());
-        for(size_t i=0;i<mTrianglePlaneQuadricList.size();i++){
-            computeTrianglePlaneQuadric(data, i);
-        }
+        parallelFor(mTrianglePlaneQuadricList.size(), [this, data](size_t begin, size_t end) {
+            for(size_t i=begin;i<end;i++){
+                computeTrianglePlaneQuadric(data, i);
+            }
+        });
         mVertexQuadricList.resize(data->mVertexList.size());
-        for (size_t i=0;i<mVertexQuadricList.size();i++) {
-            computeVertexQuadric(data, i);
-        }
+        parallelFor(mVertexQuadricList.size(), [this, data](size_t begin, size_t end) {
+            for (size_t i=begin;i<end;i++) {
+                computeVertexQuadric(data, i);
+            }
+        });
         LodCollapseCost::initCollapseCosts(data);
     }
 
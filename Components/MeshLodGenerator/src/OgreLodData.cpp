@@ -32,6 +32,7 @@ namespace Ogre
 // Use float limits instead of Real limits, because LodConfigSerializer may convert them to float.
 const Real LodData::NEVER_COLLAPSE_COST = std::numeric_limits<float>::max();
 const Real LodData::UNINITIALIZED_COLLAPSE_COST = std::numeric_limits<float>::infinity();
+const size_t LodData::CollapseCostHeap::INVALID_POSITION;
 
 void LodData::Vertex::addEdge( const LodData::Edge& edge )
 {
@@ -118,4 +119,97 @@ bool LodData::Edge::operator== (const LodData::Edge& other) const
     return dst == other.dst;
 }
 
+
+Real LodData::CollapseCostHeap::getCost(const LodData::Vertex* vertex) const
+{
+    if (vertex->costHeapPosition >= mEntries.size() || mEntries[vertex->costHeapPosition].vertex != vertex) {
+        return UNINITIALIZED_COLLAPSE_COST;
+    }
+    return mEntries[vertex->costHeapPosition].cost;
+}
+
+void LodData::CollapseCostHeap::push(LodData::Vertex* vertex, Real cost)
+{
+    Entry entry = { cost, mSerial++, vertex };
+    mEntries.push_back(entry);
+    vertex->costHeapPosition = mEntries.size() - 1;
+    siftUp(vertex->costHeapPosition);
+}
+
+void LodData::CollapseCostHeap::update(LodData::Vertex* vertex, Real cost)
+{
+    size_t position = vertex->costHeapPosition;
+    OgreAssertDbg(position < mEntries.size() && mEntries[position].vertex == vertex, "Vertex is not in the heap");
+    Entry& entry = mEntries[position];
+    // A new serial moves the vertex behind all vertices of the same cost.
+    bool decreased = cost < entry.cost;
+    entry.cost = cost;
+    entry.serial = mSerial++;
+    if (decreased) {
+        siftUp(position);
+    } else {
+        siftDown(position);
+    }
+}
+
+void LodData::CollapseCostHeap::erase(LodData::Vertex* vertex)
+{
+    size_t position = vertex->costHeapPosition;
+    if (position >= mEntries.size() || mEntries[position].vertex != vertex) {
+        return;
+    }
+    vertex->costHeapPosition = INVALID_POSITION;
+    Entry last = mEntries.back();
+    mEntries.pop_back();
+    if (position == mEntries.size()) {
+        return;
+    }
+    place(last, position);
+    if (position > 0 && last < mEntries[(position - 1) / 2]) {
+        siftUp(position);
+    } else {
+        siftDown(position);
+    }
+}
+
+void LodData::CollapseCostHeap::place(const Entry& entry, size_t position)
+{
+    mEntries[position] = entry;
+    entry.vertex->costHeapPosition = position;
+}
+
+void LodData::CollapseCostHeap::siftUp(size_t position)
+{
+    Entry entry = mEntries[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (!(entry < mEntries[parent])) {
+            break;
+        }
+        place(mEntries[parent], position);
+        position = parent;
+    }
+    place(entry, position);
+}
+
+void LodData::CollapseCostHeap::siftDown(size_t position)
+{
+    Entry entry = mEntries[position];
+    size_t count = mEntries.size();
+    for (;;) {
+        size_t child = 2 * position + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && mEntries[child + 1] < mEntries[child]) {
+            child++;
+        }
+        if (!(mEntries[child] < entry)) {
+            break;
+        }
+        place(mEntries[child], position);
+        position = child;
+    }
+    place(entry, position);
+}
 }
@@ -228,6 +228,9 @@ namespace Ogre
     class _OgrePagingExport Grid2DPageStrategy : public PageStrategy
     {
     public:
+        /// The most points along the path of the camera pages are prefetched around
+        static const int MAX_PREFETCH_STEPS;
+
         Grid2DPageStrategy(PageManager* manager);
 
         ~Grid2DPageStrategy();
@@ -203,6 +203,9 @@ namespace Ogre
     class _OgrePagingExport Grid3DPageStrategy : public PageStrategy
     {
     public:
+        /// The most points along the path of the camera pages are prefetched around
+        static const int MAX_PREFETCH_STEPS;
+
         Grid3DPageStrategy(PageManager* manager);
 
         ~Grid3DPageStrategy();
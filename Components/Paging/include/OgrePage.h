@@ -55,17 +55,24 @@ namespace Ogre
         PageID mID;
         PagedWorldSection* mParent;
         unsigned long mFrameLastHeld;
+        /// Seconds the page is held for without being touched, e.g. because it was prefetched
+        Real mHoldTime;
         ContentCollectionList mContentCollections;
         uint16 mWorkQueueChannel;
         bool mDeferredProcessInProgress;
         bool mModified;
 
+        /// The data of the page file, handed to the PageCache when the page is unloaded
+        MemoryDataStreamPtr mFileData;
+
         SceneNode* mDebugNode;
         void updateDebugDisplay();
 
         struct PageData : public PageAlloc
         {
             ContentCollectionList collectionsToAdd;
+            /// The data read from the page file, if the PageCache is enabled
+            MemoryDataStreamPtr fileData;
         };
         /// Structure for holding background page requests
         struct PageRequest
@@ -121,12 +128,22 @@ namespace Ogre
         virtual unsigned long getFrameLastHeld() { return mFrameLastHeld; }
         /// 'Touch' the page to let it know it's being used
         virtual void touch();
+        /** Hold the page for a number of seconds even if it isn't touched.
+        @remarks
+            Used for pages which are loaded ahead of time, so they aren't unloaded
+            again before they are needed. A shorter time than the page is held
+            for already is ignored.
+        */
+        virtual void holdFor(Real seconds);
 
         /** Load this page. 
         @param synchronous Whether to force this to happen synchronously.
         */
         virtual void load(bool synchronous);
         /** Unload this page. 
+        @remarks
+            The data of the page file is handed to the PageCache, unless the page
+            was modified since.
         */
         virtual void unload();
 
@@ -134,7 +151,7 @@ namespace Ogre
         /** Returns whether this page was 'held' in the last frame, that is
             was it either directly needed, or requested to stay in memory (held - as
             in a buffer region for example). If not, this page is eligible for 
-            removal.
+            removal. Pages held for a time with holdFor count as held until it is up.
         */
         virtual bool isHeld() const;
 
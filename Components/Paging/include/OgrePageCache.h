@@ -0,0 +1,122 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __Ogre_PageCache_H__
+#define __Ogre_PageCache_H__
+
+#include "OgrePagingPrerequisites.h"
+#include "Threading/OgreThreadHeaders.h"
+#include "OgreDataStream.h"
+
+namespace Ogre
+{
+    /** \addtogroup Optional
+    *  @{
+    */
+    /** \addtogroup Paging
+    *  Some details on paging component
+    *  @{
+    */
+
+    /** Keeps the data of recently unloaded pages in memory in compressed form, so
+        pages which are needed again soon after don't have to be read again.
+    @remarks
+        Pages keep the data of their file while they are loaded and hand it to the
+        cache when they are unloaded, so it is compressed once per unload rather
+        than on every read. The pages are identified by their file and resource group.
+    @par
+        The cache holds up to a budget of bytes of compressed data. Once that is
+        exceeded the least recently used pages are evicted first. A budget of 0,
+        the default, disables the cache.
+    @par
+        All methods can be called from the background threads pages are prepared in.
+    */
+    class _OgrePagingExport PageCache : public PageAlloc
+    {
+    public:
+        PageCache(size_t budget = 0);
+        ~PageCache();
+
+        /** Set the number of bytes of compressed page data the cache may hold.
+        @remarks
+            Lowering the budget evicts the least recently used pages right away.
+        */
+        void setBudget(size_t bytes);
+        /// Get the number of bytes of compressed page data the cache may hold
+        size_t getBudget() const;
+        /// Get the number of bytes of compressed page data the cache holds
+        size_t getSize() const;
+        /// Get the number of pages the cache holds
+        size_t getEntryCount() const;
+
+        /** Compress a copy of the data of a page into the cache.
+        @remarks
+            Replaces any data held for the same file. Data which is bigger than
+            the whole budget once compressed is not cached.
+        */
+        void add(const String& filename, const String& groupName, const void* data, size_t size);
+        /** Get the data of a page from the cache.
+        @return A stream holding the uncompressed data, or a null pointer if the
+            page isn't cached
+        */
+        DataStreamPtr get(const String& filename, const String& groupName);
+        /// Get whether the data of a page is cached
+        bool contains(const String& filename, const String& groupName) const;
+        /// Remove the data of a page from the cache, e.g. because its file changed
+        void remove(const String& filename, const String& groupName);
+        /// Remove all pages from the cache
+        void clear();
+
+    protected:
+        /// The file and resource group of a page
+        typedef std::pair<String, String> Key;
+        struct Entry
+        {
+            Key key;
+            /// Size of the data before compression
+            size_t size;
+            std::vector<uchar> compressed;
+        };
+        typedef std::list<Entry> EntryList;
+        /// Most recently used first
+        EntryList mEntries;
+        typedef std::map<Key, EntryList::iterator> EntryMap;
+        EntryMap mEntryMap;
+        size_t mBudget;
+        size_t mSize;
+        OGRE_MUTEX(mMutex);
+
+        /// Evict the least recently used pages until the cache is within budget, the mutex must be held
+        void evict();
+    };
+
+    /** @} */
+    /** @} */
+}
+
+#endif
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgreCamera.h"
 #include "OgreFrameListener.h"
 #include "OgreNameGenerator.h"
+#include "OgrePageCache.h"
 
 namespace Ogre
 {
@@ -432,6 +433,12 @@ namespace Ogre
         /** Get whether paging operations are currently allowed to happen. */
         bool getPagingOperationsEnabled() const { return mPagingEnabled; }
 
+        /** Get the cache which keeps the data of recently unloaded pages in memory.
+        @remarks
+            The cache is disabled until it is given a budget, see PageCache::setBudget.
+        */
+        PageCache& getPageCache() { return mPageCache; }
+
 
     protected:
 
@@ -466,6 +473,7 @@ namespace Ogre
         EventRouter mEventRouter;
         uint8 mDebugDisplayLvl;
         bool mPagingEnabled;
+        PageCache mPageCache;
 
         Grid2DPageStrategy* mGrid2DPageStrategy;
         Grid3DPageStrategy* mGrid3DPageStrategy;
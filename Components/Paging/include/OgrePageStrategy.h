@@ -30,6 +30,7 @@ THE SOFTWARE.
 #define __Ogre_PageStrategy_H__
 
 #include "OgrePagingPrerequisites.h"
+#include "OgreVector.h"
 
 
 namespace Ogre
@@ -48,8 +49,22 @@ namespace Ogre
     */
     class _OgrePagingExport PageStrategyData : public PageAlloc
     {
+    protected:
+        /// The motion of one camera, measured between the frames it is notified in
+        struct CameraMotion
+        {
+            Vector3 lastPosition;
+            Vector3 velocity;
+            Real timeSinceUpdate;
+        };
+        typedef std::map<const Camera*, CameraMotion> CameraMotionMap;
+
+        /// How many seconds ahead of the camera pages are prefetched
+        Real mPrefetchTime;
+        /// The cameras are tracked separately, so views far apart do not blur into one motion
+        CameraMotionMap mCameraMotions;
     public:
-        PageStrategyData() {}
+        PageStrategyData() : mPrefetchTime(0) {}
         virtual ~PageStrategyData() {}
 
         /// Load this data from a stream (returns true if successful)
@@ -57,7 +72,61 @@ namespace Ogre
         /// Save this data to a stream
         virtual void save(StreamSerialiser& stream) = 0;
 
+        /** Set how many seconds ahead of the camera pages are prefetched.
+        @remarks
+            Strategies which support this track the velocity of each camera and load
+            the pages along its predicted path in the background, so they are ready
+            by the time they are needed. The prefetched pages are held for the same
+            time. 0, the default, disables prefetching.
+        */
+        void setPrefetchTime(Real seconds) { mPrefetchTime = seconds; }
+        /// Get how many seconds ahead of the camera pages are prefetched
+        Real getPrefetchTime() const { return mPrefetchTime; }
+        /// Get the velocity of a camera in world units per second, smoothed over a few frames
+        Vector3 getCameraVelocity(const Camera* cam) const
+        {
+            CameraMotionMap::const_iterator i = mCameraMotions.find(cam);
+            return i == mCameraMotions.end() ? Vector3::ZERO : i->second.velocity;
+        }
 
+        /** Internal method to add the time of a frame to the interval the camera motion is measured over.
+        @remarks
+            Cameras which have not been notified for a second are forgotten, as
+            there is no notification when a camera is destroyed.
+        */
+        void _notifyFrameTime(Real timeSinceLastFrame)
+        {
+            for (CameraMotionMap::iterator i = mCameraMotions.begin(); i != mCameraMotions.end();)
+            {
+                i->second.timeSinceUpdate += timeSinceLastFrame;
+                if (i->second.timeSinceUpdate > 1)
+                    i = mCameraMotions.erase(i);
+                else
+                    ++i;
+            }
+        }
+        /** Internal method to track the position of a camera.
+        @return The position the camera is predicted at after the prefetch time
+        */
+        Vector3 _updateCameraMotion(const Camera* cam, const Vector3& position)
+        {
+            CameraMotionMap::iterator i = mCameraMotions.find(cam);
+            if (i == mCameraMotions.end())
+            {
+                CameraMotion motion = {position, Vector3::ZERO, 0};
+                i = mCameraMotions.emplace(cam, motion).first;
+            }
+            CameraMotion& motion = i->second;
+            if (motion.timeSinceUpdate > 0)
+            {
+                // smooth out the jitter of frame times
+                Vector3 velocity = (position - motion.lastPosition) / motion.timeSinceUpdate;
+                motion.velocity = (motion.velocity + velocity) * 0.5f;
+            }
+            motion.lastPosition = position;
+            motion.timeSinceUpdate = 0;
+            return position + motion.velocity * mPrefetchTime;
+        }
     };
 
 
@@ -241,6 +241,15 @@ namespace Ogre
         */
         virtual void holdPage(PageID pageID);
 
+        /** Load a page ahead of time and hold it for a number of seconds.
+        @remarks
+            Pages loaded ahead of the camera are usually outside of the hold range,
+            so they are held for the given time instead of only for the frame.
+            Calling this again while the page is held extends the time.
+        @see Page::holdFor
+        */
+        virtual void prefetchPage(PageID pageID, Real holdTime);
+
         /** Retrieves a Page.
         @remarks
             This method will only return Page instances that are already loaded. It
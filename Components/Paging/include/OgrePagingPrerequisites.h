@@ -37,6 +37,7 @@ namespace Ogre
     class Grid2DPageStrategy;
     class Grid3DPageStrategy;
     class Page;
+    class PageCache;
     class PageConnection;
     class PageContent;
     class PageContentFactory;
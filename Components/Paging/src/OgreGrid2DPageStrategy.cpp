@@ -44,6 +44,7 @@ namespace Ogre
     //---------------------------------------------------------------------
     const uint32 Grid2DPageStrategyData::CHUNK_ID = StreamSerialiser::makeIdentifier("G2DD");
     const uint16 Grid2DPageStrategyData::CHUNK_VERSION = 1;
+    const int Grid2DPageStrategy::MAX_PREFETCH_STEPS = 16;
     //---------------------------------------------------------------------
     Grid2DPageStrategyData::Grid2DPageStrategyData()
         : PageStrategyData()
@@ -349,9 +350,33 @@ namespace Ogre
                 // other pages will by inference be marked for unloading
             }
         }   
-        
-
 
+        // load the pages along the predicted path of the camera in the background,
+        // one load radius apart; they are mostly outside the hold range, so they
+        // are held for the prefetch time instead
+        Vector3 predictedPos = stratData->_updateCameraMotion(cam, pos);
+        Real holdTime = stratData->getPrefetchTime();
+        if (holdTime > 0)
+        {
+            Vector2 predictedGridPos = Vector2::ZERO;
+            stratData->convertWorldToGridSpace(predictedPos, predictedGridPos);
+            Vector2 path = predictedGridPos - gridpos;
+            Real step = std::max(stratData->getLoadRadius(), stratData->getCellSize());
+            int steps = std::min(MAX_PREFETCH_STEPS, (int)std::ceil(path.length() / step));
+            int32 radius = (int32)std::ceil(loadRadius);
+            for (int i = 1; i <= steps; ++i)
+            {
+                int32 px, py;
+                stratData->determineGridLocation(gridpos + path * ((Real)i / steps), &px, &py);
+                int32 pxmin = std::max(px - radius, stratData->getCellRangeMinX());
+                int32 pxmax = std::min(px + radius, stratData->getCellRangeMaxX());
+                int32 pymin = std::max(py - radius, stratData->getCellRangeMinY());
+                int32 pymax = std::min(py + radius, stratData->getCellRangeMaxY());
+                for (int32 cy = pymin; cy <= pymax; ++cy)
+                    for (int32 cx = pxmin; cx <= pxmax; ++cx)
+                        section->prefetchPage(stratData->calculatePageID(cx, cy), holdTime);
+            }
+        }
     }
     //---------------------------------------------------------------------
     PageStrategyData* Grid2DPageStrategy::createData()
@@ -45,6 +45,7 @@ namespace Ogre
     //---------------------------------------------------------------------
     const uint32 Grid3DPageStrategyData::CHUNK_ID = StreamSerialiser::makeIdentifier("G3DD");
     const uint16 Grid3DPageStrategyData::CHUNK_VERSION = 1;
+    const int Grid3DPageStrategy::MAX_PREFETCH_STEPS = 16;
     //---------------------------------------------------------------------
     Grid3DPageStrategyData::Grid3DPageStrategyData()
         : PageStrategyData()
@@ -320,6 +321,37 @@ namespace Ogre
                 }
             }
         }
+
+        // load the pages along the predicted path of the camera in the background,
+        // one load radius apart; they are mostly outside the hold range, so they
+        // are held for the prefetch time instead
+        Vector3 predictedPos = stratData->_updateCameraMotion(cam, pos);
+        Real holdTime = stratData->getPrefetchTime();
+        if (holdTime > 0)
+        {
+            const Vector3& cellSize = stratData->getCellSize();
+            Vector3 path = predictedPos - pos;
+            Real step = std::max(loadRadius, std::max(cellSize.x, std::max(cellSize.y, cellSize.z)));
+            int steps = std::min(MAX_PREFETCH_STEPS, (int)std::ceil(path.length() / step));
+            int32 radiusX = (int32)std::ceil(loadRadius / cellSize.x);
+            int32 radiusY = (int32)std::ceil(loadRadius / cellSize.y);
+            int32 radiusZ = (int32)std::ceil(loadRadius / cellSize.z);
+            for (int i = 1; i <= steps; ++i)
+            {
+                int32 px, py, pz;
+                stratData->determineGridLocation(pos + path * ((Real)i / steps), &px, &py, &pz);
+                int32 pxmin = std::max(px - radiusX, stratData->getCellRangeMinX());
+                int32 pxmax = std::min(px + radiusX, stratData->getCellRangeMaxX());
+                int32 pymin = std::max(py - radiusY, stratData->getCellRangeMinY());
+                int32 pymax = std::min(py + radiusY, stratData->getCellRangeMaxY());
+                int32 pzmin = std::max(pz - radiusZ, stratData->getCellRangeMinZ());
+                int32 pzmax = std::min(pz + radiusZ, stratData->getCellRangeMaxZ());
+                for (int32 cz = pzmin; cz <= pzmax; ++cz)
+                    for (int32 cy = pymin; cy <= pymax; ++cy)
+                        for (int32 cx = pxmin; cx <= pxmax; ++cx)
+                            section->prefetchPage(stratData->calculatePageID(cx, cy, cz), holdTime);
+            }
+        }
     }
     //---------------------------------------------------------------------
     PageStrategyData* Grid3DPageStrategy::createData()
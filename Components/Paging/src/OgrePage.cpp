@@ -53,6 +53,7 @@ namespace Ogre
     Page::Page(PageID pageID, PagedWorldSection* parent)
         : mID(pageID)
         , mParent(parent)
+        , mHoldTime(0)
         , mDeferredProcessInProgress(false)
         , mModified(false)
         , mDebugNode(0)
@@ -103,8 +104,16 @@ namespace Ogre
         mFrameLastHeld = Root::getSingleton().getNextFrameNumber();
     }
     //---------------------------------------------------------------------
+    void Page::holdFor(Real seconds)
+    {
+        mHoldTime = std::max(mHoldTime, seconds);
+    }
+    //---------------------------------------------------------------------
     bool Page::isHeld() const
     {
+        if (mHoldTime > 0)
+            return true;
+
         unsigned long nextFrame = Root::getSingleton().getNextFrameNumber();
         unsigned long dist;
         if (nextFrame < mFrameLastHeld)
@@ -182,6 +191,7 @@ namespace Ogre
         if (!mDeferredProcessInProgress)
         {
             destroyAllContentCollections();
+            mFileData.reset();
             PageRequest req(this);
             mDeferredProcessInProgress = true;
             Root::getSingleton().getWorkQueue()->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, 
@@ -193,6 +203,14 @@ namespace Ogre
     void Page::unload()
     {
         destroyAllContentCollections();
+
+        // the page is likely to be needed again soon, keep its data at hand
+        if (mFileData && !mModified)
+        {
+            getManager()->getPageCache().add(generateFilename(), getManager()->getPageResourceGroup(),
+                mFileData->getPtr(), mFileData->size());
+        }
+        mFileData.reset();
     }
     //---------------------------------------------------------------------
     bool Page::canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
@@ -261,6 +279,7 @@ namespace Ogre
         {
             if(!pres.pageData->collectionsToAdd.empty())
                 std::swap(mContentCollections, pres.pageData->collectionsToAdd);
+            mFileData = pres.pageData->fileData;
 
             loadImpl();
         }
@@ -280,9 +299,20 @@ namespace Ogre
         {
             // Background loading
             String filename = generateFilename();
+            const String& groupName = getManager()->getPageResourceGroup();
+            PageCache& cache = getManager()->getPageCache();
 
-            DataStreamPtr stream = Root::getSingleton().openFileStream(filename, 
-                getManager()->getPageResourceGroup());
+            DataStreamPtr stream = cache.get(filename, groupName);
+            if (!stream)
+            {
+                stream = Root::getSingleton().openFileStream(filename, groupName);
+                // keep the data to cache it when the page is unloaded, it is compressed then
+                if (cache.getBudget())
+                {
+                    dataToPopulate->fileData.reset(OGRE_NEW MemoryDataStream(filename, stream));
+                    stream = dataToPopulate->fileData;
+                }
+            }
             StreamSerialiser ser(stream);
             return prepareImpl(ser, dataToPopulate);
         }
@@ -309,6 +339,9 @@ namespace Ogre
     //---------------------------------------------------------------------
     void Page::save(const String& filename)
     {
+        // the cached data is out of date now
+        getManager()->getPageCache().remove(filename, getManager()->getPageResourceGroup());
+        mFileData.reset();
         DataStreamPtr stream = Root::getSingleton().createFileStream(filename, 
             getManager()->getPageResourceGroup(), true);
         StreamSerialiser ser(stream);
@@ -341,6 +374,8 @@ namespace Ogre
     //---------------------------------------------------------------------
     void Page::frameStart(Real timeSinceLastFrame)
     {
+        mHoldTime = std::max(Real(0), mHoldTime - timeSinceLastFrame);
+
         updateDebugDisplay();
 
         // content collections
@@ -0,0 +1,276 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgrePageCache.h"
+#include "OgreException.h"
+
+namespace Ogre
+{
+    namespace
+    {
+        /* A byte oriented LZ77 coding, which is fast enough to run on every page read.
+           The data is a list of sequences, each of a token byte with the number of
+           literals in its high nibble and the match length - MIN_MATCH in its low one,
+           the literals, a 16 bit little endian offset back to the match and, when a
+           nibble is 15, the rest of its count in bytes of up to 255. The last sequence
+           has literals only.
+        */
+        const size_t MIN_MATCH = 4;
+        const size_t MAX_OFFSET = 65535;
+        const int HASH_BITS = 12;
+
+        inline uint32 read32(const uchar* p)
+        {
+            uint32 v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        void writeCount(std::vector<uchar>& out, size_t count)
+        {
+            for (; count >= 255; count -= 255)
+                out.push_back(255);
+            out.push_back(static_cast<uchar>(count));
+        }
+
+        void writeSequence(std::vector<uchar>& out, const uchar* literals, size_t numLiterals,
+                           size_t offset, size_t matchLength)
+        {
+            size_t extraMatch = matchLength ? matchLength - MIN_MATCH : 0;
+            out.push_back(static_cast<uchar>((std::min<size_t>(numLiterals, 15) << 4) |
+                                             std::min<size_t>(extraMatch, 15)));
+            if (numLiterals >= 15)
+                writeCount(out, numLiterals - 15);
+            out.insert(out.end(), literals, literals + numLiterals);
+            if (!matchLength)
+                return;
+            out.push_back(static_cast<uchar>(offset & 0xFF));
+            out.push_back(static_cast<uchar>(offset >> 8));
+            if (extraMatch >= 15)
+                writeCount(out, extraMatch - 15);
+        }
+
+        void compress(const uchar* src, size_t size, std::vector<uchar>& out)
+        {
+            out.clear();
+            out.reserve(size / 2 + 16);
+            // position + 1 of the last 4 bytes with each hash, 0 for none
+            std::vector<size_t> table(size_t(1) << HASH_BITS, 0);
+            size_t anchor = 0, i = 0;
+            while (i + MIN_MATCH <= size)
+            {
+                uint32 seq = read32(src + i);
+                uint32 hash = (seq * 2654435761u) >> (32 - HASH_BITS);
+                size_t candidate = table[hash];
+                table[hash] = i + 1;
+                if (candidate && i - (candidate - 1) <= MAX_OFFSET && read32(src + candidate - 1) == seq)
+                {
+                    size_t match = candidate - 1;
+                    size_t length = MIN_MATCH;
+                    while (i + length < size && src[match + length] == src[i + length])
+                        ++length;
+                    writeSequence(out, src + anchor, i - anchor, i - match, length);
+                    i += length;
+                    anchor = i;
+                }
+                else
+                    ++i;
+            }
+            writeSequence(out, src + anchor, size - anchor, 0, 0);
+        }
+
+        bool readCount(const uchar*& src, const uchar* end, size_t& count)
+        {
+            uchar b;
+            do
+            {
+                if (src == end)
+                    return false;
+                b = *src++;
+                count += b;
+            } while (b == 255);
+            return true;
+        }
+
+        bool decompress(const uchar* src, size_t size, uchar* dst, size_t dstSize)
+        {
+            const uchar* end = src + size;
+            uchar* out = dst;
+            uchar* outEnd = dst + dstSize;
+            while (src < end)
+            {
+                uchar token = *src++;
+                size_t numLiterals = token >> 4;
+                if (numLiterals == 15 && !readCount(src, end, numLiterals))
+                    return false;
+                if (numLiterals > size_t(end - src) || numLiterals > size_t(outEnd - out))
+                    return false;
+                memcpy(out, src, numLiterals);
+                src += numLiterals;
+                out += numLiterals;
+                if (src == end)
+                    break;
+
+                if (end - src < 2)
+                    return false;
+                size_t offset = src[0] | (size_t(src[1]) << 8);
+                src += 2;
+                size_t length = token & 15;
+                if (length == 15 && !readCount(src, end, length))
+                    return false;
+                length += MIN_MATCH;
+                if (offset == 0 || offset > size_t(out - dst) || length > size_t(outEnd - out))
+                    return false;
+                // the match may overlap the bytes it produces
+                const uchar* match = out - offset;
+                for (size_t i = 0; i < length; ++i)
+                    out[i] = match[i];
+                out += length;
+            }
+            return out == outEnd;
+        }
+    }
+    //---------------------------------------------------------------------
+    PageCache::PageCache(size_t budget)
+        : mBudget(budget)
+        , mSize(0)
+    {
+    }
+    //---------------------------------------------------------------------
+    PageCache::~PageCache()
+    {
+    }
+    //---------------------------------------------------------------------
+    void PageCache::setBudget(size_t bytes)
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        mBudget = bytes;
+        evict();
+    }
+    //---------------------------------------------------------------------
+    size_t PageCache::getBudget() const
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        return mBudget;
+    }
+    //---------------------------------------------------------------------
+    size_t PageCache::getSize() const
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        return mSize;
+    }
+    //---------------------------------------------------------------------
+    size_t PageCache::getEntryCount() const
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        return mEntries.size();
+    }
+    //---------------------------------------------------------------------
+    void PageCache::add(const String& filename, const String& groupName, const void* data, size_t size)
+    {
+        // compress outside the lock, other pages may be read meanwhile
+        Entry entry;
+        entry.key = Key(filename, groupName);
+        entry.size = size;
+        compress(static_cast<const uchar*>(data), size, entry.compressed);
+
+        OGRE_LOCK_MUTEX(mMutex);
+        EntryMap::iterator i = mEntryMap.find(entry.key);
+        if (i != mEntryMap.end())
+        {
+            mSize -= i->second->compressed.size();
+            mEntries.erase(i->second);
+            mEntryMap.erase(i);
+        }
+        if (entry.compressed.size() > mBudget)
+            return;
+
+        mSize += entry.compressed.size();
+        mEntries.push_front(std::move(entry));
+        mEntryMap[mEntries.front().key] = mEntries.begin();
+        evict();
+    }
+    //---------------------------------------------------------------------
+    DataStreamPtr PageCache::get(const String& filename, const String& groupName)
+    {
+        MemoryDataStreamPtr stream;
+        {
+            OGRE_LOCK_MUTEX(mMutex);
+            EntryMap::iterator i = mEntryMap.find(Key(filename, groupName));
+            if (i == mEntryMap.end())
+                return DataStreamPtr();
+
+            // most recently used now
+            mEntries.splice(mEntries.begin(), mEntries, i->second);
+            const Entry& entry = mEntries.front();
+            stream.reset(OGRE_NEW MemoryDataStream(filename, entry.size));
+            if (!decompress(entry.compressed.data(), entry.compressed.size(), stream->getPtr(), entry.size))
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Corrupt data for page " + filename,
+                            "PageCache::get");
+            }
+        }
+        return stream;
+    }
+    //---------------------------------------------------------------------
+    bool PageCache::contains(const String& filename, const String& groupName) const
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        return mEntryMap.find(Key(filename, groupName)) != mEntryMap.end();
+    }
+    //---------------------------------------------------------------------
+    void PageCache::remove(const String& filename, const String& groupName)
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        EntryMap::iterator i = mEntryMap.find(Key(filename, groupName));
+        if (i != mEntryMap.end())
+        {
+            mSize -= i->second->compressed.size();
+            mEntries.erase(i->second);
+            mEntryMap.erase(i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void PageCache::clear()
+    {
+        OGRE_LOCK_MUTEX(mMutex);
+        mEntries.clear();
+        mEntryMap.clear();
+        mSize = 0;
+    }
+    //---------------------------------------------------------------------
+    void PageCache::evict()
+    {
+        while (mSize > mBudget)
+        {
+            const Entry& oldest = mEntries.back();
+            mSize -= oldest.compressed.size();
+            mEntryMap.erase(oldest.key);
+            mEntries.pop_back();
+        }
+    }
+}
@@ -297,6 +297,13 @@ namespace Ogre
             i->second->touch();
     }
     //---------------------------------------------------------------------
+    void PagedWorldSection::prefetchPage(PageID pageID, Real holdTime)
+    {
+        loadPage(pageID);
+        if (Page* page = getPage(pageID))
+            page->holdFor(holdTime);
+    }
+    //---------------------------------------------------------------------
     Page* PagedWorldSection::getPage(PageID pageID)
     {
         PageMap::iterator i = mPages.find(pageID);
@@ -321,6 +328,7 @@ namespace Ogre
     //---------------------------------------------------------------------
     void PagedWorldSection::frameStart(Real timeSinceLastFrame)
     {
+        mStrategyData->_notifyFrameTime(timeSinceLastFrame);
         mStrategy->frameStart(timeSinceLastFrame, this);
 
         for (PageMap::iterator i = mPages.begin(); i != mPages.end(); ++i)
@@ -64,6 +64,11 @@ public:
     */
     virtual const String& getType() const;
 
+    /** 
+    @see SubRenderState::hashState.
+    */
+    virtual bool hashState(uint32& hash) const;
+
     static String Type;
 
 // Protected methods
@@ -86,6 +86,11 @@ public:
     */
     virtual bool preAddToRenderState (const RenderState* renderState, Pass* srcPass, Pass* dstPass);
 
+    /** 
+    @see SubRenderState::hashState.
+    */
+    virtual bool hashState(uint32& hash) const;
+
     /** 
     @see SubRenderState::copyFrom.
     */
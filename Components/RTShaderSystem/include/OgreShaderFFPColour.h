@@ -85,6 +85,11 @@ public:
     */
     virtual bool preAddToRenderState(const RenderState* renderState, Pass* srcPass, Pass* dstPass);
 
+    /** 
+    @see SubRenderState::hashState.
+    */
+    virtual bool hashState(uint32& hash) const;
+
     /**
     Set the resolve stage flags that this sub render state will produce.
     I.E - If one want to specify that the vertex shader program needs to get a diffuse component
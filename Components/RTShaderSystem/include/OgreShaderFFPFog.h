@@ -88,6 +88,11 @@ public:
     */
     virtual bool preAddToRenderState(const RenderState* renderState, Pass* srcPass, Pass* dstPass);
 
+    /** 
+    @see SubRenderState::hashState.
+    */
+    virtual bool hashState(uint32& hash) const;
+
     /** 
     Set the fog properties this fog sub render state should emulate.
     @param fogMode The fog mode to emulate (FOG_NONE, FOG_EXP, FOG_EXP2, FOG_LINEAR).
@@ -82,6 +82,11 @@ public:
     */
     virtual bool preAddToRenderState(const RenderState* renderState, Pass* srcPass, Pass* dstPass);
 
+    /** 
+    @see SubRenderState::hashState.
+    */
+    virtual bool hashState(uint32& hash) const;
+
     /** normalise the blinn-phong reflection model to make it energy conserving
      *
      * see [this for details](http://www.rorydriscoll.com/2009/01/25/energy-conservation-in-games/)
@@ -190,6 +195,12 @@ protected:
     */
     void addIlluminationInvocation(const LightParams* curLightParams, const FunctionStageRef& stage);
 
+    /** 
+    Internal method that adds the state shared by the lighting sub render states to a hash.
+    @see SubRenderState::hashState.
+    */
+    void hashLightingState(uint32& hash) const;
+
 
 // Attributes.
 protected:  
@@ -78,6 +78,11 @@ public:
     @see SubRenderState::preAddToRenderState.
     */
     virtual bool preAddToRenderState(const RenderState* renderState, Pass* srcPass, Pass* dstPass);
+
+    /** 
+    @see SubRenderState::hashState.
+    */
+    virtual bool hashState(uint32& hash) const;
     
     static String Type;
 
@@ -195,7 +200,7 @@ protected:
     /** 
     Determines if the given texture unit state need to use texture transformation matrix.
     */
-    bool needsTextureMatrix(TextureUnitState* textureUnitState);
+    bool needsTextureMatrix(TextureUnitState* textureUnitState) const;
 
     /** 
     Determines whether a given texture unit needs to be processed by this srs
@@ -74,6 +74,8 @@ public:
 
     bool preAddToRenderState(const RenderState* renderState, Pass* srcPass, Pass* dstPass);
 
+    bool hashState(uint32& hash) const;
+
     void setInstancingParams(bool enabled, int texCoordIndex)
     {
         mInstanced = enabled;
@@ -83,9 +85,9 @@ public:
     static String Type;
 protected:
     Parameter::Content mTexCoordIndex = Parameter::SPC_TEXTURE_COORDINATE0;
-    bool mSetPointSize;
+    bool mSetPointSize = false;
     bool mInstanced = false;
-    bool mDoLightCalculations;
+    bool mDoLightCalculations = false;
 };
 
 
@@ -154,11 +154,27 @@ public:
     /** 
     Set the output shader cache path. Generated shader code will be written to this path.
     In case of empty cache path shaders will be generated directly from system memory.
+    @remarks
+    If the render system can return the compiled programs, they are kept in this path as well,
+    so that later runs do not have to compile them again. The compiled programs of earlier runs
+    are added to the microcode cache of the GpuProgramManager here and are written back by
+    saveShaderCache. Saving microcodes is enabled for as long as the path is set.
+    @par
+    The index of generated programs is kept in this path too, so that later runs also skip
+    generating the programs of render states they have seen before.
+    @see TargetRenderState::acquirePrograms
     @param cachePath The cache path of the shader.  
     The default is empty cache path.
     */
     void setShaderCachePath(const String& cachePath);
 
+    /** 
+    Save the programs generated and compiled since the shader cache path was set.
+    Called by destroy, call it yourself to keep the programs in case the application does not exit cleanly.
+    @see setShaderCachePath
+    */
+    void saveShaderCache();
+
     /** 
     Get the output shader cache path.
     */
@@ -419,6 +435,19 @@ public:
     */
     bool getCreateShaderOverProgrammablePass() const { return mCreateShaderOverProgrammablePass; }
 
+    /** Sets whether validateScheme generates the programs of the scheme techniques in parallel.
+    The render states are built on the calling thread. Their CPU programs and source code are
+    then generated on the threads of the WorkQueue, while the GPU programs are created on the
+    calling thread in the original order, so the result does not differ from the sequential path.
+    @param enabled The value to set this attribute.
+    */
+    void setParallelValidationEnabled(bool enabled) { mParallelValidation = enabled; }
+
+    /** Returns whether schemes are validated in parallel.
+    @see setParallelValidationEnabled().
+    */
+    bool getParallelValidationEnabled() const { return mParallelValidation; }
+
 
     /** Returns the amount of schemes used in the for RT shader generation
     */
@@ -484,6 +513,11 @@ protected:
         /** Build the render state. */
         void buildTargetRenderState();
 
+        /** Generate the CPU programs for this pass ahead of acquirePrograms.
+        @see TargetRenderState::prepareCpuPrograms
+        */
+        void prepareCpuPrograms(ProgramWriter* programWriter);
+
         /** Acquire the CPU/GPU programs for this pass. */
         void acquirePrograms();
 
@@ -548,6 +582,11 @@ protected:
         /** Build the render state. */
         void buildTargetRenderState();
 
+        /** Generate the CPU programs for this technique ahead of acquirePrograms.
+        @see TargetRenderState::prepareCpuPrograms
+        */
+        void prepareCpuPrograms(ProgramWriter* programWriter);
+
         /** Acquire the CPU/GPU programs for this technique. */
         void acquirePrograms();
 
@@ -858,6 +897,8 @@ protected:
     StringVector mFragmentShaderProfilesList;
     // Path for caching the generated shaders.
     String mShaderCachePath;
+    // Whether the GpuProgramManager saved microcodes before the shader cache path enabled it.
+    bool mPrevSaveMicrocodesToCache;
     // Shader program manager.
     std::unique_ptr<ProgramManager> mProgramManager;
     // Shader program writer manager.
@@ -884,6 +925,8 @@ protected:
     VSOutputCompactPolicy mVSOutputCompactPolicy;
     // Tells whether shaders are created for passes with shaders
     bool mCreateShaderOverProgrammablePass;
+    // Tells whether schemes are validated in parallel
+    bool mParallelValidation;
     // A flag to indicate finalizing
     bool mIsFinalizing;
 
@@ -894,7 +937,12 @@ private:
     friend class SGScriptTranslatorManager;
     friend class SGScriptTranslator;
     friend class SGMaterialSerializerListener;
-    
+
+    /** File in the shader cache path for the compiled programs. */
+    String getMicrocodeCacheFileName() const { return mShaderCachePath + "RTShaderMicrocode.cache"; }
+
+    /** File in the shader cache path for the index of generated programs. */
+    String getProgramIndexFileName() const { return mShaderCachePath + "RTShaderIndex.cache"; }
 };
 
 /** @} */
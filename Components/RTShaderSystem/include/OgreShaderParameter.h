@@ -339,6 +339,9 @@ public:
         mName = newName;
     }
 
+    /// the name in the program interface, which differs from getName after a local _rename
+    const String& getBindName() const { return mBindName.empty() ? mName : mBindName; }
+
     /** Get the type of this parameter. */
     GpuConstantType getType() const { return mType; }
 
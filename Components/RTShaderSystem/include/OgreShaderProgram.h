@@ -227,6 +227,7 @@ protected:
     bool mColumnMajorMatrices;
 private:
     friend class TargetRenderState;
+    friend class ProgramManager;
 };
 
 /** @} */
@@ -87,6 +87,14 @@ public:
     */
     void flushGpuProgramsCache();
 
+    /** Remove all render states from the index of generated programs.
+    @see TargetRenderState::acquirePrograms
+    */
+    void clearProgramIndex() { mProgramIndex.clear(); }
+
+    /** Return the number of render states in the index of generated programs. */
+    size_t getProgramIndexSize() const { return mProgramIndex.size(); }
+
 protected:
 
     //-----------------------------------------------------------------------------
@@ -107,6 +115,42 @@ protected:
     typedef ProgramProcessorMap::const_iterator         ProgramProcessorConstIterator;
     typedef std::vector<ProgramProcessor*>             ProgramProcessorList;
 
+    //-----------------------------------------------------------------------------
+    // A uniform parameter of a program in the index of generated programs.
+    struct IndexedUniform
+    {
+        String name;
+        uint32 type;
+        int32 index;
+        uint16 variability;
+        uint32 size;
+        uint32 autoType;
+        bool autoReal;
+        bool autoInt;
+        Real autoRealData;
+        uint32 autoIntData;
+        bool used;
+    };
+    typedef std::vector<IndexedUniform>                IndexedUniformList;
+
+    // A program in the index of generated programs.
+    struct IndexedProgram
+    {
+        String source;
+        String preprocessorDefines;
+        bool columnMajorMatrices;
+        bool skeletalAnimation;
+        IndexedUniformList uniforms;
+    };
+
+    // The programs generated for a render state, keyed by its hash.
+    struct IndexedProgramSet
+    {
+        IndexedProgram vertexProgram;
+        IndexedProgram fragmentProgram;
+    };
+    typedef std::map<uint32, IndexedProgramSet>        ProgramIndex;
+
     
 protected:
     /** Create default program processors. */
@@ -138,6 +182,17 @@ protected:
     @param programSet The program set container.
     */
     void createGpuPrograms(ProgramSet* programSet);
+
+    /** Write the source code of the CPU programs of the given program set.
+    Only the program set is modified, so different program sets may be written by different
+    threads at once as long as each thread uses its own writer.
+    @param programSet The program set container.
+    @param programWriter The program writer instance.
+    */
+    void writeSourceCode(ProgramSet* programSet, ProgramWriter* programWriter);
+
+    /** Get the program processor of the given target language. */
+    ProgramProcessor* getProgramProcessor(const String& language);
         
     /** 
     Generates a unique hash from a string
@@ -149,14 +204,14 @@ protected:
 
     /** Create GPU program based on the give CPU program.
     @param shaderProgram The CPU program instance.
-    @param programWriter The program writer instance.
+    @param source The source code written for the CPU program.
     @param language The target shader language.
     @param profiles The profiles string for program compilation.
     @param profilesList The profiles string for program compilation as string list.
     @param cachePath The output path to write the program into.
     */
     GpuProgramPtr createGpuProgram(Program* shaderProgram, 
-        ProgramWriter* programWriter,
+        const String& source,
         const String& language,
         const String& profiles,
         const StringVector& profilesList,
@@ -190,6 +245,33 @@ protected:
     /** Fix the input of the pixel shader to be the same as the output of the vertex shader */
     void synchronizePixelnToBeVertexOut(ProgramSet* programSet);
 
+    /** Add the programs of the given program set to the index of generated programs.
+    Nothing is changed if the hash is in the index already.
+    @param hash The hash of the render state the programs were generated for.
+    @param programSet The program set, with its source code written.
+    */
+    void addIndexedPrograms(uint32 hash, ProgramSet* programSet);
+
+    /** Find the programs generated for a render state in the index of generated programs.
+    Only reads the index, so it may be called by several threads at once.
+    @return NULL if the hash is not in the index.
+    */
+    const IndexedProgramSet* findIndexedPrograms(uint32 hash) const;
+
+    /** Complete a program set from the index of generated programs.
+    The program set has to hold the CPU programs with the parameters resolved by
+    SubRenderState::resolveParameters. The source code and the remaining uniform
+    parameters are taken from the index.
+    @return false if the resolved parameters do not match the indexed ones.
+    */
+    static bool applyIndexedPrograms(const IndexedProgramSet& indexed, ProgramSet* programSet);
+
+    /** Write the index of generated programs to the given stream. */
+    void saveProgramIndex(const DataStreamPtr& stream) const;
+
+    /** Add the render states stored in the given stream to the index of generated programs. */
+    void loadProgramIndex(const DataStreamPtr& stream);
+
 protected:
     // Map between target language and shader program writer.                   
     ProgramWriterMap mProgramWritersMap;
@@ -203,6 +285,8 @@ protected:
     GpuProgramsMap mFragmentShaderMap;
     // The default program processors.
     ProgramProcessorList mDefaultProgramProcessors;
+    // The programs generated so far, keyed by the hash of their render state.
+    ProgramIndex mProgramIndex;
 
 private:
     friend class ProgramSet;
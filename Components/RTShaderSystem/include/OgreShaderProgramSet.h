@@ -75,6 +75,9 @@ protected:
     GpuProgramPtr mVSGpuProgram;
     // Fragment shader CPU program.
     GpuProgramPtr mPSGpuProgram;
+    // Source code written for the vertex and fragment CPU programs, empty until written.
+    String mVSSource;
+    String mPSSource;
 
 private:
     friend class ProgramManager;
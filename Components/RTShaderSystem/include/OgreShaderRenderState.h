@@ -165,10 +165,24 @@ public:
     void removeSubRenderStateInstance(SubRenderState* subRenderState);
     
     /** Acquire CPU/GPU programs set associated with the given render state and bind them to the pass.
+    @remarks
+    If all sub render states support SubRenderState::hashState, the generated programs are kept in
+    the index of the ProgramManager. Later render states with the same hash take their source code
+    from there and skip generating the CPU programs, apart from SubRenderState::resolveParameters.
     @param pass The pass to bind the programs to.
     */
     void acquirePrograms(Pass* pass);
 
+    /** Create the CPU programs and write their source code ahead of acquirePrograms.
+    Only this render state is touched, so the render states of different passes may be
+    prepared by different threads at once. On failure the prepared programs are discarded,
+    leaving acquirePrograms to create them again and report the error.
+    Programs in the index of generated programs are taken from there instead.
+    @param programWriter The program writer instance, used by the calling thread only.
+    @return true on success.
+    */
+    bool prepareCpuPrograms(ProgramWriter* programWriter);
+
     /** Release CPU/GPU programs set associated with the given render state and pass.
     @param pass The pass to release the programs from.
     */
@@ -188,6 +202,16 @@ protected:
     */
     void createCpuPrograms();
 
+    /** Compute the hash the programs of this render state are indexed by.
+    @return false if a sub render state does not support hashing its state.
+    */
+    bool hashSubRenderStates(uint32& hash);
+
+    /** Create the CPU programs from the index of generated programs.
+    @return false if the hash is not in the index or the indexed programs do not fit.
+    */
+    bool createIndexedCpuPrograms(uint32 hash);
+
     /** Create the program set of this render state.
     */
     ProgramSet* createProgramSet();
@@ -114,6 +114,19 @@ public:
     */
     virtual bool preAddToRenderState(const RenderState* renderState, Pass* srcPass, Pass* dstPass) { return true; }
 
+    /** Add the state the programs of this sub render state are generated from to the given hash.
+    The hash keys the index of generated programs, which lets TargetRenderState::acquirePrograms
+    reuse the programs written for an equal render state instead of generating them again.
+    @remarks
+    Everything createCpuSubPrograms reads apart from the type has to go into the hash, and all
+    uniform parameters used by updateGpuProgramsParams have to be created in resolveParameters,
+    which is the only step still called when the programs are taken from the index.
+    @param hash The hash to add the state to.
+    @return false if the programs can not be derived from such a hash, which makes the render
+    states using this sub render state generate their programs every time. The default.
+    */
+    virtual bool hashState(uint32& hash) const { return false; }
+
     /** Return the accessor object to this sub render state.
     @see SubRenderStateAccessor.
     */
@@ -151,7 +164,8 @@ private:
     mutable SubRenderStateAccessorPtr mThisAccessor;
     // The accessor of the source instance which used as base to create this instance.
     SubRenderStateAccessorPtr mOtherAccessor;
-    
+
+    friend class TargetRenderState;
 };
 
 typedef std::vector<SubRenderState*>               SubRenderStateList;
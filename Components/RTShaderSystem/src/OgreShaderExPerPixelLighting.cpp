@@ -41,6 +41,17 @@ const String& PerPixelLighting::getType() const
     return Type;
 }
 
+//-----------------------------------------------------------------------
+bool PerPixelLighting::hashState(uint32& hash) const
+{
+    // Sub classes may generate their programs from state of their own.
+    if (getType() != Type)
+        return false;
+
+    hashLightingState(hash);
+    return true;
+}
+
 //-----------------------------------------------------------------------
 bool PerPixelLighting::resolveParameters(ProgramSet* programSet)
 {
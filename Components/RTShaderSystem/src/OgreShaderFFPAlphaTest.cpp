@@ -98,6 +98,12 @@ namespace Ogre {
 			mPSAlphaFunc->setGpuParameter((float)pass->getAlphaRejectFunction());
 		}
 
+		bool FFPAlphaTest::hashState(uint32& hash) const
+		{
+			// the compare function is a uniform
+			return true;
+		}
+
 		//----------------------Factory Implementation---------------------------
 		//-----------------------------------------------------------------------
 		const String& FFPAlphaTestFactory ::getType() const
@@ -188,6 +188,13 @@ bool FFPColour::preAddToRenderState(const RenderState* renderState, Pass* srcPas
     return true;
 }
 
+//-----------------------------------------------------------------------
+bool FFPColour::hashState(uint32& hash) const
+{
+    hash = HashCombine(hash, mResolveStageFlags);
+    return true;
+}
+
 //-----------------------------------------------------------------------
 const String& FFPColourFactory::getType() const
 {
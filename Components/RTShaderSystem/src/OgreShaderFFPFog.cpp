@@ -291,6 +291,15 @@ bool FFPFog::preAddToRenderState(const RenderState* renderState, Pass* srcPass,
     return true;
 }
 
+//-----------------------------------------------------------------------
+bool FFPFog::hashState(uint32& hash) const
+{
+    // the fog colour and parameters are uniforms
+    hash = HashCombine(hash, mCalcMode);
+    hash = HashCombine(hash, mFogMode);
+    return true;
+}
+
 //-----------------------------------------------------------------------
 void FFPFog::setFogProperties(FogMode fogMode, 
                              const ColourValue& fogColour, 
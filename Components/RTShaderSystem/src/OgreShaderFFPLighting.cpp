@@ -520,6 +520,28 @@ Vector3i FFPLighting::getLightCount() const
 	return lightCount;
 }
 
+//-----------------------------------------------------------------------
+bool FFPLighting::hashState(uint32& hash) const
+{
+	// Sub classes may generate their programs from state of their own.
+	if (getType() != Type)
+		return false;
+
+	hashLightingState(hash);
+	return true;
+}
+
+//-----------------------------------------------------------------------
+void FFPLighting::hashLightingState(uint32& hash) const
+{
+	hash = HashCombine(hash, mTrackVertexColourType);
+	hash = HashCombine(hash, mSpecularEnable);
+	hash = HashCombine(hash, mNormalisedEnable);
+
+	for (const auto& lp : mLightParamsList)
+		hash = HashCombine(hash, lp.mType);
+}
+
 //-----------------------------------------------------------------------
 const String& FFPLightingFactory::getType() const
 {
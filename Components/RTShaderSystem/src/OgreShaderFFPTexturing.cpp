@@ -506,7 +506,7 @@ TexCoordCalcMethod FFPTexturing::getTexCalcMethod(TextureUnitState* textureUnitS
 }
 
 //-----------------------------------------------------------------------
-bool FFPTexturing::needsTextureMatrix(TextureUnitState* textureUnitState)
+bool FFPTexturing::needsTextureMatrix(TextureUnitState* textureUnitState) const
 {
     const TextureUnitState::EffectMap&      effectMap = textureUnitState->getEffects(); 
     TextureUnitState::EffectMap::const_iterator effi;
@@ -578,6 +578,43 @@ bool FFPTexturing::preAddToRenderState(const RenderState* renderState, Pass* src
     return true;
 }
 
+//-----------------------------------------------------------------------
+bool FFPTexturing::hashState(uint32& hash) const
+{
+    // Sub classes may generate their programs from state of their own.
+    if (getType() != Type)
+        return false;
+
+    hash = HashCombine(hash, mIsPointSprite);
+
+    for (const auto& params : mTextureUnitParamsList)
+    {
+        hash = HashCombine(hash, params.mTextureSamplerIndex);
+        hash = HashCombine(hash, params.mTextureSamplerType);
+        hash = HashCombine(hash, params.mVSInTextureCoordinateType);
+        hash = HashCombine(hash, params.mVSOutTextureCoordinateType);
+        hash = HashCombine(hash, params.mTexCoordCalcMethod);
+        hash = HashCombine(hash, params.mTextureUnitState->getTextureCoordSet());
+        hash = HashCombine(hash, needsTextureMatrix(params.mTextureUnitState));
+
+        // manual blend sources are written as constants
+        for (const LayerBlendModeEx* blend : {&params.mTextureUnitState->getColourBlendMode(),
+                                              &params.mTextureUnitState->getAlphaBlendMode()})
+        {
+            hash = HashCombine(hash, blend->operation);
+            hash = HashCombine(hash, blend->source1);
+            hash = HashCombine(hash, blend->source2);
+            hash = HashCombine(hash, blend->colourArg1);
+            hash = HashCombine(hash, blend->colourArg2);
+            hash = HashCombine(hash, blend->alphaArg1);
+            hash = HashCombine(hash, blend->alphaArg2);
+            hash = HashCombine(hash, blend->factor);
+        }
+    }
+
+    return true;
+}
+
 //-----------------------------------------------------------------------
 void FFPTexturing::setTextureUnitCount(size_t count)
 {
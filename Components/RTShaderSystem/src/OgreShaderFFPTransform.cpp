@@ -55,6 +55,16 @@ bool FFPTransform::preAddToRenderState(const RenderState* renderState, Pass* src
     return true;
 }
 
+//-----------------------------------------------------------------------
+bool FFPTransform::hashState(uint32& hash) const
+{
+    hash = HashCombine(hash, mSetPointSize);
+    hash = HashCombine(hash, mInstanced);
+    hash = HashCombine(hash, mDoLightCalculations);
+    hash = HashCombine(hash, mTexCoordIndex);
+    return true;
+}
+
 //-----------------------------------------------------------------------
 bool FFPTransform::createCpuSubPrograms(ProgramSet* programSet)
 {
@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -126,9 +127,9 @@ ShaderGenerator& ShaderGenerator::getSingleton()
 
 //-----------------------------------------------------------------------------
 ShaderGenerator::ShaderGenerator() :
-    mActiveSceneMgr(NULL), mShaderLanguage(""),
+    mActiveSceneMgr(NULL), mShaderLanguage(""), mPrevSaveMicrocodesToCache(false),
     mFSLayer(0), mActiveViewportValid(false), mVSOutputCompactPolicy(VSOCP_LOW),
-    mCreateShaderOverProgrammablePass(false), mIsFinalizing(false)
+    mCreateShaderOverProgrammablePass(false), mParallelValidation(false), mIsFinalizing(false)
 {
     mLightCount[0]              = 0;
     mLightCount[1]              = 0;
@@ -313,6 +314,10 @@ void ShaderGenerator::_destroy()
     OGRE_LOCK_AUTO_MUTEX;
     
     mIsFinalizing = true;
+
+    // Keep the programs compiled during this run.
+    saveShaderCache();
+    setShaderCachePath("");
     
     // Delete technique entries.
     for (SGTechniqueMapIterator itTech = mTechniqueEntriesMap.begin(); itTech != mTechniqueEntriesMap.end(); ++itTech)
@@ -1361,6 +1366,12 @@ void ShaderGenerator::setShaderCachePath( const String& cachePath )
 
     if (mShaderCachePath != stdCachePath)
     {
+        // Only save microcodes while we have a path for them.
+        Root* root = Root::getSingletonPtr();
+        RenderSystem* rs = root ? root->getRenderSystem() : NULL;
+        if (!mShaderCachePath.empty() && rs)
+            GpuProgramManager::getSingleton().setSaveMicrocodesToCache(mPrevSaveMicrocodesToCache);
+
         mShaderCachePath = stdCachePath;
 
         // Case this is a valid file path -> add as resource location in order to make sure that
@@ -1381,10 +1392,74 @@ void ShaderGenerator::setShaderCachePath( const String& cachePath )
             // Close and remove the test file.
             outFile.close();
             remove(outTestFileName.c_str());
+
+            // Reuse the programs compiled by earlier runs.
+            GpuProgramManager& gpuMgr = GpuProgramManager::getSingleton();
+            mPrevSaveMicrocodesToCache = gpuMgr.getSaveMicrocodesToCache();
+            if (rs)
+                gpuMgr.setSaveMicrocodesToCache(true);
+
+            String path = getMicrocodeCacheFileName();
+            std::ifstream inFile(path.c_str(), std::ios::binary);
+            if (inFile.is_open())
+            {
+                LogManager::getSingleton().logMessage("RTSS: loading compiled programs from '" + path + "'");
+                DataStreamPtr istream(OGRE_NEW FileStreamDataStream(path, &inFile, false));
+                gpuMgr.loadMicrocodeCache(istream, true);
+            }
+
+            // Reuse the programs generated by earlier runs.
+            path = getProgramIndexFileName();
+            std::ifstream indexFile(path.c_str(), std::ios::binary);
+            if (indexFile.is_open())
+            {
+                LogManager::getSingleton().logMessage("RTSS: loading generated programs from '" + path + "'");
+                DataStreamPtr istream(OGRE_NEW FileStreamDataStream(path, &indexFile, false));
+                mProgramManager->loadProgramIndex(istream);
+            }
         }
     }
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::saveShaderCache()
+{
+    if (mShaderCachePath.empty())
+        return;
+
+    if (mProgramManager->getProgramIndexSize() > 0)
+    {
+        String path = getProgramIndexFileName();
+        std::fstream indexFile(path.c_str(), std::ios::out | std::ios::binary);
+        if (indexFile.is_open())
+        {
+            LogManager::getSingleton().logMessage("RTSS: writing generated programs to '" + path + "'");
+            DataStreamPtr ostream(OGRE_NEW FileStreamDataStream(path, &indexFile, false));
+            mProgramManager->saveProgramIndex(ostream);
+        }
+        else
+        {
+            LogManager::getSingleton().logWarning("RTSS: cannot write generated programs to '" + path + "'");
+        }
+    }
+
+    GpuProgramManager* gpuMgr = GpuProgramManager::getSingletonPtr();
+    if (!gpuMgr || !gpuMgr->isCacheDirty())
+        return;
+
+    String path = getMicrocodeCacheFileName();
+    std::fstream outFile(path.c_str(), std::ios::out | std::ios::binary);
+    if (!outFile.is_open())
+    {
+        LogManager::getSingleton().logWarning("RTSS: cannot write compiled programs to '" + path + "'");
+        return;
+    }
+
+    LogManager::getSingleton().logMessage("RTSS: writing compiled programs to '" + path + "'");
+    DataStreamPtr ostream(OGRE_NEW FileStreamDataStream(path, &outFile, false));
+    gpuMgr->saveMicrocodeCache(ostream);
+}
+
 //-----------------------------------------------------------------------------
 ShaderGenerator::SGMaterialIterator ShaderGenerator::findMaterialEntryIt(const String& materialName, const String& groupName)
 {
@@ -1548,6 +1623,13 @@ void ShaderGenerator::SGPass::buildTargetRenderState()
     }               
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGPass::prepareCpuPrograms(ProgramWriter* programWriter)
+{
+    if(!mTargetRenderState) return;
+    mTargetRenderState->prepareCpuPrograms(programWriter);
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGPass::acquirePrograms()
 {
@@ -1737,6 +1819,14 @@ void ShaderGenerator::SGTechnique::buildTargetRenderState()
     }
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGTechnique::prepareCpuPrograms(ProgramWriter* programWriter)
+{
+	for(SGPassIterator itPass = mPassEntries.begin(); itPass != mPassEntries.end(); ++itPass)
+		if(!(*itPass)->isIlluminationPass())
+			(*itPass)->prepareCpuPrograms(programWriter);
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGTechnique::acquirePrograms()
 {
@@ -1916,6 +2006,27 @@ void ShaderGenerator::SGScheme::validate()
             curTechEntry->buildTargetRenderState();     
     }
 
+    WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+    if (ShaderGenerator::getSingleton().getParallelValidationEnabled() && queue)
+    {
+        SGTechniqueList toPrepare;
+        for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
+        {
+            if ((*itTech)->getBuildDestinationTechnique())
+                toPrepare.push_back(*itTech);
+        }
+
+        // Generate the CPU programs concurrently, each chunk with its own writer as writers keep state.
+        // Failures are ignored here, acquiring the programs below reports them.
+        const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+        queue->parallelFor(toPrepare.size(), 4, [&](size_t begin, size_t end) {
+            ProgramWriter* programWriter = ProgramWriterManager::getSingleton().createProgramWriter(language);
+            for (size_t i = begin; i < end; ++i)
+                toPrepare[i]->prepareCpuPrograms(programWriter);
+            OGRE_DELETE programWriter;
+        });
+    }
+
     // Acquire GPU programs for each technique.
     for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
     {
@@ -363,7 +363,7 @@ void UniformParameter::bind(GpuProgramParametersSharedPtr paramsPtr)
     if (paramsPtr.get() != NULL)
     {
         // do not throw on failure: some RS optimize unused uniforms away. Also unit tests run without any RS
-        const GpuConstantDefinition* def = paramsPtr->_findNamedConstantDefinition(mBindName.empty() ? mName : mBindName, false);
+        const GpuConstantDefinition* def = paramsPtr->_findNamedConstantDefinition(getBindName(), false);
 
         if (def != NULL)
         {
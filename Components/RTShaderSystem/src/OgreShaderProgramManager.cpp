@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreStreamSerialiser.h"
 
 namespace Ogre {
 
@@ -34,6 +35,7 @@ RTShader::ProgramManager* Singleton<RTShader::ProgramManager>::msSingleton = 0;
 
 namespace RTShader {
 
+static uint32 PROGRAM_INDEX_CHUNK_ID = StreamSerialiser::makeIdentifier("RTSI"); // RTSS program index
 
 //-----------------------------------------------------------------------
 ProgramManager* ProgramManager::getSingletonPtr()
@@ -198,53 +200,34 @@ void ProgramManager::destroyProgramWriters()
 //-----------------------------------------------------------------------------
 void ProgramManager::createGpuPrograms(ProgramSet* programSet)
 {
-    // Before we start we need to make sure that the pixel shader input
-    //  parameters are the same as the vertex output, this required by 
-    //  shader models 4 and 5.
-    // This change may incrase the number of register used in older shader
-    //  models - this is why the check is present here.
-    bool isVs4 = GpuProgramManager::getSingleton().isSyntaxSupported("vs_4_0_level_9_1");
-    if (isVs4)
-    {
-        synchronizePixelnToBeVertexOut(programSet);
-    }
-
-    // Grab the matching writer.
     const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
-    ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
-    ProgramWriter* programWriter = NULL;
 
-    // No writer found -> create new one.
-    if (itWriter == mProgramWritersMap.end())
-    {
-        programWriter = ProgramWriterManager::getSingletonPtr()->createProgramWriter(language);
-        mProgramWritersMap[language] = programWriter;
-    }
-    else
+    // Write the source code, unless it was written ahead of time.
+    if (programSet->mVSSource.empty())
     {
-        programWriter = itWriter->second;
-    }
+        // Grab the matching writer.
+        ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
+        ProgramWriter* programWriter = NULL;
 
-    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
-    ProgramProcessor* programProcessor = NULL;
+        // No writer found -> create new one.
+        if (itWriter == mProgramWritersMap.end())
+        {
+            programWriter = ProgramWriterManager::getSingletonPtr()->createProgramWriter(language);
+            mProgramWritersMap[language] = programWriter;
+        }
+        else
+        {
+            programWriter = itWriter->second;
+        }
 
-    if (itProcessor == mProgramProcessorsMap.end())
-    {
-        OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
-            "Could not find processor for language '" + language,
-            "ProgramManager::createGpuPrograms");       
+        writeSourceCode(programSet, programWriter);
     }
 
-    programProcessor = itProcessor->second;
-    
-    // Call the pre creation of GPU programs method.
-    if (!programProcessor->preCreateGpuPrograms(programSet))
-        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
-    
     // Create the shader programs
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programWriter, language,
+        const String& source = type == GPT_VERTEX_PROGRAM ? programSet->mVSSource : programSet->mPSSource;
+        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), source, language,
                                            ShaderGenerator::getSingleton().getShaderProfiles(type),
                                            ShaderGenerator::getSingleton().getShaderProfilesList(type),
                                            ShaderGenerator::getSingleton().getShaderCachePath());
@@ -258,24 +241,63 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         programSet->getCpuProgram(GPT_VERTEX_PROGRAM)->getSkeletalAnimationIncluded());
 
     // Call the post creation of GPU programs method.
-    if(!programProcessor->postCreateGpuPrograms(programSet))
+    if(!getProgramProcessor(language)->postCreateGpuPrograms(programSet))
         OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "postCreateGpuPrograms failed");
 }
 
+//-----------------------------------------------------------------------------
+void ProgramManager::writeSourceCode(ProgramSet* programSet, ProgramWriter* programWriter)
+{
+    // Before we start we need to make sure that the pixel shader input
+    //  parameters are the same as the vertex output, this required by 
+    //  shader models 4 and 5.
+    // This change may incrase the number of register used in older shader
+    //  models - this is why the check is present here.
+    bool isVs4 = GpuProgramManager::getSingleton().isSyntaxSupported("vs_4_0_level_9_1");
+    if (isVs4)
+    {
+        synchronizePixelnToBeVertexOut(programSet);
+    }
+
+    ProgramProcessor* programProcessor = getProgramProcessor(programWriter->getTargetLanguage());
+
+    // Call the pre creation of GPU programs method.
+    if (!programProcessor->preCreateGpuPrograms(programSet))
+        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
+
+    // Generate source code.
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        stringstream sourceCodeStringStream;
+        programWriter->writeSourceCode(sourceCodeStringStream, programSet->getCpuProgram(type));
+        (type == GPT_VERTEX_PROGRAM ? programSet->mVSSource : programSet->mPSSource) =
+            sourceCodeStringStream.str();
+    }
+}
+
+//-----------------------------------------------------------------------------
+ProgramProcessor* ProgramManager::getProgramProcessor(const String& language)
+{
+    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
+
+    if (itProcessor == mProgramProcessorsMap.end())
+    {
+        OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
+            "Could not find processor for language '" + language,
+            "ProgramManager::getProgramProcessor");       
+    }
+
+    return itProcessor->second;
+}
+
 //-----------------------------------------------------------------------------
 GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
-                                               ProgramWriter* programWriter,
+                                               const String& source,
                                                const String& language,
                                                const String& profiles,
                                                const StringVector& profilesList,
                                                const String& cachePath)
 {
-    stringstream sourceCodeStringStream;
-
-    // Generate source code.
-    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
-    String source = sourceCodeStringStream.str();
-
     // Generate program name.
     String programName = generateHash(source, shaderProgram->getPreprocessorDefines());
 
@@ -302,6 +324,8 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
     pGpuProgram = HighLevelGpuProgramManager::getSingleton().createProgram(programName,
         ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, language, shaderProgram->getType());
 
+    pGpuProgram->setSource(source);
+
     // Case cache directory specified -> create program from file.
     if (!cachePath.empty())
     {
@@ -328,11 +352,10 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
             // use program file version
             StringStream buffer;
             programFile >> buffer.rdbuf();
-            source = buffer.str();
+            pGpuProgram->setSource(buffer.str());
         }
     }
 
-    pGpuProgram->setSource(source);
     pGpuProgram->setPreprocessorDefines(shaderProgram->getPreprocessorDefines());
     pGpuProgram->setParameter("entry_point", shaderProgram->getEntryPointFunction()->getName());
 
@@ -481,6 +504,214 @@ void ProgramManager::synchronizePixelnToBeVertexOut( ProgramSet* programSet )
     }
 }
 
+//-----------------------------------------------------------------------------
+void ProgramManager::addIndexedPrograms(uint32 hash, ProgramSet* programSet)
+{
+    if (mProgramIndex.find(hash) != mProgramIndex.end())
+        return;
+
+    IndexedProgramSet& indexed = mProgramIndex[hash];
+
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        Program* program = programSet->getCpuProgram(type);
+        IndexedProgram& dst = type == GPT_VERTEX_PROGRAM ? indexed.vertexProgram : indexed.fragmentProgram;
+
+        dst.source = type == GPT_VERTEX_PROGRAM ? programSet->mVSSource : programSet->mPSSource;
+        dst.preprocessorDefines = program->getPreprocessorDefines();
+        dst.columnMajorMatrices = program->getUseColumnMajorMatrices();
+        dst.skeletalAnimation = program->getSkeletalAnimationIncluded();
+
+        for (const auto& param : program->getParameters())
+        {
+            IndexedUniform uniform;
+            uniform.name = param->getBindName();
+            uniform.type = param->getType();
+            uniform.index = param->getIndex();
+            uniform.variability = param->getVariability();
+            uniform.size = static_cast<uint32>(param->getSize());
+            uniform.autoType = param->getAutoConstantType();
+            uniform.autoReal = param->isAutoConstantRealParameter();
+            uniform.autoInt = param->isAutoConstantIntParameter();
+            uniform.autoRealData = uniform.autoReal ? param->getAutoConstantRealData() : 0;
+            uniform.autoIntData = uniform.autoInt ? static_cast<uint32>(param->getAutoConstantIntData()) : 0;
+            uniform.used = param->isUsed();
+            dst.uniforms.push_back(uniform);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+const ProgramManager::IndexedProgramSet* ProgramManager::findIndexedPrograms(uint32 hash) const
+{
+    ProgramIndex::const_iterator it = mProgramIndex.find(hash);
+    return it == mProgramIndex.end() ? NULL : &it->second;
+}
+
+//-----------------------------------------------------------------------------
+bool ProgramManager::applyIndexedPrograms(const IndexedProgramSet& indexed, ProgramSet* programSet)
+{
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        Program* program = programSet->getCpuProgram(type);
+        const IndexedProgram& src = type == GPT_VERTEX_PROGRAM ? indexed.vertexProgram : indexed.fragmentProgram;
+
+        // Every parameter resolved up front has to be one of the indexed ones,
+        // the rest were resolved while adding the function invocations.
+        size_t numResolved = program->getParameters().size();
+        size_t numMatched = 0;
+
+        for (const auto& uniform : src.uniforms)
+        {
+            auto autoType = GpuProgramParameters::AutoConstantType(uniform.autoType);
+            auto gcType = GpuConstantType(uniform.type);
+            UniformParameterPtr param = program->getParameterByName(uniform.name);
+
+            if (param)
+            {
+                if (param->getType() != gcType || param->getIndex() != uniform.index ||
+                    param->getAutoConstantType() != autoType)
+                    return false;
+                numMatched++;
+            }
+            else
+            {
+                if (uniform.autoReal)
+                    param.reset(OGRE_NEW UniformParameter(autoType, uniform.autoRealData, uniform.size, gcType));
+                else if (uniform.autoInt)
+                    param.reset(OGRE_NEW UniformParameter(autoType, size_t(uniform.autoIntData), uniform.size, gcType));
+                else
+                    param.reset(OGRE_NEW UniformParameter(gcType, uniform.name, Parameter::SPS_UNKNOWN, uniform.index,
+                                                          Parameter::SPC_UNKNOWN, uniform.variability, uniform.size));
+
+                if (param->getName() != uniform.name)
+                    return false;
+                program->addParameter(param);
+            }
+
+            param->setSize(uniform.size);
+            param->setUsed(uniform.used);
+        }
+
+        if (numMatched != numResolved)
+            return false;
+
+        program->addPreprocessorDefines(src.preprocessorDefines);
+        program->setUseColumnMajorMatrices(src.columnMajorMatrices);
+        program->setSkeletalAnimationIncluded(src.skeletalAnimation);
+        (type == GPT_VERTEX_PROGRAM ? programSet->mVSSource : programSet->mPSSource) = src.source;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::saveProgramIndex(const DataStreamPtr& stream) const
+{
+    StreamSerialiser serialiser(stream);
+    serialiser.writeChunkBegin(PROGRAM_INDEX_CHUNK_ID, 1);
+
+    uint32 numEntries = static_cast<uint32>(mProgramIndex.size());
+    serialiser.write(&numEntries);
+
+    for (const auto& entry : mProgramIndex)
+    {
+        serialiser.write(&entry.first);
+
+        for (const IndexedProgram* program : {&entry.second.vertexProgram, &entry.second.fragmentProgram})
+        {
+            serialiser.write(&program->source);
+            serialiser.write(&program->preprocessorDefines);
+            serialiser.write(&program->columnMajorMatrices);
+            serialiser.write(&program->skeletalAnimation);
+
+            uint32 numUniforms = static_cast<uint32>(program->uniforms.size());
+            serialiser.write(&numUniforms);
+
+            for (const auto& uniform : program->uniforms)
+            {
+                serialiser.write(&uniform.name);
+                serialiser.write(&uniform.type);
+                serialiser.write(&uniform.index);
+                serialiser.write(&uniform.variability);
+                serialiser.write(&uniform.size);
+                serialiser.write(&uniform.autoType);
+                serialiser.write(&uniform.autoReal);
+                serialiser.write(&uniform.autoInt);
+                serialiser.write(&uniform.autoRealData);
+                serialiser.write(&uniform.autoIntData);
+                serialiser.write(&uniform.used);
+            }
+        }
+    }
+
+    serialiser.writeChunkEnd(PROGRAM_INDEX_CHUNK_ID);
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::loadProgramIndex(const DataStreamPtr& stream)
+{
+    StreamSerialiser serialiser(stream);
+    const StreamSerialiser::Chunk* chunk;
+
+    try
+    {
+        chunk = serialiser.readChunkBegin();
+    }
+    catch (const InvalidStateException& e)
+    {
+        LogManager::getSingleton().logWarning("RTSS: could not load the program index: " + e.getDescription());
+        return;
+    }
+
+    if (chunk->id != PROGRAM_INDEX_CHUNK_ID || chunk->version != 1)
+    {
+        LogManager::getSingleton().logWarning("RTSS: invalid program index in " + stream->getName());
+        return;
+    }
+
+    uint32 numEntries = 0;
+    serialiser.read(&numEntries);
+
+    for (uint32 i = 0; i < numEntries; ++i)
+    {
+        uint32 hash;
+        IndexedProgramSet indexed;
+        serialiser.read(&hash);
+
+        for (IndexedProgram* program : {&indexed.vertexProgram, &indexed.fragmentProgram})
+        {
+            serialiser.read(&program->source);
+            serialiser.read(&program->preprocessorDefines);
+            serialiser.read(&program->columnMajorMatrices);
+            serialiser.read(&program->skeletalAnimation);
+
+            uint32 numUniforms = 0;
+            serialiser.read(&numUniforms);
+            program->uniforms.resize(numUniforms);
+
+            for (auto& uniform : program->uniforms)
+            {
+                serialiser.read(&uniform.name);
+                serialiser.read(&uniform.type);
+                serialiser.read(&uniform.index);
+                serialiser.read(&uniform.variability);
+                serialiser.read(&uniform.size);
+                serialiser.read(&uniform.autoType);
+                serialiser.read(&uniform.autoReal);
+                serialiser.read(&uniform.autoInt);
+                serialiser.read(&uniform.autoRealData);
+                serialiser.read(&uniform.autoIntData);
+                serialiser.read(&uniform.used);
+            }
+        }
+
+        mProgramIndex.insert(std::make_pair(hash, indexed));
+    }
+
+    serialiser.readChunkEnd(PROGRAM_INDEX_CHUNK_ID);
+}
+
 /** @} */
 /** @} */
 }
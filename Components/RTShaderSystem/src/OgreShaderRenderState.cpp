@@ -159,7 +159,15 @@ void TargetRenderState::bindUniformParameters(Program* pCpuProgram, const GpuPro
 
 void TargetRenderState::acquirePrograms(Pass* pass)
 {
-    createCpuPrograms();
+    uint32 hash = 0;
+    bool indexable = hashSubRenderStates(hash);
+
+    // Reuse the programs prepared by prepareCpuPrograms or generated for an equal render state, if any.
+    if (!mProgramSet || mProgramSet->mVSSource.empty())
+    {
+        if (!indexable || !createIndexedCpuPrograms(hash))
+            createCpuPrograms();
+    }
 
     try
     {
@@ -173,6 +181,9 @@ void TargetRenderState::acquirePrograms(Pass* pass)
         throw;
     }
 
+    if (indexable)
+        ProgramManager::getSingleton().addIndexedPrograms(hash, mProgramSet.get());
+
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
         // Bind the created GPU programs to the target pass.
@@ -184,6 +195,26 @@ void TargetRenderState::acquirePrograms(Pass* pass)
     pass->getUserObjectBindings().setUserAny(UserKey, this);
 }
 
+//-----------------------------------------------------------------------
+bool TargetRenderState::prepareCpuPrograms(ProgramWriter* programWriter)
+{
+    try
+    {
+        uint32 hash;
+        if (hashSubRenderStates(hash) && createIndexedCpuPrograms(hash))
+            return true;
+
+        createCpuPrograms();
+        ProgramManager::getSingleton().writeSourceCode(mProgramSet.get(), programWriter);
+    }
+    catch(std::exception&)
+    {
+        mProgramSet.reset();
+        return false;
+    }
+
+    return true;
+}
 
 void TargetRenderState::releasePrograms(Pass* pass)
 {
@@ -221,6 +252,72 @@ void TargetRenderState::createCpuPrograms()
     }
 }
 
+//-----------------------------------------------------------------------
+bool TargetRenderState::hashSubRenderStates(uint32& hash)
+{
+    sortSubRenderStates();
+
+    // Equal sub render states are written differently for other targets.
+    ShaderGenerator& shaderGen = ShaderGenerator::getSingleton();
+    const String& language = shaderGen.getTargetLanguage();
+    hash = FastHash(language.c_str(), language.size());
+    for (auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        const String& profiles = shaderGen.getShaderProfiles(type);
+        hash = FastHash(profiles.c_str(), profiles.size(), hash);
+    }
+
+    RenderSystem* rs = Root::getSingletonPtr() ? Root::getSingleton().getRenderSystem() : NULL;
+    if (rs)
+    {
+        hash = FastHash(rs->getName().c_str(), rs->getName().size(), hash);
+        hash = HashCombine(hash, rs->getNativeShadingLanguageVersion());
+        for (const String& syntax : rs->getCapabilities()->getSupportedShaderProfiles())
+            hash = FastHash(syntax.c_str(), syntax.size(), hash);
+    }
+
+    for (SubRenderStateListIterator it=mSubRenderStateList.begin(); it != mSubRenderStateList.end(); ++it)
+    {
+        const String& type = (*it)->getType();
+        hash = FastHash(type.c_str(), type.size(), hash);
+
+        if (!(*it)->hashState(hash))
+            return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+bool TargetRenderState::createIndexedCpuPrograms(uint32 hash)
+{
+    const ProgramManager::IndexedProgramSet* indexed = ProgramManager::getSingleton().findIndexedPrograms(hash);
+    if (!indexed)
+        return false;
+
+    ProgramSet* programSet = createProgramSet();
+    programSet->setCpuProgram(std::unique_ptr<Program>(new Program(GPT_VERTEX_PROGRAM)));
+    programSet->setCpuProgram(std::unique_ptr<Program>(new Program(GPT_FRAGMENT_PROGRAM)));
+
+    // Only the parameters updated per frame are needed, the source code is taken from the index.
+    try
+    {
+        bool resolved = true;
+        for (SubRenderStateListIterator it=mSubRenderStateList.begin(); resolved && it != mSubRenderStateList.end(); ++it)
+            resolved = (*it)->resolveParameters(programSet);
+
+        if (resolved && ProgramManager::applyIndexedPrograms(*indexed, programSet))
+            return true;
+    }
+    catch (Exception&)
+    {
+    }
+
+    // Generate the programs instead.
+    mProgramSet.reset();
+    return false;
+}
+
 //-----------------------------------------------------------------------
 ProgramSet* TargetRenderState::createProgramSet()
 {
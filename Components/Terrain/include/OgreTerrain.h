@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "OgreTerrainLayerBlendMap.h"
 #include "OgreWorkQueue.h"
 #include "OgreTerrainLodManager.h"
+#include <mutex>
 
 namespace Ogre
 {
@@ -1864,6 +1865,20 @@ namespace Ogre
     private:
         /// Test a single quad of the terrain for ray intersection.
         OGRE_FORCE_INLINE std::pair<bool, Vector3> checkQuadIntersection(int x, int y, const Ray& ray) const;
+        /// Convert a ray to the local vertex space used by checkQuadIntersection.
+        Ray getVertexSpaceRay(const Ray& ray) const;
+
+        class HeightRangePyramid;
+        /// Get the min/max height pyramid, bringing it up to date with the heights first.
+        const HeightRangePyramid& getHeightRanges();
+
+        /// Min/max heights of square blocks of quads, so rays can skip empty space
+        HeightRangePyramid* mHeightRanges;
+        /// Heights which changed since mHeightRanges was last updated
+        Rect mHeightRangesDirtyRect;
+        /// Guards the lazy update of mHeightRanges, also without OGRE_THREAD_SUPPORT
+        /// as rays may be cast from threads of the application
+        std::mutex mHeightRangesMutex;
     };
 
 
@@ -429,6 +429,17 @@ namespace Ogre
          the terrain data occurs.
          */
         RayResult rayIntersects(const Ray& ray, Real distanceLimit = 0) const; 
+
+        typedef std::vector<RayResult> RayResultList;
+        /** Test a batch of rays for intersection with any terrain in the group.
+         @param rays The rays to test for intersection
+         @param results Completed with one result per ray, in the same order as the rays
+         @param distanceLimit The distance from the ray origin at which we will stop looking,
+            0 indicates no limit
+         @remarks The rays are shared between the calling thread and the WorkQueue threads, so
+         like the single ray version no parallel write to the terrain data may occur.
+         */
+        void rayIntersects(const std::vector<Ray>& rays, RayResultList& results, Real distanceLimit = 0) const;
         
         typedef std::vector<Terrain*> TerrainList; 
         /** Test intersection of a box with the terrain. 
@@ -49,6 +49,11 @@ THE SOFTWARE.
 #include "OgreTimer.h"
 #include "OgreTerrainMaterialGeneratorA.h"
 #include "OgreFileSystemLayer.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE
+#include <xmmintrin.h>
+#endif
 
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
 // we do lots of conversions here, casting them all is tedious & cluttered, we know what we're doing
@@ -83,6 +88,183 @@ namespace Ogre
     // This MUST match the bitwise OR of all the types above with no extra bits!
     const uint8 Terrain::DERIVED_DATA_ALL = 7;
     //-----------------------------------------------------------------------
+    /** Minimum and maximum heights of the square blocks of 2^level quads of a
+        heightmap, so rays can skip the blocks they pass above or below.
+    @remarks
+        Blocks of BASE_LEVEL and up are stored, smaller ones are read from the
+        heights when asked for.
+    */
+    class Terrain::HeightRangePyramid : public TerrainAlloc
+    {
+    public:
+        static const int BASE_LEVEL = 2;
+
+        HeightRangePyramid(const float* heights, long size)
+            : mHeights(heights), mSize(size)
+        {
+            mTopLevel = Bitwise::mostSignificantBitSet(size - 1);
+            for (int level = BASE_LEVEL; level <= mTopLevel; ++level)
+            {
+                long blocks = (size - 1) >> level;
+                mRanges.push_back(std::vector<float>(blocks * blocks * 2));
+            }
+            update(Rect(0, 0, size, size));
+        }
+
+        /// Recalculate the blocks holding any of the vertices in a rect
+        void update(const Rect& rect)
+        {
+            // blocks share their edge vertices with their neighbours
+            long blocks = (mSize - 1) >> BASE_LEVEL;
+            long left = std::max(0L, (rect.left - 1) >> BASE_LEVEL);
+            long top = std::max(0L, (rect.top - 1) >> BASE_LEVEL);
+            long right = std::min(blocks, ((rect.right - 1) >> BASE_LEVEL) + 1);
+            long bottom = std::min(blocks, ((rect.bottom - 1) >> BASE_LEVEL) + 1);
+            if (left >= right || top >= bottom)
+                return;
+
+            // rows of blocks are independent
+            std::vector<float>& base = mRanges[0];
+            Root::getSingleton().getWorkQueue()->parallelFor(bottom - top, 16, [&](size_t begin, size_t end) {
+                for (long z = top + begin; z < top + (long)end; ++z)
+                    for (long x = left; x < right; ++x)
+                        scanHeights(BASE_LEVEL, x, z, base[(x + z * blocks) * 2], base[(x + z * blocks) * 2 + 1]);
+            });
+
+            for (int level = BASE_LEVEL + 1; level <= mTopLevel; ++level)
+            {
+                const std::vector<float>& children = mRanges[level - BASE_LEVEL - 1];
+                std::vector<float>& ranges = mRanges[level - BASE_LEVEL];
+                long childBlocks = blocks;
+                blocks >>= 1;
+                left >>= 1;
+                top >>= 1;
+                right = (right + 1) >> 1;
+                bottom = (bottom + 1) >> 1;
+                for (long z = top; z < bottom; ++z)
+                {
+                    for (long x = left; x < right; ++x)
+                    {
+                        const float* child0 = &children[(x * 2 + z * 2 * childBlocks) * 2];
+                        const float* child1 = child0 + childBlocks * 2;
+                        ranges[(x + z * blocks) * 2] =
+                            std::min(std::min(child0[0], child0[2]), std::min(child1[0], child1[2]));
+                        ranges[(x + z * blocks) * 2 + 1] =
+                            std::max(std::max(child0[1], child0[3]), std::max(child1[1], child1[3]));
+                    }
+                }
+            }
+        }
+
+        void getRange(int level, long x, long z, float& minHeight, float& maxHeight) const
+        {
+            if (level < BASE_LEVEL)
+            {
+                scanHeights(level, x, z, minHeight, maxHeight);
+                return;
+            }
+            long blocks = (mSize - 1) >> level;
+            const float* range = &mRanges[level - BASE_LEVEL][(x + z * blocks) * 2];
+            minHeight = range[0];
+            maxHeight = range[1];
+        }
+
+        /** Visit the quads below a ray in vertex space, front to back, skipping the
+            blocks it passes above or below. Stops once visitQuad returns true.
+        @return Whether visitQuad returned true
+        */
+        template <typename QuadFunc> bool traverse(const Ray& ray, const QuadFunc& visitQuad) const
+        {
+            // clip to the extents of the heightmap
+            Real t0 = 0, t1 = std::numeric_limits<Real>::max();
+            for (int axis = 0; axis < 3; axis += 2)
+            {
+                Real origin = ray.getOrigin()[axis], dir = ray.getDirection()[axis];
+                if (dir == 0)
+                {
+                    if (origin < 0 || origin > mSize - 1)
+                        return false;
+                    continue;
+                }
+                Real ta = -origin / dir, tb = (mSize - 1 - origin) / dir;
+                t0 = std::max(t0, std::min(ta, tb));
+                t1 = std::min(t1, std::max(ta, tb));
+            }
+            if (t0 >= t1)
+                return false;
+
+            return traverseBlock(ray, mTopLevel, 0, 0, t0, t1, visitQuad);
+        }
+
+    private:
+        /// Visit the quads of a block a ray segment passes, front to back, until visitQuad returns true
+        template <typename QuadFunc>
+        bool traverseBlock(const Ray& ray, int level, long x, long z, Real t0, Real t1,
+                           const QuadFunc& visitQuad) const
+        {
+            const Vector3& origin = ray.getOrigin();
+            const Vector3& dir = ray.getDirection();
+
+            // skip the block if the segment passes above or below it. checkQuadIntersection
+            // accepts hits up to 0.01 quads outside a quad, where both the ray and the
+            // extended triangle planes can leave the range of the heights
+            float minHeight, maxHeight;
+            getRange(level, x, z, minHeight, maxHeight);
+            Real horizontal = std::max(std::abs(dir.x), std::abs(dir.z));
+            Real slack = 1e-3f + (maxHeight - minHeight) * 0.02f +
+                (horizontal > 0 ? std::abs(dir.y) * 0.015f / horizontal : 0);
+            Real y0 = origin.y + dir.y * t0, y1 = origin.y + dir.y * t1;
+            if (std::min(y0, y1) > maxHeight + slack || std::max(y0, y1) < minHeight - slack)
+                return false;
+
+            if (level == 0)
+                return visitQuad(x, z);
+
+            // split the segment where it crosses the middle of the block
+            Real mid = Real((x * 2 + 1) << (level - 1));
+            Real midZ = Real((z * 2 + 1) << (level - 1));
+            Real tMidX = dir.x != 0 ? (mid - origin.x) / dir.x : t1;
+            Real tMidZ = dir.z != 0 ? (midZ - origin.z) / dir.z : t1;
+            for (Real ta = t0; ta < t1;)
+            {
+                Real tb = t1;
+                if (tMidX > ta && tMidX < tb)
+                    tb = tMidX;
+                if (tMidZ > ta && tMidZ < tb)
+                    tb = tMidZ;
+
+                // the child holding the middle of the segment
+                Real tc = (ta + tb) * 0.5f;
+                long childX = x * 2 + (origin.x + dir.x * tc >= mid ? 1 : 0);
+                long childZ = z * 2 + (origin.z + dir.z * tc >= midZ ? 1 : 0);
+                if (traverseBlock(ray, level - 1, childX, childZ, ta, tb, visitQuad))
+                    return true;
+                ta = tb;
+            }
+            return false;
+        }
+
+        void scanHeights(int level, long x, long z, float& minHeight, float& maxHeight) const
+        {
+            long side = 1L << level;
+            const float* heights = mHeights + (x + z * mSize) * side;
+            minHeight = maxHeight = heights[0];
+            for (long j = 0; j <= side; ++j, heights += mSize)
+            {
+                for (long i = 0; i <= side; ++i)
+                {
+                    minHeight = std::min(minHeight, heights[i]);
+                    maxHeight = std::max(maxHeight, heights[i]);
+                }
+            }
+        }
+
+        const float* mHeights;
+        long mSize;
+        int mTopLevel;
+        std::vector<std::vector<float> > mRanges;
+    };
+    //-----------------------------------------------------------------------
     template<> TerrainGlobalOptions* Singleton<TerrainGlobalOptions>::msSingleton = 0;
     TerrainGlobalOptions* TerrainGlobalOptions::getSingletonPtr(void)
     {
@@ -197,7 +379,8 @@ namespace Ogre
         , mLastViewportHeight(0)
         , mCustomGpuBufferAllocator(0)
         , mLodManager(0)
-
+        , mHeightRanges(0)
+        , mHeightRangesDirtyRect(0, 0, 0, 0)
     {
         mRootNode = sm->getRootSceneNode()->createChildSceneNode();
         sm->addListener(this);
@@ -1855,6 +2038,10 @@ namespace Ogre
         mDirtyGeometryRectForNeighbours.merge(rect);
         mDirtyDerivedDataRect.merge(rect);
         mCompositeMapDirtyRect.merge(rect);
+        {
+            std::lock_guard<std::mutex> lock(mHeightRangesMutex);
+            mHeightRangesDirtyRect.merge(rect);
+        }
 
         mModified = true;
         mHeightDataModified = true;
@@ -1978,6 +2165,10 @@ namespace Ogre
         OGRE_FREE(mDeltaData, MEMCATEGORY_GEOMETRY);
         mDeltaData = 0;
 
+        OGRE_DELETE mHeightRanges;
+        mHeightRanges = 0;
+        mHeightRangesDirtyRect.setNull();
+
         OGRE_DELETE mQuadTree;
         mQuadTree = 0;
 
@@ -2058,6 +2249,109 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        // Kernels of the derived data, four points at a time with SSE. They perform the
+        // same operations in the same order as the scalar code, so the results are equal.
+
+        // deltas[x] = height of the plane t at vertex i + x minus heights[x], for x in [begin, end)
+        void calculatePlaneDeltas(const Vector4& t, Real scale, Real base, long i, Real actualY,
+                                  const float* heights, Real* deltas, long begin, long end)
+        {
+            long x = begin;
+            Real offset = t.y * actualY;
+#if __OGRE_HAVE_SSE
+            const __m128 negTx = _mm_set1_ps(-t.x), vOffset = _mm_set1_ps(offset);
+            const __m128 tw = _mm_set1_ps(t.w), tz = _mm_set1_ps(t.z);
+            const __m128 vScale = _mm_set1_ps(scale), vBase = _mm_set1_ps(base), four = _mm_set1_ps(4.0f);
+            __m128 vertex = _mm_setr_ps(Real(i + x), Real(i + x + 1), Real(i + x + 2), Real(i + x + 3));
+            for (; x + 4 <= end; x += 4)
+            {
+                __m128 actualX = _mm_add_ps(_mm_mul_ps(vertex, vScale), vBase);
+                __m128 h = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(negTx, actualX), vOffset), tw), tz);
+                _mm_storeu_ps(deltas + x, _mm_sub_ps(h, _mm_loadu_ps(heights + x)));
+                vertex = _mm_add_ps(vertex, four);
+            }
+#endif
+            for (; x < end; ++x)
+            {
+                Real actualX = (i + x) * scale + base;
+                deltas[x] = (-t.x * actualX - offset - t.w) / t.z - heights[x];
+            }
+        }
+
+        // Adds the normals of the faces (centre, a, b) of count points to the normals. The
+        // heights are those of the points at the XY offsets a and b from the centre.
+        void addFaceNormals(const float* centre, const float* heightsA, const float* heightsB,
+                            Real ax, Real ay, Real bx, Real by,
+                            Real* normalX, Real* normalY, Real* normalZ, long count)
+        {
+            long k = 0;
+            Real nz = ax * by - ay * bx;
+#if __OGRE_HAVE_SSE
+            const __m128 vax = _mm_set1_ps(ax), vay = _mm_set1_ps(ay);
+            const __m128 vbx = _mm_set1_ps(bx), vby = _mm_set1_ps(by);
+            const __m128 vnz = _mm_set1_ps(nz), one = _mm_set1_ps(1.0f);
+            for (; k + 4 <= count; k += 4)
+            {
+                __m128 c = _mm_loadu_ps(centre + k);
+                __m128 az = _mm_sub_ps(_mm_loadu_ps(heightsA + k), c);
+                __m128 bz = _mm_sub_ps(_mm_loadu_ps(heightsB + k), c);
+                __m128 nx = _mm_sub_ps(_mm_mul_ps(vay, bz), _mm_mul_ps(az, vby));
+                __m128 ny = _mm_sub_ps(_mm_mul_ps(az, vbx), _mm_mul_ps(vax, bz));
+                __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(vnz, vnz));
+                __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+                _mm_storeu_ps(normalX + k, _mm_add_ps(_mm_loadu_ps(normalX + k), _mm_mul_ps(nx, invLength)));
+                _mm_storeu_ps(normalY + k, _mm_add_ps(_mm_loadu_ps(normalY + k), _mm_mul_ps(ny, invLength)));
+                _mm_storeu_ps(normalZ + k, _mm_add_ps(_mm_loadu_ps(normalZ + k), _mm_mul_ps(vnz, invLength)));
+            }
+#endif
+            for (; k < count; ++k)
+            {
+                Real az = heightsA[k] - centre[k];
+                Real bz = heightsB[k] - centre[k];
+                Real nx = ay * bz - az * by;
+                Real ny = az * bx - ax * bz;
+                Real invLength = 1.0f / std::sqrt(nx * nx + ny * ny + nz * nz);
+                normalX[k] += nx * invLength;
+                normalY[k] += ny * invLength;
+                normalZ[k] += nz * invLength;
+            }
+        }
+
+        // Normalises count vectors like Vector3::normalise, scaling the z components by signZ,
+        // and maps them to [0, 255] for the normal map
+        void normaliseNormals(Real* normalX, Real* normalY, Real* normalZ, Real signZ, long count)
+        {
+            long k = 0;
+#if __OGRE_HAVE_SSE
+            const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f);
+            const __m128 full = _mm_set1_ps(255.0f), vSignZ = _mm_set1_ps(signZ);
+            for (; k + 4 <= count; k += 4)
+            {
+                __m128 x = _mm_loadu_ps(normalX + k);
+                __m128 y = _mm_loadu_ps(normalY + k);
+                __m128 z = _mm_mul_ps(_mm_loadu_ps(normalZ + k), vSignZ);
+                __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+                // zero-sized vectors stay as they are
+                __m128 nonZero = _mm_cmpgt_ps(length, zero);
+                __m128 invLength = _mm_or_ps(_mm_and_ps(nonZero, _mm_div_ps(one, length)), _mm_andnot_ps(nonZero, one));
+                _mm_storeu_ps(normalX + k, _mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(x, invLength), one), half), full));
+                _mm_storeu_ps(normalY + k, _mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(y, invLength), one), half), full));
+                _mm_storeu_ps(normalZ + k, _mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(z, invLength), one), half), full));
+            }
+#endif
+            for (; k < count; ++k)
+            {
+                Vector3 normal(normalX[k], normalY[k], normalZ[k] * signZ);
+                normal.normalise();
+                normalX[k] = (normal.x + 1.0f) * 0.5f * 255.0f;
+                normalY[k] = (normal.y + 1.0f) * 0.5f * 255.0f;
+                normalZ[k] = (normal.z + 1.0f) * 0.5f * 255.0f;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     Rect Terrain::calculateHeightDeltas(const Rect& rect)
     {
         Rect clampedRect = rect.intersect(Rect(0, 0, mSize, mSize));
@@ -2095,113 +2389,150 @@ namespace Ogre
             if (lodRect.bottom % step)
                 lodRect.bottom += step - (lodRect.bottom % step);
 
-            for (long j = lodRect.top; j < lodRect.bottom - step; j += step )
+            // The nodes holding the source level tile the terrain, at a size we need
+            // to know to gather the maximum deltas per node
+            TerrainQuadTreeNode* node = mQuadTree;
+            long nodeStride = mSize - 1;
+            while (sourceLevel < node->getBaseLod() ||
+                   sourceLevel >= node->getBaseLod() + node->getLodCount())
             {
-                for (long i = lodRect.left; i < lodRect.right - step; i += step )
+                node = node->getChild(0);
+                nodeStride /= 2;
+            }
+            long nodesPerSide = (mSize - 1) / nodeStride;
+
+            long numRows = (lodRect.bottom - lodRect.top - 1) / step;
+            if (numRows <= 0)
+                continue;
+
+            // Rows of quads are processed in parallel. Each chunk gathers the maximum
+            // delta per node, which are passed on to the quadtree afterwards
+            size_t grainSize = std::max(1L, 65536L / (lodRect.width() * step));
+            std::vector<std::vector<Real> > chunkMaxDeltas((numRows + grainSize - 1) / grainSize);
+
+            Root::getSingleton().getWorkQueue()->parallelFor(numRows, grainSize, [&](size_t begin, size_t end) {
+                std::vector<Real>& maxDeltas = chunkMaxDeltas[begin / grainSize];
+                maxDeltas.resize(nodesPerSide * nodesPerSide, -std::numeric_limits<Real>::max());
+                std::vector<Real> rowDeltas(step + 1);
+
+                for (long j = lodRect.top + begin * step; j < lodRect.top + (long)end * step; j += step)
                 {
-                    // Form planes relating to the lower detail tris to be produced
-                    // For even tri strip rows, they are this shape:
-                    // 2---3
-                    // | / |
-                    // 0---1
-                    // For odd tri strip rows, they are this shape:
-                    // 2---3
-                    // | \ |
-                    // 0---1
-
-                    Vector3 v0, v1, v2, v3;
-                    getPointAlign(i, j, ALIGN_X_Y, &v0);
-                    getPointAlign(i + step, j, ALIGN_X_Y, &v1);
-                    getPointAlign(i, j + step, ALIGN_X_Y, &v2);
-                    getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
-
-                    Vector4 t1, t2;
-                    bool backwardTri = false;
-                    // Odd or even in terms of target level
-                    if ((j / step) % 2 == 0)
-                    {
-                        t1 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v3);
-                        t2 = Math::calculateFaceNormalWithoutNormalize(v0, v3, v2);
-                    }
-                    else
+                    for (long i = lodRect.left; i < lodRect.right - step; i += step)
                     {
-                        t1 = Math::calculateFaceNormalWithoutNormalize(v1, v3, v2);
-                        t2 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v2);
-                        backwardTri = true;
-                    }
+                        // Form planes relating to the lower detail tris to be produced
+                        // For even tri strip rows, they are this shape:
+                        // 2---3
+                        // | / |
+                        // 0---1
+                        // For odd tri strip rows, they are this shape:
+                        // 2---3
+                        // | \ |
+                        // 0---1
+
+                        Vector3 v0, v1, v2, v3;
+                        getPointAlign(i, j, ALIGN_X_Y, &v0);
+                        getPointAlign(i + step, j, ALIGN_X_Y, &v1);
+                        getPointAlign(i, j + step, ALIGN_X_Y, &v2);
+                        getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
+
+                        Vector4 t1, t2;
+                        bool backwardTri = false;
+                        // Odd or even in terms of target level
+                        if ((j / step) % 2 == 0)
+                        {
+                            t1 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v3);
+                            t2 = Math::calculateFaceNormalWithoutNormalize(v0, v3, v2);
+                        }
+                        else
+                        {
+                            t1 = Math::calculateFaceNormalWithoutNormalize(v1, v3, v2);
+                            t2 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v2);
+                            backwardTri = true;
+                        }
 
-                    // include the bottommost row of vertices if this is the last row
-                    int yubound = (j == (mSize - step)? step : step - 1);
-                    for ( int y = 0; y <= yubound; y++ )
-                    {
+                        // max(delta) is the worst case scenario at this LOD compared to
+                        // the original heightmap. Vertices on the left and top edges also
+                        // belong to the neighbouring nodes if they are on a node boundary
+                        Real cellMax = -std::numeric_limits<Real>::max();
+                        Real leftMax = cellMax;
+                        Real topMax = cellMax;
+                        int halfStep = step / 2;
+
+                        // include the bottommost row of vertices if this is the last row
+                        int yubound = (j == (mSize - step)? step : step - 1);
                         // include the rightmost col of vertices if this is the last col
                         int xubound = (i == (mSize - step)? step : step - 1);
-                        for ( int x = 0; x <= xubound; x++ )
+                        for (int y = 0; y <= yubound; y++)
                         {
-                            int fulldetailx = static_cast<int>(i + x);
-                            int fulldetaily = static_cast<int>(j + y);
-                            if ( fulldetailx % step == 0 && 
-                                fulldetaily % step == 0 )
-                            {
-                                // Skip, this one is a vertex at this level
-                                continue;
-                            }
-
-                            Real ypct = (Real)y / (Real)step;
-                            Real xpct = (Real)x / (Real)step;
-
-                            //interpolated height
-                            Vector3 actualPos;
-                            getPointAlign(fulldetailx, fulldetaily, ALIGN_X_Y, &actualPos);
-                            Real interp_h;
-                            // Determine which tri we're on 
-                            if ((xpct > ypct && !backwardTri) ||
-                                (xpct > (1-ypct) && backwardTri))
+                            Real actualY = (j + y) * mScale + mBase;
+                            const float* heights = getHeightData(i, j + y);
+
+                            // interpolated height minus the actual height. The points up to
+                            // the diagonal are on the second tri, the others on the first
+                            long diagonal = std::min(backwardTri ? step - y : y, xubound);
+                            calculatePlaneDeltas(t2, mScale, mBase, i, actualY, heights, &rowDeltas[0], 0, diagonal + 1);
+                            calculatePlaneDeltas(t1, mScale, mBase, i, actualY, heights, &rowDeltas[0], diagonal + 1, xubound + 1);
+
+                            // Skip the vertices at this level
+                            int xbegin = 0, xend = xubound;
+                            if (y % step == 0)
                             {
-                                // Solve for x/z
-                                interp_h = 
-                                    (-t1.x * actualPos.x
-                                    - t1.y * actualPos.y
-                                    - t1.w) / t1.z;
+                                xbegin = 1;
+                                xend = std::min(xubound, step - 1);
                             }
-                            else
+                            for (int x = xbegin; x <= xend; x++)
+                                cellMax = std::max(cellMax, rowDeltas[x]);
+                            if (xbegin == 0)
+                                leftMax = std::max(leftMax, rowDeltas[0]);
+                            if (y == 0)
+                                topMax = cellMax;
+
+                            // If a vertex is being removed at this LOD, then save the height
+                            // difference since that's the move it will need to make. Vertices
+                            // to be removed at this LOD are halfway between the steps, but
+                            // exclude those that would have been eliminated at earlier levels
+                            float* deltas = mDeltaData + i + ((j + y) * mSize);
+                            if (y == halfStep)
                             {
-                                // Second tri
-                                interp_h = 
-                                    (-t2.x * actualPos.x
-                                    - t2.y * actualPos.y
-                                    - t2.w) / t2.z;
+                                for (int x = 0; x <= xubound; x += halfStep)
+                                    deltas[x] = rowDeltas[x];
                             }
-
-                            Real actual_h = actualPos.z;
-                            Real delta = interp_h - actual_h;
-
-                            // max(delta) is the worst case scenario at this LOD
-                            // compared to the original heightmap
-
-                            // tell the quadtree about this 
-                            mQuadTree->notifyDelta(fulldetailx, fulldetaily, sourceLevel, delta);
-
-
-                            // If this vertex is being removed at this LOD, 
-                            // then save the height difference since that's the move
-                            // it will need to make. Vertices to be removed at this LOD
-                            // are halfway between the steps, but exclude those that
-                            // would have been eliminated at earlier levels
-                            int halfStep = step / 2;
-                            if (
-                             ((fulldetailx % step) == halfStep && (fulldetaily % halfStep) == 0) ||
-                             ((fulldetaily % step) == halfStep && (fulldetailx % halfStep) == 0))
+                            else if (y % step == 0)
                             {
-                                // Save height difference 
-                                mDeltaData[fulldetailx + (fulldetaily * mSize)] = delta;
+                                deltas[halfStep] = rowDeltas[halfStep];
                             }
+                        }
 
+                        // tell the nodes about this
+                        long nodeX = std::min(i / nodeStride, nodesPerSide - 1);
+                        long nodeY = std::min(j / nodeStride, nodesPerSide - 1);
+                        Real& nodeMax = maxDeltas[nodeX + nodeY * nodesPerSide];
+                        nodeMax = std::max(nodeMax, cellMax);
+                        if (nodeX > 0 && i % nodeStride == 0)
+                        {
+                            Real& leftNodeMax = maxDeltas[nodeX - 1 + nodeY * nodesPerSide];
+                            leftNodeMax = std::max(leftNodeMax, leftMax);
+                        }
+                        if (nodeY > 0 && j % nodeStride == 0)
+                        {
+                            Real& topNodeMax = maxDeltas[nodeX + (nodeY - 1) * nodesPerSide];
+                            topNodeMax = std::max(topNodeMax, topMax);
                         }
+                    } // i
+                } // j
+            });
 
-                    }
-                } // i
-            } // j
+            // a vertex next to the node corner belongs to that node only
+            for (long n = 0; n < nodesPerSide * nodesPerSide; ++n)
+            {
+                Real maxDelta = -std::numeric_limits<Real>::max();
+                for (size_t c = 0; c < chunkMaxDeltas.size(); ++c)
+                    maxDelta = std::max(maxDelta, chunkMaxDeltas[c][n]);
+
+                if (maxDelta > -std::numeric_limits<Real>::max())
+                    mQuadTree->notifyDelta((n % nodesPerSide) * nodeStride + 1,
+                                           (n / nodesPerSide) * nodeStride + 1, sourceLevel, maxDelta);
+            }
 
         } // targetLevel
 
@@ -2306,46 +2637,9 @@ namespace Ogre
     {
         typedef std::pair<bool, Vector3> Result;
         // first step: convert the ray to a local vertex space
-        // we assume terrain to be in the x-z plane, with the [0,0] vertex
-        // at origin and a plane distance of 1 between vertices.
-        // This makes calculations easier.
-        Vector3 rayOrigin = ray.getOrigin() - getPosition();
-        Vector3 rayDirection = ray.getDirection();
-        // change alignment
+        Ray localRay = getVertexSpaceRay(ray);
+        Vector3 rayOrigin = localRay.getOrigin();
         Vector3 tmp;
-        switch (getAlignment())
-        {
-        case ALIGN_X_Y:
-            std::swap(rayOrigin.y, rayOrigin.z);
-            std::swap(rayDirection.y, rayDirection.z);
-            break;
-        case ALIGN_Y_Z:
-            // x = z, z = y, y = -x
-            tmp.x = rayOrigin.z; 
-            tmp.z = rayOrigin.y; 
-            tmp.y = -rayOrigin.x; 
-            rayOrigin = tmp;
-            tmp.x = rayDirection.z; 
-            tmp.z = rayDirection.y; 
-            tmp.y = -rayDirection.x; 
-            rayDirection = tmp;
-            break;
-        case ALIGN_X_Z:
-            // already in X/Z but values increase in -Z
-            rayOrigin.z = -rayOrigin.z;
-            rayDirection.z = -rayDirection.z;
-            break;
-        }
-        // readjust coordinate origin
-        rayOrigin.x += mWorldSize/2;
-        rayOrigin.z += mWorldSize/2;
-        // scale down to vertex level
-        rayOrigin.x /= mScale;
-        rayOrigin.z /= mScale;
-        rayDirection.x /= mScale;
-        rayDirection.z /= mScale;
-        rayDirection.normalise();
-        Ray localRay (rayOrigin, rayDirection);
 
         // test if the ray actually hits the terrain's bounds
         Real maxHeight = getMaxHeight();
@@ -2364,47 +2658,12 @@ namespace Ogre
             }
             return Result(false, Vector3());
         }
-        // get intersection point and move inside
-        Vector3 cur = localRay.getPoint(aabbTest.second);
-
-        // now check every quad the ray touches
-        int quadX = std::min(std::max(static_cast<int>(cur.x), 0), (int)mSize-2);
-        int quadZ = std::min(std::max(static_cast<int>(cur.z), 0), (int)mSize-2);
-        int flipX = (rayDirection.x < 0 ? 0 : 1);
-        int flipZ = (rayDirection.z < 0 ? 0 : 1);
-        int xDir = (rayDirection.x < 0 ? -1 : 1);
-        int zDir = (rayDirection.z < 0 ? -1 : 1);
-
-        Result result(true, Vector3::ZERO);
-        Real dummyHighValue = (Real)mSize * 10000.0f;
-
-
-        while (cur.y >= (minHeight - 1e-3) && cur.y <= (maxHeight + 1e-3))
-        {
-            if (quadX < 0 || quadX >= (int)mSize-1 || quadZ < 0 || quadZ >= (int)mSize-1)
-                break;
-
+        // check the quads under the ray, skipping the blocks it passes above or below
+        Result result(false, Vector3::ZERO);
+        getHeightRanges().traverse(localRay, [&](long quadX, long quadZ) {
             result = checkQuadIntersection(quadX, quadZ, localRay);
-            if (result.first)
-                break;
-
-            // determine next quad to test
-            Real xDist = Math::RealEqual(rayDirection.x, 0.0) ? dummyHighValue : 
-                (quadX - cur.x + flipX) / rayDirection.x;
-            Real zDist = Math::RealEqual(rayDirection.z, 0.0) ? dummyHighValue : 
-                (quadZ - cur.z + flipZ) / rayDirection.z;
-            if (xDist < zDist)
-            {
-                quadX += xDir;
-                cur += rayDirection * xDist;
-            }
-            else
-            {
-                quadZ += zDir;
-                cur += rayDirection * zDist;
-            }
-
-        }
+            return result.first;
+        });
 
         if (result.first)
         {
@@ -2440,6 +2699,65 @@ namespace Ogre
         return result;
     }
     //---------------------------------------------------------------------
+    const Terrain::HeightRangePyramid& Terrain::getHeightRanges()
+    {
+        std::lock_guard<std::mutex> lock(mHeightRangesMutex);
+        if (!mHeightRanges)
+        {
+            mHeightRanges = OGRE_NEW HeightRangePyramid(mHeightData, mSize);
+        }
+        else if (!mHeightRangesDirtyRect.isNull())
+        {
+            mHeightRanges->update(mHeightRangesDirtyRect);
+        }
+        mHeightRangesDirtyRect.setNull();
+        return *mHeightRanges;
+    }
+    //---------------------------------------------------------------------
+    Ray Terrain::getVertexSpaceRay(const Ray& ray) const
+    {
+        // we assume terrain to be in the x-z plane, with the [0,0] vertex
+        // at origin and a plane distance of 1 between vertices.
+        // This makes calculations easier.
+        Vector3 rayOrigin = ray.getOrigin() - getPosition();
+        Vector3 rayDirection = ray.getDirection();
+        // change alignment
+        Vector3 tmp;
+        switch (getAlignment())
+        {
+        case ALIGN_X_Y:
+            std::swap(rayOrigin.y, rayOrigin.z);
+            std::swap(rayDirection.y, rayDirection.z);
+            break;
+        case ALIGN_Y_Z:
+            // x = z, z = y, y = -x
+            tmp.x = rayOrigin.z; 
+            tmp.z = rayOrigin.y; 
+            tmp.y = -rayOrigin.x; 
+            rayOrigin = tmp;
+            tmp.x = rayDirection.z; 
+            tmp.z = rayDirection.y; 
+            tmp.y = -rayDirection.x; 
+            rayDirection = tmp;
+            break;
+        case ALIGN_X_Z:
+            // already in X/Z but values increase in -Z
+            rayOrigin.z = -rayOrigin.z;
+            rayDirection.z = -rayDirection.z;
+            break;
+        }
+        // readjust coordinate origin
+        rayOrigin.x += mWorldSize/2;
+        rayOrigin.z += mWorldSize/2;
+        // scale down to vertex level
+        rayOrigin.x /= mScale;
+        rayOrigin.z /= mScale;
+        rayDirection.x /= mScale;
+        rayDirection.z /= mScale;
+        rayDirection.normalise();
+        return Ray(rayOrigin, rayDirection);
+    }
+    //---------------------------------------------------------------------
     std::pair<bool, Vector3> Terrain::checkQuadIntersection(int x, int z, const Ray& ray) const
     {
         // build the two planes belonging to the quad's triangles
@@ -3295,47 +3613,107 @@ namespace Ogre
         //  4---P---0
         //  | / | \ |
         //  5---6---7
+        static const int offsetX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+        static const int offsetY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        // encode as RGB, object space
+        // invert the Y to deal with image space
+        auto storeNormal = [&](long x, long y, const Vector3& normal)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+            long storeX = x - widenedRect.left;
+            long storeY = widenedRect.bottom - y - 1;
+
+            uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX) * 3;
+            *pStore++ = static_cast<uint8>((normal.x + 1.0f) * 0.5f * 255.0f);
+            *pStore++ = static_cast<uint8>((normal.y + 1.0f) * 0.5f * 255.0f);
+            *pStore++ = static_cast<uint8>((normal.z + 1.0f) * 0.5f * 255.0f);
+        };
+
+        // Rows are processed in parallel. Points with all neighbours on this terrain
+        // read the heights directly, the others may need to look at our neighbours
+        long innerLeft = std::max(1L, widenedRect.left);
+        long innerRight = std::max(innerLeft, std::min((long)mSize - 1, widenedRect.right));
+        size_t grainSize = std::max(1L, 16384L / widenedRect.width());
+
+        Root::getSingleton().getWorkQueue()->parallelFor(widenedRect.height(), grainSize, [&](size_t begin, size_t end) {
+            std::vector<Real> normalX(widenedRect.width()), normalY(widenedRect.width()), normalZ(widenedRect.width());
+
+            for (long y = widenedRect.top + begin; y < widenedRect.top + (long)end; ++y)
             {
-                Vector3 cumulativeNormal = Vector3::ZERO;
-
-                // Build points to sample
-                Vector3 centrePoint;
-                Vector3 adjacentPoints[8];
-                getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
-                getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
-                getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
-                getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
-                getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
-                getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
-                getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
-                getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
-                getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
+                long fastLeft = innerLeft, fastRight = innerRight;
+                if (y < 1 || y >= mSize - 1)
+                    fastLeft = fastRight = widenedRect.left;
 
-                for (int i = 0; i < 8; ++i)
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
                 {
-                    cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
-                }
+                    if (x == fastLeft)
+                        x = fastRight;
+                    if (x >= widenedRect.right)
+                        break;
 
-                // normalise & store normal
-                cumulativeNormal.normalise();
+                    Vector3 cumulativeNormal = Vector3::ZERO;
+
+                    // Build points to sample
+                    Vector3 centrePoint;
+                    Vector3 adjacentPoints[8];
+                    getPointFromSelfOrNeighbour(x, y, &centrePoint);
+                    for (int i = 0; i < 8; ++i)
+                        getPointFromSelfOrNeighbour(x + offsetX[i], y + offsetY[i], &adjacentPoints[i]);
+
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
+                    }
 
-                // encode as RGB, object space
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                    // normalise & store normal
+                    cumulativeNormal.normalise();
+                    storeNormal(x, y, cumulativeNormal);
+                }
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX) * 3;
-                *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                if (fastLeft == fastRight)
+                    continue;
 
+                // Sum the normals of the 8 faces around the points in the X_Y layout
+                long count = fastRight - fastLeft;
+                const float* centre = getHeightData(fastLeft, y);
+                std::fill(normalX.begin(), normalX.end(), 0.0f);
+                std::fill(normalY.begin(), normalY.end(), 0.0f);
+                std::fill(normalZ.begin(), normalZ.end(), 0.0f);
+                for (int i = 0; i < 8; ++i)
+                {
+                    int n = (i + 1) % 8;
+                    addFaceNormals(centre, getHeightData(fastLeft + offsetX[i], y + offsetY[i]),
+                                   getHeightData(fastLeft + offsetX[n], y + offsetY[n]),
+                                   offsetX[i] * mScale, offsetY[i] * mScale, offsetX[n] * mScale,
+                                   offsetY[n] * mScale, &normalX[0], &normalY[0], &normalZ[0], count);
+                }
 
+                // rotate from the X_Y layout to our alignment, then normalise
+                Real* alignedX = &normalX[0];
+                Real* alignedY = &normalY[0];
+                Real* alignedZ = &normalZ[0];
+                Real signZ = 1.0f;
+                if (mAlign == ALIGN_X_Z)
+                {
+                    std::swap(alignedY, alignedZ);
+                    signZ = -1.0f;
+                }
+                else if (mAlign == ALIGN_Y_Z)
+                {
+                    std::swap(alignedX, alignedZ);
+                    signZ = -1.0f;
+                }
+                normaliseNormals(alignedX, alignedY, alignedZ, signZ, count);
+
+                uint8* pStore = pData + ((widenedRect.bottom - y - 1) * widenedRect.width() + fastLeft - widenedRect.left) * 3;
+                for (long k = 0; k < count; ++k)
+                {
+                    *pStore++ = static_cast<uint8>(alignedX[k]);
+                    *pStore++ = static_cast<uint8>(alignedY[k]);
+                    *pStore++ = static_cast<uint8>(alignedZ[k]);
+                }
             }
-        }
+        });
 
         finalRect = widenedRect;
 
@@ -3470,41 +3848,58 @@ namespace Ogre
 
         Real heightPad = (getMaxHeight() - getMinHeight()) * 1.0e-3f;
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
-        {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
-            {
-                float litVal = 1.0f;
-
-                // convert to terrain space (not points, allow this to go between points)
-                float Tx = (float)x / (float)(mLightmapSizeActual-1);
-                float Ty = (float)y / (float)(mLightmapSizeActual-1);
+        // The shadow rays skip the parts of the terrain they pass above, and rows are
+        // processed in parallel
+        const HeightRangePyramid& heightRanges = getHeightRanges();
 
-                // get world space point
-                // add a little height padding to stop shadowing self
-                Vector3 wpos = Vector3::ZERO;
-                getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
-                wpos += getPosition();
-                // build ray, cast backwards along light direction
-                Ray ray(wpos, -lightVec);
-
-                // Cascade into neighbours when casting, but don't travel further
-                // than world size
-                std::pair<bool, Vector3> rayHit = rayIntersects(ray, true, mWorldSize);
+        Root::getSingleton().getWorkQueue()->parallelFor(widenedRect.height(), 4, [&](size_t begin, size_t end) {
+            for (long y = widenedRect.top + begin; y < widenedRect.top + (long)end; ++y)
+            {
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
+                {
+                    float litVal = 1.0f;
+
+                    // convert to terrain space (not points, allow this to go between points)
+                    float Tx = (float)x / (float)(mLightmapSizeActual-1);
+                    float Ty = (float)y / (float)(mLightmapSizeActual-1);
+
+                    // get world space point
+                    // add a little height padding to stop shadowing self
+                    Vector3 wpos = Vector3::ZERO;
+                    getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
+                    wpos += getPosition();
+                    // build ray, cast backwards along light direction
+                    Ray ray(wpos, -lightVec);
+                    Ray localRay = getVertexSpaceRay(ray);
+
+                    bool rayHit = heightRanges.traverse(localRay, [&](long quadX, long quadZ) {
+                        return checkQuadIntersection(quadX, quadZ, localRay).first;
+                    });
+
+                    // Cascade into neighbours when casting, but don't travel further
+                    // than world size
+                    if (!rayHit)
+                    {
+                        OGRE_LOCK_RW_MUTEX_READ(mNeighbourMutex);
+                        Terrain* neighbour = raySelectNeighbour(ray, mWorldSize);
+                        if (neighbour)
+                            rayHit = neighbour->rayIntersects(ray, true, mWorldSize).first;
+                    }
 
-                if (rayHit.first)
-                    litVal = 0.0f;
+                    if (rayHit)
+                        litVal = 0.0f;
 
-                // encode as L8
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                    // encode as L8
+                    // invert the Y to deal with image space
+                    long storeX = x - widenedRect.left;
+                    long storeY = widenedRect.bottom - y - 1;
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
-                *pStore = (unsigned char)(litVal * 255.0);
+                    uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
+                    *pStore = (unsigned char)(litVal * 255.0);
 
+                }
             }
-        }
+        });
 
         return pixbox;
 
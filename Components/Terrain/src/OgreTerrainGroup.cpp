@@ -649,6 +649,16 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    void TerrainGroup::rayIntersects(const std::vector<Ray>& rays, RayResultList& results,
+                                     Real distanceLimit /* = 0*/) const
+    {
+        results.assign(rays.size(), RayResult(false, 0, Vector3::ZERO));
+        Root::getSingleton().getWorkQueue()->parallelFor(rays.size(), 64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                results[i] = rayIntersects(rays[i], distanceLimit);
+        });
+    }
+    //---------------------------------------------------------------------
     void TerrainGroup::boxIntersects(const AxisAlignedBox& box, TerrainList* resultList) const
     {
         resultList->clear();
@@ -71,6 +71,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     /** A plane.
@@ -102,6 +110,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     /** A not rotated cube.
@@ -244,6 +260,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     /** Builds the union between two sources.
@@ -271,6 +295,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     /** Builds the difference between two sources.
@@ -299,6 +331,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     /** Source which does a unary operation to another one.
@@ -359,6 +399,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     /** Scales the given volume source.
@@ -386,6 +434,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
     };
 
     class _OgreVolumeExport CSGNoiseSource: public CSGUnarySource
@@ -413,6 +469,20 @@ namespace Volume {
         /// Prepares the node members.
         void setData(void);
 
+        /** Gets the density values of the source with the noise added for a batch of positions.
+        @param x
+            The x coordinates of the positions.
+        @param y
+            The y coordinates of the positions.
+        @param z
+            The z coordinates of the positions.
+        @param values
+            Receives the values.
+        @param count
+            The amount of positions.
+        */
+        void getInternalValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
         /* Gets the density value.
         @param position
             The position of the value.
@@ -464,6 +534,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
         
         /** Gets the initial seed.
         @return
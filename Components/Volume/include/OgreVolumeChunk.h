@@ -34,6 +34,9 @@ THE SOFTWARE.
 #include "OgreEntity.h"
 
 #include "OgreVolumePrerequisites.h"
+#include "OgreVolumeChunkHandler.h"
+
+#include <deque>
 
 namespace Ogre {
 namespace Volume {
@@ -96,12 +99,22 @@ namespace Volume {
         /// Whether to load the chunks async. if set to false, the call to load waits for the whole chunk. false is the default.
         bool async;
 
+        /** The maximum amount of chunks being meshed at the same time. Each of them holds an octree, a dualgrid and
+        a mesh until it is loaded, so this bounds the memory needed while loading. 0 is the default and means no limit.
+        */
+        size_t maxChunksInFlight;
+
+        /** Whether the chunks keep their octree after loading. An update of a part of the tree then only evaluates
+        the octree cells touching the updated region again, at the cost of the memory of the octrees. false is the default.
+        */
+        bool keepOctrees;
+
         /** Constructor.
         */
         ChunkParameters(void) :
             sceneManager(0), src(0), baseError((Real)0.0), errorMultiplicator((Real)1.0), createOctreeVisualization(false),
             createDualGridVisualization(false), skirtFactor(0), lodCallback(0), scale((Real)1.0), maxScreenSpaceError(0), createGeometryFromLevel(0),
-            updateFrom(Vector3::ZERO), updateTo(Vector3::ZERO), async(false)
+            updateFrom(Vector3::ZERO), updateTo(Vector3::ZERO), async(false), maxChunksInFlight(0), keepOctrees(false)
         {
         }
     } ChunkParameters;
@@ -122,12 +135,28 @@ namespace Volume {
         /// The amount of chunks being processed (== loading).
         int chunksBeingProcessed;
 
+        /// The amount of chunks handed to the WorkQueue and not loaded yet.
+        size_t chunksInWorkQueue;
+
+        /// The requests of chunks waiting to be meshed.
+        std::deque<ChunkRequest> pendingRequests;
+
+        /// The back lower left corner of the world.
+        Vector3 totalFrom;
+
+        /// The front upper right corner of the world.
+        Vector3 totalTo;
+
+        /// The amount of LOD levels.
+        size_t maxLevels;
+
         /// The parameters with which the chunktree got loaded.
         ChunkParameters *parameters;
 
         /** Constructor.
         */
-        ChunkTreeSharedData(const ChunkParameters *params) : octreeVisible(false), dualGridVisible(false), volumeVisible(true), chunksBeingProcessed(0)
+        ChunkTreeSharedData(const ChunkParameters *params) : octreeVisible(false), dualGridVisible(false), volumeVisible(true), chunksBeingProcessed(0),
+            chunksInWorkQueue(0), totalFrom(Vector3::ZERO), totalTo(Vector3::ZERO), maxLevels(0)
         {
             this->parameters = new ChunkParameters(*params);
         }
@@ -178,6 +207,12 @@ namespace Volume {
         /// Holds some shared data among all chunks of the tree.
         ChunkTreeSharedData *mShared;
 
+        /// The octree of the last meshing if ChunkParameters::keepOctrees is set.
+        OctreeNode *mOctreeRoot;
+
+        /// The number of the latest request of this chunk.
+        uint32 mRequestSerial;
+
         /** Loads a single chunk of the tree.
         @param parent
             The parent scene node for the volume
@@ -259,6 +294,63 @@ namespace Volume {
         */
         virtual void prepareGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo);
 
+        /** Like prepareGeometry, but for an octree kept from the last meshing of this chunk, which
+        gets updated in the changed region only. To be called in a different thread.
+        @param level
+            The current LOD level.
+        @param root
+            The root of the kept Octree of the chunk.
+        @param updatedBox
+            The region where the source changed.
+        @param dualGridGenerator
+            The DualGrid.
+        @param meshBuilder
+            The MeshBuilder which will contain the geometry.
+        @param totalFrom
+            The back lower left corner of the world.
+        @param totalTo
+            The front upper rightcorner of the world.
+        */
+        virtual void updateGeometry(size_t level, OctreeNode *root, const AxisAlignedBox &updatedBox, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo);
+
+        /** Builds the dualgrid and the mesh of a split octree.
+        @param level
+            The current LOD level.
+        @param root
+            The root of the Octree of the chunk.
+        @param dualGridGenerator
+            The DualGrid.
+        @param meshBuilder
+            The MeshBuilder which will contain the geometry.
+        @param totalFrom
+            The back lower left corner of the world.
+        @param totalTo
+            The front upper rightcorner of the world.
+        */
+        void generateMesh(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo);
+
+        /** Prepares the geometry of a request of this chunk. Can be called in any thread.
+        @param req
+            The request.
+        */
+        void prepareRequest(const ChunkRequest &req);
+
+        /** Loads the prepared geometry of a request of this chunk and frees the request data.
+        @param req
+            The request.
+        */
+        void finishRequest(const ChunkRequest &req);
+
+        /** Hands pending requests of the tree to the WorkQueue as long as
+        ChunkParameters::maxChunksInFlight allows it.
+        */
+        void dispatchRequests(void);
+
+        /** Meshes all pending requests of the tree in the calling thread and the
+        WorkQueue workers, at most ChunkParameters::maxChunksInFlight at once.
+        */
+        void processRequests(void);
+
         /** Loads the actual geometry when the processing is done.
         @param meshBuilder
             The MeshBuilder holding the geometry.
@@ -369,6 +461,19 @@ namespace Volume {
             The resource group where to search for the configuration file.
         */
         virtual void load(SceneNode *parent, SceneManager *sceneManager, const String& filename, bool validSourceResult = false, MeshBuilderCallback *lodCallback = 0, const String& resourceGroup = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+
+        /** Meshes the chunks touching a region again after the source changed there.
+        @remarks
+            Only to be called on the root chunk of a loaded tree. Sets the update region of
+            the parameters, grown by Source::getEditPadding, and reloads with them. With
+            ChunkParameters::keepOctrees, only the octree cells touching the region are
+            evaluated again.
+        @param from
+            The back lower left corner of the changed region.
+        @param to
+            The front upper right corner of the changed region.
+        */
+        virtual void updateRegion(const Vector3 &from, const Vector3 &to);
         
         /** Shows the debug visualization entity of the dualgrid.
         @param visible
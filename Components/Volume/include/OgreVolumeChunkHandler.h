@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_Chunk_Handler_H__
 
 #include "OgreWorkQueue.h"
+#include "OgreAxisAlignedBox.h"
 
 #include "OgreVolumePrerequisites.h"
 
@@ -76,8 +77,17 @@ namespace Volume {
         /// The chunk which created this request.
         Chunk *origin;
 
+        /// The number of this request among the ones of the origin chunk.
+        uint32 serial;
+
         /// Whether this is an update of an existing tree
         bool isUpdate;
+
+        /// Whether root is the kept octree of the chunk, which only needs an update within updatedBox.
+        bool updateOctree;
+
+        /// The updated region of the tree if isUpdate is set.
+        AxisAlignedBox updatedBox;
         
         /** Stream operator <<.
         @param o
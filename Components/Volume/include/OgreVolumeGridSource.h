@@ -142,6 +142,15 @@ namespace Volume {
                 getVolumeGridValue(x, y, z + 1) - getVolumeGridValue(x, y, z - 1));
         }
 
+        /** Gets the negated gradient at a position in grid space, interpolated if trilinear
+        gradients are enabled.
+        @param scaledPosition
+            The position multiplied with the grid scale.
+        @return
+            The gradient.
+        */
+        Vector3 getInterpolatedGradient(const Vector3 &scaledPosition) const;
+
     public:
 
         GridSource(bool trilinearValue, bool trilinearGradient, bool sobelGradient);
@@ -158,6 +167,16 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const;
 
+        /** Overridden from VolumeSource.
+        @remarks
+            Computes the grid cells and interpolation weights of the whole batch at once.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Overridden from VolumeSource.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
+
         /** Gets the width of the texture.
         @return
             The width of the texture.
@@ -197,6 +216,10 @@ namespace Volume {
         */
         Real getVolumeSpaceToWorldSpaceFactor(void) const;
 
+        /** Overridden from VolumeSource.
+        */
+        Vector3 getEditPadding(void) const;
+
     };
     /** @} */
     /** @} */
@@ -98,6 +98,18 @@ namespace Volume {
             return v0 + mu * (v1 - v0);
         }
 
+        /** Gets the densities and gradients of some corners in one batch from the source.
+        @param corners
+            The corners.
+        @param indices
+            The indices of the corners to evaluate, null to take the first count ones.
+        @param count
+            The amount of corners to evaluate, at most eight.
+        @param results
+            Receives the densities and gradients.
+        */
+        void getCornerValuesAndGradients(const Vector3 *corners, const size_t *indices, size_t count, Vector4 *results) const;
+
     public:
 
         /** Constructor.
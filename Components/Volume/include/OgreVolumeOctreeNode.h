@@ -145,6 +145,24 @@ namespace Volume {
         */
         void split(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError);
 
+        /** Updates an already split octree after the source changed within a region.
+        @remarks
+            The split decision and the center value of a cell only depend on the source
+            values and gradients within the cell, so cells not touching the region are kept
+            as they are. The others are evaluated again, reusing their children where they
+            still split. The result is only the same as splitting a fresh node if the region
+            covers every position whose value or gradient changed, see Source::getEditPadding.
+        @param splitPolicy
+            Defines the policy deciding whether to split a node or not.
+        @param src
+            The volume source.
+        @param geometricError
+            The accepted geometric error.
+        @param region
+            The region where the source changed.
+        */
+        void updateSplit(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox &region);
+
         /** Getter for the octree debug visualization of the octree starting with
             this node.
         @param sceneManager
@@ -154,6 +172,14 @@ namespace Volume {
         */
         Entity* getOctreeGrid(SceneManager *sceneManager);
 
+        /** Forgets the debug visualization, so the next getOctreeGrid builds it from the
+            current cells. Call it after updateSplit, the caller destroys the old entity.
+        */
+        inline void resetOctreeGrid(void)
+        {
+            mOctreeGrid = 0;
+        }
+
         /** Setter for the from-part of this cell.
         @param from
             The back lower left corner of the cell.
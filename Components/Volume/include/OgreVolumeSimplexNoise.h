@@ -113,6 +113,24 @@ namespace Volume {
             The noise value.
         */
         Real noise(Real xIn, Real yIn, Real zIn) const;
+
+        /** 3D noise function for a batch of positions.
+        @remarks
+            Gives the same values as calling the single position version for each of them but
+            selects the simplex corners and drops the contributions of far away corners without
+            branching, so the loop is cheaper for the large batches of the volume meshing.
+        @param xIn
+            The first dimension parameters.
+        @param yIn
+            The second dimension parameters.
+        @param zIn
+            The third dimension parameters.
+        @param results
+            Receives the noise values, must hold count elements.
+        @param count
+            The amount of positions.
+        */
+        void noise(const Real *xIn, const Real *yIn, const Real *zIn, Real *results, size_t count) const;
         
         /** Gets the current seed.
         @return
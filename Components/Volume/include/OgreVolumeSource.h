@@ -80,6 +80,9 @@ namespace Volume {
 
         /// The amount of items being written as one chunk during serialization.
         static const size_t SERIALIZATION_CHUNK_SIZE;
+
+        /// The amount of positions sources evaluate at once when they need temporary buffers for a batch.
+        static const size_t BATCH_SIZE = 64;
         
         /** Destructor.
         */
@@ -101,6 +104,42 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values at a batch of positions.
+        @remarks
+            The positions are passed as separate arrays of coordinates so implementations can
+            process several of them at once. The default implementation calls getValue for
+            each position; sources which can do better, like the CSG operations, the noise and
+            the grid sources, override it.
+        @param x
+            The x coordinates of the positions.
+        @param y
+            The y coordinates of the positions.
+        @param z
+            The z coordinates of the positions.
+        @param values
+            Receives the densities, must hold count elements.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const;
+
+        /** Gets the density values and gradients at a batch of positions.
+        @remarks
+            Same as getValues but like getValueAndGradient, the default implementation calls
+            getValueAndGradient for each position.
+        @param x
+            The x coordinates of the positions.
+        @param y
+            The y coordinates of the positions.
+        @param z
+            The z coordinates of the positions.
+        @param results
+            Receives the gradients in x, y, z and the densities in w, must hold count elements.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
@@ -157,6 +196,15 @@ namespace Volume {
             The factor, 1.0 in the default implementation.
         */
         Real getVolumeSpaceToWorldSpaceFactor(void) const;
+
+        /** Gets how far beyond an edited region the values and gradients of this source change.
+        @remarks
+            Chunk::updateRegion grows the region by this, as cells next to it read the edited
+            samples, too.
+        @return
+            The distance per axis in world space, zero in the default implementation.
+        */
+        virtual Vector3 getEditPadding(void) const;
     };
 
     /** @} */
@@ -66,6 +66,35 @@ namespace Volume {
         Vector3 pMinCenter = position - mCenter;
         return mR - pMinCenter.length();
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Real dx = x[i] - mCenter.x;
+            Real dy = y[i] - mCenter.y;
+            Real dz = z[i] - mCenter.z;
+            values[i] = mR - Math::Sqrt(dx * dx + dy * dy + dz * dz);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Real dx = x[i] - mCenter.x;
+            Real dy = y[i] - mCenter.y;
+            Real dz = z[i] - mCenter.z;
+            Real length = Math::Sqrt(dx * dx + dy * dy + dz * dz);
+            // Like Vector3::normalise, the center itself keeps a zero gradient
+            Real invLength = length > (Real)0.0 ? (Real)1.0 / length : (Real)1.0;
+            results[i] = Vector4(dx * invLength, dy * invLength, dz * invLength, mR - length);
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -93,6 +122,26 @@ namespace Volume {
         // Lineare Algebra: Ein geometrischer Zugang, S.180-181
         return mD - mNormal.dotProduct(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = mD - (mNormal.x * x[i] + mNormal.y * y[i] + mNormal.z * z[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = Vector4(mNormal.x, mNormal.y, mNormal.z, mD - (mNormal.x * x[i] + mNormal.y * y[i] + mNormal.z * z[i]));
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -202,6 +251,45 @@ namespace Volume {
         }
         return valueB;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            mA->getValues(x + offset, y + offset, z + offset, values + offset, num);
+            mB->getValues(x + offset, y + offset, z + offset, valuesB, num);
+            Real *valuesA = values + offset;
+            for (size_t i = 0; i < num; ++i)
+            {
+                valuesA[i] = valuesA[i] < valuesB[i] ? valuesA[i] : valuesB[i];
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Vector4 resultsB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            mA->getValuesAndGradients(x + offset, y + offset, z + offset, results + offset, num);
+            mB->getValuesAndGradients(x + offset, y + offset, z + offset, resultsB, num);
+            Vector4 *resultsA = results + offset;
+            for (size_t i = 0; i < num; ++i)
+            {
+                if (!(resultsA[i].w < resultsB[i].w))
+                {
+                    resultsA[i] = resultsB[i];
+                }
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -240,6 +328,45 @@ namespace Volume {
         }
         return valueB;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            mA->getValues(x + offset, y + offset, z + offset, values + offset, num);
+            mB->getValues(x + offset, y + offset, z + offset, valuesB, num);
+            Real *valuesA = values + offset;
+            for (size_t i = 0; i < num; ++i)
+            {
+                valuesA[i] = valuesA[i] > valuesB[i] ? valuesA[i] : valuesB[i];
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Vector4 resultsB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            mA->getValuesAndGradients(x + offset, y + offset, z + offset, results + offset, num);
+            mB->getValuesAndGradients(x + offset, y + offset, z + offset, resultsB, num);
+            Vector4 *resultsA = results + offset;
+            for (size_t i = 0; i < num; ++i)
+            {
+                if (!(resultsA[i].w > resultsB[i].w))
+                {
+                    resultsA[i] = resultsB[i];
+                }
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -278,6 +405,45 @@ namespace Volume {
         }
         return valueB;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            mA->getValues(x + offset, y + offset, z + offset, values + offset, num);
+            mB->getValues(x + offset, y + offset, z + offset, valuesB, num);
+            Real *valuesA = values + offset;
+            for (size_t i = 0; i < num; ++i)
+            {
+                valuesA[i] = valuesA[i] < -valuesB[i] ? valuesA[i] : -valuesB[i];
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Vector4 resultsB[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            mA->getValuesAndGradients(x + offset, y + offset, z + offset, results + offset, num);
+            mB->getValuesAndGradients(x + offset, y + offset, z + offset, resultsB, num);
+            Vector4 *resultsA = results + offset;
+            for (size_t i = 0; i < num; ++i)
+            {
+                if (!(resultsA[i].w < -resultsB[i].w))
+                {
+                    resultsA[i] = (Real)-1.0 * resultsB[i];
+                }
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -330,6 +496,28 @@ namespace Volume {
     {
         return (Real)-1.0 * mSrc->getValue(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        mSrc->getValues(x, y, z, values, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        mSrc->getValuesAndGradients(x, y, z, results, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = (Real)-1.0 * results[i];
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -350,6 +538,52 @@ namespace Volume {
     {
         return mSrc->getValue(position / mScale) * mScale;
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real invScale = (Real)1.0 / mScale;
+        Real scaledX[BATCH_SIZE], scaledY[BATCH_SIZE], scaledZ[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            for (size_t i = 0; i < num; ++i)
+            {
+                scaledX[i] = x[offset + i] * invScale;
+                scaledY[i] = y[offset + i] * invScale;
+                scaledZ[i] = z[offset + i] * invScale;
+            }
+            mSrc->getValues(scaledX, scaledY, scaledZ, values + offset, num);
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] *= mScale;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Real invScale = (Real)1.0 / mScale;
+        Real scaledX[BATCH_SIZE], scaledY[BATCH_SIZE], scaledZ[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            for (size_t i = 0; i < num; ++i)
+            {
+                scaledX[i] = x[offset + i] * invScale;
+                scaledY[i] = y[offset + i] * invScale;
+                scaledZ[i] = z[offset + i] * invScale;
+            }
+            mSrc->getValuesAndGradients(scaledX, scaledY, scaledZ, results + offset, num);
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] *= mScale;
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -369,6 +603,40 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNoiseSource::getInternalValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        Real scaledX[BATCH_SIZE], scaledY[BATCH_SIZE], scaledZ[BATCH_SIZE];
+        Real noise[BATCH_SIZE], toAdd[BATCH_SIZE];
+        mSrc->getValues(x, y, z, values, count);
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            std::fill(toAdd, toAdd + num, (Real)0.0);
+            for (size_t octave = 0; octave < mNumOctaves; ++octave)
+            {
+                Real frequency = mFrequencies[octave];
+                for (size_t i = 0; i < num; ++i)
+                {
+                    scaledX[i] = x[offset + i] * frequency;
+                    scaledY[i] = y[offset + i] * frequency;
+                    scaledZ[i] = z[offset + i] * frequency;
+                }
+                mNoise.noise(scaledX, scaledY, scaledZ, noise, num);
+                Real amplitude = mAmplitudes[octave];
+                for (size_t i = 0; i < num; ++i)
+                {
+                    toAdd[i] += noise[i] * amplitude;
+                }
+            }
+            for (size_t i = 0; i < num; ++i)
+            {
+                values[offset + i] += toAdd[i];
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
     CSGNoiseSource::CSGNoiseSource(const Source *src, Real *frequencies, Real *amplitudes, size_t numOctaves, long seed) :
         CSGUnarySource(src), mFrequencies(frequencies), mAmplitudes(amplitudes), mNumOctaves(numOctaves), mNoise(seed)
     {
@@ -400,6 +668,53 @@ namespace Volume {
     {
         return getInternalValue(position);
     }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        getInternalValues(x, y, z, values, count);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        // The central differences and the value itself are seven positions per input position,
+        // all of them are evaluated in one batch.
+        static const size_t NUM_SAMPLES = 7;
+        static const size_t NUM_POSITIONS = BATCH_SIZE / 8;
+        Real sampleX[NUM_SAMPLES * NUM_POSITIONS], sampleY[NUM_SAMPLES * NUM_POSITIONS], sampleZ[NUM_SAMPLES * NUM_POSITIONS];
+        Real samples[NUM_SAMPLES * NUM_POSITIONS];
+        for (size_t offset = 0; offset < count; offset += NUM_POSITIONS)
+        {
+            size_t num = std::min(count - offset, NUM_POSITIONS);
+            for (size_t i = 0; i < num; ++i)
+            {
+                for (size_t s = 0; s < NUM_SAMPLES; ++s)
+                {
+                    sampleX[s * num + i] = x[offset + i];
+                    sampleY[s * num + i] = y[offset + i];
+                    sampleZ[s * num + i] = z[offset + i];
+                }
+                sampleX[i] += mGradientOff;
+                sampleX[num + i] -= mGradientOff;
+                sampleY[2 * num + i] += mGradientOff;
+                sampleY[3 * num + i] -= mGradientOff;
+                sampleZ[4 * num + i] += mGradientOff;
+                sampleZ[5 * num + i] -= mGradientOff;
+            }
+            getInternalValues(sampleX, sampleY, sampleZ, samples, NUM_SAMPLES * num);
+            for (size_t i = 0; i < num; ++i)
+            {
+                results[offset + i] = Vector4(
+                    -(samples[i] - samples[num + i]),
+                    -(samples[2 * num + i] - samples[3 * num + i]),
+                    -(samples[4 * num + i] - samples[5 * num + i]),
+                    samples[6 * num + i]);
+            }
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -40,10 +40,14 @@ THE SOFTWARE.
 #include "OgreRoot.h"
 #include "OgreVolumeChunk.h"
 
+#include <algorithm>
 #include <cmath>
 #include "OgreVolumeMeshBuilder.h"
 #include "OgreVolumeOctreeNode.h"
 #include "OgreMaterialManager.h"
+#include "OgreMesh.h"
+#include "OgreMeshManager.h"
+#include "OgreEntity.h"
 
 namespace Ogre {
 namespace Volume {
@@ -71,13 +75,31 @@ namespace Volume {
             req.level = level;
             req.maxLevels = maxLevels;
             req.isUpdate = mShared->parameters->updateFrom != Vector3::ZERO || mShared->parameters->updateTo != Vector3::ZERO;
+            req.updatedBox = AxisAlignedBox(mShared->parameters->updateFrom, mShared->parameters->updateTo);
 
             req.origin = this;
-            req.root = OGRE_NEW OctreeNode(from, to);
+            req.serial = ++mRequestSerial;
+            // The request owns the kept octree until it is loaded, so a second update
+            // of this chunk in the meantime starts with a new one.
+            req.updateOctree = req.isUpdate && mOctreeRoot != 0;
+            if (req.updateOctree)
+            {
+                req.root = mOctreeRoot;
+            }
+            else
+            {
+                OGRE_DELETE mOctreeRoot;
+                req.root = OGRE_NEW OctreeNode(from, to);
+            }
+            mOctreeRoot = 0;
             req.meshBuilder = OGRE_NEW MeshBuilder();
             req.dualGridGenerator = OGRE_NEW DualGridGenerator();
 
-            mChunkHandler.addRequest(req);
+            mShared->pendingRequests.push_back(req);
+            if (mShared->parameters->async)
+            {
+                dispatchRequests();
+            }
         }
         else
         {
@@ -181,6 +203,9 @@ namespace Volume {
         // Don't generate this chunk if it doesn't contribute to the whole volume.
         if (!contributesToVolumeMesh(from, to))
         {
+            // A kept octree would be outdated now.
+            OGRE_DELETE mOctreeRoot;
+            mOctreeRoot = 0;
             return;
         }
     
@@ -197,6 +222,24 @@ namespace Volume {
             mShared->parameters->errorMultiplicator * mShared->parameters->baseError);
         mError = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError;
         root->split(&policy, mShared->parameters->src, mError);
+        generateMesh(level, root, dualGridGenerator, meshBuilder, totalFrom, totalTo);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void Chunk::updateGeometry(size_t level, OctreeNode *root, const AxisAlignedBox &updatedBox, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo)
+    {
+        OctreeNodeSplitPolicy policy(mShared->parameters->src,
+            mShared->parameters->errorMultiplicator * mShared->parameters->baseError);
+        mError = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError;
+        root->updateSplit(&policy, mShared->parameters->src, mError, updatedBox);
+        generateMesh(level, root, dualGridGenerator, meshBuilder, totalFrom, totalTo);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void Chunk::generateMesh(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo)
+    {
         Real maxMSDistance = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError * mShared->parameters->skirtFactor;
         IsoSurface *is = OGRE_NEW IsoSurfaceMC(mShared->parameters->src);
         dualGridGenerator->generateDualGrid(root, is, meshBuilder, maxMSDistance, totalFrom, totalTo,
@@ -241,6 +284,15 @@ namespace Volume {
 
         if (mShared->parameters->createOctreeVisualization)
         {
+            if (isUpdate && mOctree)
+            {
+                // The cells changed, so replace the visualization of the old ones. A kept
+                // octree would hand it out again, a new one would leave it behind.
+                root->resetOctreeGrid();
+                MeshPtr octreeMesh = mOctree->getMesh();
+                mShared->parameters->sceneManager->destroyEntity(mOctree);
+                MeshManager::getSingleton().remove(octreeMesh);
+            }
             mOctree = root->getOctreeGrid(mShared->parameters->sceneManager);
             mNode->attachObject(mOctree);
             mOctree->setVisible(false);
@@ -251,8 +303,85 @@ namespace Volume {
     //-----------------------------------------------------------------------
 
     Chunk::Chunk(void) : mNode(0), mError(false), mDualGrid(0), mOctree(0), mChildren(0),
-        mInvisible(false), isRoot(false), mShared(0)
+        mInvisible(false), isRoot(false), mShared(0), mOctreeRoot(0), mRequestSerial(0)
+    {
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::prepareRequest(const ChunkRequest &req)
+    {
+        if (req.updateOctree)
+        {
+            updateGeometry(req.level, req.root, req.updatedBox, req.dualGridGenerator, req.meshBuilder, req.totalFrom, req.totalTo);
+        }
+        else
+        {
+            prepareGeometry(req.level, req.root, req.dualGridGenerator, req.meshBuilder, req.totalFrom, req.totalTo);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::finishRequest(const ChunkRequest &req)
     {
+        loadGeometry(req.meshBuilder, req.dualGridGenerator, req.root, req.level, req.isUpdate);
+        // Only the octree of the latest request matches the current source.
+        if (mShared->parameters->keepOctrees && req.serial == mRequestSerial)
+        {
+            OGRE_DELETE mOctreeRoot;
+            mOctreeRoot = req.root;
+        }
+        else
+        {
+            OGRE_DELETE req.root;
+        }
+        OGRE_DELETE req.dualGridGenerator;
+        OGRE_DELETE req.meshBuilder;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::dispatchRequests(void)
+    {
+        size_t maxChunksInFlight = mShared->parameters->maxChunksInFlight;
+        while (!mShared->pendingRequests.empty() &&
+            (maxChunksInFlight == 0 || mShared->chunksInWorkQueue < maxChunksInFlight))
+        {
+            mShared->chunksInWorkQueue++;
+            mChunkHandler.addRequest(mShared->pendingRequests.front());
+            mShared->pendingRequests.pop_front();
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Chunk::processRequests(void)
+    {
+        WorkQueue *queue = Root::getSingleton().getWorkQueue();
+        std::vector<ChunkRequest> requests;
+        while (!mShared->pendingRequests.empty())
+        {
+            size_t count = mShared->pendingRequests.size();
+            if (mShared->parameters->maxChunksInFlight)
+            {
+                count = std::min(count, mShared->parameters->maxChunksInFlight);
+            }
+            requests.assign(mShared->pendingRequests.begin(), mShared->pendingRequests.begin() + count);
+            mShared->pendingRequests.erase(mShared->pendingRequests.begin(), mShared->pendingRequests.begin() + count);
+
+            // The chunks are independent of each other, only loading the geometry has to happen here.
+            queue->parallelFor(count, 1, [&requests](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    requests[i].origin->prepareRequest(requests[i]);
+                }
+            });
+            for (size_t i = 0; i < count; ++i)
+            {
+                requests[i].origin->finishRequest(requests[i]);
+            }
+        }
     }
     
     //-----------------------------------------------------------------------
@@ -261,6 +390,7 @@ namespace Volume {
     {
         OGRE_DELETE mRenderOp.indexData;
         OGRE_DELETE mRenderOp.vertexData;
+        OGRE_DELETE mOctreeRoot;
 
         // Root might already be shutdown.
         if (Root::getSingletonPtr())
@@ -330,12 +460,16 @@ namespace Volume {
         }
 
         mShared->chunksBeingProcessed = 0;
+        mShared->totalFrom = from;
+        mShared->totalTo = to;
+        mShared->maxLevels = level;
         
         doLoad(parent, from, to, from, to, level, level);
 
-        // Wait for the threads.
+        // Mesh the chunks right here or wait for the threads.
         if (!parameters->async)
         {
+            processRequests();
             while(mShared->chunksBeingProcessed)
             {
                 OGRE_THREAD_SLEEP(0);
@@ -413,6 +547,27 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void Chunk::updateRegion(const Vector3 &from, const Vector3 &to)
+    {
+        if (!isRoot)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_CALL, "Only the root chunk of a loaded tree can be updated!");
+        }
+        if (!mNode)
+        {
+            // Nothing got loaded, so there is no parent node to reload with.
+            return;
+        }
+        ChunkParameters *parameters = mShared->parameters;
+        // Cells and chunks next to the region read the changed samples, too.
+        Vector3 padding = parameters->src->getEditPadding();
+        parameters->updateFrom = from - padding;
+        parameters->updateTo = to + padding;
+        load(mNode->getParentSceneNode(), mShared->totalFrom, mShared->totalTo, mShared->maxLevels, parameters);
+    }
+    
+    //-----------------------------------------------------------------------
+
     void Chunk::setDualGridVisible(const bool visible)
     {
         mShared->dualGridVisible = visible;
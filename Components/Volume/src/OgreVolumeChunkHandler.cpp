@@ -88,7 +88,7 @@ namespace Volume {
     WorkQueue::Response* ChunkHandler::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
     {
         ChunkRequest cReq = any_cast<ChunkRequest>(req->getData());
-        cReq.origin->prepareGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.totalFrom, cReq.totalTo);
+        cReq.origin->prepareRequest(cReq);
         return OGRE_NEW WorkQueue::Response(req, true, Any());
     }
     
@@ -96,14 +96,14 @@ namespace Volume {
 
     void ChunkHandler::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
     {
+        ChunkRequest cReq = any_cast<ChunkRequest>(res->getRequest()->getData());
         if (res->succeeded())
         {
-            ChunkRequest cReq = any_cast<ChunkRequest>(res->getRequest()->getData());
-            cReq.origin->loadGeometry(cReq.meshBuilder, cReq.dualGridGenerator, cReq.root, cReq.level, cReq.isUpdate);
-            OGRE_DELETE cReq.root;
-            OGRE_DELETE cReq.dualGridGenerator;
-            OGRE_DELETE cReq.meshBuilder;
+            cReq.origin->finishRequest(cReq);
         }
+        // Make room for the next chunks of the tree.
+        cReq.origin->mShared->chunksInWorkQueue--;
+        cReq.origin->dispatchRequests();
     }
 }
 }
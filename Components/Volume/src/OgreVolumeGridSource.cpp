@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "OgreRay.h"
 #include "OgreVolumeCSGSource.h"
 
+#include <algorithm>
+
 namespace Ogre {
 namespace Volume {
     
@@ -90,9 +92,8 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
-    Vector4 GridSource::getValueAndGradient(const Vector3 &position) const
+    Vector3 GridSource::getInterpolatedGradient(const Vector3 &scaledPosition) const
     {
-        Vector3 scaledPosition(position.x * mPosXScale, position.y * mPosYScale, position.z * mPosZScale);
         Vector3 gradient;
         if (mTrilinearGradient)
         {
@@ -138,6 +139,15 @@ namespace Volume {
             gradient = getGradient((size_t)(scaledPosition.x + (Real)0.5), (size_t)(scaledPosition.y + (Real)0.5), (size_t)(scaledPosition.z + (Real)0.5));
             gradient *= (Real)-1.0;
         }
+        return gradient;
+    }
+    
+    //-----------------------------------------------------------------------
+    
+    Vector4 GridSource::getValueAndGradient(const Vector3 &position) const
+    {
+        Vector3 scaledPosition(position.x * mPosXScale, position.y * mPosYScale, position.z * mPosZScale);
+        Vector3 gradient = getInterpolatedGradient(scaledPosition);
         return Vector4(gradient.x, gradient.y, gradient.z, getValue(position));
     }
     
@@ -198,6 +208,107 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
     
+    void GridSource::getValues(const Real *x, const Real *y, const Real *z, Real *values, size_t count) const
+    {
+        size_t x0[BATCH_SIZE], y0[BATCH_SIZE], z0[BATCH_SIZE];
+        if (!mTrilinearValue)
+        {
+            // Nearest neighbour
+            for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+            {
+                size_t num = std::min(count - offset, BATCH_SIZE);
+                for (size_t i = 0; i < num; ++i)
+                {
+                    x0[i] = (size_t)(x[offset + i] * mPosXScale + (Real)0.5);
+                    y0[i] = (size_t)(y[offset + i] * mPosYScale + (Real)0.5);
+                    z0[i] = (size_t)(z[offset + i] * mPosZScale + (Real)0.5);
+                }
+                for (size_t i = 0; i < num; ++i)
+                {
+                    values[offset + i] = (Real)getVolumeGridValue(x0[i], y0[i], z0[i]);
+                }
+            }
+            return;
+        }
+
+        size_t x1[BATCH_SIZE], y1[BATCH_SIZE], z1[BATCH_SIZE];
+        Real dX[BATCH_SIZE], dY[BATCH_SIZE], dZ[BATCH_SIZE];
+        Real f[8][BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+
+            // Cells and weights of the whole batch first...
+            for (size_t i = 0; i < num; ++i)
+            {
+                Real scaledX = x[offset + i] * mPosXScale;
+                Real scaledY = y[offset + i] * mPosYScale;
+                Real scaledZ = z[offset + i] * mPosZScale;
+                x0[i] = (size_t)scaledX;
+                x1[i] = (size_t)ceil(scaledX);
+                y0[i] = (size_t)scaledY;
+                y1[i] = (size_t)ceil(scaledY);
+                z0[i] = (size_t)scaledZ;
+                z1[i] = (size_t)ceil(scaledZ);
+                dX[i] = scaledX - (Real)x0[i];
+                dY[i] = scaledY - (Real)y0[i];
+                dZ[i] = scaledZ - (Real)z0[i];
+            }
+
+            // ...then the grid lookups...
+            for (size_t i = 0; i < num; ++i)
+            {
+                f[0][i] = getVolumeGridValue(x0[i], y0[i], z0[i]);
+                f[1][i] = getVolumeGridValue(x1[i], y0[i], z0[i]);
+                f[2][i] = getVolumeGridValue(x0[i], y1[i], z0[i]);
+                f[3][i] = getVolumeGridValue(x0[i], y0[i], z1[i]);
+                f[4][i] = getVolumeGridValue(x1[i], y0[i], z1[i]);
+                f[5][i] = getVolumeGridValue(x0[i], y1[i], z1[i]);
+                f[6][i] = getVolumeGridValue(x1[i], y1[i], z0[i]);
+                f[7][i] = getVolumeGridValue(x1[i], y1[i], z1[i]);
+            }
+
+            // ...and the interpolation as one straight loop.
+            for (size_t i = 0; i < num; ++i)
+            {
+                Real oneMinX = (Real)1.0 - dX[i];
+                Real oneMinY = (Real)1.0 - dY[i];
+                Real oneMinZ = (Real)1.0 - dZ[i];
+                Real oneMinXoneMinY = oneMinX * oneMinY;
+                Real dXOneMinY = dX[i] * oneMinY;
+
+                values[offset + i] = oneMinZ * (f[0][i] * oneMinXoneMinY
+                    + f[1][i] * dXOneMinY
+                    + f[2][i] * oneMinX * dY[i])
+                    + dZ[i] * (f[3][i] * oneMinXoneMinY
+                    + f[4][i] * dXOneMinY
+                    + f[5][i] * oneMinX * dY[i])
+                    + dX[i] * dY[i] * (f[6][i] * oneMinZ
+                    + f[7][i] * dZ[i]);
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
+    void GridSource::getValuesAndGradients(const Real *x, const Real *y, const Real *z, Vector4 *results, size_t count) const
+    {
+        Real values[BATCH_SIZE];
+        for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            size_t num = std::min(count - offset, BATCH_SIZE);
+            getValues(x + offset, y + offset, z + offset, values, num);
+            for (size_t i = 0; i < num; ++i)
+            {
+                Vector3 gradient = getInterpolatedGradient(Vector3(
+                    x[offset + i] * mPosXScale, y[offset + i] * mPosYScale, z[offset + i] * mPosZScale));
+                results[offset + i] = Vector4(gradient.x, gradient.y, gradient.z, values[i]);
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+    
     size_t GridSource::getWidth(void) const
     {
         return mWidth;
@@ -265,5 +376,14 @@ namespace Volume {
     {
         return mVolumeSpaceToWorldSpaceFactor;
     }
+    
+    //-----------------------------------------------------------------------
+
+    Vector3 GridSource::getEditPadding(void) const
+    {
+        // combineWithSource truncates the start of the edited voxels by up to one, the
+        // interpolation reaches the next voxel and the central differences one more.
+        return Vector3((Real)3.0 / mPosXScale, (Real)3.0 / mPosYScale, (Real)3.0 / mPosZScale);
+    }
 }
 }
\ No newline at end of file
@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "OgreVolumeSource.h"
 #include "OgreVolumeMeshBuilder.h"
 
+#include <algorithm>
+
 namespace Ogre {
 namespace Volume {
         
@@ -38,6 +40,21 @@ namespace Volume {
     IsoSurfaceMC::IsoSurfaceMC(const Source *src) : IsoSurface(src)
     {
     }
+
+    //-----------------------------------------------------------------------
+
+    void IsoSurfaceMC::getCornerValuesAndGradients(const Vector3 *corners, const size_t *indices, size_t count, Vector4 *results) const
+    {
+        Real x[8], y[8], z[8];
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Vector3 &corner = corners[indices ? indices[i] : i];
+            x[i] = corner.x;
+            y[i] = corner.y;
+            z[i] = corner.z;
+        }
+        mSrc->getValuesAndGradients(x, y, z, results, count);
+    }
     
     //-----------------------------------------------------------------------
 
@@ -45,18 +62,18 @@ namespace Volume {
     {
         unsigned char cubeIndex = 0;
         Vector4 values[8];
+        if (volumeValues)
+        {
+            std::copy(volumeValues, volumeValues + 8, values);
+        }
+        else
+        {
+            getCornerValuesAndGradients(corners, 0, 8, values);
+        }
 
         // Find out the case.
         for (size_t i = 0; i < 8; ++i)
         {
-            if (volumeValues)
-            {
-                values[i] = volumeValues[i];
-            }
-            else
-            {
-                values[i] = mSrc->getValueAndGradient(corners[i]);
-            }
             if (values[i].w >= ISO_LEVEL)
             {
                 cubeIndex |= 1 << i;
@@ -138,18 +155,21 @@ namespace Volume {
     {
         unsigned char squareIndex = 0;
         Vector4 values[4];
-
-        // Find out the case.
-        for (size_t i = 0; i < 4; ++i)
+        if (volumeValues)
         {
-            if (volumeValues)
+            for (size_t i = 0; i < 4; ++i)
             {
                 values[i] = Vector4(volumeValues[indices[i]].w);
             }
-            else
-            {
-                values[i] = mSrc->getValueAndGradient(corners[indices[i]]);
-            }
+        }
+        else
+        {
+            getCornerValuesAndGradients(corners, indices, 4, values);
+        }
+
+        // Find out the case.
+        for (size_t i = 0; i < 4; ++i)
+        {
             if (values[i].w >= ISO_LEVEL)
             {
                 squareIndex |= 1 << i;
@@ -172,30 +192,26 @@ namespace Volume {
         intersectionPoints[4] = corners[indices[2]];
         intersectionPoints[6] = corners[indices[3]];
 
-        Vector4 innerVal = mSrc->getValueAndGradient(intersectionPoints[0]);
-        intersectionNormals[0].x = innerVal.x;
-        intersectionNormals[0].y = innerVal.y;
-        intersectionNormals[0].z = innerVal.z;
-        intersectionNormals[0].normalise();
-        intersectionNormals[0] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[2]);
-        intersectionNormals[2].x = innerVal.x;
-        intersectionNormals[2].y = innerVal.y;
-        intersectionNormals[2].z = innerVal.z;
-        intersectionNormals[2].normalise();
-        intersectionNormals[2] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[4]);
-        intersectionNormals[4].x = innerVal.x;
-        intersectionNormals[4].y = innerVal.y;
-        intersectionNormals[4].z = innerVal.z;
-        intersectionNormals[4].normalise();
-        intersectionNormals[4] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[6]);
-        intersectionNormals[6].x = innerVal.x;
-        intersectionNormals[6].y = innerVal.y;
-        intersectionNormals[6].z = innerVal.z;
-        intersectionNormals[6].normalise();
-        intersectionNormals[6] *= innerVal.w + (Real)1.0;
+        // The normals of the corners need the gradients of the source, which are already known
+        // if the values were not passed in.
+        Vector4 innerValues[4];
+        if (volumeValues)
+        {
+            getCornerValuesAndGradients(corners, indices, 4, innerValues);
+        }
+        else
+        {
+            std::copy(values, values + 4, innerValues);
+        }
+        for (size_t i = 0; i < 4; ++i)
+        {
+            Vector3 &normal = intersectionNormals[i * 2];
+            normal.x = innerValues[i].x;
+            normal.y = innerValues[i].y;
+            normal.z = innerValues[i].z;
+            normal.normalise();
+            normal *= innerValues[i].w + (Real)1.0;
+        }
 
         if (edge & 1)
         {
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreVolumeSource.h"
 #include "OgreVolumeOctreeNodeSplitPolicy.h"
 #include "OgreSceneManager.h"
+#include "OgreAxisAlignedBox.h"
 
 namespace Ogre {
 namespace Volume {
@@ -146,6 +147,45 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void OctreeNode::updateSplit(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox &region)
+    {
+        if (!region.intersects(AxisAlignedBox(mFrom, mTo)))
+        {
+            return;
+        }
+
+        // Forget the old value, like a fresh node.
+        mCenterValue = Vector4(0.0, 0.0, 0.0, 0.0);
+        if (!mChildren)
+        {
+            split(splitPolicy, src, geometricError);
+            return;
+        }
+
+        if (splitPolicy->doSplit(this, geometricError))
+        {
+            for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+            {
+                mChildren[i]->updateSplit(splitPolicy, src, geometricError, region);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+            {
+                OGRE_DELETE mChildren[i];
+            }
+            delete[] mChildren;
+            mChildren = 0;
+            if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
+            {
+                setCenterValue(src->getValueAndGradient(getCenter()));
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     Entity* OctreeNode::getOctreeGrid(SceneManager *sceneManager)
     {
         if (!mOctreeGrid)
@@ -60,14 +60,26 @@ namespace Volume {
         }
 
         // Error metric of http://www.andrew.cmu.edu/user/jessicaz/publication/meshing/
-        Real f000 = mSrc->getValue(from);
-        Real f001 = mSrc->getValue(node->getCorner3());
-        Real f010 = mSrc->getValue(node->getCorner4());
-        Real f011 = mSrc->getValue(node->getCorner7());
-        Real f100 = mSrc->getValue(node->getCorner1());
-        Real f101 = mSrc->getValue(node->getCorner2());
-        Real f110 = mSrc->getValue(node->getCorner5());
-        Real f111 = mSrc->getValue(to);
+        const Vector3 corners[8] = {
+            from, node->getCorner3(), node->getCorner4(), node->getCorner7(),
+            node->getCorner1(), node->getCorner2(), node->getCorner5(), to
+        };
+        Real cornerX[8], cornerY[8], cornerZ[8], cornerValues[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            cornerX[i] = corners[i].x;
+            cornerY[i] = corners[i].y;
+            cornerZ[i] = corners[i].z;
+        }
+        mSrc->getValues(cornerX, cornerY, cornerZ, cornerValues, 8);
+        Real f000 = cornerValues[0];
+        Real f001 = cornerValues[1];
+        Real f010 = cornerValues[2];
+        Real f011 = cornerValues[3];
+        Real f100 = cornerValues[4];
+        Real f101 = cornerValues[5];
+        Real f110 = cornerValues[6];
+        Real f111 = cornerValues[7];
 
         Vector3 positions[19][2] = {
             {node->getCenterBackBottom(), Vector3((Real)0.5, (Real)0.0, (Real)0.0)},
@@ -93,27 +105,43 @@ namespace Volume {
             {node->getCenterFrontTop(), Vector3((Real)0.5, (Real)1.0, (Real)1.0)}
         };
 
-    
+        Real positionX[19], positionY[19], positionZ[19];
+        for (size_t i = 0; i < 19; ++i)
+        {
+            positionX[i] = positions[i][0].x;
+            positionY[i] = positions[i][0].y;
+            positionZ[i] = positions[i][0].z;
+        }
+
+        // The positions are evaluated layer by layer, so the error can still stop early.
+        const size_t layerEnds[3] = {5, 14, 19};
         Real error = (Real)0.0;
-        Vector4 value;
+        Vector4 values[19];
         Vector3 gradient;
-        for (size_t i = 0; i < 19; ++i)
+        size_t layerStart = 0;
+        for (size_t layer = 0; layer < 3; ++layer)
         {
-            value = mSrc->getValueAndGradient(positions[i][0]);
-            gradient.x = value.x;
-            gradient.y = value.y;
-            gradient.z = value.z;
-            Real interpolated = interpolate(f000, f001, f010, f011, f100, f101, f110, f111, positions[i][1]);
-            Real gradientMagnitude = gradient.length();
-            if (gradientMagnitude < FLT_EPSILON)
-            {
-                gradientMagnitude = (Real)1.0;
-            }
-            error += Math::Abs(value.w - interpolated) / gradientMagnitude;
-            if (error >= geometricError)
+            mSrc->getValuesAndGradients(positionX + layerStart, positionY + layerStart, positionZ + layerStart,
+                values + layerStart, layerEnds[layer] - layerStart);
+            for (size_t i = layerStart; i < layerEnds[layer]; ++i)
             {
-                return true;
+                const Vector4 &value = values[i];
+                gradient.x = value.x;
+                gradient.y = value.y;
+                gradient.z = value.z;
+                Real interpolated = interpolate(f000, f001, f010, f011, f100, f101, f110, f111, positions[i][1]);
+                Real gradientMagnitude = gradient.length();
+                if (gradientMagnitude < FLT_EPSILON)
+                {
+                    gradientMagnitude = (Real)1.0;
+                }
+                error += Math::Abs(value.w - interpolated) / gradientMagnitude;
+                if (error >= geometricError)
+                {
+                    return true;
+                }
             }
+            layerStart = layerEnds[layer];
         }
         node->setCenterValue(centerValue);
         return false;
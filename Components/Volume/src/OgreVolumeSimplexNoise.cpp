@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #include <time.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace Ogre {
@@ -232,6 +233,63 @@ namespace Volume {
         return (Real)32.0 * (n0 + n1 + n2 + n3);
     }
     
+    //-----------------------------------------------------------------------
+
+    void SimplexNoise::noise(const Real *xIn, const Real *yIn, const Real *zIn, Real *results, size_t count) const
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            Real s = (xIn[n] + yIn[n] + zIn[n]) * F3;
+            int i = (int)std::floor(xIn[n] + s);
+            int j = (int)std::floor(yIn[n] + s);
+            int k = (int)std::floor(zIn[n] + s);
+            Real t = (i + j + k) * G3;
+            Real x0 = xIn[n] - (i - t);
+            Real y0 = yIn[n] - (j - t);
+            Real z0 = zIn[n] - (k - t);
+            // The same simplex as the nested conditions of the single position version
+            int xy = x0 >= y0;
+            int yz = y0 >= z0;
+            int xz = x0 >= z0;
+            int i1 = xy & xz;
+            int j1 = (1 - xy) & yz;
+            int k1 = (1 - xz) & (1 - yz);
+            int i2 = xy | xz;
+            int j2 = (1 - xy) | yz;
+            int k2 = (1 - xz) | (1 - yz);
+            Real x1 = x0 - i1 + G3;
+            Real y1 = y0 - j1 + G3;
+            Real z1 = z0 - k1 + G3;
+            Real x2 = x0 - i2 + (Real)2.0 * G3;
+            Real y2 = y0 - j2 + (Real)2.0 * G3;
+            Real z2 = z0 - k2 + (Real)2.0 * G3;
+            Real x3 = x0 - (Real)1.0 + (Real)3.0 * G3;
+            Real y3 = y0 - (Real)1.0 + (Real)3.0 * G3;
+            Real z3 = z0 - (Real)1.0 + (Real)3.0 * G3;
+            int ii = i & 255;
+            int jj = j & 255;
+            int kk = k & 255;
+            const Vector3 &g0 = grad3[permMod12[ii + perm[jj + perm[kk]]]];
+            const Vector3 &g1 = grad3[permMod12[ii + i1 + perm[jj + j1 + perm[kk + k1]]]];
+            const Vector3 &g2 = grad3[permMod12[ii + i2 + perm[jj + j2 + perm[kk + k2]]]];
+            const Vector3 &g3 = grad3[permMod12[ii + 1 + perm[jj + 1 + perm[kk + 1]]]];
+            // A corner out of reach gets a weight of zero instead of being skipped
+            Real t0 = std::max((Real)0.6 - x0 * x0 - y0 * y0 - z0 * z0, (Real)0.0);
+            Real t1 = std::max((Real)0.6 - x1 * x1 - y1 * y1 - z1 * z1, (Real)0.0);
+            Real t2 = std::max((Real)0.6 - x2 * x2 - y2 * y2 - z2 * z2, (Real)0.0);
+            Real t3 = std::max((Real)0.6 - x3 * x3 - y3 * y3 - z3 * z3, (Real)0.0);
+            t0 *= t0;
+            t1 *= t1;
+            t2 *= t2;
+            t3 *= t3;
+            results[n] = (Real)32.0 * (
+                t0 * t0 * dot(g0, x0, y0, z0) +
+                t1 * t1 * dot(g1, x1, y1, z1) +
+                t2 * t2 * dot(g2, x2, y2, z2) +
+                t3 * t3 * dot(g3, x3, y3, z3));
+        }
+    }
+    
     //-----------------------------------------------------------------------
     
     long SimplexNoise::getSeed(void) const
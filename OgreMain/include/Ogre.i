@@ -469,6 +469,7 @@ ADD_REPR(ColourValue)
 %include "OgreGpuProgramParams.h"
 %include "OgreImage.h"
 %include "OgreBillboard.h"
+%ignore Ogre::ParticleArrays; // internal, used by the parallel update
 %include "OgreParticle.h"
 %include "OgreHardwareOcclusionQuery.h"
 SHARED_PTR(HardwareBuffer);
@@ -279,6 +279,23 @@ namespace Ogre {
         void apply(Skeleton* skeleton, Real timePos, float weight,
           const AnimationState::BoneBlendMask* blendMask, Real scale);
 
+        /** Applies all node tracks given a specific time point and weight to a given skeleton,
+            starting the keyframe search at a cached position.
+        @remarks
+            As the other skeleton apply methods, but when time advances monotonically,
+            as it does for an AnimationState, the next keyframe is usually the one
+            found last time or the one after. Skeleton::setAnimationState uses this
+            with a cursor stored in each AnimationState.
+        @param skeleton
+        @param timePos The time position in the animation to apply.
+        @param weight The influence to give to this track
+        @param blendMask Optional per bone weights, modulated with the weight factor
+        @param scale The scale to apply to translations and scalings
+        @param keyFrameCursor The global keyframe index found last time, updated to the new one
+        */
+        void apply(Skeleton* skeleton, Real timePos, float weight,
+          const AnimationState::BoneBlendMask* blendMask, Real scale, uint& keyFrameCursor);
+
         /** Applies all vertex tracks given a specific time point and weight to a given entity.
         @param entity The Entity to which this animation should be applied
         @param timePos The time position in the animation to apply.
@@ -423,6 +440,11 @@ namespace Ogre {
         */
         void optimise(bool discardIdentityNodeTracks = true);
 
+        /** Compresses the keyframes of all node tracks.
+        @see NodeAnimationTrack::compress
+        */
+        void compressNodeTracks(Real tolerance = 1e-4f);
+
         /// A list of track handles
         typedef std::set<ushort> TrackHandleList;
 
@@ -462,6 +484,14 @@ namespace Ogre {
             global keyframe time list.
         */
         TimeIndex _getTimeIndex(Real timePos) const;
+
+        /** Internal method used to convert time position to time index object,
+            checking the given global keyframe index first.
+        @param timePos The time position.
+        @param keyFrameCursor The global keyframe index to check first, e.g. the one returned
+            for the previous time position. Receives the new index.
+        */
+        TimeIndex _getTimeIndex(Real timePos, uint& keyFrameCursor) const;
         
         /** Sets a base keyframe which for the skeletal / pose keyframes 
             in this animation. 
@@ -534,6 +564,8 @@ namespace Ogre {
         AnimationContainer* mContainer;
 
         void optimiseNodeTracks(bool discardIdentityTracks);
+        void applyToSkeleton(Skeleton* skeleton, const TimeIndex& timeIndex, float weight,
+          const AnimationState::BoneBlendMask* blendMask, Real scale);
         void optimiseVertexTracks(void);
 
         /// Internal method to build global keyframe time list
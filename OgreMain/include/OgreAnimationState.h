@@ -169,6 +169,11 @@ namespace Ogre {
           assert(mBlendMask && mBlendMask->size() > boneHandle);
           return (*mBlendMask)[boneHandle];
       }
+
+        /** Internal cache of the global keyframe index found at the last update.
+        @see Animation::apply(Skeleton*, Real, float, const BoneBlendMask*, Real, uint&)
+        */
+        uint& _getKeyFrameCursor() const { return mKeyFrameCursor; }
     protected:
         /// The blend mask (containing per bone weights)
         BoneBlendMask* mBlendMask;
@@ -180,6 +185,7 @@ namespace Ogre {
         Real mWeight;
         bool mEnabled;
         bool mLoop;
+        mutable uint mKeyFrameCursor;
 
     };
 
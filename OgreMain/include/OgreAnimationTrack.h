@@ -380,10 +380,50 @@ namespace Ogre
         /** Optimise the current track by removing any duplicate keyframes. */
         virtual void optimise(void);
 
+        /** @copydoc AnimationTrack::getKeyFramesAtTime
+        @note
+            There are no KeyFrame objects to return for a compressed track, so this
+            throws an exception unless the track is decompressed first.
+        */
+        Real getKeyFramesAtTime(const TimeIndex& timeIndex, KeyFrame** keyFrame1, KeyFrame** keyFrame2,
+                                unsigned short* firstKeyIndex = 0) const;
+
+        /** Converts the keyframes of this track into a compact, read-only form.
+        @remarks
+            Rotations are quantised to 16 bits per component, and translation,
+            rotation or scale channels which stay constant over the whole track
+            are stored only once. The remaining keys are kept in contiguous
+            arrays per channel instead of individual KeyFrame objects, which
+            takes a fraction of the memory and is sampled without any virtual
+            calls or pointer chasing.
+        @par
+            The KeyFrame objects are destroyed, so getNumKeyFrames returns 0 for
+            a compressed track and getKeyFramesAtTime throws. Creating a new
+            keyframe decompresses it again.
+        @param tolerance The difference below which a channel is considered constant,
+            in radians for the rotation
+        */
+        void compress(Real tolerance = 1e-4f);
+
+        /** Recreates the KeyFrame objects of a compressed track.
+        @note
+            The rotations keep the precision they were quantised to.
+        */
+        void decompress(void);
+
+        /// Returns whether the keyframes of this track are compressed, see compress
+        bool isCompressed(void) const { return mCompressedKeys != 0; }
+
         /** Clone this track (internal use only) */
         NodeAnimationTrack* _clone(Animation* newParent) const;
         
         void _applyBaseKeyFrame(const KeyFrame* base);
+
+        /// @copydoc AnimationTrack::_collectKeyFrameTimes
+        void _collectKeyFrameTimes(std::vector<Real>& keyFrameTimes);
+
+        /// @copydoc AnimationTrack::_buildKeyFrameIndexMap
+        void _buildKeyFrameIndexMap(const std::vector<Real>& keyFrameTimes);
         
     protected:
         /// Specialised keyframe creation
@@ -391,6 +431,14 @@ namespace Ogre
         // Flag indicating we need to rebuild the splines next time
         virtual void buildInterpolationSplines(void) const;
 
+        /// Keyframes in compressed form, see compress
+        struct CompressedKeys;
+
+        /// getKeyFramesAtTime for compressed keys
+        Real getCompressedKeysAtTime(const TimeIndex& timeIndex, size_t& key1, size_t& key2) const;
+        /// getInterpolatedKeyFrame for compressed keys
+        void getInterpolatedCompressedKeyFrame(const TimeIndex& timeIndex, TransformKeyFrame* kf) const;
+
         // Struct for store splines, allocate on demand for better memory footprint
         struct Splines
         {
@@ -402,6 +450,7 @@ namespace Ogre
         Node* mTargetNode;
         // Prebuilt splines, must be mutable since lazy-update in const method
         mutable Splines* mSplines;
+        CompressedKeys* mCompressedKeys;
         mutable bool mSplineBuildNeeded;
         /// Defines if rotation is done using shortest path
         mutable bool mUseShortestRotationPath ;
@@ -0,0 +1,229 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __BoundingVolumeHierarchy_H__
+#define __BoundingVolumeHierarchy_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreAxisAlignedBox.h"
+#include "OgreRay.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Math
+    *  @{
+    */
+    /** A binary tree of axis aligned boxes, for finding the primitives a ray hits.
+    @remarks
+        The primitives are only known by their index and bounds. The tree is built
+        by splitting the primitives at the median of their centres along the longest
+        axis. If the primitives move, but keep their order, refit updates the bounds
+        without changing the tree structure.
+    */
+    class _OgreExport BoundingVolumeHierarchy : public GeometryAllocatedObject
+    {
+    public:
+        /// Maximum number of primitives in a leaf
+        static const size_t LEAF_SIZE = 4;
+
+        struct Node
+        {
+            Vector3 minimum;
+            /// leaf: first entry in the primitive list, inner node: index of the second child
+            uint32 first;
+            Vector3 maximum;
+            /// number of primitives, 0 for inner nodes whose first child directly follows them
+            uint32 count;
+        };
+
+        /** Builds the tree over the given boxes.
+        @param boxes the bounds of the primitives, which must be finite
+        @param count the number of primitives
+        */
+        void build(const AxisAlignedBox* boxes, size_t count);
+        /** Updates the bounds of all nodes.
+        @param boxes the new bounds of the primitives, in the order passed to build
+        */
+        void refit(const AxisAlignedBox* boxes);
+        /// Removes all primitives
+        void clear();
+
+        /// The number of primitives in the tree
+        size_t getNumPrimitives() const { return mPrimitives.size(); }
+        const std::vector<Node>& getNodes() const { return mNodes; }
+        /// The primitive indexes, in leaf order
+        const std::vector<uint32>& getPrimitives() const { return mPrimitives; }
+
+        /** Finds the primitives whose leaf the ray passes through.
+        @param ray the ray
+        @param maxDistance ignore nodes further away along the ray
+        @param func called as <tt>Real func(uint32 primitive, Real maxDistance)</tt> for each candidate,
+            returns the new maximum distance, which allows finding the closest hit early.
+            Nodes closer to the ray origin are visited first. Returning a negative distance
+            ends the search.
+        */
+        template <typename Func> void intersect(const Ray& ray, Real maxDistance, Func func) const
+        {
+            if (mNodes.empty())
+                return;
+
+            const Vector3& origin = ray.getOrigin();
+            Vector3 invDir = 1 / ray.getDirection();
+
+            // nodes still to visit and where the ray enters them
+            std::pair<uint32, Real> stack[64];
+            size_t stackSize = 0;
+            uint32 current = 0;
+            Real distance;
+            if (!intersects(mNodes[0], origin, invDir, maxDistance, distance))
+                return;
+
+            while (true)
+            {
+                const Node& node = mNodes[current];
+                if (node.count)
+                {
+                    for (uint32 i = node.first; i < node.first + node.count && maxDistance >= 0; ++i)
+                        maxDistance = func(mPrimitives[i], maxDistance);
+                }
+                else
+                {
+                    uint32 left = current + 1, right = node.first;
+                    Real leftDistance, rightDistance;
+                    bool hitLeft = intersects(mNodes[left], origin, invDir, maxDistance, leftDistance);
+                    bool hitRight = intersects(mNodes[right], origin, invDir, maxDistance, rightDistance);
+                    if (hitLeft && hitRight)
+                    {
+                        // visit the nearer child first
+                        if (rightDistance < leftDistance)
+                        {
+                            std::swap(left, right);
+                            std::swap(leftDistance, rightDistance);
+                        }
+                        stack[stackSize++] = std::make_pair(right, rightDistance);
+                        current = left;
+                        continue;
+                    }
+                    if (hitLeft || hitRight)
+                    {
+                        current = hitLeft ? left : right;
+                        continue;
+                    }
+                }
+
+                // skip the nodes behind the closest hit found since they were pushed
+                do
+                {
+                    if (stackSize == 0)
+                        return;
+                    --stackSize;
+                } while (stack[stackSize].second > maxDistance);
+                current = stack[stackSize].first;
+            }
+        }
+
+    private:
+        std::vector<Node> mNodes;
+        std::vector<uint32> mPrimitives;
+
+        void buildNode(const AxisAlignedBox* boxes, const Vector3* centres, uint32 begin, uint32 end, size_t depth);
+
+        /// slab test, distance is where the ray enters the node
+        static bool intersects(const Node& node, const Vector3& origin, const Vector3& invDir,
+                               Real maxDistance, Real& distance)
+        {
+            Real tmin = 0, tmax = maxDistance;
+            for (int i = 0; i < 3; ++i)
+            {
+                Real t0 = (node.minimum[i] - origin[i]) * invDir[i];
+                Real t1 = (node.maximum[i] - origin[i]) * invDir[i];
+                if (t0 > t1)
+                    std::swap(t0, t1);
+                // written so that NaNs, from 0 * inf, do not reject the node
+                tmin = t0 > tmin ? t0 : tmin;
+                tmax = t1 < tmax ? t1 : tmax;
+            }
+            distance = tmin;
+            return tmin <= tmax;
+        }
+    };
+
+    /** The triangles of a Mesh with a BoundingVolumeHierarchy over them.
+    @remarks
+        Built from the positions of the first LOD level by Mesh::getTriangleBVH.
+        Only triangle lists are taken into account.
+    */
+    class _OgreExport TriangleBVH : public GeometryAllocatedObject
+    {
+    public:
+        /// The closest triangle hit by a ray
+        struct Hit
+        {
+            Real distance;
+            /// index of the triangle within its SubMesh
+            uint32 triangle;
+            uint16 subMesh;
+            /// weights of the three triangle corners at the hit point
+            Vector3 barycentricCoords;
+        };
+
+        /// Adds the triangles of the given index and vertex data, before build
+        void addTriangles(uint16 subMesh, const VertexData* vertexData, const IndexData* indexData);
+        /// Builds the hierarchy over the triangles added so far
+        void build();
+
+        size_t getNumTriangles() const { return mTriangles.size(); }
+
+        /** Finds the closest triangle hit by the ray.
+        @param ray the ray, in the space of the triangles
+        @param maxDistance ignore hits further away along the ray
+        @param hit receives the details of the hit
+        @return whether a triangle was hit
+        */
+        bool intersect(const Ray& ray, Real maxDistance, Hit& hit) const;
+
+    private:
+        struct Triangle
+        {
+            Vector3 corners[3];
+            uint32 index;
+            uint16 subMesh;
+        };
+        std::vector<Triangle> mTriangles;
+        BoundingVolumeHierarchy mBVH;
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
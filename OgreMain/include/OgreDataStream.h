@@ -450,6 +450,10 @@ namespace Ogre {
         */
         size_t skipLine(const String& delim = "\n");
 
+        /** @copydoc DataStream::getAsString
+        */
+        String getAsString(void);
+
         /** @copydoc DataStream::skip
         */
         void skip(long count);
@@ -474,6 +478,33 @@ namespace Ogre {
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
     };
 
+    /** Common subclass of DataStream for handling data from memory mapped files.
+    @remarks
+        The file is mapped into the address space instead of being read, so the
+        bytes are only paged in when accessed and never copied into a separate
+        buffer. As this is a MemoryDataStream, codecs and serializers can parse
+        the file in place through getPtr / getCurrentPtr.
+    @par
+        The mapping is private: writing to the memory does not change the file.
+        The file must not be truncated while mapped. Only available on POSIX
+        platforms, the constructor throws elsewhere.
+    */
+    class _OgreExport MappedDataStream : public MemoryDataStream
+    {
+    public:
+        /** Map a file in a named, read-only stream.
+        @param name The name to give the stream
+        @param path The path of the file to map
+        */
+        MappedDataStream(const String& name, const String& path);
+
+        ~MappedDataStream();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
+    };
+
     /** Common subclass of DataStream for handling data from 
         std::basic_istream.
     */
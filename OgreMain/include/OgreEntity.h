@@ -121,6 +121,24 @@ namespace Ogre {
         ///   the vertex data for hardware morphing (pos2 binding)
         std::unique_ptr<VertexData> mHardwareVertexAnimVertexData;
 
+        /// Shadow volume for a light, see SceneManager::setShadowVolumeCacheEnabled
+        struct CachedShadowVolume
+        {
+            const Light* light = NULL;
+            /// object space light position the volume was built for
+            Vector4 lightPos = Vector4::ZERO;
+            unsigned long flags = 0;
+            bool useMcGuire = false;
+            const EdgeData* edgeList = NULL;
+            std::vector<char> lightFacings;
+            ShadowVolumeIndexes volume;
+        };
+        /// Cached shadow volumes, one per light
+        std::vector<CachedShadowVolume> mCachedShadowVolumes;
+        /// Returns the cached shadow volume for the light, rebuilding it if outdated
+        const CachedShadowVolume& updateCachedShadowVolume(const Light* light, const Vector4& lightPos,
+                                                           unsigned long flags, const EdgeData* edgeList);
+
         /// Have we applied any vertex animation to shared geometry?
         bool mVertexAnimationAppliedThisFrame : 1;
         /// Have the temp buffers already had their geometry prepared for use in rendering shadow volumes?
@@ -600,6 +618,7 @@ namespace Ogre {
             ShadowTechnique shadowTechnique, const Light* light,
             HardwareIndexBufferSharedPtr* indexBuffer, size_t* indexBufferUsedSize,
             bool extrudeVertices, Real extrusionDistance, unsigned long flags = 0) override;
+        void _prepareShadowVolume(const Light* light, unsigned long flags) override;
 
         /** Internal method for retrieving bone matrix information. */
         const Affine3* _getBoneMatrices(void) const { return mBoneMatrices;}
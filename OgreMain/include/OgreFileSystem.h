@@ -70,6 +70,19 @@ namespace Ogre {
 
         /// Get whether hidden files are ignored during filesystem enumeration.
         static bool getIgnoreHidden();
+
+        /** Set whether files opened read-only are memory mapped.
+        @remarks
+            Instead of a stream reading through std::ifstream, a MappedDataStream
+            is returned, so the file contents are accessed in place rather than
+            being copied into intermediate buffers. The files must not be truncated
+            while their streams are open. Only supported on POSIX platforms,
+            ignored elsewhere. The default is false.
+        */
+        static void setUseMemoryMapping(bool useMapping);
+
+        /// Get whether files opened read-only are memory mapped.
+        static bool getUseMemoryMapping();
     };
 
     class APKFileSystemArchiveFactory : public ArchiveFactory
@@ -241,8 +241,10 @@ namespace Ogre {
         void saveMicrocodeCache( DataStreamPtr stream ) const;
         /** Loads the microcode cache from disk.
         @param stream The source stream
+        @param merge Keep the microcodes already in the cache instead of replacing them,
+        they take precedence over the loaded ones
         */
-        void loadMicrocodeCache( DataStreamPtr stream );
+        void loadMicrocodeCache( DataStreamPtr stream, bool merge = false );
         
 
 
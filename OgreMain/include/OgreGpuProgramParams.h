@@ -1354,6 +1354,27 @@ namespace Ogre {
         /// physical index for active pass iteration parameter real constant entry;
         size_t mActivePassIterationIndex;
 
+        /// A range of mAutoConstantOrder whose auto constants share the same variability
+        struct AutoConstantGroup
+        {
+            uint16 variability;
+            size_t begin;
+            size_t end;
+        };
+        typedef std::vector<AutoConstantGroup> AutoConstantGroupList;
+        /// Indices into mAutoConstants, grouped by variability and sorted by physical index
+        std::vector<size_t> mAutoConstantOrder;
+        /// Update plan of _updateAutoParams, rebuilt whenever mAutoConstants changed
+        AutoConstantGroupList mAutoConstantGroups;
+        bool mAutoConstantGroupsDirty;
+        /// Whether _writeRawConstants compares the new values with the old ones
+        bool mDetectValueChanges;
+        /// Set by _writeRawConstants if a write changed a value while mDetectValueChanges is set
+        bool mValuesChanged;
+
+        /// Rebuilds mAutoConstantOrder and mAutoConstantGroups from mAutoConstants
+        void buildAutoConstantGroups();
+
         /// Return the variability for an auto constant
         static uint16 deriveVariability(AutoConstantType act);
 
@@ -1865,10 +1886,15 @@ namespace Ogre {
         /// @}
 
         /** Update automatic parameters.
+        @remarks
+            The auto constants are grouped by their variability once, so each update only
+            visits the constants matching variabilityMask.
             @param source The source of the parameters
             @param variabilityMask A mask of GpuParamVariability which identifies which autos will need updating
+            @return The variabilities of the updated auto constants whose values actually changed.
+            The caller may skip uploading the others, if they were uploaded before.
         */
-        void _updateAutoParams(const AutoParamDataSource* source, uint16 variabilityMask);
+        uint16 _updateAutoParams(const AutoParamDataSource* source, uint16 variabilityMask);
 
         /** Tells the program whether to ignore missing parameters or not.
          */
@@ -412,7 +412,9 @@ namespace Ogre {
             FILTER_BILINEAR,
             FILTER_BOX,
             FILTER_TRIANGLE,
-            FILTER_BICUBIC
+            FILTER_BICUBIC,
+            FILTER_KAISER,
+            FILTER_LANCZOS
         };
         /** Scale a 1D, 2D or 3D image volume. 
             @param  src         PixelBox containing the source pointer, dimensions and format
@@ -425,6 +427,24 @@ namespace Ogre {
         
         /** Resize a 2D image, applying the appropriate filter. */
         void resize(ushort width, ushort height, Filter filter = FILTER_BILINEAR);
+
+        /** Generate the full mipmap chain of every face on the CPU.
+
+            Each level is filtered from the previous one, in floating point. Any
+            mipmaps already contained in the image are replaced.
+            @param gammaCorrect Treat the colour channels as sRGB and filter them in
+                linear space
+            @param filter FILTER_BOX, FILTER_TRIANGLE, FILTER_BICUBIC, FILTER_KAISER or
+                FILTER_LANCZOS. The remaining filters are treated as FILTER_BOX.
+            @param alphaCoverageRef If greater than 0, the alpha of each mipmap is scaled
+                so that the fraction of pixels with an alpha above this reference
+                value stays the same as in the top level. This keeps alpha tested
+                foliage from thinning out in the distance.
+            @note The rows of each level are processed on the WorkQueue of the Root,
+                if there is one.
+        */
+        Image& generateMipmaps(bool gammaCorrect = false, Filter filter = FILTER_BOX,
+                               Real alphaCoverageRef = 0);
         
         /// Static function to calculate size in bytes from the number of mipmaps, faces and the dimensions
         static size_t calculateSize(size_t mipmaps, size_t faces, uint32 width, uint32 height, uint32 depth, PixelFormat format);
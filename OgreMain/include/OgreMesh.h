@@ -177,6 +177,9 @@ namespace Ogre {
         bool mEdgeListsBuilt;
         bool mAutoBuildEdgeLists;
 
+        /// Triangles of the first LOD level for ray queries, built on demand
+        TriangleBVH* mTriangleBVH;
+
         /// Storage of morph animations, lookup by name
         typedef std::map<String, Animation*> AnimationList;
         AnimationList mAnimationsList;
@@ -775,6 +778,21 @@ namespace Ogre {
         /** Returns whether this mesh has an attached edge list. */
         bool isEdgeListBuilt(void) const { return mEdgeListsBuilt; }
 
+        /** Return a bounding volume hierarchy over the triangles of this mesh, building it if required.
+        @remarks
+            The hierarchy covers the triangle lists of the first LOD level in their bind pose and is
+            used by RaySceneQuery to find the exact triangle a ray hits. Building it reads back the
+            vertex and index buffers, which is slow unless they have shadow buffers or live in
+            system memory, see setVertexBufferPolicy and setIndexBufferPolicy.
+        @par
+            Building the hierarchy is not thread safe, but once built it may be used by several
+            threads at once. Call freeTriangleBVH if you modify the vertex positions.
+        */
+        const TriangleBVH* getTriangleBVH(void);
+
+        /** Destroys the triangle hierarchy built by getTriangleBVH. */
+        void freeTriangleBVH(void);
+
         /** Prepare matrices for software indexed vertex blend.
         @remarks
             This function organise bone indexed matrices to blend indexed matrices,
@@ -820,6 +838,45 @@ namespace Ogre {
             const Affine3* const* blendMatrices, size_t numMatrices,
             bool blendNormals);
 
+        /// Raw data of a software vertex blend, as passed to OptimisedUtil::softwareVertexSkinning
+        struct SoftwareVertexBlendData
+        {
+            const float* srcPos;
+            float* destPos;
+            const float* srcNorm;
+            float* destNorm;
+            const float* blendWeight;
+            const unsigned char* blendIndex;
+            size_t srcPosStride;
+            size_t destPosStride;
+            size_t srcNormStride;
+            size_t destNormStride;
+            size_t blendWeightStride;
+            size_t blendIndexStride;
+            size_t numWeightsPerVertex;
+            size_t numVertices;
+        };
+
+        /// Locks a buffer for prepareSoftwareVertexBlend and returns a pointer to its data
+        typedef std::function<void*(const HardwareVertexBufferSharedPtr&, HardwareBuffer::LockOptions)>
+            BufferLockFunction;
+
+        /** Locks the buffers of a software vertex blend and resolves them to raw pointers.
+        @remarks
+            This is the first half of softwareVertexBlend, which allows to perform
+            the blend later on, e.g. on another thread. Each buffer is locked once
+            through lockFunc, which must keep it locked until the blend is done.
+        @param sourceVertexData, targetVertexData, blendNormals
+            See softwareVertexBlend.
+        @param lockFunc
+            Called to lock the buffers.
+        @param data
+            Receives the pointers, strides and counts.
+        */
+        static void prepareSoftwareVertexBlend(const VertexData* sourceVertexData,
+            const VertexData* targetVertexData, bool blendNormals,
+            const BufferLockFunction& lockFunc, SoftwareVertexBlendData& data);
+
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
         @remarks
@@ -204,6 +204,120 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Test axis aligned boxes against a set of planes, e.g. the planes of a frustum.
+        @remarks
+            A box is considered visible unless it lies entirely on the negative
+            side of at least one of the planes, which is the same test as
+            Frustum::isVisible performs for a single box.
+        @param planes The planes to test against, stored as (normal.x, normal.y,
+            normal.z, d). No alignment requirement.
+        @param numPlanes Number of planes, at most 6.
+        @param centres Box centres in SoA layout: the x components of all boxes,
+            followed by the y components at offset stride and the z components at
+            offset 2 * stride. No alignment requirement.
+        @param halfSizes Box half sizes, in the same layout as the centres.
+        @param stride Offset in floats between the x, y and z arrays.
+        @param visibilities An array of flags to store the results, the flag is
+            true if the corresponding box is visible, false otherwise.
+        @param numBoxes Number of boxes to test.
+        */
+        virtual void calculateBoxVisibility(
+            const Vector4* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            size_t stride,
+            char* visibilities,
+            size_t numBoxes) = 0;
+
+        /** Combine local node transforms with the derived transforms of their parents.
+        @remarks
+            This performs the calculation of Node::_updateFromParent for a batch of
+            nodes at once. Shear is never inherited, as in builds without
+            OGRE_NODE_INHERIT_TRANSFORM.
+        @param local Local transforms in SoA layout: the position x, y, z, scale
+            x, y, z and orientation w, x, y, z components of all nodes, each array
+            starting stride floats after the previous one. No alignment requirement.
+        @param derived Derived transforms, in the same layout as local. The parent
+            transforms are read from and the results are written to this buffer.
+        @param stride Offset in floats between the component arrays.
+        @param parents Index of the parent of each node.
+        @param inherit Per node flags, bit 0 is set if the node inherits the
+            orientation and bit 1 if it inherits the scale of its parent.
+        @param indices Indices of the nodes to update, none of them may be the
+            parent of another one.
+        @param numNodes Number of nodes to update.
+        */
+        virtual void calculateDerivedTransforms(
+            const float* local,
+            float* derived,
+            size_t stride,
+            const uint32* parents,
+            const uchar* inherit,
+            const uint32* indices,
+            size_t numNodes) = 0;
+
+        /** Convert half precision floats to single precision floats.
+        @remarks
+            The results are identical to those of Bitwise::halfToFloat.
+        @param src The half floats, no alignment requirement.
+        @param dst The floats, no alignment requirement.
+        @param count Number of values to convert.
+        */
+        virtual void convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count) = 0;
+
+        /** Convert single precision floats to half precision floats.
+        @remarks
+            The results are identical to those of Bitwise::floatToHalf, which
+            truncates the mantissa.
+        @param src The floats, no alignment requirement.
+        @param dst The half floats, no alignment requirement.
+        @param count Number of values to convert.
+        */
+        virtual void convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count) = 0;
+
+        /** Convert normalised unsigned bytes to floats in [0, 1].
+        @remarks
+            The results are identical to those of Bitwise::fixedToFloat(value, 8).
+        @param src The bytes.
+        @param dst The floats, no alignment requirement.
+        @param count Number of values to convert.
+        */
+        virtual void convertUnormByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count) = 0;
+
+        /** Convert floats to normalised unsigned bytes, clamping them to [0, 1].
+        @remarks
+            The results are identical to those of Bitwise::floatToFixed(value, 8).
+        @param src The floats, no alignment requirement.
+        @param dst The bytes.
+        @param count Number of values to convert.
+        */
+        virtual void convertFloatToUnormByte(
+            const float* src,
+            uint8* dst,
+            size_t count) = 0;
+
+        /** Expand 3 byte pixels to 4 byte pixels with an opaque alpha.
+        @remarks
+            The bytes of each pixel keep their order, the fourth byte is set to 0xFF.
+        @param src The source pixels, 3 bytes each.
+        @param dst The destination pixels, 4 bytes each.
+        @param numPixels Number of pixels to convert.
+        */
+        virtual void expandRGB8ToRGBA8(
+            const uint8* src,
+            uint8* dst,
+            size_t numPixels) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #define __Particle_H__
 
 #include "OgrePrerequisites.h"
+#include "OgreColourValue.h"
+#include "OgreVector.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -138,6 +140,72 @@ namespace Ogre {
         /// Utility method to reset this particle
         void resetDimensions(void);
     };
+
+    /** The active particles of a ParticleSystem as a structure of arrays.
+    @remarks
+        Element i of every array belongs to the i-th active particle, so affectors
+        can update several particles at once with SIMD instructions. Only the
+        components the affectors of the system ask for are held, see
+        ParticleAffector::_getParticleArrayComponents.
+    @par
+        ParticleSystem copies the particles into the arrays before applying its
+        affectors and the motion of the frame, and copies the writable components
+        back into the Particle instances afterwards, so emitters, renderers and
+        other code keep working on Particle instances.
+    */
+    struct _OgreExport ParticleArrays
+    {
+        /// The components of the particles which can be held in arrays
+        enum Component
+        {
+            /// position, writable
+            PAC_POSITION = 0x1,
+            /// direction, writable
+            PAC_DIRECTION = 0x2,
+            /// colour, writable
+            PAC_COLOUR = 0x4,
+            /// timeToLive and totalTimeToLive, read only
+            PAC_TIME_TO_LIVE = 0x8,
+            /// rotation, writable, and rotationSpeed, read only
+            PAC_ROTATION = 0x10,
+            /// width, height and ownDimensions, writable
+            PAC_DIMENSIONS = 0x20
+        };
+
+        /// World position, x, y and z
+        std::vector<Real> position[3];
+        /// Direction (and speed), x, y and z
+        std::vector<Real> direction[3];
+        /// Colour, red, green, blue and alpha
+        std::vector<Real> colour[4];
+        std::vector<Real> timeToLive;
+        std::vector<Real> totalTimeToLive;
+        /// Rotation in radians
+        std::vector<Real> rotation;
+        /// Speed of rotation in radians/sec
+        std::vector<Real> rotationSpeed;
+        /// The own dimensions of the particle, or the default ones of the system if it has none
+        std::vector<Real> width;
+        std::vector<Real> height;
+        /// Whether the particle has own dimensions, 0 or 1
+        std::vector<uchar> ownDimensions;
+
+        /// The components held, a combination of Component values
+        uint32 components;
+
+        ParticleArrays() : components(0) {}
+
+        /// Hold the given components of count particles
+        void resize(size_t count, uint32 components);
+        /** Copy the held components of particles [begin, end) into the arrays.
+        @param particles The active particles of the system
+        @param defaultWidth,defaultHeight The default dimensions of the system
+        */
+        void gather(Particle* const* particles, size_t begin, size_t end, Real defaultWidth,
+                    Real defaultHeight);
+        /// Copy the held writable components of the arrays back into particles [begin, end)
+        void scatter(Particle* const* particles, size_t begin, size_t end) const;
+    };
     /** @} */
     /** @} */
 }
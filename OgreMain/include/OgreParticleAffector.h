@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreString.h"
 #include "OgreStringInterface.h"
+#include "OgreParticle.h"
 #include "OgreHeaderPrefix.h"
 
 
@@ -110,6 +111,37 @@ namespace Ogre {
         */
         virtual void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) = 0;
 
+        /** Returns the components of ParticleArrays this affector uses in _affectParticleArrays.
+        @remarks
+            0, the default, means that the affector does not implement _affectParticleArrays.
+            Only if all its affectors do, a ParticleSystem updates its particles in
+            structure of arrays form, holding the components all of them ask for.
+            Otherwise _affectParticles is called as usual.
+        @return A combination of ParticleArrays::Component values
+        */
+        virtual uint32 _getParticleArrayComponents(void) const { return 0; }
+
+        /** Applies the effect of this affector to a range of particles held in arrays.
+        @remarks
+            Must give the same results as _affectParticles for these particles. The system
+            processes its particles in blocks, and with parallel update enabled the blocks
+            are processed concurrently, so implementations must neither modify the state of
+            the affector nor anything but elements [begin, end) of the arrays.
+        @param
+            pSystem Pointer to the ParticleSystem owning the particles.
+        @param
+            timeElapsed The number of seconds which have elapsed since the last call.
+        @param
+            arrays The active particles, holding at least the components this affector asked for.
+        @param
+            begin,end The range of particles to affect.
+        */
+        virtual void _affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                           ParticleArrays& arrays, size_t begin, size_t end)
+        {
+            (void)pSystem; (void)timeElapsed; (void)arrays; (void)begin; (void)end;
+        }
+
         /** Returns the name of the type of affector. 
         @remarks
             This property is useful for determining the type of affector procedurally so another
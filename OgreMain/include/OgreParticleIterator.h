@@ -45,12 +45,12 @@ namespace Ogre {
     {
         friend class ParticleSystem;
     protected:
-        std::list<Particle*>::iterator mPos;
-        std::list<Particle*>::iterator mStart;
-        std::list<Particle*>::iterator mEnd;
+        std::vector<Particle*>::iterator mPos;
+        std::vector<Particle*>::iterator mStart;
+        std::vector<Particle*>::iterator mEnd;
 
         /// Protected constructor, only available from ParticleSystem::getIterator
-        ParticleIterator(std::list<Particle*>::iterator start, std::list<Particle*>::iterator end);
+        ParticleIterator(std::vector<Particle*>::iterator start, std::vector<Particle*>::iterator end);
 
     public:
         /// Returns true when at the end of the particle list
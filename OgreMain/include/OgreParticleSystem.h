@@ -32,6 +32,7 @@ THE SOFTWARE.
 
 #include "OgreVector.h"
 #include "OgreParticleIterator.h"
+#include "OgreParticle.h"
 #include "OgreStringInterface.h"
 #include "OgreMovableObject.h"
 #include "OgreRadixSort.h"
@@ -353,7 +354,7 @@ namespace Ogre {
             this is the easiest way to step through all the particles in a system and apply the
             changes the affector wants to make.
         */
-        const std::list<Particle*>& _getActiveParticles() { return mActiveParticles; }
+        const std::vector<Particle*>& _getActiveParticles() { return mActiveParticles; }
 
         /// @deprecated use _getActiveParticles()
         OGRE_DEPRECATED ParticleIterator _getIterator(void);
@@ -585,6 +586,22 @@ namespace Ogre {
         */
         bool getKeepParticlesInLocalSpace(void) const { return mLocalSpace; }
 
+        /** Enables updating the active particles across the threads of the WorkQueue.
+        @remarks
+            If every affector of the system supports particles in structure of arrays
+            form (see ParticleAffector::_getParticleArrayComponents), the particles are
+            updated in blocks which get all affectors and the motion of the frame applied
+            in turn. With this enabled the blocks are processed on the worker threads
+            (see WorkQueue::parallelFor). Expiry, emission and the renderer notifications
+            still happen on the calling thread.
+        @par
+            Otherwise the system is updated serially as usual. It pays off for systems
+            with tens of thousands of particles.
+        */
+        void setParallelUpdateEnabled(bool enabled) { mParallelUpdate = enabled; }
+        /// Returns whether the particles are updated in parallel
+        bool getParallelUpdateEnabled(void) const { return mParallelUpdate; }
+
         /** Internal method for updating the bounds of the particle system.
         @remarks
             This is called automatically for a period of time after the system's
@@ -677,8 +694,8 @@ namespace Ogre {
         /// Used to control if the particle system should emit particles or not.
         bool mIsEmitting;
 
-        typedef std::list<Particle*> ActiveParticleList;
-        typedef std::list<Particle*> FreeParticleList;
+        typedef std::vector<Particle*> ActiveParticleList;
+        typedef std::vector<Particle*> FreeParticleList;
         typedef std::vector<Particle*> ParticlePool;
 
         /** Sort by direction functor */
@@ -705,32 +722,42 @@ namespace Ogre {
 
         /** Active particle list.
             @remarks
-                This is a linked list of pointers to particles in the particle pool.
+                This is a contiguous array of pointers to particles in the particle pool,
+                in emission order. Expired particles are removed by compacting the array
+                in a single pass, so affectors can walk it linearly or in disjoint ranges.
             @par
-                This allows very fast insertions and deletions from anywhere in 
-                the list to activate / deactivate particles as well as reuse of 
-                Particle instances in the pool without construction & destruction 
+                Particle instances in the pool are reused without construction & destruction
                 which avoids memory thrashing.
         */
         ActiveParticleList mActiveParticles;
 
-        /** Free particle queue.
+        /** Free particle stack.
             @remarks
-                This contains a list of the particles free for use as new instances
+                This contains the particles free for use as new instances
                 as required by the set. Particle instances are preconstructed up 
                 to the estimated size in the mParticlePool vector and are 
-                referenced on this deque at startup. As they get used this list
-                reduces, as they get released back to to the set they get added
-                back to the list.
+                referenced on this stack at startup. As they get used it
+                reduces, as they get released back to to the set they get pushed
+                back onto it.
         */
         FreeParticleList mFreeParticles;
 
         /** Pool of particle instances for use and reuse in the active particle list.
             @remarks
                 This vector will be preallocated with the estimated size of the set,and will extend as required.
+                The instances themselves are allocated in blocks, see mParticleBlocks.
         */
         ParticlePool mParticlePool;
 
+        /// Arrays holding the Particle instances referenced by mParticlePool
+        std::vector<Particle*> mParticleBlocks;
+
+        /// The active particles as arrays, while the affectors are applied
+        ParticleArrays mParticleArrays;
+
+        /// Whether affectors and motion are applied in parallel, see setParallelUpdateEnabled
+        bool mParallelUpdate;
+
         typedef std::list<ParticleEmitter*> FreeEmittedEmitterList;
         typedef std::list<ParticleEmitter*> ActiveEmittedEmitterList;
         typedef std::vector<ParticleEmitter*> EmittedEmitterList;
@@ -807,6 +834,12 @@ namespace Ogre {
         /** Applies the effects of affectors. */
         void _triggerAffectors(Real timeElapsed);
 
+        /** Applies the affectors and motion to the active particles in structure of arrays
+            form, across the WorkQueue if enabled, see setParallelUpdateEnabled.
+            @return false if the affectors do not allow it, nothing is done then
+        */
+        bool _updateParticleArrays(Real timeElapsed);
+
         /** Sort the particles in the system **/
         void _sortParticles(Camera* cam);
 
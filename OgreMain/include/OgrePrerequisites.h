@@ -88,6 +88,7 @@ namespace Ogre {
     class BillboardChain;
     class BillboardSet;
     class Bone;
+    class BoundingVolumeHierarchy;
     class Camera;
     class Codec;
     class ColourValue;
@@ -166,6 +167,7 @@ namespace Ogre {
     class Particle;
     class ParticleAffector;
     class ParticleAffectorFactory;
+    struct ParticleArrays;
     class ParticleEmitter;
     class ParticleEmitterFactory;
     class ParticleSystem;
@@ -238,6 +240,7 @@ namespace Ogre {
     class StringInterface;
     class SubEntity;
     class SubMesh;
+    class SweepAndPrune;
     class TagPoint;
     class Technique;
     class TempBlendedBufferInfo;
@@ -247,6 +250,7 @@ namespace Ogre {
     class TextureManager;
     class TransformKeyFrame;
     class Timer;
+    class TriangleBVH;
     class UserObjectBindings;
     template <int dims, typename T> class Vector;
     typedef Vector<2, Real> Vector2;
@@ -139,6 +139,7 @@ namespace Ogre {
         bool mSplitPassesByLightingType;
         bool mSplitNoShadowPasses;
         bool mShadowCastersCannotBeReceivers;
+        bool mSortKeys;
 
         RenderableListener* mRenderableListener;
     public:
@@ -274,6 +275,21 @@ namespace Ogre {
         */
         bool getShadowCastersCannotBeReceivers(void) const;
 
+        /** Sets whether the queued renderables are ordered by precomputed sort keys.
+        @remarks
+            Instead of grouping by pass in a map and depth sorting with two radix
+            sorts, each renderable / pass pair is kept in a flat list with a 64 bit
+            key that a single sort orders by. The queue group and priority are given
+            by the collection the pair is queued in. If the same pairs are queued
+            again, as is typical for mostly static scenes, the previous order is
+            reused instead of being rebuilt.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
+        /** Gets whether the queued renderables are ordered by precomputed sort keys. */
+        bool getSortKeysEnabled(void) const;
+
         /** Set a renderable listener on the queue.
         @remarks
             There can only be a single renderable listener on the queue, since
@@ -219,6 +219,29 @@ namespace Ogre {
         /// Radix sorter for sort value 2 (distance)
         static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
 
+        /// Renderable / pass pair with its packed sort key, see setSortKeysEnabled
+        struct KeyedRenderablePass
+        {
+            uint64 key;
+            RenderablePass rp;
+
+            KeyedRenderablePass(uint64 k, const RenderablePass& p) : key(k), rp(p) {}
+            bool operator<(const KeyedRenderablePass& rhs) const { return key < rhs.key; }
+        };
+        typedef std::vector<KeyedRenderablePass> KeyedRenderablePassList;
+
+        /// Functor for accessing the sort key for radix sort
+        struct RadixSortFunctorKey
+        {
+            uint64 operator()(const KeyedRenderablePass& p) const
+            {
+                return p.key;
+            }
+        };
+
+        /// Radix sorter for the sort key
+        static RadixSort<KeyedRenderablePassList, KeyedRenderablePass, uint64> msRadixSorterKey;
+
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
 
@@ -227,12 +250,32 @@ namespace Ogre {
         /// Sorted descending (can iterate backwards to get ascending)
         RenderablePassList mSortedDescending;
 
+        /// Whether the flat, sort key based organisation is used
+        bool mUseSortKeys;
+        /// Pairs added since the last clear, in order of addition (sort key mode)
+        RenderablePassList mAdded;
+        /// mAdded as of the last sort, the keyed lists are up to date for these
+        RenderablePassList mSortedAdded;
+        /// Ordered by pass hash, then pass (sort key mode)
+        KeyedRenderablePassList mKeyedGrouped;
+        /// Ordered by descending depth, then pass hash (sort key mode)
+        KeyedRenderablePassList mKeyedDescending;
+        /// Renderables of the pass group currently visited (sort key mode)
+        mutable RenderableList mVisitedGroup;
+
+        /// Internal method for sorting in sort key mode
+        void sortKeyed(const Camera* cam);
+        /// Internal method, stable sort of a keyed list
+        static void sortByKey(KeyedRenderablePassList& list);
+
         /// Internal visitor implementation
         void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
         void acceptVisitorDescending(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
         void acceptVisitorAscending(QueuedRenderableVisitor* visitor) const;
+        /// Internal visitor implementation
+        void acceptVisitorKeyedGrouped(QueuedRenderableVisitor* visitor) const;
 
     public:
         QueuedRenderableCollection();
@@ -267,6 +310,24 @@ namespace Ogre {
             mOrganisationMode |= uint8(om);
         }
 
+        /** Sets whether the collection is kept in flat lists ordered by a packed sort key.
+        @remarks
+            In this mode every renderable / pass pair gets a 64 bit key; the pass hash
+            and pass for grouping, the view depth and the pass hash for depth
+            sorting. A single sort of the key replaces the pass map and the two radix
+            sorts. The pairs added are remembered, so if the same ones are added again,
+            e.g. for a static scene, the grouped order is reused as is and the
+            depth order of the last sort is only checked and fixed up.
+        @par
+            You can only do this when the collection is empty.
+        */
+        void setSortKeysEnabled(bool enabled)
+        {
+            mUseSortKeys = enabled;
+        }
+        /// Gets whether the collection is ordered by sort keys
+        bool getSortKeysEnabled(void) const { return mUseSortKeys; }
+
         /// Add a renderable to the collection using a given pass
         void addRenderable(Pass* pass, Renderable* rend);
         
@@ -434,6 +495,11 @@ namespace Ogre {
             mShadowCastersNotReceivers = ind;
         }
 
+        /** Sets whether the collections are ordered by sort keys.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
         /** Merge group of renderables. 
         */
         void merge( const RenderPriorityGroup* rhs );
@@ -460,6 +526,7 @@ namespace Ogre {
         bool mSplitPassesByLightingType;
         bool mSplitNoShadowPasses;
         bool mShadowCastersNotReceivers;
+        bool mSortKeys;
         /// Map of RenderPriorityGroup objects
         PriorityMap mPriorityGroups;
         /// Whether shadows are enabled for this queue
@@ -477,6 +544,7 @@ namespace Ogre {
             , mSplitPassesByLightingType(splitPassesByLightingType)
             , mSplitNoShadowPasses(splitNoShadowPasses)
             , mShadowCastersNotReceivers(shadowCastersNotReceivers)
+            , mSortKeys(false)
             , mShadowsEnabled(true)
             , mOrganisationMode(0)
         {
@@ -521,6 +589,8 @@ namespace Ogre {
                     pPriorityGrp->resetOrganisationModes();
                     pPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                 }
+                if (mSortKeys)
+                    pPriorityGrp->setSortKeysEnabled(true);
 
                 mPriorityGroups.emplace(priority, pPriorityGrp);
             }
@@ -615,6 +685,25 @@ namespace Ogre {
                 i->second->setShadowCastersCannotBeReceivers(ind);
             }
         }
+        /** Sets whether the collections of this group are ordered by sort keys.
+        @remarks
+            You can only do this when the group is empty, ie after clearing the 
+            queue.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled)
+        {
+            mSortKeys = enabled;
+            PriorityMap::iterator i, iend;
+            iend = mPriorityGroups.end();
+            for (i = mPriorityGroups.begin(); i != iend; ++i)
+            {
+                i->second->setSortKeysEnabled(enabled);
+            }
+        }
+        /// Gets whether the collections of this group are ordered by sort keys
+        bool getSortKeysEnabled(void) const { return mSortKeys; }
+
         /** Reset the organisation modes required for the solids in this group. 
         @remarks
             You can only do this when the group is empty, ie after clearing the 
@@ -695,6 +784,8 @@ namespace Ogre {
                         pDstPriorityGrp->resetOrganisationModes();
                         pDstPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                     }
+                    if (mSortKeys)
+                        pDstPriorityGrp->setSortKeysEnabled(true);
 
                     mPriorityGroups.emplace(priority, pDstPriorityGrp);
                 }
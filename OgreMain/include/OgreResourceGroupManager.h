@@ -419,6 +419,13 @@ namespace Ogre {
 
         /// Stored current group - optimisation for when bulk loading a group
         ResourceGroup* mCurrentGroup;
+
+        /// Whether loadResourceGroup prepares resources in parallel
+        bool mParallelLoading;
+
+        /** Prepares the resources of a group on the threads of the WorkQueue,
+            see setParallelLoadingEnabled. Internal use only */
+        void prepareResourcesParallel(const String& name, ResourceGroup* grp);
     public:
         ResourceGroupManager();
         virtual ~ResourceGroupManager();
@@ -493,6 +500,30 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
             bool loadWorldGeom = true);
 
+        /** Enables preparing resources in parallel in loadResourceGroup.
+
+            Before the resources are loaded one after the other, the CPU side work
+            of Resource::prepare - reading files, decoding images, parsing skeletons -
+            is done for all of them across the threads of the WorkQueue (see
+            WorkQueue::parallelFor). The textures of the materials in the group are
+            prepared as well, so loading the materials only has to upload them.
+            The load step itself, which may touch the RenderSystem, is still done
+            in order on the calling thread.
+
+            Progress is reported through ResourceGroupListener::resourcePrepareStarted
+            and resourcePrepareEnded from the calling thread, in batches as the
+            resources are done. Materials and manually loaded resources are not
+            prepared in parallel. Failures are ignored in this step and reported
+            when the resource is loaded.
+        @note
+            Resource::prepareImpl of the involved resources must not create further
+            resources, as the ResourceManagers are not synchronised unless
+            OGRE_THREAD_SUPPORT is 1 or 2.
+        */
+        void setParallelLoadingEnabled(bool enabled) { mParallelLoading = enabled; }
+        /// Returns whether resources are prepared in parallel by loadResourceGroup
+        bool getParallelLoadingEnabled() const { return mParallelLoading; }
+
         /** Unloads a resource group.
 
             This method unloads all the resources that have been declared as
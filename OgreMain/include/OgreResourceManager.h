@@ -315,6 +315,12 @@ namespace Ogre {
         virtual void removeUnreferencedResources(bool reloadableOnly = true);
 
         /** Retrieves a pointer to a resource by name, or null if the resource does not exist.
+        @remarks
+            Lookups by name or handle do not take the manager wide mutex but only the one
+            of the shard of the lookup index the name hashes to, so worker threads looking
+            up resources concurrently rarely block each other or the thread creating them.
+            The mutex of the ResourceGroupManager is only taken if the group holds no
+            resource of this name.
         */
         virtual ResourcePtr getResourceByName(const String& name, const String& groupName OGRE_RESOURCE_GROUP_INIT);
 
@@ -496,6 +502,40 @@ namespace Ogre {
         */
         void checkUsage(void);
 
+    private:
+        /// Number of shards of the lookup index, a power of two
+        enum { NUM_LOOKUP_SHARDS = 16 };
+
+        /// Weak references, so use_count() is the same as without the index
+        struct ResourceLookupEntry
+        {
+            std::weak_ptr<Resource> resource;
+            /// Group the resource was added to
+            String group;
+            /// Whether the group is in the global pool, kept so lookups need not ask the
+            /// ResourceGroupManager and take its mutex
+            bool inGlobalPool;
+        };
+
+        /** Part of the lookup index mirroring mResources, mResourcesWithGroup and
+            mResourcesByHandle for the names and handles hashing to it.
+        */
+        struct ResourceLookupShard
+        {
+            OGRE_MUTEX(mutex);
+            /// Entries of all pools, keyed by the FastHash of the resource name
+            std::unordered_multimap<uint32, ResourceLookupEntry> byName;
+            std::unordered_map<ResourceHandle, std::weak_ptr<Resource> > byHandle;
+        };
+        ResourceLookupShard mLookupShards[NUM_LOOKUP_SHARDS];
+
+        ResourceLookupShard& getLookupShard(uint32 hash)
+        {
+            return mLookupShards[hash & (NUM_LOOKUP_SHARDS - 1)];
+        }
+        void addToLookup(const ResourcePtr& res, bool inGlobalPool);
+        void removeFromLookup(const ResourcePtr& res);
+        void clearLookup(void);
 
     public:
         typedef std::unordered_map< String, ResourcePtr > ResourceMap;
@@ -212,10 +212,13 @@ namespace Ogre
             Defaults to "ogre.cfg", may be left blank to load nothing.
         @param logFileName The logfile to create, defaults to Ogre.log, may be 
             left blank if you've already set up LogManager & Log yourself
+        @param workQueue The WorkQueue to use, e.g. a WorkStealingWorkQueue. Root
+            takes ownership of it. If NULL, a DefaultWorkQueue is created.
         */
         Root(const String& pluginFileName = "plugins.cfg",
             const String& configFileName = "ogre.cfg", 
-            const String& logFileName = "Ogre.log");
+            const String& logFileName = "Ogre.log",
+            WorkQueue* workQueue = NULL);
         ~Root();
 
         /** Saves the details of the current configuration
@@ -47,6 +47,8 @@ Torus Knot Software Ltd.
 #include "OgreManualObject.h"
 #include "OgreRenderSystem.h"
 #include "OgreLodListener.h"
+#include "OgreBoundingVolumeHierarchy.h"
+#include "OgreSweepAndPrune.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreNameGenerator.h"
 
@@ -232,6 +234,34 @@ namespace Ogre {
             Real skyBoxDistance;
         };
 
+        /// The world bounds of the movable objects of the scene, for spatial queries
+        struct MovableObjectBounds
+        {
+            /// objects with finite bounds
+            std::vector<MovableObject*> objects;
+            std::vector<AxisAlignedBox> boxes;
+            /// objects with null or infinite bounds
+            std::vector<MovableObject*> others;
+            /// the state of the scene the bounds were taken from
+            size_t changeCount, moveCount;
+
+            MovableObjectBounds() : changeCount(~size_t(0)), moveCount(~size_t(0)) {}
+        };
+
+        /// The movable objects of the scene in a hierarchy over their world bounds
+        struct MovableObjectBVH : public MovableObjectBounds
+        {
+            /// over objects, the others are not part of the hierarchy
+            BoundingVolumeHierarchy bvh;
+        };
+
+        /// The movable objects of the scene sorted by their world bounds
+        struct MovableObjectBroadphase : public MovableObjectBounds
+        {
+            /// over objects, the others are not sorted
+            SweepAndPrune sweepAndPrune;
+        };
+
         /** Class that allows listening in on the various stages of SceneManager
             processing, so that custom behaviour can be implemented from outside.
         */
@@ -685,6 +715,30 @@ namespace Ogre {
             bool mShadowTextureSelfShadow;
             bool mShadowTextureConfigDirty;
             bool mShadowCasterRenderBackFaces;
+            bool mParallelShadowCasterCulling;
+            bool mShadowCasterCullingCache;
+            bool mShadowVolumeCache;
+
+            /// how to render the shadow volume of a caster
+            struct ShadowVolumeSettings
+            {
+                unsigned long flags;
+                Real extrudeDist;
+                bool zfailAlgo;
+            };
+            std::vector<ShadowVolumeSettings> mShadowVolumeSettings;
+
+            /// shadow textures whose update is deferred, see setParallelShadowCasterCullingEnabled
+            struct PendingShadowTarget
+            {
+                Light* light;
+                RenderTarget* target;
+                Camera* camera;
+            };
+            std::vector<PendingShadowTarget> mPendingShadowTargets;
+            std::vector<Camera*> mPendingShadowCameras;
+            /// Culls the scene for all pending shadow textures at once and updates them
+            void updatePendingShadowTargets();
 
             ShadowTextureConfigList mShadowTextureConfigList;
 
@@ -854,6 +908,120 @@ namespace Ogre {
         bool mDisplayNodes;
         std::unique_ptr<DebugDrawer> mDebugDrawer;
 
+        /// Whether _findVisibleObjects uses the flat, parallel culling path
+        bool mParallelCulling;
+        /// Scratch storage of the parallel culling path, kept to avoid reallocations
+        struct CullingData
+        {
+            /// all scene nodes, in the order of the recursive traversal
+            std::vector<SceneNode*> nodes;
+            /// traversal stack
+            std::vector<Node*> stack;
+            /// SoA world bounds: centres x, y, z followed by half sizes x, y, z
+            std::vector<float> boxes;
+            /// per node visibility flags
+            std::vector<char> visibilities;
+            /// indices of the nodes not drawn by the debug drawer yet, see queueVisibleNodes
+            std::vector<size_t> pendingDebugNodes;
+        };
+        CullingData mCullingData;
+
+        /// Chunk size of the parallel culling path, a multiple of the SIMD width
+        static const size_t CULLING_GRAIN_SIZE = 1024;
+
+        /// Culling results of a single camera, see _precomputeCulling
+        struct CameraCulling
+        {
+            const Camera* camera;
+            Vector4 planes[6];
+            size_t numPlanes;
+            std::vector<char> visibilities;
+
+            CameraCulling() : camera(0), numPlanes(0) {}
+        };
+        /// Culling results used by _findVisibleObjects instead of culling again
+        struct PrecomputedCulling
+        {
+            /// the nodes and boxes the results were computed for
+            std::vector<SceneNode*> nodes;
+            std::vector<float> boxes;
+            /// only the first numCameras entries are active
+            std::vector<CameraCulling> cameras;
+            size_t numCameras;
+
+            PrecomputedCulling() : numCameras(0) {}
+        };
+        PrecomputedCulling mPrecomputedCulling;
+
+        /// Parallel implementation of _findVisibleObjects, see setParallelCullingEnabled
+        void findVisibleObjectsParallel(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+                                        bool onlyShadowCasters);
+        /// Stores the culling planes of the camera in planes and returns their count
+        static size_t getCullingPlanes(const Camera* cam, Vector4* planes);
+        /** Flattens the scene graph and gathers the world bounds into mCullingData.
+            Also culls them against the given planes, if any. */
+        void gatherCullingBoxes(const Vector4* planes, size_t numPlanes);
+        /// Culls the range [begin, end) of the gathered boxes against the given planes
+        void cullBoxes(const Vector4* planes, size_t numPlanes, char* visibilities, size_t begin,
+                       size_t end) const;
+        /// Passes the objects attached to the visible nodes to the RenderQueue
+        void queueVisibleNodes(Camera* cam, const std::vector<SceneNode*>& nodes, const char* visibilities,
+                               VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
+
+        /// Whether _updateSceneGraph uses the flattened hierarchy, see setFlatTransformUpdateEnabled
+        bool mFlatTransformUpdate;
+        /// Set when nodes were attached to or detached from the scene graph
+        bool mSceneGraphChanged;
+        /// The scene graph sorted by depth, as used by the flat transform update
+        struct TransformHierarchy
+        {
+            /// all scene nodes, breadth first
+            std::vector<SceneNode*> nodes;
+            /// index of the parent of each node
+            std::vector<uint32> parents;
+            /// index of the first node of each depth level, followed by the node count
+            std::vector<size_t> levels;
+            /// per node inheritance flags, see OptimisedUtil::calculateDerivedTransforms
+            std::vector<uchar> inherit;
+            /// per node update state of the current sweep
+            std::vector<uchar> states;
+            /// nodes whose transform is recomputed, sorted by depth
+            std::vector<uint32> dirty;
+            /// index of the first dirty node of each depth level, followed by the dirty count
+            std::vector<size_t> dirtyLevels;
+            /// local and derived transforms in SoA layout
+            std::vector<float> local, derived;
+        };
+        TransformHierarchy mTransformHierarchy;
+
+        /// Flat implementation of _updateSceneGraph, see setFlatTransformUpdateEnabled
+        void updateSceneGraphFlat();
+
+        /// Whether software vertex blends are collected and performed in parallel
+        bool mParallelSoftwareAnimation;
+        /// Software vertex blends collected during _findVisibleObjects
+        struct SoftwareBlendBatch;
+        std::unique_ptr<SoftwareBlendBatch> mSoftwareBlendBatch;
+
+        /// Performs and unlocks the collected software vertex blends
+        void applySoftwareVertexBlends();
+
+        /// Whether the default RaySceneQuery uses mMovableObjectBVH
+        bool mRaySceneQueryBVH;
+        MovableObjectBVH mMovableObjectBVH;
+        /// Whether the default IntersectionSceneQuery uses mMovableObjectBroadphase
+        bool mIntersectionSceneQueryBroadphase;
+        MovableObjectBroadphase mMovableObjectBroadphase;
+        /// Incremented when movable objects are created or destroyed
+        size_t mMovableObjectsChangeCount;
+        /// Incremented when the scene graph is updated
+        size_t mMovableObjectsMoveCount;
+
+        /** Updates the bounds unless they are up to date.
+        @return whether the set of objects changed, rather than only their bounds
+        */
+        bool updateMovableObjectBounds(MovableObjectBounds& bounds);
+
         /// Storage of animations, lookup by name
         AnimationList mAnimationsList;
         OGRE_MUTEX(mAnimationsListMutex);
@@ -1074,6 +1242,8 @@ namespace Ogre {
         uint32 mLastLightHash;
         /// Gpu params that need rebinding (mask of GpuParamVariability)
         uint16 mGpuParamsDirty;
+        /// Whether unchanged per object and light params are not uploaded again
+        bool mGpuParamDeduplication;
 
         void useLights(const LightList* lights, ushort limit);
         void bindGpuProgram(GpuProgram* prog);
@@ -1423,6 +1593,126 @@ namespace Ogre {
         /** Allows all bounding boxes of scene nodes to be displayed. */
         void showBoundingBoxes(bool bShow);
 
+        /** Enables the parallel culling path of the default _findVisibleObjects implementation.
+        @remarks
+            Instead of recursing through the scene graph, the world bounds of all
+            SceneNodes are gathered into flat arrays, which are tested against the
+            camera frustum several boxes at a time using SIMD, split across the
+            threads of the WorkQueue (see WorkQueue::parallelFor). The visible objects
+            are then passed to the RenderQueue on the calling thread, in the same
+            order as the recursive traversal would.
+        @par
+            This pays off for scenes with many thousands of nodes. Only the culling
+            planes of the camera are used, so Camera subclasses overriding isVisible
+            are not taken into account. SceneManagers with their own
+            _findVisibleObjects implementation are not affected.
+        */
+        void setParallelCullingEnabled(bool enabled) { mParallelCulling = enabled; }
+        /// Returns whether the parallel culling path is used
+        bool getParallelCullingEnabled() const { return mParallelCulling; }
+
+        /** Enables the flat transform update path of the default _updateSceneGraph implementation.
+        @remarks
+            The scene graph is kept sorted by depth in contiguous arrays, holding
+            the local and derived transforms of all SceneNodes. Each frame the
+            dirty nodes are found in a single linear pass and their derived
+            transforms are recomputed level by level, several nodes at a time
+            using SIMD and split across the threads of the WorkQueue. Bounds are
+            then updated from the deepest level upwards.
+        @par
+            The results are the same as those of the recursive Node::_update.
+            SceneNode subclasses which override _update or updateFromParentImpl
+            are not supported. Builds with OGRE_NODE_INHERIT_TRANSFORM or double
+            precision fall back to updating the dirty nodes one by one.
+        */
+        void setFlatTransformUpdateEnabled(bool enabled) { mFlatTransformUpdate = enabled; }
+        /// Returns whether the flat transform update path is used
+        bool getFlatTransformUpdateEnabled() const { return mFlatTransformUpdate; }
+        /// Internal method, notifies that the structure of the scene graph has changed
+        void _notifySceneGraphChanged() { mSceneGraphChanged = true; }
+
+        /** Enables batched, parallel software skinning of Entities.
+        @remarks
+            Entities using software skinning, or needing it for stencil shadows,
+            normally blend their vertices one after the other while they are
+            added to the render queue. With this enabled, the blends are only
+            collected during _findVisibleObjects, locking their buffers on the
+            calling thread. They are then performed all at once, split into
+            ranges of vertices across the threads of the WorkQueue, before the
+            buffers are unlocked again.
+        @par
+            This pays off for many software animated Entities, e.g. crowds or
+            servers rendering without a GPU. Entities with morph or pose animation
+            are batched as well, but their vertex animation is applied beforehand
+            and completes any collected blends which use the same buffers.
+        */
+        void setParallelSoftwareAnimationEnabled(bool enabled) { mParallelSoftwareAnimation = enabled; }
+        /// Returns whether software skinning of Entities is batched
+        bool getParallelSoftwareAnimationEnabled() const { return mParallelSoftwareAnimation; }
+
+        /** Internal method, starts collecting software vertex blends.
+        @see setParallelSoftwareAnimationEnabled
+        */
+        void _beginSoftwareVertexBlends();
+        /** Internal method, queues a software vertex blend until _endSoftwareVertexBlends.
+        @remarks
+            The arguments are the same as those of Mesh::softwareVertexBlend. The
+            blend matrices are copied, the matrices themselves must stay unchanged
+            until the blend is performed.
+        @return
+            false if no blends are being collected, the caller has to perform
+            the blend itself then
+        */
+        bool _queueSoftwareVertexBlend(const VertexData* sourceVertexData,
+            const VertexData* targetVertexData, const Affine3* const* blendMatrices,
+            size_t numMatrices, bool blendNormals);
+        /// Internal method, performs the software vertex blends collected since _beginSoftwareVertexBlends
+        void _endSoftwareVertexBlends();
+        /** Internal method, performs the collected software vertex blends right away
+            if they use any buffer of the given vertex data.
+        @remarks
+            Their buffers stay locked until the blends are done, so this must be called
+            before locking such a buffer otherwise, e.g. for vertex animation.
+        */
+        void _flushSoftwareVertexBlends(const VertexData* vertexData);
+
+        /** Makes the default RaySceneQuery find movable objects through a bounding volume hierarchy.
+        @remarks
+            Otherwise the ray is tested against the bounds of every movable object. The
+            hierarchy is updated when the next query runs after the scene graph was updated,
+            by refitting it to the new bounds or by rebuilding it if objects were created or
+            destroyed. This pays off for many queries per frame and large scenes.
+        @par
+            The results are the same, but unless they are sorted by distance they may be
+            returned in a different order.
+        */
+        void setRaySceneQueryBVHEnabled(bool enabled) { mRaySceneQueryBVH = enabled; }
+        /// Returns whether the default RaySceneQuery uses a bounding volume hierarchy
+        bool getRaySceneQueryBVHEnabled() const { return mRaySceneQueryBVH; }
+
+        /** Internal method, returns the hierarchy used by the default RaySceneQuery.
+        @see setRaySceneQueryBVHEnabled
+        */
+        const MovableObjectBVH& _getMovableObjectBVH();
+
+        /** Makes the default IntersectionSceneQuery find overlapping movable objects by sort and sweep.
+        @remarks
+            Otherwise every movable object is compared with every other. The movable objects are
+            kept sorted by their bounds along one axis across queries. When the next query runs
+            after the scene graph was updated, the objects which moved are sorted into their new
+            place, or all objects are sorted again if objects were created or destroyed.
+        @par
+            The same pairs are found, but in a different order.
+        */
+        void setIntersectionSceneQueryBroadphaseEnabled(bool enabled) { mIntersectionSceneQueryBroadphase = enabled; }
+        /// Returns whether the default IntersectionSceneQuery uses sort and sweep
+        bool getIntersectionSceneQueryBroadphaseEnabled() const { return mIntersectionSceneQueryBroadphase; }
+
+        /** Internal method, returns the sorted objects used by the default IntersectionSceneQuery.
+        @see setIntersectionSceneQueryBroadphaseEnabled
+        */
+        const MovableObjectBroadphase& _getMovableObjectBroadphase();
+
         /** Returns if all bounding boxes of scene nodes are to be displayed */
         bool getShowBoundingBoxes() const;
 
@@ -1900,6 +2190,21 @@ namespace Ogre {
         */
         virtual void _findVisibleObjects(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
 
+        /** Internal method which culls the scene for several cameras at once.
+            @remarks
+                Until _clearPrecomputedCulling is called, the default _findVisibleObjects
+                uses these results for the given cameras instead of culling again.
+                The cameras are processed in parallel using the WorkQueue.
+            @param cameras the cameras to cull for
+            @param count the number of cameras
+            @param reuseUnchanged reuse the results of the previous call for cameras
+                whose frustum did not change, provided no SceneNode bounds changed either
+            @return the number of cameras the scene was actually culled for
+        */
+        size_t _precomputeCulling(Camera* const* cameras, size_t count, bool reuseUnchanged = false);
+        /// Stops using the results of _precomputeCulling
+        void _clearPrecomputedCulling();
+
         /** Internal method for issuing the render operation.*/
         void _issueRenderOp(Renderable* rend, const Pass* pass);
 
@@ -2851,6 +3156,53 @@ namespace Ogre {
         planes should be used to restrict light rendering.
         */
         bool getShadowUseLightClipPlanes() const { return mShadowRenderer.mShadowAdditiveLightClip; }
+
+        /** Sets whether the shadow casters of all shadow textures are culled at once.
+        @remarks
+            Rather than culling the scene for each shadow camera while rendering its
+            texture, all shadow cameras are set up first and the scene is culled for
+            all of them in one go, using the flat culling path of setParallelCullingEnabled
+            split across the threads of the WorkQueue. The rendering itself still happens
+            sequentially.
+        @par
+            Only the default _findVisibleObjects implementation makes use of this.
+            Nodes moved by listeners after the shadow cameras were set up are culled
+            at their previous position.
+        @par
+            This changes the order of the listener callbacks: Listener::shadowTextureCasterPreViewProj
+            is called for all shadow textures before any of them is rendered, rather than
+            right before the rendering of each texture.
+        */
+        void setParallelShadowCasterCullingEnabled(bool enabled)
+        { mShadowRenderer.mParallelShadowCasterCulling = enabled; }
+        /// Returns whether the shadow casters of all shadow textures are culled at once
+        bool getParallelShadowCasterCullingEnabled() const
+        { return mShadowRenderer.mParallelShadowCasterCulling; }
+        /** Sets whether the shadow caster culling results are reused across frames.
+        @remarks
+            Requires setParallelShadowCasterCullingEnabled. The culling of a shadow
+            camera is skipped if neither its frustum nor the bounds of any SceneNode
+            changed since the previous frame, which is typical for static lights.
+        */
+        void setShadowCasterCullingCacheEnabled(bool enabled)
+        { mShadowRenderer.mShadowCasterCullingCache = enabled; }
+        /// Returns whether the shadow caster culling results are reused across frames
+        bool getShadowCasterCullingCacheEnabled() const
+        { return mShadowRenderer.mShadowCasterCullingCache; }
+
+        /** Sets whether the stencil shadow volumes are cached.
+        @remarks
+            Casters keep the shadow volume indexes they generated for each light
+            and only rebuild them when the light moved relative to the caster or the
+            caps required changed. Before rendering the volumes of a light, the
+            outdated ones are rebuilt in parallel using the WorkQueue.
+        @par
+            Only Entities without skeletal or vertex animation make use of this.
+            It costs the memory of the cached indexes per caster and light.
+        */
+        void setShadowVolumeCacheEnabled(bool enabled) { mShadowRenderer.mShadowVolumeCache = enabled; }
+        /// Returns whether the stencil shadow volumes are cached
+        bool getShadowVolumeCacheEnabled() const { return mShadowRenderer.mShadowVolumeCache; }
         /// @}
 
         /// @name Shadow Texture Config
@@ -3448,6 +3800,23 @@ namespace Ogre {
         */
         void _markGpuParamsDirty(uint16 mask);
 
+        /** Skips uploading per object and light GPU parameters whose values did not change.
+        @remarks
+            Consecutive renderables of a pass often produce the same per object
+            parameters, e.g. the submeshes of an Entity. With this enabled, the auto
+            constants updated for a renderable are compared with the values uploaded
+            for the previous one and only the variabilities which actually changed are
+            passed to RenderSystem::bindGpuProgramParameters. Global and pass iteration
+            parameters are always uploaded.
+        @par
+            This relies on the RenderSystem keeping the constants of a bound program
+            between draw calls. Do not enable it if you upload parameters of the bound
+            programs yourself, e.g. from a RenderObjectListener.
+        */
+        void setGpuParamDeduplicationEnabled(bool enabled) { mGpuParamDeduplication = enabled; }
+        /// Returns whether unchanged per object and light parameters are skipped
+        bool getGpuParamDeduplicationEnabled() const { return mGpuParamDeduplication; }
+
         /** Render the objects in a given queue group 
         @remarks You should only call this from a RenderQueueInvocation implementation
         */
@@ -3537,6 +3906,15 @@ namespace Ogre {
 
         /** See IntersectionSceneQuery. */
         void execute(IntersectionSceneQueryListener* listener);
+    private:
+        /// Finds the pairs using SceneManager::_getMovableObjectBroadphase
+        void executeBroadphase(IntersectionSceneQueryListener* listener);
+        /// Whether the object passes the masks
+        bool isCandidate(MovableObject* obj) const
+        {
+            return (obj->getTypeFlags() & mQueryTypeMask) && (obj->getQueryFlags() & mQueryMask) &&
+                   obj->isInScene();
+        }
     };
 
     /** Default implementation of RaySceneQuery. */
@@ -3546,8 +3924,23 @@ namespace Ogre {
         DefaultRaySceneQuery(SceneManager* creator);
         ~DefaultRaySceneQuery();
 
+        /** See RaySceneQuery. */
+        RaySceneQueryResult& execute(void);
         /** See RayScenQuery. */
         void execute(RaySceneQueryListener* listener);
+        /** See RaySceneQuery.
+        @remarks
+            Always uses the hierarchy of SceneManager::setRaySceneQueryBVHEnabled
+            and splits the rays across the threads of the WorkQueue.
+        */
+        void executeBatch(const Ray* rays, size_t count, RaySceneQueryResultEntry* results);
+    private:
+        /// Tests the ray against an object which passes the masks, hits beyond maxDistance are ignored
+        bool intersects(MovableObject* obj, const Ray& ray, Real maxDistance,
+                        RaySceneQueryResultEntry& result) const;
+        /// Finds the closest object hit by the ray using the hierarchy
+        bool findClosest(const SceneManager::MovableObjectBVH& objects, const Ray& ray,
+                         RaySceneQueryResultEntry& result) const;
     };
     /** Default implementation of SphereSceneQuery. */
     class _OgreExport DefaultSphereSceneQuery : public SphereSceneQuery
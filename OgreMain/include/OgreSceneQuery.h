@@ -321,6 +321,30 @@ namespace Ogre {
     };
     */
 
+    /** This struct allows a single comparison of result data no matter what the type */
+    struct _OgreExport RaySceneQueryResultEntry
+    {
+        /// Distance along the ray
+        Real distance;
+        /// The movable, or NULL if this is not a movable result
+        MovableObject* movable;
+        /// The world fragment, or NULL if this is not a fragment result
+        SceneQuery::WorldFragment* worldFragment;
+        /// The SubMesh containing the triangle hit, or NULL if this is not a triangle result
+        SubMesh* subMesh;
+        /// Index of the triangle hit within subMesh
+        uint32 triangle;
+        /// Weights of the three triangle corners at the hit point
+        Vector3 barycentricCoords;
+        /// Comparison operator for sorting
+        bool operator < (const RaySceneQueryResultEntry& rhs) const
+        {
+            return this->distance < rhs.distance;
+        }
+
+    };
+    typedef std::vector<RaySceneQueryResultEntry> RaySceneQueryResult;
+
     /** Alternative listener class for dealing with RaySceneQuery.
     @remarks
         Because the RaySceneQuery returns results in an extra bit of information, namely
@@ -346,25 +370,20 @@ namespace Ogre {
         */
         virtual bool queryResult(SceneQuery::WorldFragment* fragment, Real distance) = 0;
 
-    };
-      
-    /** This struct allows a single comparison of result data no matter what the type */
-    struct _OgreExport RaySceneQueryResultEntry
-    {
-        /// Distance along the ray
-        Real distance;
-        /// The movable, or NULL if this is not a movable result
-        MovableObject* movable;
-        /// The world fragment, or NULL if this is not a fragment result
-        SceneQuery::WorldFragment* worldFragment;
-        /// Comparison operator for sorting
-        bool operator < (const RaySceneQueryResultEntry& rhs) const
+        /** Called with the full details of a result.
+        @remarks
+            Used by queries which know more about a result than the distance, e.g. the
+            triangle hit. By default calls the queryResult overload for the movable or
+            world fragment of the entry.
+        */
+        virtual bool queryResultEntry(const RaySceneQueryResultEntry& result)
         {
-            return this->distance < rhs.distance;
+            if (result.movable)
+                return queryResult(result.movable, result.distance);
+            return queryResult(result.worldFragment, result.distance);
         }
-
     };
-    typedef std::vector<RaySceneQueryResultEntry> RaySceneQueryResult;
+      
 
     /** Specialises the SceneQuery class for querying along a ray. */
     class _OgreExport RaySceneQuery : public SceneQuery, public RaySceneQueryListener
@@ -373,6 +392,7 @@ namespace Ogre {
         Ray mRay;
         bool mSortByDistance;
         ushort mMaxResults;
+        bool mTriangleIntersection;
         RaySceneQueryResult mResult;
 
     public:
@@ -406,6 +426,19 @@ namespace Ogre {
         /** Gets the maximum number of results returned from the query (only relevant if 
         results are being sorted) */
         virtual ushort getMaxResults(void) const;
+        /** Sets whether the ray is intersected with the triangles of entities rather than their bounds.
+        @remarks
+            Entities are only reported if the ray hits one of the triangles of their mesh, at the
+            distance of the closest triangle hit. The result entries also name the SubMesh and the
+            triangle hit, see RaySceneQueryResultEntry. Animated entities are tested in their bind
+            pose. Other movables are still reported by their bounds. The triangles are taken from
+            Mesh::getTriangleBVH.
+        @par
+            Only supported by the default implementation, other implementations ignore this option.
+        */
+        void setTriangleIntersectionEnabled(bool enabled) { mTriangleIntersection = enabled; }
+        /** Gets whether the ray is intersected with the triangles of entities. */
+        bool getTriangleIntersectionEnabled(void) const { return mTriangleIntersection; }
         /** Executes the query, returning the results back in one list.
         @remarks
             This method executes the scene query as configured, gathers the results
@@ -425,6 +458,19 @@ namespace Ogre {
         */
         virtual void execute(RaySceneQueryListener* listener) = 0;
 
+        /** Finds the closest result for each of several rays.
+        @remarks
+            Uses the current masks and triangle intersection setting, but ignores the ray
+            and sorting options of this query. Implementations may process the rays in parallel,
+            so this is much faster than executing the query for each ray in turn. The last results
+            of this query are not updated.
+        @param rays the rays to query
+        @param count the number of rays
+        @param results receives the closest result of each ray; movable and worldFragment are
+            NULL and distance is infinite if a ray hits nothing
+        */
+        virtual void executeBatch(const Ray* rays, size_t count, RaySceneQueryResultEntry* results);
+
         /** Gets the results of the last query that was run using this object, provided
             the query was executed using the collection-returning version of execute. 
         */
@@ -441,6 +487,8 @@ namespace Ogre {
         bool queryResult(MovableObject* obj, Real distance);
         /** Self-callback in order to deal with execute which returns collection. */
         bool queryResult(SceneQuery::WorldFragment* fragment, Real distance);
+        /** Self-callback in order to deal with execute which returns collection. */
+        bool queryResultEntry(const RaySceneQueryResultEntry& result);
 
 
 
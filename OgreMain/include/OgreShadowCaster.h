@@ -213,7 +213,25 @@ namespace Ogre {
             size_t originalVertexCount, const Vector4& lightPos, Real extrudeDist);
         /** Get the distance to extrude for a point/spot light. */
         virtual Real getPointExtrusionDistance(const Light* l) const = 0;
+
+        /** Prepares the shadow volume for the given light ahead of getShadowVolumeRenderableList.
+        @remarks
+            Used by the shadow volume cache, see SceneManager::setShadowVolumeCacheEnabled.
+            It is called for several casters at once from the threads of the WorkQueue,
+            so implementations must only modify their own state. The light and the full
+            transform of the parent node are brought up to date beforehand. The parameters are
+            the ones getShadowVolumeRenderableList will be called with. The default does nothing.
+        */
+        virtual void _prepareShadowVolume(const Light* light, unsigned long flags) {}
     protected:
+        /// Indexes of a shadow volume, see buildShadowVolume
+        struct ShadowVolumeIndexes
+        {
+            std::vector<unsigned short> indexes;
+            /// index counts of the volume and of the separate light cap, per shadow renderable
+            std::vector<std::pair<size_t, size_t> > counts;
+        };
+
         /** Tells the caster to perform the tasks necessary to update the 
             edge data's light listing. Can be overridden if the subclass needs 
             to do additional things. 
@@ -250,6 +268,23 @@ namespace Ogre {
         virtual void generateShadowVolume(EdgeData* edgeData, 
             const HardwareIndexBufferSharedPtr& indexBuffer, size_t& indexBufferUsedSize,
             const Light* light, ShadowRenderableList& shadowRenderables, unsigned long flags);
+        /** Generates the indexes of a shadow volume, like generateShadowVolume does,
+            but into system memory, so it can run on any thread.
+        @param lightFacings
+            The light facing flags of the triangles of edgeData.
+        @param useMcGuire
+            Whether to close the volume using a triangle fan, see useMcGuireDarkCap.
+        */
+        static void buildShadowVolume(const EdgeData* edgeData, const char* lightFacings,
+            const Light* light, bool useMcGuire, const ShadowRenderableList& shadowRenderables,
+            unsigned long flags, ShadowVolumeIndexes& volume);
+        /** Copies the indexes generated by buildShadowVolume to the index buffer and
+            updates the shadow renderables to use them. */
+        static void uploadShadowVolume(const ShadowVolumeIndexes& volume,
+            const HardwareIndexBufferSharedPtr& indexBuffer, size_t& indexBufferUsedSize,
+            ShadowRenderableList& shadowRenderables, unsigned long flags);
+        /// Whether the dark cap can be a single triangle fan covering all silhouette edges
+        bool useMcGuireDarkCap(const EdgeData* edgeData, const Light* light) const;
         /** Utility method for extruding a bounding box. 
         @param box
             Original bounding box, will be updated in-place.
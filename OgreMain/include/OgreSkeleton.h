@@ -307,6 +307,11 @@ namespace Ogre {
         */
         virtual void optimiseAllAnimations(bool preservingIdentityNodeTracks = false);
 
+        /** Compress the keyframes of all of this skeleton's animations.
+        @see NodeAnimationTrack::compress, SkeletonManager::setCompressAnimations
+        */
+        void compressAllAnimations(Real tolerance = 1e-4f);
+
         /** Allows you to use the animations from another Skeleton object to animate
             this skeleton.
         @remarks
@@ -65,11 +65,23 @@ namespace Ogre {
         /// @see ResourceManager::getResourceByName
         SkeletonPtr getByName(const String& name, const String& groupName OGRE_RESOURCE_GROUP_INIT);
 
+        /** Sets whether the animations of skeletons are compressed when loading.
+        @remarks
+            Compressed animations take much less memory and are cheaper to
+            apply, at the cost of slightly quantised rotations and read-only
+            keyframes. Defaults to false.
+        @see Skeleton::compressAllAnimations
+        */
+        void setCompressAnimations(bool compress) { mCompressAnimations = compress; }
+        /// Gets whether the animations of skeletons are compressed when loading
+        bool getCompressAnimations() const { return mCompressAnimations; }
+
         /// @copydoc Singleton::getSingleton()
         static SkeletonManager& getSingleton(void);
         /// @copydoc Singleton::getSingleton()
         static SkeletonManager* getSingletonPtr(void);
     protected:
+        bool mCompressAnimations;
 
         /// @copydoc ResourceManager::createImpl
         Resource* createImpl(const String& name, ResourceHandle handle, 
@@ -0,0 +1,113 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SweepAndPrune_H__
+#define __SweepAndPrune_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreAxisAlignedBox.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Math
+    *  @{
+    */
+    /** Finds the pairs of overlapping boxes by sorting them along one axis.
+    @remarks
+        The boxes are kept sorted by their minimum along the axis their centres spread
+        most. Sweeping the sorted list only compares boxes whose intervals along that
+        axis overlap. If the boxes move, but keep their order, update sorts them again
+        using insertion sort, which only moves the boxes that changed their place.
+    */
+    class _OgreExport SweepAndPrune : public GeometryAllocatedObject
+    {
+    public:
+        SweepAndPrune() : mAxis(0) {}
+
+        /** Sorts the given boxes.
+        @param boxes the boxes, which must be finite
+        @param count the number of boxes
+        */
+        void build(const AxisAlignedBox* boxes, size_t count);
+        /** Sorts the boxes again after they moved.
+        @param boxes the new boxes, in the order passed to build
+        */
+        void update(const AxisAlignedBox* boxes);
+        /// Removes all boxes
+        void clear() { mEntries.clear(); }
+
+        /// The number of boxes
+        size_t getNumBoxes() const { return mEntries.size(); }
+        /// The axis the boxes are sorted along
+        int getAxis() const { return mAxis; }
+
+        /** Finds the pairs of overlapping boxes.
+        @param func called as <tt>bool func(uint32 a, uint32 b)</tt> with the indexes of each
+            pair of overlapping boxes, returns whether to continue
+        @return false if func ended the search
+        */
+        template <typename Func> bool findPairs(Func func) const
+        {
+            const int axis = mAxis, axis1 = (axis + 1) % 3, axis2 = (axis + 2) % 3;
+            for (size_t i = 0; i < mEntries.size(); ++i)
+            {
+                const Entry& a = mEntries[i];
+                // the boxes following a only overlap it until one starts after its end
+                for (size_t j = i + 1; j < mEntries.size() && mEntries[j].minimum[axis] <= a.maximum[axis]; ++j)
+                {
+                    const Entry& b = mEntries[j];
+                    if (a.maximum[axis1] < b.minimum[axis1] || b.maximum[axis1] < a.minimum[axis1] ||
+                        a.maximum[axis2] < b.minimum[axis2] || b.maximum[axis2] < a.minimum[axis2])
+                        continue;
+                    if (!func(a.index, b.index))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        struct Entry
+        {
+            Vector3 minimum;
+            uint32 index;
+            Vector3 maximum;
+        };
+        std::vector<Entry> mEntries;
+        int mAxis;
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
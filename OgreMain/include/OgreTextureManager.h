@@ -396,6 +396,18 @@ namespace Ogre {
             return mDefaultNumMipmaps;
         }
 
+        /** Sets the filter used to generate the mipmaps of textures on the CPU, when
+            the hardware cannot generate them.
+            @see Image::generateMipmaps
+            @note
+                The default value is Image::FILTER_BOX.
+        */
+        void setSoftwareMipmapFilter(Image::Filter filter) { mSoftwareMipmapFilter = filter; }
+
+        /** Gets the filter used to generate the mipmaps of textures on the CPU.
+        */
+        Image::Filter getSoftwareMipmapFilter() const { return mSoftwareMipmapFilter; }
+
         /// Internal method to create a warning texture (bound when a texture unit is blank)
         const TexturePtr& _getWarningTexture();
 
@@ -414,6 +426,7 @@ namespace Ogre {
         ushort mPreferredIntegerBitDepth;
         ushort mPreferredFloatBitDepth;
         uint32 mDefaultNumMipmaps;
+        Image::Filter mSoftwareMipmapFilter;
         TexturePtr mWarningTexture;
         SamplerPtr mDefaultSampler;
         std::map<String, SamplerPtr> mNamedSamplers;
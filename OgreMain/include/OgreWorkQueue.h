@@ -363,6 +363,24 @@ namespace Ogre
         */
         virtual uint16 getChannel(const String& channelName);
 
+        /// Function processing the elements [begin, end) of a parallelFor range
+        typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+        /** Process the elements [0, count) in chunks of grainSize elements and
+            return once all chunks have been processed.
+        @remarks
+            Implementations may distribute the chunks over their worker threads.
+            The calling thread always takes part in the processing, so this never
+            waits for workers that are busy with other requests. The function is
+            called concurrently for disjoint ranges, hence it must not touch any
+            shared state that is not protected otherwise.
+        @par
+            The default implementation processes all chunks on the calling thread.
+        @param count Number of elements to process
+        @param grainSize Maximal number of elements passed to a single call of func
+        @param func The function processing a sub range
+        */
+        virtual void parallelFor(size_t count, size_t grainSize, const RangeFunction& func);
     };
 
     /** Base for a general purpose request / response style background work queue.
@@ -467,6 +485,8 @@ namespace Ogre
         virtual unsigned long getResponseProcessingTimeLimit() const { return mResposeTimeLimitMS; }
         /// @copydoc WorkQueue::setResponseProcessingTimeLimit
         virtual void setResponseProcessingTimeLimit(unsigned long ms) { mResposeTimeLimitMS = ms; }
+        /// @copydoc WorkQueue::parallelFor
+        virtual void parallelFor(size_t count, size_t grainSize, const RangeFunction& func);
     protected:
         String mName;
         size_t mWorkerThreadCount;
@@ -582,6 +602,15 @@ namespace Ogre
         
 
         bool processIdleRequests();
+
+        /// Helps processing the chunks of a parallelFor call on a worker thread
+        class _OgrePrivate ParallelForHandler : public RequestHandler
+        {
+        public:
+            Response* handleRequest(const Request* req, const WorkQueue* srcQ);
+        };
+        ParallelForHandler mParallelForHandler;
+        uint16 mParallelForChannel;
     };
 
 
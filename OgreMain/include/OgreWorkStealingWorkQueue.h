@@ -0,0 +1,236 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __OgreWorkStealingWorkQueue_H__
+#define __OgreWorkStealingWorkQueue_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreWorkQueue.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+    /** A WorkQueue scheduling its work by work stealing.
+    @remarks
+        Requests are put on lock-free queues, one per Priority, from which
+        the worker threads take them highest priority first. Unlike the
+        DefaultWorkQueue, adding and taking a request does not go through a
+        single mutex and condition variable, so many subsystems can submit
+        concurrently without contending with each other or with the workers.
+    @par
+        Each worker additionally owns a lock-free deque for fork/join work:
+        parallelFor splits its range recursively, pushing one half onto the
+        deque of the current worker, where idle workers steal it from.
+        This keeps the hot loops of the engine (culling, skinning, particle
+        updates) balanced across all threads, even while long running
+        requests occupy some of them.
+    @par
+        To use it instead of the DefaultWorkQueue, pass it to the Root
+        constructor or to Root::setWorkQueue.
+    */
+    class _OgreExport WorkStealingWorkQueue : public WorkQueue
+    {
+    public:
+        /// Scheduling priority of the requests of a channel
+        enum Priority
+        {
+            WQP_HIGH,
+            WQP_NORMAL,
+            WQP_LOW,
+            WQP_COUNT
+        };
+
+        /** Constructor.
+            Call startup() to initialise.
+        @param name Optional name, just helps to identify logging output
+        */
+        WorkStealingWorkQueue(const String& name = BLANKSTRING);
+        ~WorkStealingWorkQueue();
+
+        /// Get the name of the work queue
+        const String& getName() const { return mName; }
+
+        /** Set the number of worker threads that this queue will start
+            when startup() is called.
+            Defaults to the number of hardware threads minus one, as the
+            thread calling parallelFor takes part in the processing.
+            Calling this will have no effect unless the queue is shut down and
+            restarted.
+        */
+        void setWorkerThreadCount(size_t c) { mWorkerThreadCount = c; }
+        /// Get the number of worker threads started by startup()
+        size_t getWorkerThreadCount() const { return mWorkerThreadCount; }
+
+        /** Set the priority of the requests on the given channel.
+        @remarks
+            Requests of a higher priority are always taken before those of a
+            lower one, requests of the same priority are processed in the order
+            they were added. Channels default to WQP_NORMAL. The priority of
+            requests already added is not changed.
+        */
+        void setChannelPriority(uint16 channel, Priority priority);
+        /// Get the priority of the requests on the given channel
+        Priority getChannelPriority(uint16 channel) const;
+
+        void startup(bool forceRestart = true);
+        void shutdown();
+        void addRequestHandler(uint16 channel, RequestHandler* rh);
+        void removeRequestHandler(uint16 channel, RequestHandler* rh);
+        void addResponseHandler(uint16 channel, ResponseHandler* rh);
+        void removeResponseHandler(uint16 channel, ResponseHandler* rh);
+        RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0,
+                             bool forceSynchronous = false, bool idleThread = false);
+        void abortRequest(RequestID id);
+        bool abortPendingRequest(RequestID id);
+        void abortRequestsByChannel(uint16 channel);
+        void abortPendingRequestsByChannel(uint16 channel);
+        void abortAllRequests();
+        void setPaused(bool pause);
+        bool isPaused() const { return mPaused; }
+        void setRequestsAccepted(bool accept) { mAcceptRequests = accept; }
+        bool getRequestsAccepted() const { return mAcceptRequests; }
+        void processResponses();
+        unsigned long getResponseProcessingTimeLimit() const { return mResponseTimeLimitMS; }
+        void setResponseProcessingTimeLimit(unsigned long ms) { mResponseTimeLimitMS = ms; }
+
+        /** @copydoc WorkQueue::parallelFor
+        @par
+            When called from a worker thread, e.g. by a RequestHandler, the
+            range is split onto the deque of that worker. While waiting for
+            stolen parts, the calling thread helps with the fork/join work of
+            other threads, but never takes requests.
+        */
+        void parallelFor(size_t count, size_t grainSize, const RangeFunction& func);
+
+    private:
+        struct Task;
+        struct Worker;
+        struct ParallelForJob;
+        class TaskQueue;
+
+        /// A request handler, kept alive while it is being called
+        struct HandlerHolder
+        {
+            std::atomic<RequestHandler*> handler;
+            std::atomic<int> users;
+            HandlerHolder(RequestHandler* rh) : handler(rh), users(0) {}
+        };
+        typedef SharedPtr<HandlerHolder> HandlerHolderPtr;
+        typedef std::vector<HandlerHolderPtr> HandlerHolderList;
+
+        /// A queued or running request
+        struct RequestEntry
+        {
+            Request* request;
+            bool running;
+        };
+        /// Part of the registry of queued and running requests, split to reduce contention
+        struct RequestShard
+        {
+            OGRE_WQ_MUTEX(mutex);
+            std::map<RequestID, RequestEntry> requests;
+        };
+        static const size_t NUM_SHARDS = 16;
+
+        String mName;
+        size_t mWorkerThreadCount;
+        unsigned long mResponseTimeLimitMS;
+        bool mIsRunning;
+        std::atomic<bool> mPaused;
+        std::atomic<bool> mAcceptRequests;
+        std::atomic<bool> mShuttingDown;
+        std::atomic<RequestID> mRequestCount;
+
+        std::vector<Worker*> mWorkers;
+        std::atomic<size_t> mNumWorkersStarted;
+        /// parts of parallelFor ranges handed out by non-worker threads
+        TaskQueue* mForkQueue;
+        TaskQueue* mRequestQueues[WQP_COUNT];
+
+        /// tasks in all queues and deques, to decide whether workers can sleep
+        std::atomic<size_t> mPendingTasks;
+        std::atomic<size_t> mNumSleeping;
+        OGRE_WQ_MUTEX(mSleepMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mSleepCondition);
+
+        /// requests processed one at a time, when there is nothing else to do
+        std::deque<Task*> mIdleQueue; // Guarded by mIdleMutex
+        bool mIdleRunning; // Guarded by mIdleMutex
+        OGRE_WQ_MUTEX(mIdleMutex);
+
+        RequestShard mShards[NUM_SHARDS];
+
+        std::map<uint16, HandlerHolderList> mRequestHandlers; // Guarded by mChannelMutex
+        std::map<uint16, Priority> mChannelPriorities; // Guarded by mChannelMutex
+        OGRE_WQ_MUTEX(mChannelMutex);
+
+        typedef std::list<ResponseHandler*> ResponseHandlerList;
+        std::map<uint16, ResponseHandlerList> mResponseHandlers;
+        std::deque<Response*> mResponseQueue; // Guarded by mResponseMutex
+        OGRE_WQ_MUTEX(mResponseMutex);
+
+        friend struct Worker;
+        void threadMain(Worker* worker);
+
+        /// Returns the worker running on the calling thread, if any
+        Worker* getCurrentWorker() const;
+
+        /// Put a task on a shared queue and wake a worker
+        void pushTask(TaskQueue* queue, Task* task);
+        /// Put a task on the deque of the given worker and wake another one
+        bool pushLocalTask(Worker* worker, Task* task);
+        void notifyWorkers();
+
+        /// Find fork/join work on the own deque, the fork queue or other workers' deques
+        Task* findRangeTask(Worker* self);
+        /// Find a request, highest priority first
+        Task* findRequestTask();
+        Task* findIdleTask();
+
+        /// Process a part of a parallelFor range, splitting it onto the deque of self
+        void runRangeTask(Worker* self, Task* task);
+
+        void queueRequest(Request* req, bool idleThread);
+        void runRequestTask(Task* task);
+        void processRequestResponse(Request* r, bool synchronous);
+        Response* processRequest(Request* r);
+        void processResponse(Response* r);
+        RequestShard& getShard(RequestID id) { return mShards[id % NUM_SHARDS]; }
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
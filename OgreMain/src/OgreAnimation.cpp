@@ -348,17 +348,7 @@ namespace Ogre {
         _applyBaseKeyFrame();
 
         // Calculate time index for fast keyframe search
-        TimeIndex timeIndex = _getTimeIndex(timePos);
-
-        NodeTrackList::iterator i;
-        for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
-        {
-            // get bone to apply to 
-            Bone* b = skel->getBone(i->first);
-            i->second->applyToNode(b, timeIndex, weight, scale);
-        }
-
-
+        applyToSkeleton(skel, _getTimeIndex(timePos), weight, NULL, scale);
     }
     //---------------------------------------------------------------------
     void Animation::apply(Skeleton* skel, Real timePos, float weight,
@@ -367,15 +357,28 @@ namespace Ogre {
         _applyBaseKeyFrame();
 
         // Calculate time index for fast keyframe search
-      TimeIndex timeIndex = _getTimeIndex(timePos);
+        applyToSkeleton(skel, _getTimeIndex(timePos), weight, blendMask, scale);
+    }
+    //---------------------------------------------------------------------
+    void Animation::apply(Skeleton* skel, Real timePos, float weight,
+      const AnimationState::BoneBlendMask* blendMask, Real scale, uint& keyFrameCursor)
+    {
+        _applyBaseKeyFrame();
 
-      NodeTrackList::iterator i;
-      for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
-      {
-        // get bone to apply to 
-        Bone* b = skel->getBone(i->first);
-        i->second->applyToNode(b, timeIndex, (*blendMask)[b->getHandle()] * weight, scale);
-      }
+        applyToSkeleton(skel, _getTimeIndex(timePos, keyFrameCursor), weight, blendMask, scale);
+    }
+    //---------------------------------------------------------------------
+    void Animation::applyToSkeleton(Skeleton* skel, const TimeIndex& timeIndex, float weight,
+      const AnimationState::BoneBlendMask* blendMask, Real scale)
+    {
+        NodeTrackList::iterator i;
+        for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
+        {
+            // get bone to apply to 
+            Bone* b = skel->getBone(i->first);
+            Real boneWeight = blendMask ? (*blendMask)[b->getHandle()] * weight : weight;
+            i->second->applyToNode(b, timeIndex, boneWeight, scale);
+        }
     }
     //---------------------------------------------------------------------
     void Animation::apply(Entity* entity, Real timePos, Real weight, 
@@ -520,6 +523,15 @@ namespace Ogre {
         
     }
     //-----------------------------------------------------------------------
+    void Animation::compressNodeTracks(Real tolerance)
+    {
+        NodeTrackList::iterator i;
+        for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
+        {
+            i->second->compress(tolerance);
+        }
+    }
+    //-----------------------------------------------------------------------
     void Animation::_collectIdentityNodeTracks(TrackHandleList& tracks) const
     {
         NodeTrackList::const_iterator i, iend;
@@ -653,6 +665,39 @@ namespace Ogre {
         return TimeIndex(timePos, static_cast<uint>(std::distance(mKeyFrameTimes.begin(), it)));
     }
     //-----------------------------------------------------------------------
+    TimeIndex Animation::_getTimeIndex(Real timePos, uint& keyFrameCursor) const
+    {
+        // Build keyframe time list on demand
+        if (mKeyFrameTimesDirty)
+        {
+            buildKeyFrameTimeList();
+        }
+
+        // Wrap time
+        Real totalAnimationLength = mLength;
+
+        if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
+            timePos = std::fmod( timePos, totalAnimationLength );
+
+        // Whether index is the lower bound of timePos in the global keyframe times
+        size_t numTimes = mKeyFrameTimes.size();
+        auto isLowerBound = [&](size_t index) {
+            return index <= numTimes && (index == numTimes || timePos <= mKeyFrameTimes[index]) &&
+                   (index == 0 || mKeyFrameTimes[index - 1] < timePos);
+        };
+
+        // Usually time did not pass a keyframe, or just the next one
+        size_t index = keyFrameCursor;
+        if (!isLowerBound(index) && !isLowerBound(++index))
+        {
+            index = std::distance(mKeyFrameTimes.begin(),
+                std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos));
+        }
+        keyFrameCursor = static_cast<uint>(index);
+
+        return TimeIndex(timePos, keyFrameCursor);
+    }
+    //-----------------------------------------------------------------------
     void Animation::buildKeyFrameTimeList(void) const
     {
         NodeTrackList::const_iterator i;
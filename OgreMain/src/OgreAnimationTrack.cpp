@@ -351,9 +351,44 @@ namespace Ogre {
     //---------------------------------------------------------------------
     // Node specialisations
     //---------------------------------------------------------------------
+    struct NodeAnimationTrack::CompressedKeys
+    {
+        /// Key times, ascending
+        std::vector<Real> times;
+        /// Rotations as w, x, y, z quantised to int16, one per key or a single one if constant
+        std::vector<int16> rotations;
+        /// Translations as x, y, z, one per key or a single one if constant
+        std::vector<float> translations;
+        /// Scales as x, y, z, one per key or a single one if constant
+        std::vector<float> scales;
+        /// Tolerance the constant channels were detected with
+        Real tolerance;
+
+        bool isRotationConstant() const { return rotations.size() == 4; }
+        bool isTranslationConstant() const { return translations.size() == 3; }
+        bool isScaleConstant() const { return scales.size() == 3; }
+
+        Quaternion getRotation(size_t key) const
+        {
+            const int16* r = &rotations[isRotationConstant() ? 0 : key * 4];
+            const float inv = 1.0f / 32767;
+            Quaternion q(r[0] * inv, r[1] * inv, r[2] * inv, r[3] * inv);
+            q.normalise();
+            return q;
+        }
+        Vector3 getTranslation(size_t key) const
+        {
+            return Vector3(&translations[isTranslationConstant() ? 0 : key * 3]);
+        }
+        Vector3 getScale(size_t key) const
+        {
+            return Vector3(&scales[isScaleConstant() ? 0 : key * 3]);
+        }
+    };
+    //---------------------------------------------------------------------
     NodeAnimationTrack::NodeAnimationTrack(Animation* parent, unsigned short handle)
         : AnimationTrack(parent, handle), mTargetNode(0)
-        , mSplines(0), mSplineBuildNeeded(false)
+        , mSplines(0), mCompressedKeys(0), mSplineBuildNeeded(false)
         , mUseShortestRotationPath(true)
     {
     }
@@ -361,7 +396,7 @@ namespace Ogre {
     NodeAnimationTrack::NodeAnimationTrack(Animation* parent, unsigned short handle,
         Node* targetNode)
         : AnimationTrack(parent, handle), mTargetNode(targetNode)
-        , mSplines(0), mSplineBuildNeeded(false)
+        , mSplines(0), mCompressedKeys(0), mSplineBuildNeeded(false)
         , mUseShortestRotationPath(true)
     {
     }
@@ -369,6 +404,7 @@ namespace Ogre {
     NodeAnimationTrack::~NodeAnimationTrack()
     {
         OGRE_DELETE_T(mSplines, Splines, MEMCATEGORY_ANIMATION);
+        OGRE_DELETE_T(mCompressedKeys, CompressedKeys, MEMCATEGORY_ANIMATION);
     }
     //---------------------------------------------------------------------
     void NodeAnimationTrack::getInterpolatedKeyFrame(const TimeIndex& timeIndex, KeyFrame* kf) const
@@ -381,6 +417,12 @@ namespace Ogre {
 
         TransformKeyFrame* kret = static_cast<TransformKeyFrame*>(kf);
 
+        if (mCompressedKeys)
+        {
+            getInterpolatedCompressedKeyFrame(timeIndex, kret);
+            return;
+        }
+
         // Keyframe pointers
         KeyFrame *kBase1, *kBase2;
         TransformKeyFrame *k1, *k2;
@@ -455,6 +497,112 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    Real NodeAnimationTrack::getCompressedKeysAtTime(const TimeIndex& timeIndex, size_t& key1,
+        size_t& key2) const
+    {
+        const std::vector<Real>& times = mCompressedKeys->times;
+        Real timePos = timeIndex.getTimePos();
+
+        // Find first key after or on current time
+        size_t i;
+        if (timeIndex.hasKeyIndex())
+        {
+            // Global keyframe index available, map to local key index directly.
+            assert(timeIndex.getKeyIndex() < mKeyFrameIndexMap.size());
+            i = mKeyFrameIndexMap[timeIndex.getKeyIndex()];
+        }
+        else
+        {
+            // Wrap time
+            Real totalAnimationLength = mParent->getLength();
+            if (timePos > totalAnimationLength && totalAnimationLength > 0.0f)
+                timePos = std::fmod(timePos, totalAnimationLength);
+
+            i = std::lower_bound(times.begin(), times.end(), timePos) - times.begin();
+        }
+
+        Real t2;
+        if (i == times.size())
+        {
+            // There is no key after this time, wrap back to first
+            key2 = 0;
+            t2 = mParent->getLength() + times.front();
+            --i;
+        }
+        else
+        {
+            key2 = i;
+            t2 = times[i];
+            // Find last key before or on current time
+            if (i != 0 && timePos < times[i])
+                --i;
+        }
+
+        key1 = i;
+        Real t1 = times[i];
+        return t1 == t2 ? 0.0f : (timePos - t1) / (t2 - t1);
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::getInterpolatedCompressedKeyFrame(const TimeIndex& timeIndex,
+        TransformKeyFrame* kf) const
+    {
+        const CompressedKeys& keys = *mCompressedKeys;
+        size_t k1, k2;
+        Real t = getCompressedKeysAtTime(timeIndex, k1, k2);
+
+        if (t == 0.0 || keys.times.size() == 1)
+        {
+            kf->setRotation(keys.getRotation(k1));
+            kf->setTranslate(keys.getTranslation(k1));
+            kf->setScale(keys.getScale(k1));
+            return;
+        }
+
+        // Constant channels need no interpolation at all
+        if (mParent->getInterpolationMode() == Animation::IM_LINEAR)
+        {
+            if (keys.isRotationConstant())
+                kf->setRotation(keys.getRotation(0));
+            else if (mParent->getRotationInterpolationMode() == Animation::RIM_LINEAR)
+                kf->setRotation(Quaternion::nlerp(t, keys.getRotation(k1), keys.getRotation(k2),
+                    mUseShortestRotationPath));
+            else
+                kf->setRotation(Quaternion::Slerp(t, keys.getRotation(k1), keys.getRotation(k2),
+                    mUseShortestRotationPath));
+
+            if (keys.isTranslationConstant())
+                kf->setTranslate(keys.getTranslation(0));
+            else
+            {
+                Vector3 base = keys.getTranslation(k1);
+                kf->setTranslate(base + ((keys.getTranslation(k2) - base) * t));
+            }
+
+            if (keys.isScaleConstant())
+                kf->setScale(keys.getScale(0));
+            else
+            {
+                Vector3 base = keys.getScale(k1);
+                kf->setScale(base + ((keys.getScale(k2) - base) * t));
+            }
+        }
+        else // if (im == Animation::IM_SPLINE)
+        {
+            if (mSplineBuildNeeded)
+            {
+                buildInterpolationSplines();
+            }
+
+            ushort firstKeyIndex = static_cast<ushort>(k1);
+            kf->setRotation(keys.isRotationConstant() ? keys.getRotation(0) :
+                mSplines->rotationSpline.interpolate(firstKeyIndex, t, mUseShortestRotationPath));
+            kf->setTranslate(keys.isTranslationConstant() ? keys.getTranslation(0) :
+                mSplines->positionSpline.interpolate(firstKeyIndex, t));
+            kf->setScale(keys.isScaleConstant() ? keys.getScale(0) :
+                mSplines->scaleSpline.interpolate(firstKeyIndex, t));
+        }
+    }
+    //---------------------------------------------------------------------
     void NodeAnimationTrack::apply(const TimeIndex& timeIndex, Real weight, Real scale)
     {
         applyToNode(mTargetNode, timeIndex, weight, scale);
@@ -475,11 +623,14 @@ namespace Ogre {
         Real scl)
     {
         // Nothing to do if no keyframes or zero weight or no node
-        if (mKeyFrames.empty() || !weight || !node)
+        if ((mKeyFrames.empty() && !mCompressedKeys) || !weight || !node)
             return;
 
         TransformKeyFrame kf(0, timeIndex.getTimePos());
-        getInterpolatedKeyFrame(timeIndex, &kf);
+        if (mCompressedKeys && !mListener)
+            getInterpolatedCompressedKeyFrame(timeIndex, &kf);
+        else
+            getInterpolatedKeyFrame(timeIndex, &kf);
 
         // add to existing. Weights are not relative, but treated as absolute multipliers for the animation
         Vector3 translate = kf.getTranslate() * weight * scl;
@@ -533,6 +684,16 @@ namespace Ogre {
         splines->rotationSpline.clear();
         splines->scaleSpline.clear();
 
+        if (mCompressedKeys)
+        {
+            for (size_t i = 0; i < mCompressedKeys->times.size(); ++i)
+            {
+                splines->positionSpline.addPoint(mCompressedKeys->getTranslation(i));
+                splines->rotationSpline.addPoint(mCompressedKeys->getRotation(i));
+                splines->scaleSpline.addPoint(mCompressedKeys->getScale(i));
+            }
+        }
+
         KeyFrameList::const_iterator i, iend;
         iend = mKeyFrames.end(); // precall to avoid overhead
         for (i = mKeyFrames.begin(); i != iend; ++i)
@@ -570,6 +731,24 @@ namespace Ogre {
     //---------------------------------------------------------------------
     bool NodeAnimationTrack::hasNonZeroKeyFrames(void) const
     {
+        if (mCompressedKeys)
+        {
+            Real tolerance = 1e-3f;
+            for (size_t k = 0; k < mCompressedKeys->times.size(); ++k)
+            {
+                Vector3 axis;
+                Radian angle;
+                mCompressedKeys->getRotation(k).ToAngleAxis(angle, axis);
+                if (!mCompressedKeys->getTranslation(k).positionEquals(Vector3::ZERO, tolerance) ||
+                    !mCompressedKeys->getScale(k).positionEquals(Vector3::UNIT_SCALE, tolerance) ||
+                    !Math::RealEqual(angle.valueRadians(), 0.0f, tolerance))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         KeyFrameList::const_iterator i = mKeyFrames.begin();
         for (; i != mKeyFrames.end(); ++i)
         {
@@ -650,10 +829,145 @@ namespace Ogre {
         }
 
 
+    }
+    //---------------------------------------------------------------------
+    Real NodeAnimationTrack::getKeyFramesAtTime(const TimeIndex& timeIndex, KeyFrame** keyFrame1,
+                                                KeyFrame** keyFrame2, unsigned short* firstKeyIndex) const
+    {
+        if (mCompressedKeys)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                "The keyframes of this track are compressed, call decompress first",
+                "NodeAnimationTrack::getKeyFramesAtTime");
+        }
+        return AnimationTrack::getKeyFramesAtTime(timeIndex, keyFrame1, keyFrame2, firstKeyIndex);
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::compress(Real tolerance)
+    {
+        if (mCompressedKeys || mKeyFrames.empty())
+            return;
+
+        CompressedKeys* keys = OGRE_NEW_T(CompressedKeys, MEMCATEGORY_ANIMATION);
+        keys->tolerance = tolerance;
+        size_t numKeys = mKeyFrames.size();
+        keys->times.reserve(numKeys);
+
+        bool constantRotation = true, constantTranslation = true, constantScale = true;
+        const TransformKeyFrame* first = static_cast<const TransformKeyFrame*>(mKeyFrames.front());
+        Quaternion firstRotation = first->getRotation();
+        firstRotation.normalise();
+        Radian rotationTolerance(tolerance);
+        for (size_t i = 0; i < numKeys; ++i)
+        {
+            const TransformKeyFrame* kf = static_cast<const TransformKeyFrame*>(mKeyFrames[i]);
+            keys->times.push_back(kf->getTime());
+
+            // Quantise the normalised rotation to the full int16 range
+            Quaternion q = kf->getRotation();
+            q.normalise();
+            for (size_t c = 0; c < 4; ++c)
+            {
+                Real v = Math::Clamp(q.ptr()[c], Real(-1), Real(1));
+                keys->rotations.push_back(static_cast<int16>(std::floor(v * 32767 + 0.5f)));
+            }
+            // q and -q are the same rotation
+            if (q.Dot(firstRotation) < 0)
+                q = -q;
+            constantRotation = constantRotation && q.equals(firstRotation, rotationTolerance);
+
+            const Vector3& t = kf->getTranslate();
+            keys->translations.insert(keys->translations.end(), t.ptr(), t.ptr() + 3);
+            constantTranslation = constantTranslation && t.positionEquals(first->getTranslate(), tolerance);
+
+            const Vector3& s = kf->getScale();
+            keys->scales.insert(keys->scales.end(), s.ptr(), s.ptr() + 3);
+            constantScale = constantScale && s.positionEquals(first->getScale(), tolerance);
+        }
+
+        // Eliminate constant channels
+        if (constantRotation)
+            keys->rotations.resize(4);
+        if (constantTranslation)
+            keys->translations.resize(3);
+        if (constantScale)
+            keys->scales.resize(3);
+        keys->rotations.shrink_to_fit();
+        keys->translations.shrink_to_fit();
+        keys->scales.shrink_to_fit();
+
+        removeAllKeyFrames();
+        mCompressedKeys = keys;
+        _keyFrameDataChanged();
+        mParent->_keyFrameListChanged();
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::decompress(void)
+    {
+        if (!mCompressedKeys)
+            return;
+
+        CompressedKeys* keys = mCompressedKeys;
+        mCompressedKeys = 0;
+
+        mKeyFrames.reserve(keys->times.size());
+        for (size_t i = 0; i < keys->times.size(); ++i)
+        {
+            TransformKeyFrame* kf = OGRE_NEW TransformKeyFrame(this, keys->times[i]);
+            kf->setRotation(keys->getRotation(i));
+            kf->setTranslate(keys->getTranslation(i));
+            kf->setScale(keys->getScale(i));
+            mKeyFrames.push_back(kf);
+        }
+        OGRE_DELETE_T(keys, CompressedKeys, MEMCATEGORY_ANIMATION);
+
+        _keyFrameDataChanged();
+        mParent->_keyFrameListChanged();
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::_collectKeyFrameTimes(std::vector<Real>& keyFrameTimes)
+    {
+        if (!mCompressedKeys)
+        {
+            AnimationTrack::_collectKeyFrameTimes(keyFrameTimes);
+            return;
+        }
+
+        for (Real timePos : mCompressedKeys->times)
+        {
+            std::vector<Real>::iterator it =
+                std::lower_bound(keyFrameTimes.begin(), keyFrameTimes.end(), timePos);
+            if (it == keyFrameTimes.end() || *it != timePos)
+            {
+                keyFrameTimes.insert(it, timePos);
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void NodeAnimationTrack::_buildKeyFrameIndexMap(const std::vector<Real>& keyFrameTimes)
+    {
+        if (!mCompressedKeys)
+        {
+            AnimationTrack::_buildKeyFrameIndexMap(keyFrameTimes);
+            return;
+        }
+
+        // Local index of the first key at or after each global keyframe time
+        const std::vector<Real>& times = mCompressedKeys->times;
+        mKeyFrameIndexMap.resize(keyFrameTimes.size() + 1);
+        size_t i = 0;
+        for (size_t j = 0; j <= keyFrameTimes.size(); ++j)
+        {
+            mKeyFrameIndexMap[j] = static_cast<ushort>(i);
+            while (j < keyFrameTimes.size() && i < times.size() && times[i] <= keyFrameTimes[j])
+                ++i;
+        }
     }
     //--------------------------------------------------------------------------
     KeyFrame* NodeAnimationTrack::createKeyFrameImpl(Real time)
     {
+        // Editing works on KeyFrame objects only
+        decompress();
         return OGRE_NEW TransformKeyFrame(this, time);
     }
     //--------------------------------------------------------------------------
@@ -673,12 +987,24 @@ namespace Ogre {
             newParent->createNodeTrack(mHandle, mTargetNode);
         newTrack->mUseShortestRotationPath = mUseShortestRotationPath;
         populateClone(newTrack);
+        if (mCompressedKeys)
+        {
+            newTrack->mCompressedKeys =
+                OGRE_NEW_T(CompressedKeys, MEMCATEGORY_ANIMATION)(*mCompressedKeys);
+            newTrack->_keyFrameDataChanged();
+            newParent->_keyFrameListChanged();
+        }
         return newTrack;
     }
     //--------------------------------------------------------------------------
     void NodeAnimationTrack::_applyBaseKeyFrame(const KeyFrame* b)
     {
         const TransformKeyFrame* base = static_cast<const TransformKeyFrame*>(b);
+
+        // Rebase the keyframe objects, and compress them again afterwards
+        Real compressTolerance = mCompressedKeys ? mCompressedKeys->tolerance : 0;
+        bool wasCompressed = mCompressedKeys != 0;
+        decompress();
         
         for (KeyFrameList::iterator i = mKeyFrames.begin(); i != mKeyFrames.end(); ++i)
         {
@@ -687,7 +1013,9 @@ namespace Ogre {
             kf->setRotation(base->getRotation().Inverse() * kf->getRotation());
             kf->setScale(kf->getScale() * (Vector3::UNIT_SCALE / base->getScale()));
         }
-            
+
+        if (wasCompressed)
+            compress(compressTolerance);
     }
     //--------------------------------------------------------------------------
     VertexAnimationTrack::VertexAnimationTrack(Animation* parent,
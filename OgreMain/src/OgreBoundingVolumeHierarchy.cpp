@@ -0,0 +1,199 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreBoundingVolumeHierarchy.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    void BoundingVolumeHierarchy::build(const AxisAlignedBox* boxes, size_t count)
+    {
+        clear();
+        if (count == 0)
+            return;
+
+        std::vector<Vector3> centres(count);
+        mPrimitives.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            assert(boxes[i].isFinite() && "only finite boxes are supported");
+            centres[i] = boxes[i].getCenter();
+            mPrimitives[i] = uint32(i);
+        }
+
+        mNodes.reserve(2 * count / LEAF_SIZE + 1);
+        buildNode(boxes, centres.data(), 0, uint32(count), 0);
+    }
+    //-----------------------------------------------------------------------
+    void BoundingVolumeHierarchy::buildNode(const AxisAlignedBox* boxes, const Vector3* centres, uint32 begin,
+                                            uint32 end, size_t depth)
+    {
+        uint32 index = uint32(mNodes.size());
+        mNodes.push_back(Node());
+
+        AxisAlignedBox bounds, centreBounds;
+        for (uint32 i = begin; i < end; ++i)
+        {
+            bounds.merge(boxes[mPrimitives[i]]);
+            centreBounds.merge(centres[mPrimitives[i]]);
+        }
+        mNodes[index].minimum = bounds.getMinimum();
+        mNodes[index].maximum = bounds.getMaximum();
+
+        // the depth limit keeps the traversal stack bounded
+        if (end - begin <= LEAF_SIZE || depth == 60)
+        {
+            mNodes[index].first = begin;
+            mNodes[index].count = end - begin;
+            return;
+        }
+
+        // Split at the median along the axis the centres spread most
+        Vector3 extent = centreBounds.getSize();
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        uint32 mid = begin + (end - begin) / 2;
+        std::nth_element(mPrimitives.begin() + begin, mPrimitives.begin() + mid, mPrimitives.begin() + end,
+                         [centres, axis](uint32 a, uint32 b) { return centres[a][axis] < centres[b][axis]; });
+
+        buildNode(boxes, centres, begin, mid, depth + 1);
+        mNodes[index].first = uint32(mNodes.size());
+        mNodes[index].count = 0;
+        buildNode(boxes, centres, mid, end, depth + 1);
+    }
+    //-----------------------------------------------------------------------
+    void BoundingVolumeHierarchy::refit(const AxisAlignedBox* boxes)
+    {
+        // children always follow their parent
+        for (size_t i = mNodes.size(); i-- > 0;)
+        {
+            Node& node = mNodes[i];
+            AxisAlignedBox bounds;
+            if (node.count)
+            {
+                for (uint32 p = node.first; p < node.first + node.count; ++p)
+                    bounds.merge(boxes[mPrimitives[p]]);
+            }
+            else
+            {
+                bounds.setExtents(mNodes[i + 1].minimum, mNodes[i + 1].maximum);
+                bounds.merge(AxisAlignedBox(mNodes[node.first].minimum, mNodes[node.first].maximum));
+            }
+            node.minimum = bounds.getMinimum();
+            node.maximum = bounds.getMaximum();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void BoundingVolumeHierarchy::clear()
+    {
+        mNodes.clear();
+        mPrimitives.clear();
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    void TriangleBVH::addTriangles(uint16 subMesh, const VertexData* vertexData, const IndexData* indexData)
+    {
+        const VertexElement* posElem =
+            vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        if (!posElem || !indexData->indexBuffer || indexData->indexCount < 3)
+            return;
+
+        HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+        HardwareBufferLockGuard vertexLock(vbuf, HardwareBuffer::HBL_READ_ONLY);
+        HardwareBufferLockGuard indexLock(indexData->indexBuffer, HardwareBuffer::HBL_READ_ONLY);
+
+        const uchar* vertices = static_cast<const uchar*>(vertexLock.pData) + vertexData->vertexStart * vbuf->getVertexSize();
+        bool use32bit = indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT;
+        const uint16* pShort = static_cast<const uint16*>(indexLock.pData) + indexData->indexStart;
+        const uint32* pInt = static_cast<const uint32*>(indexLock.pData) + indexData->indexStart;
+
+        for (size_t t = 0; t < indexData->indexCount / 3; ++t)
+        {
+            Triangle tri;
+            for (int c = 0; c < 3; ++c)
+            {
+                size_t index = use32bit ? pInt[3 * t + c] : pShort[3 * t + c];
+                float* pos;
+                posElem->baseVertexPointerToElement(const_cast<uchar*>(vertices + index * vbuf->getVertexSize()), &pos);
+                tri.corners[c] = Vector3(pos[0], pos[1], pos[2]);
+            }
+            tri.index = uint32(t);
+            tri.subMesh = subMesh;
+            mTriangles.push_back(tri);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void TriangleBVH::build()
+    {
+        std::vector<AxisAlignedBox> boxes(mTriangles.size());
+        for (size_t i = 0; i < mTriangles.size(); ++i)
+        {
+            boxes[i].setExtents(mTriangles[i].corners[0], mTriangles[i].corners[0]);
+            boxes[i].merge(mTriangles[i].corners[1]);
+            boxes[i].merge(mTriangles[i].corners[2]);
+        }
+        mBVH.build(boxes.data(), boxes.size());
+    }
+    //-----------------------------------------------------------------------
+    bool TriangleBVH::intersect(const Ray& ray, Real maxDistance, Hit& hit) const
+    {
+        const Vector3& origin = ray.getOrigin();
+        const Vector3& dir = ray.getDirection();
+
+        bool found = false;
+        mBVH.intersect(ray, maxDistance, [&](uint32 primitive, Real maxDist) {
+            const Triangle& tri = mTriangles[primitive];
+
+            // Moeller-Trumbore, both sides
+            Vector3 e1 = tri.corners[1] - tri.corners[0];
+            Vector3 e2 = tri.corners[2] - tri.corners[0];
+            Vector3 p = dir.crossProduct(e2);
+            Real det = e1.dotProduct(p);
+            if (std::abs(det) < std::numeric_limits<Real>::min())
+                return maxDist;
+            Real invDet = 1 / det;
+            Vector3 s = origin - tri.corners[0];
+            Real u = s.dotProduct(p) * invDet;
+            if (u < 0 || u > 1)
+                return maxDist;
+            Vector3 q = s.crossProduct(e1);
+            Real v = dir.dotProduct(q) * invDet;
+            if (v < 0 || u + v > 1)
+                return maxDist;
+            Real t = e2.dotProduct(q) * invDet;
+            if (t < 0 || t >= maxDist)
+                return maxDist;
+
+            hit.distance = t;
+            hit.triangle = tri.index;
+            hit.subMesh = tri.subMesh;
+            hit.barycentricCoords = Vector3(1 - u - v, u, v);
+            found = true;
+            return t;
+        });
+        return found;
+    }
+}
@@ -27,6 +27,17 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_LINUX || OGRE_PLATFORM == OGRE_PLATFORM_APPLE || \
+    OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
+#   define OGRE_HAVE_MMAP 1
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#else
+#   define OGRE_HAVE_MMAP 0
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -431,6 +442,14 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    String MemoryDataStream::getAsString(void)
+    {
+        // Copy the remainder in one go
+        String result(reinterpret_cast<const char*>(mPos), mEnd - mPos);
+        mPos = mEnd;
+        return result;
+    }
+    //-----------------------------------------------------------------------
     void MemoryDataStream::skip(long count)
     {
         size_t newpos = (size_t)( ( mPos - mData ) + count );
@@ -467,6 +486,62 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    MappedDataStream::MappedDataStream(const String& name, const String& path)
+        : MemoryDataStream(name, NULL, 0, false, true)
+    {
+#if OGRE_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+
+        struct stat tagStat;
+        if (fstat(fd, &tagStat) != 0)
+        {
+            ::close(fd);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot stat file: " + path);
+        }
+
+        if (tagStat.st_size == 0)
+        {
+            // empty files can not be mapped, they result in an empty stream
+            ::close(fd);
+            return;
+        }
+
+        // private, so in place modifications by codecs do not reach the file
+        void* data = mmap(NULL, tagStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping stays valid
+
+        if (data == MAP_FAILED)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot map file: " + path);
+
+        // start paging in, the data is usually parsed right away
+        posix_madvise(data, tagStat.st_size, POSIX_MADV_WILLNEED);
+
+        mData = mPos = static_cast<uchar*>(data);
+        mSize = tagStat.st_size;
+        mEnd = mData + mSize;
+#else
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Memory mapped files are not supported on this platform");
+#endif
+    }
+    //-----------------------------------------------------------------------
+    MappedDataStream::~MappedDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MappedDataStream::close(void)
+    {
+        mAccess = 0;
+#if OGRE_HAVE_MMAP
+        if (mData)
+            munmap(mData, mSize);
+#endif
+        mData = mPos = mEnd = 0;
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mInStream(s), mFStreamRO(s), mFStream(0), mFreeOnClose(freeOnClose)
     {
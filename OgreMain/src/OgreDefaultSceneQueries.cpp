@@ -26,6 +26,9 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreStableHeaders.h"
+#include "OgreEntity.h"
+#include "OgreBoundingVolumeHierarchy.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
     //---------------------------------------------------------------------
@@ -42,6 +45,12 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void DefaultIntersectionSceneQuery::execute(IntersectionSceneQueryListener* listener)
     {
+        if (mParentSceneMgr->getIntersectionSceneQueryBroadphaseEnabled())
+        {
+            executeBroadphase(listener);
+            return;
+        }
+
         // Iterate over all movable types
         const auto& factories = Root::getSingleton().getMovableObjectFactories();
         auto factIt = factories.begin();
@@ -112,6 +121,49 @@ namespace Ogre {
 
     }
     //---------------------------------------------------------------------
+    void DefaultIntersectionSceneQuery::executeBroadphase(IntersectionSceneQueryListener* listener)
+    {
+        const SceneManager::MovableObjectBroadphase& objects = mParentSceneMgr->_getMovableObjectBroadphase();
+
+        // Test the masks once per object rather than once per pair
+        std::vector<uchar> candidates(objects.objects.size());
+        for (size_t i = 0; i < candidates.size(); ++i)
+            candidates[i] = isCandidate(objects.objects[i]);
+
+        bool more = objects.sweepAndPrune.findPairs([&](uint32 a, uint32 b) {
+            if (!candidates[a] || !candidates[b])
+                return true;
+            return listener->queryResult(objects.objects[a], objects.objects[b]);
+        });
+        if (!more)
+            return;
+
+        // Objects with infinite bounds are not sorted, they overlap all objects with bounds
+        for (size_t i = 0; i < objects.others.size(); ++i)
+        {
+            MovableObject* a = objects.others[i];
+            if (!isCandidate(a))
+                continue;
+            const AxisAlignedBox& box = a->getWorldBoundingBox();
+
+            for (size_t j = i + 1; j < objects.others.size(); ++j)
+            {
+                MovableObject* b = objects.others[j];
+                if (isCandidate(b) && box.intersects(b->getWorldBoundingBox()))
+                {
+                    if (!listener->queryResult(a, b)) return;
+                }
+            }
+            for (size_t j = 0; j < objects.objects.size(); ++j)
+            {
+                if (candidates[j] && box.intersects(objects.boxes[j]))
+                {
+                    if (!listener->queryResult(a, objects.objects[j])) return;
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     DefaultAxisAlignedBoxSceneQuery::
     DefaultAxisAlignedBoxSceneQuery(SceneManager* creator)
     : AxisAlignedBoxSceneQuery(creator)
@@ -156,8 +208,42 @@ namespace Ogre {
     {
     }
     //---------------------------------------------------------------------
+    RaySceneQueryResult& DefaultRaySceneQuery::execute(void)
+    {
+        if (!mSortByDistance || mMaxResults != 1 || !mParentSceneMgr->getRaySceneQueryBVHEnabled())
+            return RaySceneQuery::execute();
+
+        // Only the closest result is wanted, so objects behind it can be skipped
+        mResult.clear();
+        RaySceneQueryResultEntry result;
+        if (findClosest(mParentSceneMgr->_getMovableObjectBVH(), mRay, result))
+            mResult.push_back(result);
+
+        return mResult;
+    }
+    //---------------------------------------------------------------------
     void DefaultRaySceneQuery::execute(RaySceneQueryListener* listener)
     {
+        RaySceneQueryResultEntry result;
+
+        if (mParentSceneMgr->getRaySceneQueryBVHEnabled())
+        {
+            const SceneManager::MovableObjectBVH& objects = mParentSceneMgr->_getMovableObjectBVH();
+            bool stop = false;
+            objects.bvh.intersect(mRay, Math::POS_INFINITY, [&](uint32 i, Real maxDistance) {
+                if (!stop && intersects(objects.objects[i], mRay, maxDistance, result))
+                    stop = !listener->queryResultEntry(result);
+                // a negative distance ends the traversal
+                return stop ? -1 : maxDistance;
+            });
+            for (size_t i = 0; i < objects.others.size() && !stop; ++i)
+            {
+                if (intersects(objects.others[i], mRay, Math::POS_INFINITY, result))
+                    stop = !listener->queryResultEntry(result);
+            }
+            return;
+        }
+
         // Note that because we have no scene partitioning, we actually
         // perform a complete scene search even if restricted results are
         // requested; smarter scene manager queries can utilise the paritioning 
@@ -174,21 +260,105 @@ namespace Ogre {
                 if (!(a->getTypeFlags() & mQueryTypeMask))
                     break;
 
-                if ((a->getQueryFlags() & mQueryMask) && a->isInScene())
+                // Do ray / box test, and triangle test if enabled
+                if (intersects(a, mRay, Math::POS_INFINITY, result))
                 {
-                    // Do ray / box test
-                    std::pair<bool, Real> result = mRay.intersects(a->getWorldBoundingBox());
-
-                    if (result.first)
-                    {
-                        if (!listener->queryResult(a, result.second)) return;
-                    }
+                    if (!listener->queryResultEntry(result)) return;
                 }
             }
         }
 
     }
     //---------------------------------------------------------------------
+    void DefaultRaySceneQuery::executeBatch(const Ray* rays, size_t count, RaySceneQueryResultEntry* results)
+    {
+        const SceneManager::MovableObjectBVH& objects = mParentSceneMgr->_getMovableObjectBVH();
+
+        // Meshes build their triangle hierarchy on first use, which must not happen concurrently
+        if (mTriangleIntersection)
+        {
+            for (auto obj : objects.objects)
+            {
+                if (obj->getTypeFlags() == SceneManager::ENTITY_TYPE_MASK)
+                    static_cast<Entity*>(obj)->getMesh()->getTriangleBVH();
+            }
+        }
+
+        Root::getSingleton().getWorkQueue()->parallelFor(count, 16, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                findClosest(objects, rays[i], results[i]);
+        });
+    }
+    //---------------------------------------------------------------------
+    bool DefaultRaySceneQuery::intersects(MovableObject* obj, const Ray& ray, Real maxDistance,
+                                          RaySceneQueryResultEntry& result) const
+    {
+        if (!(obj->getTypeFlags() & mQueryTypeMask) || !(obj->getQueryFlags() & mQueryMask) ||
+            !obj->isInScene())
+            return false;
+
+        std::pair<bool, Real> boxHit = ray.intersects(obj->getWorldBoundingBox());
+        if (!boxHit.first || boxHit.second > maxDistance)
+            return false;
+
+        result.distance = boxHit.second;
+        result.movable = obj;
+        result.worldFragment = NULL;
+        result.subMesh = NULL;
+        result.triangle = 0;
+        result.barycentricCoords = Vector3::ZERO;
+
+        // compare the flags exactly, objects without a creator report all of them
+        if (!mTriangleIntersection || obj->getTypeFlags() != SceneManager::ENTITY_TYPE_MASK)
+            return true;
+
+        const MeshPtr& mesh = static_cast<Entity*>(obj)->getMesh();
+        const TriangleBVH* triangles = mesh->getTriangleBVH();
+        // Meshes without triangles are reported by their bounds
+        if (triangles->getNumTriangles() == 0)
+            return true;
+
+        // The direction is not normalised, so that distances stay in world units
+        Affine3 toObject = obj->_getParentNodeFullTransform().inverse();
+        Ray localRay(toObject * ray.getOrigin(), toObject.linear() * ray.getDirection());
+
+        TriangleBVH::Hit hit;
+        if (!triangles->intersect(localRay, maxDistance, hit))
+            return false;
+
+        result.distance = hit.distance;
+        result.subMesh = mesh->getSubMesh(hit.subMesh);
+        result.triangle = hit.triangle;
+        result.barycentricCoords = hit.barycentricCoords;
+        return true;
+    }
+    //---------------------------------------------------------------------
+    bool DefaultRaySceneQuery::findClosest(const SceneManager::MovableObjectBVH& objects, const Ray& ray,
+                                           RaySceneQueryResultEntry& result) const
+    {
+        result.distance = Math::POS_INFINITY;
+        result.movable = NULL;
+        result.worldFragment = NULL;
+        result.subMesh = NULL;
+        result.triangle = 0;
+        result.barycentricCoords = Vector3::ZERO;
+
+        RaySceneQueryResultEntry candidate;
+        objects.bvh.intersect(ray, Math::POS_INFINITY, [&](uint32 i, Real maxDistance) {
+            if (!intersects(objects.objects[i], ray, maxDistance, candidate))
+                return maxDistance;
+            result = candidate;
+            return candidate.distance;
+        });
+        for (auto obj : objects.others)
+        {
+            if (intersects(obj, ray, result.distance, candidate))
+                result = candidate;
+        }
+
+        return result.movable != NULL;
+    }
+    //---------------------------------------------------------------------
     DefaultSphereSceneQuery::
     DefaultSphereSceneQuery(SceneManager* creator) : SphereSceneQuery(creator)
     {
@@ -219,6 +219,7 @@ namespace Ogre {
 #endif
         // Delete shadow renderables
         clearShadowRenderableList(mShadowRenderables);
+        mCachedShadowVolumes.clear();
 
         // Detach all child objects, do this manually to avoid needUpdate() call
         // which can fail because of deleted items
@@ -277,6 +278,7 @@ namespace Ogre {
     void Entity::_releaseManualHardwareResources()
     {
         clearShadowRenderableList(mShadowRenderables);
+        mCachedShadowVolumes.clear();
     }
     //-----------------------------------------------------------------------
     void Entity::_restoreManualHardwareResources()
@@ -860,6 +862,18 @@ namespace Ogre {
 
                     }
                 }
+                // Vertex animation locks the mesh buffers and writes the temporary ones, which
+                // software blends queued before might still hold
+                if (mManager)
+                {
+                    mManager->_flushSoftwareVertexBlends(mMesh->sharedVertexData);
+                    mManager->_flushSoftwareVertexBlends(mSoftwareVertexAnimVertexData.get());
+                    for (SubEntity* se : mSubEntityList)
+                    {
+                        mManager->_flushSoftwareVertexBlends(se->getSubMesh()->vertexData);
+                        mManager->_flushSoftwareVertexBlends(se->mSoftwareVertexAnimVertexData.get());
+                    }
+                }
                 applyVertexAnimation(hwAnimation, stencilShadows);
             }
 
@@ -871,6 +885,8 @@ namespace Ogre {
                 if (softwareAnimation)
                 {
                     const Affine3* blendMatrices[256];
+                    // Let the SceneManager batch the blends of all entities
+                    bool queueBlends = mManager != NULL;
 
                     // Ok, we need to do a software blend
                     // Firstly, check out working vertex buffers
@@ -887,12 +903,17 @@ namespace Ogre {
                         Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                                             mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
                         // Blend, taking source from either mesh data or morph data
-                        Mesh::softwareVertexBlend(
+                        const VertexData* sourceVertexData =
                             (mMesh->getSharedVertexDataAnimationType() != VAT_NONE) ?
-                            mSoftwareVertexAnimVertexData.get() : mMesh->sharedVertexData,
-                            mSkelAnimVertexData.get(),
-                            blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
-                            blendNormals);
+                            mSoftwareVertexAnimVertexData.get() : mMesh->sharedVertexData;
+                        if (!queueBlends ||
+                            !mManager->_queueSoftwareVertexBlend(sourceVertexData, mSkelAnimVertexData.get(),
+                                blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(), blendNormals))
+                        {
+                            Mesh::softwareVertexBlend(sourceVertexData, mSkelAnimVertexData.get(),
+                                blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+                                blendNormals);
+                        }
                     }
                     SubEntityList::iterator i, iend;
                     iend = mSubEntityList.end();
@@ -909,12 +930,17 @@ namespace Ogre {
                             Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                                                 mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
                             // Blend, taking source from either mesh data or morph data
-                            Mesh::softwareVertexBlend(
+                            const VertexData* sourceVertexData =
                                 (se->getSubMesh()->getVertexAnimationType() != VAT_NONE)?
-                                se->mSoftwareVertexAnimVertexData.get() : se->mSubMesh->vertexData,
-                                se->mSkelAnimVertexData.get(),
-                                blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
-                                blendNormals);
+                                se->mSoftwareVertexAnimVertexData.get() : se->mSubMesh->vertexData;
+                            if (!queueBlends ||
+                                !mManager->_queueSoftwareVertexBlend(sourceVertexData, se->mSkelAnimVertexData.get(),
+                                    blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(), blendNormals))
+                            {
+                                Mesh::softwareVertexBlend(sourceVertexData, se->mSkelAnimVertexData.get(),
+                                    blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+                                    blendNormals);
+                            }
                         }
 
                     }
@@ -2040,6 +2066,14 @@ namespace Ogre {
             esrPositionBuffer->suppressHardwareUpdate(false);
 
         }
+        if (!hasAnimation && mManager && mManager->getShadowVolumeCacheEnabled())
+        {
+            // Only rebuild the indexes if the light moved relative to us
+            const CachedShadowVolume& cached = updateCachedShadowVolume(light, lightPos, flags, edgeList);
+            uploadShadowVolume(cached.volume, *indexBuffer, *indexBufferUsedSize, mShadowRenderables, flags);
+            return mShadowRenderables;
+        }
+
         // Calc triangle light facing
         updateEdgeListLightFacing(edgeList, lightPos);
 
@@ -2051,6 +2085,80 @@ namespace Ogre {
         return mShadowRenderables;
     }
     //-----------------------------------------------------------------------
+    void Entity::_prepareShadowVolume(const Light* light, unsigned long flags)
+    {
+#if OGRE_NO_MESHLOD
+        unsigned short mMeshLodIndex = 0;
+#else
+        // Manual LOD levels are separate entities
+        if (mMesh->hasManualLodLevel() && mMeshLodIndex > 0)
+            return;
+#endif
+        // Anything else needs to be set up on the render thread first
+        if (!mParentNode || hasSkeleton() || hasVertexAnimation() || !mPreparedForShadowVolumes ||
+            mMesh->getStateCount() != mMeshStateCount || !mMesh->isEdgeListBuilt())
+            return;
+
+        const EdgeData* edgeList = static_cast<const Mesh*>(mMesh.get())->getEdgeList(mMeshLodIndex);
+        if (!edgeList || mShadowRenderables.size() != edgeList->edgeGroups.size())
+            return;
+
+        Vector4 lightPos = mParentNode->_getFullTransform().inverse() * light->getAs4DVector();
+        updateCachedShadowVolume(light, lightPos, flags, edgeList);
+    }
+    //-----------------------------------------------------------------------
+    const Entity::CachedShadowVolume& Entity::updateCachedShadowVolume(
+        const Light* light, const Vector4& lightPos, unsigned long flags, const EdgeData* edgeList)
+    {
+        // Rather few lights cast shadows on the same entity
+        static const size_t maxCachedShadowVolumes = 8;
+
+        bool useMcGuire = useMcGuireDarkCap(edgeList, light);
+
+        CachedShadowVolume* cached = NULL;
+        for (auto& c : mCachedShadowVolumes)
+        {
+            if (c.light == light)
+            {
+                cached = &c;
+                break;
+            }
+        }
+
+        if (!cached)
+        {
+            if (mCachedShadowVolumes.size() == maxCachedShadowVolumes)
+                mCachedShadowVolumes.erase(mCachedShadowVolumes.begin());
+            mCachedShadowVolumes.push_back(CachedShadowVolume());
+            cached = &mCachedShadowVolumes.back();
+            cached->light = light;
+            cached->edgeList = NULL;
+        }
+        else if (cached->edgeList == edgeList && cached->lightPos == lightPos && cached->flags == flags &&
+                 cached->useMcGuire == useMcGuire)
+        {
+            return *cached;
+        }
+
+        cached->lightPos = lightPos;
+        cached->flags = flags;
+        cached->useMcGuire = useMcGuire;
+        cached->edgeList = edgeList;
+
+        // Keep our own light facings, as the edge list is shared with other entities
+        cached->lightFacings.resize(edgeList->triangleFaceNormals.size());
+        if (!cached->lightFacings.empty())
+        {
+            OptimisedUtil::getImplementation()->calculateLightFacing(
+                lightPos, edgeList->triangleFaceNormals.data(), cached->lightFacings.data(),
+                cached->lightFacings.size());
+        }
+        buildShadowVolume(edgeList, cached->lightFacings.data(), light, useMcGuire, mShadowRenderables,
+                          flags, cached->volume);
+
+        return *cached;
+    }
+    //-----------------------------------------------------------------------
     const VertexData* Entity::findBlendedVertexData(const VertexData* orig)
     {
         bool skel = hasSkeleton();
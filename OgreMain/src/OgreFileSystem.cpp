@@ -116,6 +116,7 @@ namespace {
     };
 
     bool gIgnoreHidden = true;
+    bool gUseMemoryMapping = false;
 }
 
     //-----------------------------------------------------------------------
@@ -339,7 +340,13 @@ namespace {
 
         if(!readOnly) mode |= std::ios::out;
 
-        return _openFileStream(concatenate_path(mName, filename), mode, filename);
+        String full_path = concatenate_path(mName, filename);
+#if OGRE_PLATFORM == OGRE_PLATFORM_LINUX || OGRE_PLATFORM == OGRE_PLATFORM_APPLE || \
+    OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
+        if (readOnly && gUseMemoryMapping)
+            return std::make_shared<MappedDataStream>(filename, full_path);
+#endif
+        return _openFileStream(full_path, mode, filename);
     }
     DataStreamPtr _openFileStream(const String& full_path, std::ios::openmode mode, const String& name)
     {
@@ -573,4 +580,14 @@ namespace {
     {
         return gIgnoreHidden;
     }
+
+    void FileSystemArchiveFactory::setUseMemoryMapping(bool useMapping)
+    {
+        gUseMemoryMapping = useMapping;
+    }
+
+    bool FileSystemArchiveFactory::getUseMemoryMapping()
+    {
+        return gUseMemoryMapping;
+    }
 }
@@ -379,9 +379,10 @@ namespace Ogre {
         serialiser.writeChunkEnd(CACHE_CHUNK_ID);
     }
     //---------------------------------------------------------------------
-    void GpuProgramManager::loadMicrocodeCache( DataStreamPtr stream )
+    void GpuProgramManager::loadMicrocodeCache( DataStreamPtr stream, bool merge )
     {
-        mMicrocodeCache.clear();
+        if (!merge)
+            mMicrocodeCache.clear();
 
         StreamSerialiser serialiser(stream);
         const StreamSerialiser::Chunk* chunk;
@@ -426,7 +427,8 @@ namespace Ogre {
         serialiser.readChunkEnd(CACHE_CHUNK_ID);
 
         // if cache is not modified, mark it as clean.
-        mCacheDirty = false;
+        if (!merge)
+            mCacheDirty = false;
         
     }
     //---------------------------------------------------------------------
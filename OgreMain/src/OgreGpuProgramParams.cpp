@@ -933,6 +933,9 @@ namespace Ogre
         , mTransposeMatrices(false)
         , mIgnoreMissingParams(false)
         , mActivePassIterationIndex(std::numeric_limits<size_t>::max())
+        , mAutoConstantGroupsDirty(true)
+        , mDetectValueChanges(false)
+        , mValuesChanged(false)
     {
     }
     GpuProgramParameters::~GpuProgramParameters() {}
@@ -963,6 +966,9 @@ namespace Ogre
         mTransposeMatrices = oth.mTransposeMatrices;
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
         mActivePassIterationIndex = oth.mActivePassIterationIndex;
+        mAutoConstantGroupsDirty = true;
+        mDetectValueChanges = false;
+        mValuesChanged = false;
 
         return *this;
     }
@@ -1277,25 +1283,34 @@ namespace Ogre
         assert(physicalIndex + count <= mFloatConstants.size());
         for (size_t i = 0; i < count; ++i)
         {
-            mFloatConstants[physicalIndex+i] = static_cast<float>(val[i]);
+            float f = static_cast<float>(val[i]);
+            if (mDetectValueChanges && mFloatConstants[physicalIndex+i] != f)
+                mValuesChanged = true;
+            mFloatConstants[physicalIndex+i] = f;
         }
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const float* val, size_t count)
     {
         assert(physicalIndex + count <= mFloatConstants.size());
+        if (mDetectValueChanges && !mValuesChanged)
+            mValuesChanged = memcmp(&mFloatConstants[physicalIndex], val, sizeof(float) * count) != 0;
         memcpy(&mFloatConstants[physicalIndex], val, sizeof(float) * count);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const int* val, size_t count)
     {
         assert(physicalIndex + count <= mIntConstants.size());
+        if (mDetectValueChanges && !mValuesChanged)
+            mValuesChanged = memcmp(&mIntConstants[physicalIndex], val, sizeof(int) * count) != 0;
         memcpy(&mIntConstants[physicalIndex], val, sizeof(int) * count);
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const uint* val, size_t count)
     {
         assert(physicalIndex + count <= mIntConstants.size());
+        if (mDetectValueChanges && !mValuesChanged)
+            mValuesChanged = memcmp(&mIntConstants[physicalIndex], val, sizeof(uint) * count) != 0;
         memcpy(&mIntConstants[physicalIndex], val, sizeof(uint) * count);
     }
     //-----------------------------------------------------------------------------
@@ -1603,6 +1618,7 @@ namespace Ogre
                         ac.physicalIndex += insertCount;
                     }
                 }
+                mAutoConstantGroupsDirty = true;
                 if (mNamedConstants)
                 {
                     for (auto& p : mNamedConstants->map)
@@ -1815,6 +1831,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, extraInfo, variability, elementSize));
 
         mCombinedVariability |= variability;
+        mAutoConstantGroupsDirty = true;
 
 
     }
@@ -1865,6 +1882,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, rData, variability, elementSize));
 
         mCombinedVariability |= variability;
+        mAutoConstantGroupsDirty = true;
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::clearAutoConstant(size_t index)
@@ -1882,6 +1900,7 @@ namespace Ogre
                 if (i->physicalIndex == physicalIndex)
                 {
                     mAutoConstants.erase(i);
+                    mAutoConstantGroupsDirty = true;
                     break;
                 }
             }
@@ -1903,6 +1922,7 @@ namespace Ogre
                     if (i->physicalIndex == def->physicalIndex)
                     {
                         mAutoConstants.erase(i);
+                        mAutoConstantGroupsDirty = true;
                         break;
                     }
                 }
@@ -1914,6 +1934,7 @@ namespace Ogre
     {
         mAutoConstants.clear();
         mCombinedVariability = GPV_GLOBAL;
+        mAutoConstantGroupsDirty = true;
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::setAutoConstantReal(size_t index, AutoConstantType acType, Real rData)
@@ -1940,13 +1961,44 @@ namespace Ogre
     //-----------------------------------------------------------------------------
 
     //-----------------------------------------------------------------------------
-    void GpuProgramParameters::_updateAutoParams(const AutoParamDataSource* source, uint16 mask)
+    void GpuProgramParameters::buildAutoConstantGroups()
+    {
+        mAutoConstantOrder.resize(mAutoConstants.size());
+        for (size_t i = 0; i < mAutoConstantOrder.size(); ++i)
+            mAutoConstantOrder[i] = i;
+
+        // sort by variability first, so each group is a contiguous range
+        const AutoConstantList& autos = mAutoConstants;
+        std::sort(mAutoConstantOrder.begin(), mAutoConstantOrder.end(), [&autos](size_t a, size_t b) {
+            if (autos[a].variability != autos[b].variability)
+                return autos[a].variability < autos[b].variability;
+            return autos[a].physicalIndex < autos[b].physicalIndex;
+        });
+
+        mAutoConstantGroups.clear();
+        for (size_t i = 0; i < mAutoConstantOrder.size(); ++i)
+        {
+            uint16 variability = autos[mAutoConstantOrder[i]].variability;
+            if (mAutoConstantGroups.empty() || mAutoConstantGroups.back().variability != variability)
+            {
+                AutoConstantGroup group = {variability, i, i};
+                mAutoConstantGroups.push_back(group);
+            }
+            mAutoConstantGroups.back().end = i + 1;
+        }
+        mAutoConstantGroupsDirty = false;
+    }
+    //-----------------------------------------------------------------------------
+    uint16 GpuProgramParameters::_updateAutoParams(const AutoParamDataSource* source, uint16 mask)
     {
         // abort early if no autos
-        if (!hasAutoConstants()) return;
+        if (!hasAutoConstants()) return 0;
         // abort early if variability doesn't match any param
         if (!(mask & mCombinedVariability))
-            return;
+            return 0;
+
+        if (mAutoConstantGroupsDirty)
+            buildAutoConstantGroups();
 
         size_t index;
         size_t numMatrices;
@@ -1960,12 +2012,19 @@ namespace Ogre
 
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
-        // Autoconstant index is not a physical index
-        for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
+        uint16 changed = 0;
+        mDetectValueChanges = true;
+        for (const AutoConstantGroup& group : mAutoConstantGroups)
         {
             // Only update needed slots
-            if (i->variability & mask)
+            if (!(group.variability & mask))
+                continue;
+
+            mValuesChanged = false;
+            // Autoconstant index is not a physical index
+            for (size_t k = group.begin; k != group.end; ++k)
             {
+                const AutoConstantEntry* i = &mAutoConstants[mAutoConstantOrder[k]];
 
                 switch(i->paramType)
                 {
@@ -2597,8 +2656,13 @@ namespace Ogre
                     break;
                 };
             }
+
+            if (mValuesChanged)
+                changed |= group.variability;
         }
+        mDetectValueChanges = false;
 
+        return changed;
     }
     //---------------------------------------------------------------------------
     static size_t withArrayOffset(const GpuConstantDefinition* def, const String& name)
@@ -2965,6 +3029,7 @@ namespace Ogre
         mIntConstants = source.getIntConstantList();
         mAutoConstants = source.getAutoConstantList();
         mCombinedVariability = source.mCombinedVariability;
+        mAutoConstantGroupsDirty = true;
         copySharedParamSetUsage(source.mSharedParamSets);
     }
     //---------------------------------------------------------------------
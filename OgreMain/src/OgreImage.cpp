@@ -542,6 +542,191 @@ namespace Ogre {
         // scale the image from temp into our resized buffer
         Image::scale(temp.getPixelBox(), getPixelBox(), filter);
     }
+    //-----------------------------------------------------------------------------
+    namespace
+    {
+        inline float sRGBToLinear(float c)
+        {
+            return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+
+        inline float linearToSRGB(float c)
+        {
+            c = std::max(c, 0.0f);
+            return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1 / 2.4f) - 0.055f;
+        }
+
+        /// Fraction of the pixels whose alpha, scaled by alphaScale, is above alphaRef
+        float getAlphaCoverage(const std::vector<float>& pixels, float alphaRef, float alphaScale = 1)
+        {
+            size_t count = 0, numPixels = pixels.size() / 4;
+            for (size_t i = 0; i < numPixels; i++)
+                count += pixels[i * 4 + 3] * alphaScale > alphaRef;
+            return float(count) / numPixels;
+        }
+
+        /// Scale of the alpha that gives the coverage closest to the wanted one
+        float getAlphaCoverageScale(const std::vector<float>& pixels, float alphaRef, float coverage)
+        {
+            std::vector<float> alphas(pixels.size() / 4);
+            for (size_t i = 0; i < alphas.size(); i++)
+                alphas[i] = pixels[i * 4 + 3];
+
+            // the k-th largest alpha has to end up just above alphaRef
+            size_t k = size_t(coverage * alphas.size() + 0.5f);
+            if (k == 0)
+                return 1;
+            k = std::min(k, alphas.size());
+            std::nth_element(alphas.begin(), alphas.begin() + (k - 1), alphas.end(), std::greater<float>());
+            float alpha = alphas[k - 1];
+            if (alpha <= 0)
+                return 1;
+            return std::min(alphaRef / alpha * 1.0001f, 16.0f);
+        }
+    }
+    //-----------------------------------------------------------------------------
+    Image& Image::generateMipmaps(bool gammaCorrect, Filter filter, Real alphaCoverageRef)
+    {
+        OgreAssert(mAutoDelete, "generating mipmaps of dynamic images is not supported");
+        OgreAssert(PixelUtil::isAccessible(mFormat), "compressed formats are not supported");
+
+        uint32 numMips = 0;
+        for (uint32 w = mWidth, h = mHeight, d = mDepth; w > 1 || h > 1 || d > 1; numMips++)
+        {
+            w = std::max(w / 2, 1u);
+            h = std::max(h / 2, 1u);
+            d = std::max(d / 2, 1u);
+        }
+
+        size_t numFaces = getNumFaces();
+        std::vector<PixelBox> topLevels;
+        for (size_t face = 0; face < numFaces; face++)
+            topLevels.push_back(getPixelBox(face, 0));
+
+        // reassign buffer to temp image, make sure auto-delete is true
+        Image temp(mFormat, mWidth, mHeight, 1, mBuffer, true);
+        // do not delete[] mBuffer!  temp will destroy it
+
+        mNumMipmaps = numMips;
+        mBufSize = calculateSize(mNumMipmaps, numFaces, mWidth, mHeight, mDepth, mFormat);
+        mBuffer = OGRE_ALLOC_T(uchar, mBufSize, MEMCATEGORY_GENERAL);
+
+        bool coverage = alphaCoverageRef > 0 && getHasAlpha();
+        float alphaRef = float(alphaCoverageRef);
+
+        // 8 bit channels are converted to linear space by table
+        float sRGBTable[256];
+        bool useTable = gammaCorrect && PixelUtil::getComponentType(mFormat) == PCT_BYTE;
+        if (useTable)
+        {
+            for (int i = 0; i < 256; i++)
+                sRGBTable[i] = sRGBToLinear(i / 255.0f);
+        }
+
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+        auto parallelFor = [queue](size_t count, size_t grainSize, const WorkQueue::RangeFunction& func) {
+            if (queue)
+                queue->parallelFor(count, grainSize, func);
+            else
+                func(0, count);
+        };
+
+        std::vector<float> level, scaled;
+        FilteredResampler::Taps taps;
+        for (size_t face = 0; face < numFaces; face++)
+        {
+            PixelBox top = getPixelBox(face, 0);
+            memcpy(top.data, topLevels[face].data, top.getConsecutiveSize());
+
+            uint32 width = mWidth, height = mHeight, depth = mDepth;
+            level.resize(size_t(width) * height * depth * 4);
+
+            // unpack the top level, in rows
+            parallelFor(height * depth, 16, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; row++)
+                {
+                    uint32 y = uint32(row % height), z = uint32(row / height);
+                    float* pixels = &level[row * width * 4];
+                    PixelUtil::bulkPixelConversion(top.getSubVolume(Box(0, y, z, width, y + 1, z + 1)),
+                                                   PixelBox(width, 1, 1, PF_FLOAT32_RGBA, pixels));
+                    if (!gammaCorrect)
+                        continue;
+                    for (uint32 x = 0; x < width * 4; x++)
+                    {
+                        if ((x & 3) == 3)
+                            continue;
+                        pixels[x] = useTable ? sRGBTable[int(pixels[x] * 255 + 0.5f)] : sRGBToLinear(pixels[x]);
+                    }
+                }
+            });
+
+            float topCoverage = coverage ? getAlphaCoverage(level, alphaRef) : 0;
+
+            for (uint32 mip = 1; mip <= numMips; mip++)
+            {
+                uint32 newWidth = std::max(width / 2, 1u);
+                uint32 newHeight = std::max(height / 2, 1u);
+                uint32 newDepth = std::max(depth / 2, 1u);
+
+                // filter each axis in turn, the level is laid out as [depth][height][width][4]
+                const uint32 sizes[3] = {width, height, depth};
+                const uint32 newSizes[3] = {newWidth, newHeight, newDepth};
+                size_t blocks = size_t(height) * depth, length = 4;
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    if (sizes[axis] != newSizes[axis])
+                    {
+                        FilteredResampler::computeTaps(filter, sizes[axis], newSizes[axis], taps);
+                        scaled.resize(blocks * newSizes[axis] * length);
+                        size_t count = blocks * newSizes[axis];
+                        size_t grainSize = std::max<size_t>(1, 16384 / (length * taps.taps));
+                        parallelFor(count, grainSize, [&](size_t begin, size_t end) {
+                            FilteredResampler::scale(level.data(), scaled.data(), sizes[axis],
+                                                     newSizes[axis], length, taps, begin, end);
+                        });
+                        level.swap(scaled);
+                    }
+                    if (axis < 2)
+                    {
+                        length *= newSizes[axis];
+                        blocks /= sizes[axis + 1];
+                    }
+                }
+                width = newWidth;
+                height = newHeight;
+                depth = newDepth;
+
+                float alphaScale =
+                    coverage ? getAlphaCoverageScale(level, alphaRef, topCoverage) : 1;
+
+                // pack the level, keeping the linear data as source of the next one
+                PixelBox dst = getPixelBox(face, mip);
+                parallelFor(height * depth, 16, [&](size_t begin, size_t end) {
+                    std::vector<float> pixels(width * 4);
+                    for (size_t row = begin; row < end; row++)
+                    {
+                        uint32 y = uint32(row % height), z = uint32(row / height);
+                        memcpy(pixels.data(), &level[row * width * 4], width * 4 * sizeof(float));
+                        for (uint32 x = 0; x < width * 4; x += 4)
+                        {
+                            if (gammaCorrect)
+                            {
+                                pixels[x] = linearToSRGB(pixels[x]);
+                                pixels[x + 1] = linearToSRGB(pixels[x + 1]);
+                                pixels[x + 2] = linearToSRGB(pixels[x + 2]);
+                            }
+                            if (coverage)
+                                pixels[x + 3] = std::min(pixels[x + 3] * alphaScale, 1.0f);
+                        }
+                        PixelUtil::bulkPixelConversion(PixelBox(width, 1, 1, PF_FLOAT32_RGBA, pixels.data()),
+                                                       dst.getSubVolume(Box(0, y, z, width, y + 1, z + 1)));
+                    }
+                });
+            }
+        }
+
+        return *this;
+    }
     //-----------------------------------------------------------------------
     void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter) 
     {
@@ -30,6 +30,11 @@ THE SOFTWARE.
 
 #include <algorithm>
 
+#include "OgrePlatformInformation.h"
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+#include "OgreSIMDHelper.h"
+#endif
+
 // this file is inlined into OgreImage.cpp!
 // do not include anywhere else.
 namespace Ogre {
@@ -337,6 +342,186 @@ template<unsigned int channels> struct LinearResampler_Byte {
         }
     }
 };
+
+// separable filtering resampler, used to generate mipmaps.
+// works on consecutive FLOAT32_RGBA data, one axis at a time. The taps of an
+// axis are computed once, with clamp-to-edge addressing, so the inner loops
+// are plain multiply-adds over consecutive floats, done four at a time with SSE.
+struct FilteredResampler {
+    // source indices and normalised weights, taps entries per destination index
+    struct Taps {
+        uint32 taps;
+        std::vector<uint32> indices;
+        std::vector<float> weights;
+    };
+
+    // kernel radius in destination pixels
+    static float getSupport(Image::Filter filter) {
+        switch (filter) {
+        case Image::FILTER_TRIANGLE: return 1.0f;
+        case Image::FILTER_BICUBIC: return 2.0f;
+        case Image::FILTER_KAISER:
+        case Image::FILTER_LANCZOS: return 3.0f;
+        default: return 0.5f;
+        }
+    }
+
+    static float sinc(float x) {
+        if (std::abs(x) < 1e-5f)
+            return 1.0f;
+        x *= Math::PI;
+        return std::sin(x) / x;
+    }
+
+    // modified bessel function of the first kind, order 0
+    static float bessel0(float x) {
+        float sum = 1.0f, term = 1.0f;
+        for (int k = 1; term > sum * 1e-8f; k++) {
+            float t = x / (2.0f * k);
+            term *= t * t;
+            sum += term;
+        }
+        return sum;
+    }
+
+    static float evaluate(Image::Filter filter, float x) {
+        x = std::abs(x);
+        switch (filter) {
+        case Image::FILTER_TRIANGLE:
+            return std::max(0.0f, 1.0f - x);
+        case Image::FILTER_BICUBIC: {
+            // Mitchell-Netravali, B = C = 1/3
+            const float B = 1.0f / 3, C = 1.0f / 3;
+            if (x < 1.0f)
+                return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x +
+                        (6 - 2 * B)) / 6;
+            if (x < 2.0f)
+                return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x +
+                        (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6;
+            return 0.0f;
+        }
+        case Image::FILTER_KAISER: {
+            // width 3, alpha 4
+            const float alpha = 4.0f;
+            if (x >= 3.0f)
+                return 0.0f;
+            float t = x / 3.0f;
+            return sinc(x) * bessel0(alpha * std::sqrt(1.0f - t * t)) / bessel0(alpha);
+        }
+        case Image::FILTER_LANCZOS:
+            return x < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+        default:
+            return x < 0.5f ? 1.0f : (x == 0.5f ? 0.5f : 0.0f);
+        }
+    }
+
+    static void computeTaps(Image::Filter filter, uint32 srcSize, uint32 dstSize, Taps& taps) {
+        float scale = float(srcSize) / dstSize;
+        float radius = getSupport(filter) * std::max(scale, 1.0f);
+        taps.taps = uint32(std::ceil(radius * 2)) + 1;
+        taps.indices.resize(dstSize * taps.taps);
+        taps.weights.resize(dstSize * taps.taps);
+
+        for (uint32 i = 0; i < dstSize; i++) {
+            float centre = (i + 0.5f) * scale;
+            int first = int(std::floor(centre - radius));
+            uint32* idx = &taps.indices[i * taps.taps];
+            float* w = &taps.weights[i * taps.taps];
+            float total = 0;
+            for (uint32 t = 0; t < taps.taps; t++) {
+                int j = first + int(t);
+                w[t] = evaluate(filter, (j + 0.5f - centre) / std::max(scale, 1.0f));
+                idx[t] = uint32(Math::Clamp(j, 0, int(srcSize) - 1));
+                total += w[t];
+            }
+            for (uint32 t = 0; t < taps.taps; t++)
+                w[t] /= total;
+        }
+    }
+
+    // src is laid out as [blocks][srcSize][length], dst as [blocks][dstSize][length].
+    // computes the destination samples [begin, end) of the blocks*dstSize samples.
+    static void scale(const float* src, float* dst, uint32 srcSize, uint32 dstSize,
+                      size_t length, const Taps& taps, size_t begin, size_t end) {
+        for (size_t o = begin; o < end; o++) {
+            size_t block = o / dstSize;
+            size_t i = o % dstSize;
+            const float* in = src + block * srcSize * length;
+            const uint32* idx = &taps.indices[i * taps.taps];
+            const float* w = &taps.weights[i * taps.taps];
+            float* out = dst + o * length;
+
+            if (length == 4)
+                scalePixel(in, idx, w, taps.taps, out);
+            else
+                scaleRow(in, idx, w, taps.taps, length, out);
+        }
+    }
+
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+    // single RGBA pixels, horizontal pass
+    static void scalePixel(const float* in, const uint32* idx, const float* w, uint32 taps,
+                           float* out) {
+        __m128 sum = _mm_setzero_ps();
+        for (uint32 t = 0; t < taps; t++)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[t]), _mm_loadu_ps(in + idx[t] * 4)));
+        _mm_storeu_ps(out, sum);
+    }
+
+    // whole rows or slices, vertical and depth passes. length is a multiple of 4.
+    // sums the taps of 16 floats in registers before storing them
+    static void scaleRow(const float* in, const uint32* idx, const float* w, uint32 taps,
+                         size_t length, float* out) {
+        size_t k = 0;
+        for (; k + 16 <= length; k += 16) {
+            __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+            __m128 s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+            for (uint32 t = 0; t < taps; t++) {
+                const float* p = in + idx[t] * length + k;
+                __m128 wt = _mm_set1_ps(w[t]);
+                s0 = _mm_add_ps(s0, _mm_mul_ps(wt, _mm_loadu_ps(p)));
+                s1 = _mm_add_ps(s1, _mm_mul_ps(wt, _mm_loadu_ps(p + 4)));
+                s2 = _mm_add_ps(s2, _mm_mul_ps(wt, _mm_loadu_ps(p + 8)));
+                s3 = _mm_add_ps(s3, _mm_mul_ps(wt, _mm_loadu_ps(p + 12)));
+            }
+            _mm_storeu_ps(out + k, s0);
+            _mm_storeu_ps(out + k + 4, s1);
+            _mm_storeu_ps(out + k + 8, s2);
+            _mm_storeu_ps(out + k + 12, s3);
+        }
+        for (; k < length; k += 4) {
+            __m128 sum = _mm_setzero_ps();
+            for (uint32 t = 0; t < taps; t++)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[t]), _mm_loadu_ps(in + idx[t] * length + k)));
+            _mm_storeu_ps(out + k, sum);
+        }
+    }
+#else
+    static void scalePixel(const float* in, const uint32* idx, const float* w, uint32 taps,
+                           float* out) {
+        float r = 0, g = 0, b = 0, a = 0;
+        for (uint32 t = 0; t < taps; t++) {
+            const float* p = in + idx[t] * 4;
+            r += w[t] * p[0];
+            g += w[t] * p[1];
+            b += w[t] * p[2];
+            a += w[t] * p[3];
+        }
+        out[0] = r; out[1] = g; out[2] = b; out[3] = a;
+    }
+
+    static void scaleRow(const float* in, const uint32* idx, const float* w, uint32 taps,
+                         size_t length, float* out) {
+        std::fill(out, out + length, 0.0f);
+        for (uint32 t = 0; t < taps; t++) {
+            const float* p = in + idx[t] * length;
+            const float wt = w[t];
+            for (size_t k = 0; k < length; k++)
+                out[k] += wt * p[k];
+        }
+    }
+#endif
+};
 /** @} */
 /** @} */
 
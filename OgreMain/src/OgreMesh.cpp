@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "OgreSkeletonManager.h"
 #include "OgreEdgeListBuilder.h"
+#include "OgreBoundingVolumeHierarchy.h"
 #include "OgreAnimation.h"
 #include "OgreAnimationState.h"
 #include "OgreAnimationTrack.h"
@@ -56,6 +57,7 @@ namespace Ogre {
         mPreparedForShadowVolumes(false),
         mEdgeListsBuilt(false),
         mAutoBuildEdgeLists(true), // will be set to false by serializers of 1.30 and above
+        mTriangleBVH(NULL),
         mSharedVertexDataAnimationType(VAT_NONE),
         mSharedVertexDataAnimationIncludesNormals(false),
         mAnimationTypesDirty(true),
@@ -208,8 +210,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless already there (e.g. memory mapped)
+        if (!dynamic_cast<MemoryDataStream*>(mFreshFromDisk.get()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -263,6 +266,7 @@ namespace Ogre {
         mSubMeshNameMap.clear();
 
         freeEdgeList();
+        freeTriangleBVH();
 #if !OGRE_NO_MESHLOD
         // Removes all LOD data
         removeLodLevels();
@@ -1845,6 +1849,33 @@ namespace Ogre {
         mEdgeListsBuilt = false;
     }
     //---------------------------------------------------------------------
+    const TriangleBVH* Mesh::getTriangleBVH(void)
+    {
+        if (mTriangleBVH)
+            return mTriangleBVH;
+
+        mTriangleBVH = OGRE_NEW TriangleBVH();
+        for (size_t i = 0; i < mSubMeshList.size(); ++i)
+        {
+            SubMesh* sm = mSubMeshList[i];
+            if (sm->operationType != RenderOperation::OT_TRIANGLE_LIST)
+                continue;
+
+            const VertexData* vertexData = sm->useSharedVertices ? sharedVertexData : sm->vertexData;
+            if (vertexData)
+                mTriangleBVH->addTriangles(uint16(i), vertexData, sm->indexData);
+        }
+        mTriangleBVH->build();
+
+        return mTriangleBVH;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::freeTriangleBVH(void)
+    {
+        OGRE_DELETE mTriangleBVH;
+        mTriangleBVH = NULL;
+    }
+    //---------------------------------------------------------------------
     void Mesh::prepareForShadowVolume(void)
     {
         if (mPreparedForShadowVolumes)
@@ -1911,6 +1942,35 @@ namespace Ogre {
         const VertexData* targetVertexData,
         const Affine3* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
+    {
+        // at most positions, normals, indices and weights of the source and
+        // positions and normals of the target
+        HardwareBufferLockGuard locks[6];
+        size_t numLocks = 0;
+
+        SoftwareVertexBlendData data;
+        prepareSoftwareVertexBlend(sourceVertexData, targetVertexData, blendNormals,
+            [&](const HardwareVertexBufferSharedPtr& buf, HardwareBuffer::LockOptions options) {
+                HardwareBufferLockGuard& lock = locks[numLocks++];
+                lock.lock(buf.get(), options);
+                return lock.pData;
+            }, data);
+
+        OptimisedUtil::getImplementation()->softwareVertexSkinning(
+            data.srcPos, data.destPos,
+            data.srcNorm, data.destNorm,
+            data.blendWeight, data.blendIndex,
+            blendMatrices,
+            data.srcPosStride, data.destPosStride,
+            data.srcNormStride, data.destNormStride,
+            data.blendWeightStride, data.blendIndexStride,
+            data.numWeightsPerVertex,
+            data.numVertices);
+    }
+    //---------------------------------------------------------------------
+    void Mesh::prepareSoftwareVertexBlend(const VertexData* sourceVertexData,
+        const VertexData* targetVertexData, bool blendNormals,
+        const BufferLockFunction& lockFunc, SoftwareVertexBlendData& data)
     {
         float *pSrcPos = 0;
         float *pSrcNorm = 0;
@@ -1974,63 +2034,67 @@ namespace Ogre {
         }
 
         // Lock source buffers for reading
-        HardwareBufferLockGuard srcPosLock(srcPosBuf, HardwareBuffer::HBL_READ_ONLY);
-        srcElemPos->baseVertexPointerToElement(srcPosLock.pData, &pSrcPos);
-        HardwareBufferLockGuard srcNormLock;
+        void* pSrcPosData = lockFunc(srcPosBuf, HardwareBuffer::HBL_READ_ONLY);
+        srcElemPos->baseVertexPointerToElement(pSrcPosData, &pSrcPos);
         if (includeNormals)
         {
+            void* pSrcNormData = pSrcPosData;
             if (srcNormBuf != srcPosBuf)
             {
                 // Different buffer
-                srcNormLock.lock(srcNormBuf, HardwareBuffer::HBL_READ_ONLY);
+                pSrcNormData = lockFunc(srcNormBuf, HardwareBuffer::HBL_READ_ONLY);
             }
-            srcElemNorm->baseVertexPointerToElement(srcNormBuf != srcPosBuf ? srcNormLock.pData : srcPosLock.pData, &pSrcNorm);
+            srcElemNorm->baseVertexPointerToElement(pSrcNormData, &pSrcNorm);
         }
 
         // Indices must be 4 bytes
         assert(srcElemBlendIndices->getType() == VET_UBYTE4 &&
                "Blend indices must be VET_UBYTE4");
-        HardwareBufferLockGuard srcIdxLock(srcIdxBuf, HardwareBuffer::HBL_READ_ONLY);
-        srcElemBlendIndices->baseVertexPointerToElement(srcIdxLock.pData, &pBlendIdx);
-        HardwareBufferLockGuard srcWeightLock;
+        void* pSrcIdxData = lockFunc(srcIdxBuf, HardwareBuffer::HBL_READ_ONLY);
+        srcElemBlendIndices->baseVertexPointerToElement(pSrcIdxData, &pBlendIdx);
+        void* pSrcWeightData = pSrcIdxData;
         if (srcWeightBuf != srcIdxBuf)
         {
             // Lock buffer
-            srcWeightLock.lock(srcWeightBuf, HardwareBuffer::HBL_READ_ONLY);
+            pSrcWeightData = lockFunc(srcWeightBuf, HardwareBuffer::HBL_READ_ONLY);
         }
-        srcElemBlendWeights->baseVertexPointerToElement(srcWeightBuf != srcIdxBuf ? srcWeightLock.pData : srcIdxLock.pData, &pBlendWeight);
+        srcElemBlendWeights->baseVertexPointerToElement(pSrcWeightData, &pBlendWeight);
         unsigned short numWeightsPerVertex =
             VertexElement::getTypeCount(srcElemBlendWeights->getType());
 
 
         // Lock destination buffers for writing
-        HardwareBufferLockGuard destPosLock(destPosBuf,
+        void* pDestPosData = lockFunc(destPosBuf,
             (destNormBuf != destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize()) ||
             (destNormBuf == destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize() + destElemNorm->getSize()) ?
             HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
-        destElemPos->baseVertexPointerToElement(destPosLock.pData, &pDestPos);
-        HardwareBufferLockGuard destNormLock;
+        destElemPos->baseVertexPointerToElement(pDestPosData, &pDestPos);
         if (includeNormals)
         {
+            void* pDestNormData = pDestPosData;
             if (destNormBuf != destPosBuf)
             {
-                destNormLock.lock(destNormBuf,
+                pDestNormData = lockFunc(destNormBuf,
                     destNormBuf->getVertexSize() == destElemNorm->getSize() ?
                     HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
             }
-            destElemNorm->baseVertexPointerToElement(destNormBuf != destPosBuf ? destNormLock.pData : destPosLock.pData, &pDestNorm);
-        }
-
-        OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
-            pBlendWeight, pBlendIdx,
-            blendMatrices,
-            srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
-            blendWeightStride, blendIdxStride,
-            numWeightsPerVertex,
-            targetVertexData->vertexCount);
+            destElemNorm->baseVertexPointerToElement(pDestNormData, &pDestNorm);
+        }
+
+        data.srcPos = pSrcPos;
+        data.destPos = pDestPos;
+        data.srcNorm = pSrcNorm;
+        data.destNorm = pDestNorm;
+        data.blendWeight = pBlendWeight;
+        data.blendIndex = pBlendIdx;
+        data.srcPosStride = srcPosStride;
+        data.destPosStride = destPosStride;
+        data.srcNormStride = srcNormStride;
+        data.destNormStride = destNormStride;
+        data.blendWeightStride = blendWeightStride;
+        data.blendIndexStride = blendIdxStride;
+        data.numWeightsPerVertex = numWeightsPerVertex;
+        data.numVertices = targetVertexData->vertexCount;
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexMorph(Real t,
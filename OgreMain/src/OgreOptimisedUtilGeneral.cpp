@@ -91,6 +91,56 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Vector4* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            size_t stride,
+            char* visibilities,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::calculateDerivedTransforms
+        virtual void calculateDerivedTransforms(
+            const float* local,
+            float* derived,
+            size_t stride,
+            const uint32* parents,
+            const uchar* inherit,
+            const uint32* indices,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertUnormByteToFloat
+        virtual void convertUnormByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToUnormByte
+        virtual void convertFloatToUnormByte(
+            const float* src,
+            uint8* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::expandRGB8ToRGBA8
+        virtual void expandRGB8ToRGBA8(
+            const uint8* src,
+            uint8* dst,
+            size_t numPixels);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -364,6 +414,129 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateBoxVisibility(
+        const Vector4* planes,
+        size_t numPlanes,
+        const float* centres,
+        const float* halfSizes,
+        size_t stride,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            Vector3 centre(centres[i], centres[stride + i], centres[2 * stride + i]);
+            Vector3 halfSize(halfSizes[i], halfSizes[stride + i], halfSizes[2 * stride + i]);
+
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes && visible; ++p)
+            {
+                // same as Plane::getSide != NEGATIVE_SIDE
+                Vector3 normal = planes[p].xyz();
+                visible = !(normal.dotProduct(centre) + planes[p].w < -normal.absDotProduct(halfSize));
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateDerivedTransforms(
+        const float* local,
+        float* derived,
+        size_t stride,
+        const uint32* parents,
+        const uchar* inherit,
+        const uint32* indices,
+        size_t numNodes)
+    {
+        const float* lpos = local;
+        const float* lscl = local + 3 * stride;
+        const float* lrot = local + 6 * stride;
+        float* dpos = derived;
+        float* dscl = derived + 3 * stride;
+        float* drot = derived + 6 * stride;
+
+        for (size_t k = 0; k < numNodes; ++k)
+        {
+            size_t i = indices[k];
+            size_t p = parents[i];
+
+            Vector3 parentPosition(dpos[p], dpos[stride + p], dpos[2 * stride + p]);
+            Vector3 parentScale(dscl[p], dscl[stride + p], dscl[2 * stride + p]);
+            Quaternion parentOrientation(drot[p], drot[stride + p], drot[2 * stride + p], drot[3 * stride + p]);
+
+            Vector3 position(lpos[i], lpos[stride + i], lpos[2 * stride + i]);
+            Vector3 scale(lscl[i], lscl[stride + i], lscl[2 * stride + i]);
+            Quaternion orientation(lrot[i], lrot[stride + i], lrot[2 * stride + i], lrot[3 * stride + i]);
+
+            // same as Node::updateFromParentImpl
+            if (inherit[i] & 1)
+                orientation = parentOrientation * orientation;
+            if (inherit[i] & 2)
+                scale = parentScale * scale;
+            position = parentOrientation * (parentScale * position) + parentPosition;
+
+            for (int c = 0; c < 3; ++c)
+            {
+                dpos[c * stride + i] = position[c];
+                dscl[c * stride + i] = scale[c];
+            }
+            for (int c = 0; c < 4; ++c)
+                drot[c * stride + i] = orientation[c];
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertHalfToFloat(
+        const uint16* src,
+        float* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = Bitwise::halfToFloat(src[i]);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertFloatToHalf(
+        const float* src,
+        uint16* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = Bitwise::floatToHalf(src[i]);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertUnormByteToFloat(
+        const uint8* src,
+        float* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = Bitwise::fixedToFloat(src[i], 8);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::convertFloatToUnormByte(
+        const float* src,
+        uint8* dst,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = static_cast<uint8>(Bitwise::floatToFixed(src[i], 8));
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::expandRGB8ToRGBA8(
+        const uint8* src,
+        uint8* dst,
+        size_t numPixels)
+    {
+        for (size_t i = 0; i < numPixels; ++i)
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = 0xFF;
+            src += 3;
+            dst += 4;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
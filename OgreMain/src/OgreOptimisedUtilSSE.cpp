@@ -35,6 +35,32 @@ THE SOFTWARE.
 // other header file on some platform for some reason.
 #include "OgreSIMDHelper.h"
 
+// AVX2/FMA routines are compiled for the target ISA on function level, and only
+// used when the CPU supports them, so the rest of the file stays plain SSE.
+#if __OGRE_HAVE_SSE && (OGRE_COMPILER == OGRE_COMPILER_MSVC && OGRE_COMP_VER >= 1800 || \
+    OGRE_COMPILER == OGRE_COMPILER_CLANG || OGRE_COMPILER == OGRE_COMPILER_GNUC && OGRE_COMP_VER >= 490)
+#   define __OGRE_HAVE_AVX2 1
+#   include <immintrin.h>
+#   if OGRE_COMPILER == OGRE_COMPILER_MSVC
+#       define __OGRE_AVX2_TARGET
+#   else
+#       define __OGRE_AVX2_TARGET __attribute__((target("avx2,fma")))
+#   endif
+#else
+#   define __OGRE_HAVE_AVX2 0
+#endif
+
+// The integer routines need SSE2, which 32 bit x86 builds with plain -msse
+// do not enable. They fall back to scalar code there.
+#if __OGRE_HAVE_NEON || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define __OGRE_HAVE_SSE2 1
+#   if __OGRE_HAVE_SSE
+#       include <emmintrin.h>
+#   endif
+#else
+#   define __OGRE_HAVE_SSE2 0
+#endif
+
 // I'd like to merge this file with OgreOptimisedUtil.cpp, but it's
 // impossible when compile with gcc, due SSE instructions can only
 // enable/disable at file level.
@@ -75,6 +101,8 @@ namespace Ogre {
     protected:
         /// Do we prefer to use a general SSE version for position/normal shared buffers?
         bool mPreferGeneralVersionForSharedBuffers;
+        /// Do we use the AVX2/FMA versions where available?
+        bool mUseAVX2;
 
     public:
         /// Constructor
@@ -129,6 +157,56 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateBoxVisibility(
+            const Vector4* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            size_t stride,
+            char* visibilities,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::calculateDerivedTransforms
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateDerivedTransforms(
+            const float* local,
+            float* derived,
+            size_t stride,
+            const uint32* parents,
+            const uchar* inherit,
+            const uint32* indices,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertUnormByteToFloat
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertUnormByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::convertFloatToUnormByte
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE convertFloatToUnormByte(
+            const float* src,
+            uint8* dst,
+            size_t count);
+
+        /// @copydoc OptimisedUtil::expandRGB8ToRGBA8
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE expandRGB8ToRGBA8(
+            const uint8* src,
+            uint8* dst,
+            size_t numPixels);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -268,6 +346,120 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Vector4* planes,
+            size_t numPlanes,
+            const float* centres,
+            const float* halfSizes,
+            size_t stride,
+            char* visibilities,
+            size_t numBoxes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateBoxVisibility(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                stride,
+                visibilities,
+                numBoxes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateDerivedTransforms
+        virtual void calculateDerivedTransforms(
+            const float* local,
+            float* derived,
+            size_t stride,
+            const uint32* parents,
+            const uchar* inherit,
+            const uint32* indices,
+            size_t numNodes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateDerivedTransforms(
+                local,
+                derived,
+                stride,
+                parents,
+                inherit,
+                indices,
+                numNodes);
+        }
+
+        /// @copydoc OptimisedUtil::convertHalfToFloat
+        virtual void convertHalfToFloat(
+            const uint16* src,
+            float* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertHalfToFloat(
+                src,
+                dst,
+                count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToHalf
+        virtual void convertFloatToHalf(
+            const float* src,
+            uint16* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertFloatToHalf(
+                src,
+                dst,
+                count);
+        }
+
+        /// @copydoc OptimisedUtil::convertUnormByteToFloat
+        virtual void convertUnormByteToFloat(
+            const uint8* src,
+            float* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertUnormByteToFloat(
+                src,
+                dst,
+                count);
+        }
+
+        /// @copydoc OptimisedUtil::convertFloatToUnormByte
+        virtual void convertFloatToUnormByte(
+            const float* src,
+            uint8* dst,
+            size_t count)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->convertFloatToUnormByte(
+                src,
+                dst,
+                count);
+        }
+
+        /// @copydoc OptimisedUtil::expandRGB8ToRGBA8
+        virtual void expandRGB8ToRGBA8(
+            const uint8* src,
+            uint8* dst,
+            size_t numPixels)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->expandRGB8ToRGBA8(
+                src,
+                dst,
+                numPixels);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -1033,12 +1225,85 @@ namespace Ogre {
                 numIterations);
         }
     }
+#if __OGRE_HAVE_AVX2
+    //---------------------------------------------------------------------
+    // AVX2/FMA version of software vertex skinning, handles any buffer layout.
+    //
+    // Row 0 and 1 of the blend matrices are accumulated as one 256-bit
+    // register, row 2 as a 128-bit one, with fused multiply-add. Position
+    // and normal are then transformed by horizontal adds of the products.
+    //
+    __OGRE_AVX2_TARGET
+    static void softwareVertexSkinning_AVX2(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        for (size_t i = 0; i < numVertices; ++i)
+        {
+            // Collapse the weighted matrices
+            __m256 m01 = _mm256_setzero_ps();
+            __m128 m2 = _mm_setzero_ps();
+            for (size_t w = 0; w < numWeightsPerVertex; ++w)
+            {
+                const Affine3& mat = *blendMatrices[pBlendIndex[w]];
+                __m256 weight = _mm256_broadcast_ss(pBlendWeight + w);
+                m01 = _mm256_fmadd_ps(_mm256_loadu_ps(mat[0]), weight, m01);
+                m2 = _mm_fmadd_ps(_mm_loadu_ps(mat[2]), _mm256_castps256_ps128(weight), m2);
+            }
+
+            // Transform position, w = 1
+            __m128 p = _mm_setr_ps(pSrcPos[0], pSrcPos[1], pSrcPos[2], 1.0f);
+            __m256 r01 = _mm256_mul_ps(m01, _mm256_insertf128_ps(_mm256_castps128_ps256(p), p, 1));
+            __m128 r2 = _mm_mul_ps(m2, p);
+            __m128 r = _mm_hadd_ps(
+                _mm_hadd_ps(_mm256_castps256_ps128(r01), _mm256_extractf128_ps(r01, 1)),
+                _mm_hadd_ps(r2, r2));
+            _mm_storel_pi((__m64*)pDestPos, r);
+            _mm_store_ss(pDestPos + 2, _mm_movehl_ps(r, r));
+
+            if (pSrcNorm)
+            {
+                // Transform normal, w = 0, and renormalise
+                __m128 n = _mm_setr_ps(pSrcNorm[0], pSrcNorm[1], pSrcNorm[2], 0.0f);
+                __m256 n01 = _mm256_mul_ps(m01, _mm256_insertf128_ps(_mm256_castps128_ps256(n), n, 1));
+                __m128 n2 = _mm_mul_ps(m2, n);
+                n = _mm_hadd_ps(
+                    _mm_hadd_ps(_mm256_castps256_ps128(n01), _mm256_extractf128_ps(n01, 1)),
+                    _mm_hadd_ps(n2, n2));
+                n = _mm_mul_ps(n, __MM_RSQRT_PS(_mm_dp_ps(n, n, 0x77)));
+                _mm_storel_pi((__m64*)pDestNorm, n);
+                _mm_store_ss(pDestNorm + 2, _mm_movehl_ps(n, n));
+
+                advanceRawPointer(pSrcNorm, srcNormStride);
+                advanceRawPointer(pDestNorm, destNormStride);
+            }
+
+            advanceRawPointer(pSrcPos, srcPosStride);
+            advanceRawPointer(pDestPos, destPosStride);
+            advanceRawPointer(pBlendWeight, blendWeightStride);
+            advanceRawPointer(pBlendIndex, blendIndexStride);
+        }
+    }
+#endif
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     OptimisedUtilSSE::OptimisedUtilSSE(void)
         : mPreferGeneralVersionForSharedBuffers(false)
+        , mUseAVX2(false)
     {
+#if __OGRE_HAVE_AVX2
+        const uint requiredFeatures = PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+        mUseAVX2 = (PlatformInformation::getCpuFeatures() & requiredFeatures) == requiredFeatures;
+#endif
+
         // For AMD Athlon XP (but not that for Althon 64), it's prefer to never use
         // unrolled version for shared buffers at all, I guess because that version
         // run out of usable CPU registers, or L1/L2 cache related problem, causing
@@ -1074,6 +1339,23 @@ namespace Ogre {
 
         __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
 
+#if __OGRE_HAVE_AVX2
+        if (mUseAVX2)
+        {
+            softwareVertexSkinning_AVX2(
+                pSrcPos, pDestPos,
+                pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIndex,
+                blendMatrices,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIndexStride,
+                numWeightsPerVertex,
+                numVertices);
+            return;
+        }
+#endif
+
         // All position/normal pointers should be perfect aligned, but still check here
         // for avoid hardware buffer which allocated by potential buggy driver doesn't
         // support alignment properly.
@@ -1722,6 +2004,66 @@ namespace Ogre {
 
 #undef __LOAD_VECTOR3
     }
+    //---------------------------------------------------------------------
+    // Map to convert 4-bits mask to 4 byte values
+    static const char msMaskMapping[16][4] =
+    {
+        {0, 0, 0, 0},   {1, 0, 0, 0},   {0, 1, 0, 0},   {1, 1, 0, 0},
+        {0, 0, 1, 0},   {1, 0, 1, 0},   {0, 1, 1, 0},   {1, 1, 1, 0},
+        {0, 0, 0, 1},   {1, 0, 0, 1},   {0, 1, 0, 1},   {1, 1, 0, 1},
+        {0, 0, 1, 1},   {1, 0, 1, 1},   {0, 1, 1, 1},   {1, 1, 1, 1},
+    };
+#if __OGRE_HAVE_AVX2
+    //---------------------------------------------------------------------
+    // AVX2 version of calculateLightFacing, eight faces per iteration.
+    //
+    // Each 256-bit register holds two face normals, so the dot products of
+    // faces 0, 2, 4, 6 end up in the low lane and of 1, 3, 5, 7 in the high
+    // lane. The additions happen in the same order as the SSE version, hence
+    // the results are identical. Returns the number of faces processed.
+    //
+    __OGRE_AVX2_TARGET
+    static size_t calculateLightFacing_AVX2(
+        const Vector4& lightPos,
+        const Vector4* faceNormals,
+        char* lightFacings,
+        size_t numFaces)
+    {
+        __m256 lp = _mm256_broadcast_ps((const __m128*)&lightPos.x);
+        __m256 zero = _mm256_setzero_ps();
+        // restores the face order
+        __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        size_t numIterations = numFaces / 8;
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m256 n01 = _mm256_mul_ps(_mm256_loadu_ps(&faceNormals[0].x), lp);
+            __m256 n23 = _mm256_mul_ps(_mm256_loadu_ps(&faceNormals[2].x), lp);
+            __m256 n45 = _mm256_mul_ps(_mm256_loadu_ps(&faceNormals[4].x), lp);
+            __m256 n67 = _mm256_mul_ps(_mm256_loadu_ps(&faceNormals[6].x), lp);
+            faceNormals += 8;
+
+            __m256 t0 = _mm256_add_ps(                                  // x0+z0 x2+z2 y0+w0 y2+w2 | 1, 3
+                _mm256_unpacklo_ps(n01, n23),
+                _mm256_unpackhi_ps(n01, n23));
+            __m256 t1 = _mm256_add_ps(                                  // x4+z4 x6+z6 y4+w4 y6+w6 | 5, 7
+                _mm256_unpacklo_ps(n45, n67),
+                _mm256_unpackhi_ps(n45, n67));
+            __m256 dp = _mm256_add_ps(                                  // dp0 dp2 dp4 dp6 | dp1 dp3 dp5 dp7
+                _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0)),
+                _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2)));
+            dp = _mm256_permutevar8x32_ps(dp, order);
+
+            int bitmask = _mm256_movemask_ps(_mm256_cmp_ps(dp, zero, _CMP_NLE_UQ));
+
+            memcpy(lightFacings, msMaskMapping[bitmask & 15], sizeof(uint32));
+            memcpy(lightFacings + 4, msMaskMapping[bitmask >> 4], sizeof(uint32));
+            lightFacings += 8;
+        }
+
+        return numIterations * 8;
+    }
+#endif
     //---------------------------------------------------------------------
     void OptimisedUtilSSE::calculateLightFacing(
         const Vector4& lightPos,
@@ -1733,14 +2075,16 @@ namespace Ogre {
 
         assert(_isAlignedForSSE(faceNormals));
 
-        // Map to convert 4-bits mask to 4 byte values
-        static const char msMaskMapping[16][4] =
+#if __OGRE_HAVE_AVX2
+        if (mUseAVX2)
         {
-            {0, 0, 0, 0},   {1, 0, 0, 0},   {0, 1, 0, 0},   {1, 1, 0, 0},
-            {0, 0, 1, 0},   {1, 0, 1, 0},   {0, 1, 1, 0},   {1, 1, 1, 0},
-            {0, 0, 0, 1},   {1, 0, 0, 1},   {0, 1, 0, 1},   {1, 1, 0, 1},
-            {0, 0, 1, 1},   {1, 0, 1, 1},   {0, 1, 1, 1},   {1, 1, 1, 1},
-        };
+            // the remaining faces are handled below
+            size_t numDone = calculateLightFacing_AVX2(lightPos, faceNormals, lightFacings, numFaces);
+            faceNormals += numDone;
+            lightFacings += numDone;
+            numFaces -= numDone;
+        }
+#endif
 
         __m128 n0, n1, n2, n3;
         __m128 t0, t1;
@@ -2132,6 +2476,498 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateBoxVisibility(
+        const Vector4* planes,
+        size_t numPlanes,
+        const float* centres,
+        const float* halfSizes,
+        size_t stride,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        assert(numPlanes <= 6);
+
+        // Broadcast the plane components once. The half sizes are never negative,
+        // so the absolute dot product reduces to a dot product with |normal|.
+        __m128 nx[6], ny[6], nz[6], nd[6];
+        __m128 ax[6], ay[6], az[6];
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            nx[p] = _mm_set_ps1(planes[p].x);
+            ny[p] = _mm_set_ps1(planes[p].y);
+            nz[p] = _mm_set_ps1(planes[p].z);
+            nd[p] = _mm_set_ps1(planes[p].w);
+            ax[p] = _mm_set_ps1(-Math::Abs(planes[p].x));
+            ay[p] = _mm_set_ps1(-Math::Abs(planes[p].y));
+            az[p] = _mm_set_ps1(-Math::Abs(planes[p].z));
+        }
+
+        const float* cx = centres;
+        const float* cy = centres + stride;
+        const float* cz = centres + 2 * stride;
+        const float* hx = halfSizes;
+        const float* hy = halfSizes + stride;
+        const float* hz = halfSizes + 2 * stride;
+
+        size_t numIterations = numBoxes / 4;
+        numBoxes &= 3;
+
+        // Four boxes per-iteration
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            // Load box data, unaligned
+            __m128 x = _mm_loadu_ps(cx);
+            __m128 y = _mm_loadu_ps(cy);
+            __m128 z = _mm_loadu_ps(cz);
+            __m128 sx = _mm_loadu_ps(hx);
+            __m128 sy = _mm_loadu_ps(hy);
+            __m128 sz = _mm_loadu_ps(hz);
+            cx += 4; cy += 4; cz += 4;
+            hx += 4; hy += 4; hz += 4;
+
+            int culled = 0;
+            for (size_t p = 0; p < numPlanes && culled != 0xF; ++p)
+            {
+                // dist = normal.dotProduct(centre) + d
+                __m128 dist = _mm_add_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], x), _mm_mul_ps(ny[p], y)), _mm_mul_ps(nz[p], z)),
+                    nd[p]);
+                // -normal.absDotProduct(halfSize)
+                __m128 negMaxAbsDist = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ax[p], sx), _mm_mul_ps(ay[p], sy)), _mm_mul_ps(az[p], sz));
+
+                // All corners on the negative side
+                culled |= _mm_movemask_ps(_mm_cmplt_ps(dist, negMaxAbsDist));
+            }
+
+            memcpy(visibilities, msMaskMapping[culled ^ 0xF], sizeof(uint32));
+            visibilities += 4;
+        }
+
+        // Dealing with remaining boxes
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes && visible; ++p)
+            {
+                float dist = planes[p].x * cx[i] + planes[p].y * cy[i] + planes[p].z * cz[i] + planes[p].w;
+                float negMaxAbsDist = -Math::Abs(planes[p].x) * hx[i] - Math::Abs(planes[p].y) * hy[i] -
+                                      Math::Abs(planes[p].z) * hz[i];
+                visible = !(dist < negMaxAbsDist);
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
+    /// Load four components addressed by the given indices
+    static OGRE_FORCE_INLINE __m128 _gatherPS(const float* p, const uint32* idx)
+    {
+        return _mm_setr_ps(p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]]);
+    }
+    /// Store four components to the addresses given by the indices
+    static OGRE_FORCE_INLINE void _scatterPS(float* p, const uint32* idx, __m128 v)
+    {
+        float tmp[4];
+        _mm_storeu_ps(tmp, v);
+        p[idx[0]] = tmp[0];
+        p[idx[1]] = tmp[1];
+        p[idx[2]] = tmp[2];
+        p[idx[3]] = tmp[3];
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateDerivedTransforms(
+        const float* local,
+        float* derived,
+        size_t stride,
+        const uint32* parents,
+        const uchar* inherit,
+        const uint32* indices,
+        size_t numNodes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 two = _mm_set_ps1(2.0f);
+
+        size_t numIterations = numNodes / 4;
+        numNodes &= 3;
+
+        // Four nodes per-iteration, in SoA form
+        for (size_t k = 0; k < numIterations; ++k)
+        {
+            const uint32* idx = indices + 4 * k;
+            uint32 pidx[4] = {parents[idx[0]], parents[idx[1]], parents[idx[2]], parents[idx[3]]};
+            // The nodes of a depth level are usually all dirty, so they can be
+            // loaded and stored directly.
+            bool contiguous = idx[1] == idx[0] + 1 && idx[2] == idx[0] + 2 && idx[3] == idx[0] + 3;
+
+            __m128 l[10], pd[10];
+            for (size_t c = 0; c < 10; ++c)
+            {
+                l[c] = contiguous ? _mm_loadu_ps(local + c * stride + idx[0])
+                                  : _gatherPS(local + c * stride, idx);
+                pd[c] = _gatherPS(derived + c * stride, pidx);
+            }
+
+            __m128 inheritOrientation = _mm_cmpneq_ps(
+                _mm_setr_ps(float(inherit[idx[0]] & 1), float(inherit[idx[1]] & 1),
+                            float(inherit[idx[2]] & 1), float(inherit[idx[3]] & 1)), zero);
+            __m128 inheritScale = _mm_cmpneq_ps(
+                _mm_setr_ps(float(inherit[idx[0]] & 2), float(inherit[idx[1]] & 2),
+                            float(inherit[idx[2]] & 2), float(inherit[idx[3]] & 2)), zero);
+
+            const __m128 &pw = pd[6], &px = pd[7], &py = pd[8], &pz = pd[9];
+            const __m128 &lw = l[6], &lx = l[7], &ly = l[8], &lz = l[9];
+
+            // orientation = parentOrientation * orientation
+            __m128 ow = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(pw, lw), _mm_mul_ps(px, lx)),
+                                   _mm_add_ps(_mm_mul_ps(py, ly), _mm_mul_ps(pz, lz)));
+            __m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pw, lx), _mm_mul_ps(px, lw)),
+                                   _mm_sub_ps(_mm_mul_ps(py, lz), _mm_mul_ps(pz, ly)));
+            __m128 oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pw, ly), _mm_mul_ps(py, lw)),
+                                   _mm_sub_ps(_mm_mul_ps(pz, lx), _mm_mul_ps(px, lz)));
+            __m128 oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pw, lz), _mm_mul_ps(pz, lw)),
+                                   _mm_sub_ps(_mm_mul_ps(px, ly), _mm_mul_ps(py, lx)));
+
+            __m128 d[10];
+            d[6] = _mm_or_ps(_mm_and_ps(inheritOrientation, ow), _mm_andnot_ps(inheritOrientation, lw));
+            d[7] = _mm_or_ps(_mm_and_ps(inheritOrientation, ox), _mm_andnot_ps(inheritOrientation, lx));
+            d[8] = _mm_or_ps(_mm_and_ps(inheritOrientation, oy), _mm_andnot_ps(inheritOrientation, ly));
+            d[9] = _mm_or_ps(_mm_and_ps(inheritOrientation, oz), _mm_andnot_ps(inheritOrientation, lz));
+
+            // scale = parentScale * scale
+            for (size_t c = 3; c < 6; ++c)
+            {
+                __m128 s = _mm_mul_ps(pd[c], l[c]);
+                d[c] = _mm_or_ps(_mm_and_ps(inheritScale, s), _mm_andnot_ps(inheritScale, l[c]));
+            }
+
+            // v = parentScale * position
+            __m128 vx = _mm_mul_ps(pd[3], l[0]);
+            __m128 vy = _mm_mul_ps(pd[4], l[1]);
+            __m128 vz = _mm_mul_ps(pd[5], l[2]);
+
+            // parentOrientation * v, same as Quaternion::operator*(const Vector3&)
+            __m128 uvx = _mm_sub_ps(_mm_mul_ps(py, vz), _mm_mul_ps(pz, vy));
+            __m128 uvy = _mm_sub_ps(_mm_mul_ps(pz, vx), _mm_mul_ps(px, vz));
+            __m128 uvz = _mm_sub_ps(_mm_mul_ps(px, vy), _mm_mul_ps(py, vx));
+            __m128 uuvx = _mm_sub_ps(_mm_mul_ps(py, uvz), _mm_mul_ps(pz, uvy));
+            __m128 uuvy = _mm_sub_ps(_mm_mul_ps(pz, uvx), _mm_mul_ps(px, uvz));
+            __m128 uuvz = _mm_sub_ps(_mm_mul_ps(px, uvy), _mm_mul_ps(py, uvx));
+            __m128 w2 = _mm_mul_ps(two, pw);
+
+            d[0] = _mm_add_ps(_mm_add_ps(_mm_add_ps(vx, _mm_mul_ps(uvx, w2)), _mm_mul_ps(uuvx, two)), pd[0]);
+            d[1] = _mm_add_ps(_mm_add_ps(_mm_add_ps(vy, _mm_mul_ps(uvy, w2)), _mm_mul_ps(uuvy, two)), pd[1]);
+            d[2] = _mm_add_ps(_mm_add_ps(_mm_add_ps(vz, _mm_mul_ps(uvz, w2)), _mm_mul_ps(uuvz, two)), pd[2]);
+
+            for (size_t c = 0; c < 10; ++c)
+            {
+                if (contiguous)
+                    _mm_storeu_ps(derived + c * stride + idx[0], d[c]);
+                else
+                    _scatterPS(derived + c * stride, idx, d[c]);
+            }
+        }
+
+        // Dealing with remaining nodes
+        indices += 4 * numIterations;
+        for (size_t k = 0; k < numNodes; ++k)
+        {
+            size_t i = indices[k];
+            size_t p = parents[i];
+
+            Vector3 parentPosition(derived[p], derived[stride + p], derived[2 * stride + p]);
+            Vector3 parentScale(derived[3 * stride + p], derived[4 * stride + p], derived[5 * stride + p]);
+            Quaternion parentOrientation(derived[6 * stride + p], derived[7 * stride + p],
+                                         derived[8 * stride + p], derived[9 * stride + p]);
+
+            Vector3 position(local[i], local[stride + i], local[2 * stride + i]);
+            Vector3 scale(local[3 * stride + i], local[4 * stride + i], local[5 * stride + i]);
+            Quaternion orientation(local[6 * stride + i], local[7 * stride + i],
+                                   local[8 * stride + i], local[9 * stride + i]);
+
+            if (inherit[i] & 1)
+                orientation = parentOrientation * orientation;
+            if (inherit[i] & 2)
+                scale = parentScale * scale;
+            position = parentOrientation * (parentScale * position) + parentPosition;
+
+            for (size_t c = 0; c < 3; ++c)
+            {
+                derived[c * stride + i] = position[c];
+                derived[(3 + c) * stride + i] = scale[c];
+            }
+            for (size_t c = 0; c < 4; ++c)
+                derived[(6 + c) * stride + i] = orientation[c];
+        }
+    }
+    //---------------------------------------------------------------------
+#if __OGRE_HAVE_SSE2
+    // Converts the halves in the low 16 bits of each lane, bit exact with
+    // Bitwise::halfToFloatI. Denormals are renormalised by a float subtraction.
+    static OGRE_FORCE_INLINE __m128 __halfToFloat_SSE2(__m128i h)
+    {
+        __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+        __m128i exp = _mm_and_si128(o, _mm_set1_epi32(0x7c00 << 13));
+        o = _mm_add_epi32(o, _mm_set1_epi32((127 - 15) << 23));
+
+        // Inf / NaN, adjust the exponent once more
+        __m128i infNan = _mm_cmpgt_epi32(exp, _mm_set1_epi32((0x7c00 << 13) - 1));
+        o = _mm_add_epi32(o, _mm_and_si128(infNan, _mm_set1_epi32((128 - 16) << 23)));
+
+        // Zero / denormal
+        __m128i denorm = _mm_cmpgt_epi32(_mm_set1_epi32(1), exp);
+        __m128 renorm = _mm_sub_ps(
+            _mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))),
+            _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+        o = _mm_or_si128(_mm_andnot_si128(denorm, o), _mm_and_si128(denorm, _mm_castps_si128(renorm)));
+
+        __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+        return _mm_castsi128_ps(_mm_or_si128(o, sign));
+    }
+    //---------------------------------------------------------------------
+    // Converts four floats to halves in the low 16 bits of each lane, bit
+    // exact with Bitwise::floatToHalfI, which truncates the mantissa.
+    static OGRE_FORCE_INLINE __m128i __floatToHalf_SSE2(__m128 f)
+    {
+        __m128i i = _mm_castps_si128(f);
+        __m128i sign = _mm_and_si128(_mm_srli_epi32(i, 16), _mm_set1_epi32(0x8000));
+        __m128i a = _mm_and_si128(i, _mm_set1_epi32(0x7fffffff));
+        __m128i e = _mm_sub_epi32(_mm_srli_epi32(a, 23), _mm_set1_epi32(127 - 15));
+
+        __m128i isBig = _mm_cmpgt_epi32(e, _mm_set1_epi32(30));
+        __m128i isNormal = _mm_andnot_si128(isBig, _mm_cmpgt_epi32(e, _mm_setzero_si128()));
+        __m128i isDenorm = _mm_andnot_si128(_mm_cmpgt_epi32(e, _mm_setzero_si128()),
+            _mm_cmpgt_epi32(e, _mm_set1_epi32(-11)));
+        __m128i isTiny = _mm_cmpgt_epi32(_mm_set1_epi32(-10), e);
+
+        // 1 <= e <= 30
+        __m128i normal = _mm_sub_epi32(_mm_srli_epi32(a, 13), _mm_set1_epi32((127 - 15) << 10));
+
+        // Overflow and Inf, NaN keeps the top of its payload and never turns into Inf
+        __m128i nanBits = _mm_srli_epi32(_mm_and_si128(i, _mm_set1_epi32(0x007fffff)), 13);
+        nanBits = _mm_or_si128(nanBits,
+            _mm_andnot_si128(_mm_cmpgt_epi32(nanBits, _mm_setzero_si128()), _mm_set1_epi32(1)));
+        __m128i isNaN = _mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f800000));
+        __m128i big = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNaN, nanBits));
+
+        // -10 <= e <= 0, the truncated mantissa is |f| * 2^24
+        __m128i denorm = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(a), _mm_set1_ps(16777216.0f)));
+
+        __m128i h = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(isNormal, normal), _mm_and_si128(isBig, big)),
+            _mm_and_si128(isDenorm, denorm));
+        // The smallest values even lose their sign
+        return _mm_andnot_si128(isTiny, _mm_or_si128(h, sign));
+    }
+#endif
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertHalfToFloat(
+        const uint16* src,
+        float* dst,
+        size_t count)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+#if __OGRE_HAVE_SSE2
+        size_t numIterations = count / 8;
+        count &= 7;
+
+        // Eight values per-iteration
+        __m128i zero = _mm_setzero_si128();
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m128i h = _mm_loadu_si128((const __m128i*)src);
+            _mm_storeu_ps(dst, __halfToFloat_SSE2(_mm_unpacklo_epi16(h, zero)));
+            _mm_storeu_ps(dst + 4, __halfToFloat_SSE2(_mm_unpackhi_epi16(h, zero)));
+            src += 8;
+            dst += 8;
+        }
+#endif
+
+        // Dealing with remaining values
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = Bitwise::halfToFloat(src[i]);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertFloatToHalf(
+        const float* src,
+        uint16* dst,
+        size_t count)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+#if __OGRE_HAVE_SSE2
+        size_t numIterations = count / 8;
+        count &= 7;
+
+        // Eight values per-iteration
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m128i lo = __floatToHalf_SSE2(_mm_loadu_ps(src));
+            __m128i hi = __floatToHalf_SSE2(_mm_loadu_ps(src + 4));
+            // sign extend, so the signed saturation of the pack keeps all bits
+            lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+            hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+            _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(lo, hi));
+            src += 8;
+            dst += 8;
+        }
+#endif
+
+        // Dealing with remaining values
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = Bitwise::floatToHalf(src[i]);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertUnormByteToFloat(
+        const uint8* src,
+        float* dst,
+        size_t count)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+#if __OGRE_HAVE_SSE2
+        size_t numIterations = count / 16;
+        count &= 15;
+
+        // Divide rather than multiply by the reciprocal, as Bitwise::fixedToFloat
+        __m128 scale = _mm_set_ps1(255.0f);
+        __m128i zero = _mm_setzero_si128();
+
+        // Sixteen values per-iteration
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m128i b = _mm_loadu_si128((const __m128i*)src);
+            __m128i lo = _mm_unpacklo_epi8(b, zero);
+            __m128i hi = _mm_unpackhi_epi8(b, zero);
+            _mm_storeu_ps(dst, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+            _mm_storeu_ps(dst + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+            _mm_storeu_ps(dst + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+            _mm_storeu_ps(dst + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+            src += 16;
+            dst += 16;
+        }
+#endif
+
+        // Dealing with remaining values
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = Bitwise::fixedToFloat(src[i], 8);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::convertFloatToUnormByte(
+        const float* src,
+        uint8* dst,
+        size_t count)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+#if __OGRE_HAVE_SSE2
+        size_t numIterations = count / 16;
+        count &= 15;
+
+        // Bitwise::floatToFixed scales by 256 and truncates, the clamping to
+        // [0, 255] before the conversion gives the same results, NaN included
+        __m128 scale = _mm_set_ps1(256.0f);
+        __m128 maxValue = _mm_set_ps1(255.0f);
+        __m128 zero = _mm_setzero_ps();
+
+#define __CONVERT_FLOAT4(p) \
+        _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(p), scale), zero), maxValue))
+
+        // Sixteen values per-iteration
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m128i lo = _mm_packs_epi32(__CONVERT_FLOAT4(src), __CONVERT_FLOAT4(src + 4));
+            __m128i hi = _mm_packs_epi32(__CONVERT_FLOAT4(src + 8), __CONVERT_FLOAT4(src + 12));
+            _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(lo, hi));
+            src += 16;
+            dst += 16;
+        }
+
+#undef __CONVERT_FLOAT4
+#endif
+
+        // Dealing with remaining values
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = static_cast<uint8>(Bitwise::floatToFixed(src[i], 8));
+    }
+#if __OGRE_HAVE_AVX2
+    //---------------------------------------------------------------------
+    // AVX2 version of expandRGB8ToRGBA8, eight pixels per iteration.
+    //
+    // Each 128-bit lane shuffles four pixels, the second lane is loaded 12
+    // bytes after the first one. Reads 4 bytes beyond the last pixel it
+    // converts, so the caller leaves enough pixels to the scalar code.
+    // Returns the number of pixels processed.
+    //
+    __OGRE_AVX2_TARGET
+    static size_t expandRGB8ToRGBA8_AVX2(
+        const uint8* src,
+        uint8* dst,
+        size_t numPixels)
+    {
+        const __m256i shuffle = _mm256_setr_epi8(
+            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m256i alpha = _mm256_set1_epi32(int(0xFF000000));
+
+        size_t numIterations = numPixels > 2 ? (numPixels - 2) / 8 : 0;
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m256i rgb = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)src)),
+                _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+            _mm256_storeu_si256((__m256i*)dst, _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffle), alpha));
+            src += 24;
+            dst += 32;
+        }
+
+        return numIterations * 8;
+    }
+#endif
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::expandRGB8ToRGBA8(
+        const uint8* src,
+        uint8* dst,
+        size_t numPixels)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+#if __OGRE_HAVE_AVX2
+        if (mUseAVX2)
+        {
+            // the remaining pixels are handled below
+            size_t numDone = expandRGB8ToRGBA8_AVX2(src, dst, numPixels);
+            src += numDone * 3;
+            dst += numDone * 4;
+            numPixels -= numDone;
+        }
+#endif
+
+        // SSE2 has no byte shuffle, read four bytes per pixel instead. The
+        // last pixel is copied byte by byte, so nothing past the source is read.
+        const uint32 alpha = OGRE_ENDIAN == OGRE_ENDIAN_BIG ? 0x000000FF : 0xFF000000;
+        for (; numPixels > 1; --numPixels)
+        {
+            uint32 pixel;
+            memcpy(&pixel, src, sizeof(uint32));
+            pixel |= alpha;
+            memcpy(dst, &pixel, sizeof(uint32));
+            src += 3;
+            dst += 4;
+        }
+        if (numPixels)
+        {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = 0xFF;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
@@ -50,4 +50,97 @@ namespace Ogre
     {
         mOwnDimensions = false;
     }
+    //-----------------------------------------------------------------------
+    void ParticleArrays::resize(size_t count, uint32 comps)
+    {
+        components = comps;
+        // keep the memory of components that are no longer held, they are likely to come back
+        if (components & PAC_POSITION)
+            for (auto& a : position)
+                a.resize(count);
+        if (components & PAC_DIRECTION)
+            for (auto& a : direction)
+                a.resize(count);
+        if (components & PAC_COLOUR)
+            for (auto& a : colour)
+                a.resize(count);
+        if (components & PAC_TIME_TO_LIVE)
+        {
+            timeToLive.resize(count);
+            totalTimeToLive.resize(count);
+        }
+        if (components & PAC_ROTATION)
+        {
+            rotation.resize(count);
+            rotationSpeed.resize(count);
+        }
+        if (components & PAC_DIMENSIONS)
+        {
+            width.resize(count);
+            height.resize(count);
+            ownDimensions.resize(count);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ParticleArrays::gather(Particle* const* particles, size_t begin, size_t end,
+                                Real defaultWidth, Real defaultHeight)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Particle* p = particles[i];
+            if (components & PAC_POSITION)
+            {
+                position[0][i] = p->mPosition.x;
+                position[1][i] = p->mPosition.y;
+                position[2][i] = p->mPosition.z;
+            }
+            if (components & PAC_DIRECTION)
+            {
+                direction[0][i] = p->mDirection.x;
+                direction[1][i] = p->mDirection.y;
+                direction[2][i] = p->mDirection.z;
+            }
+            if (components & PAC_COLOUR)
+            {
+                colour[0][i] = p->mColour.r;
+                colour[1][i] = p->mColour.g;
+                colour[2][i] = p->mColour.b;
+                colour[3][i] = p->mColour.a;
+            }
+            if (components & PAC_TIME_TO_LIVE)
+            {
+                timeToLive[i] = p->mTimeToLive;
+                totalTimeToLive[i] = p->mTotalTimeToLive;
+            }
+            if (components & PAC_ROTATION)
+            {
+                rotation[i] = p->mRotation.valueRadians();
+                rotationSpeed[i] = p->mRotationSpeed.valueRadians();
+            }
+            if (components & PAC_DIMENSIONS)
+            {
+                ownDimensions[i] = p->mOwnDimensions;
+                width[i] = p->mOwnDimensions ? p->mWidth : defaultWidth;
+                height[i] = p->mOwnDimensions ? p->mHeight : defaultHeight;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ParticleArrays::scatter(Particle* const* particles, size_t begin, size_t end) const
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Particle* p = particles[i];
+            if (components & PAC_POSITION)
+                p->mPosition = Vector3(position[0][i], position[1][i], position[2][i]);
+            if (components & PAC_DIRECTION)
+                p->mDirection = Vector3(direction[0][i], direction[1][i], direction[2][i]);
+            if (components & PAC_COLOUR)
+                p->mColour = ColourValue(colour[0][i], colour[1][i], colour[2][i], colour[3][i]);
+            if (components & PAC_ROTATION)
+                p->mRotation = Radian(rotation[i]);
+            if ((components & PAC_DIMENSIONS) && ownDimensions[i])
+                p->setDimensions(width[i], height[i]);
+        }
+    }
 }
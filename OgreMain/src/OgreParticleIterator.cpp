@@ -32,8 +32,8 @@ THE SOFTWARE.
 namespace Ogre {
 
     //-----------------------------------------------------------------------
-    ParticleIterator::ParticleIterator(std::list<Particle*>::iterator start, 
-        std::list<Particle*>::iterator last)
+    ParticleIterator::ParticleIterator(std::vector<Particle*>::iterator start, 
+        std::vector<Particle*>::iterator last)
     {
         mStart = mPos = start;
         mEnd = last;
@@ -34,8 +34,33 @@ THE SOFTWARE.
 #include "OgreParticleAffectorFactory.h"
 #include "OgreParticleSystemRenderer.h"
 #include "OgreControllerManager.h"
+#include "OgreWorkQueue.h"
+#include "OgrePlatformInformation.h"
+#if (__OGRE_HAVE_SSE || __OGRE_HAVE_NEON) && OGRE_DOUBLE_PRECISION == 0
+#include "OgreSIMDHelper.h"
+#endif
 
 namespace Ogre {
+    namespace
+    {
+        /// position += direction * timeElapsed for particles [begin, end) of the arrays
+        void applyMotion(ParticleArrays& arrays, size_t begin, size_t end, Real timeElapsed)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                Real* pos = arrays.position[c].data();
+                const Real* dir = arrays.direction[c].data();
+                size_t i = begin;
+#if (__OGRE_HAVE_SSE || __OGRE_HAVE_NEON) && OGRE_DOUBLE_PRECISION == 0
+                __m128 t = _mm_set1_ps(timeElapsed);
+                for (; i + 4 <= end; i += 4)
+                    _mm_storeu_ps(pos + i, _mm_add_ps(_mm_loadu_ps(pos + i), _mm_mul_ps(_mm_loadu_ps(dir + i), t)));
+#endif
+                for (; i < end; ++i)
+                    pos[i] += dir[i] * timeElapsed;
+            }
+        }
+    }
     // Init statics
     ParticleSystem::CmdCull ParticleSystem::msCullCmd;
     ParticleSystem::CmdHeight ParticleSystem::msHeightCmd;
@@ -89,6 +114,7 @@ namespace Ogre {
         mTimeController(0),
         mEmittedEmitterPoolInitialised(false),
         mIsEmitting(true),
+        mParallelUpdate(false),
         mRenderer(0),
         mCullIndividual(false),
         mPoolSize(0),
@@ -122,6 +148,7 @@ namespace Ogre {
         mTimeController(0),
         mEmittedEmitterPoolInitialised(false),
         mIsEmitting(true),
+        mParallelUpdate(false),
         mRenderer(0), 
         mCullIndividual(false),
         mPoolSize(0),
@@ -155,9 +182,9 @@ namespace Ogre {
         // Deallocate all particles
         destroyVisualParticles(0, mParticlePool.size());
         // Free pool items
-        for (auto p : mParticlePool)
+        for (auto block : mParticleBlocks)
         {
-            OGRE_DELETE p;
+            OGRE_DELETE[] block;
         }
 
         if (mRenderer)
@@ -278,6 +305,7 @@ namespace Ogre {
         mCullIndividual = rhs.mCullIndividual;
         mSorted = rhs.mSorted;
         mLocalSpace = rhs.mLocalSpace;
+        mParallelUpdate = rhs.mParallelUpdate;
         mIterationInterval = rhs.mIterationInterval;
         mIterationIntervalSet = rhs.mIterationIntervalSet;
         mNonvisibleTimeout = rhs.mNonvisibleTimeout;
@@ -395,8 +423,11 @@ namespace Ogre {
             {
                 // Update existing particles
                 _expire(iterationInterval);
-                _triggerAffectors(iterationInterval);
-                _applyMotion(iterationInterval);
+                if (!_updateParticleArrays(iterationInterval))
+                {
+                    _triggerAffectors(iterationInterval);
+                    _applyMotion(iterationInterval);
+                }
 
                 if(mIsEmitting)
                 {
@@ -411,8 +442,11 @@ namespace Ogre {
         {
             // Update existing particles
             _expire(timeElapsed);
-            _triggerAffectors(timeElapsed);
-            _applyMotion(timeElapsed);
+            if (!_updateParticleArrays(timeElapsed))
+            {
+                _triggerAffectors(timeElapsed);
+                _applyMotion(timeElapsed);
+            }
 
             if(mIsEmitting)
             {
@@ -429,15 +463,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_expire(Real timeElapsed)
     {
-        ActiveParticleList::iterator i, itEnd;
-        Particle* pParticle;
-        ParticleEmitter* pParticleEmitter;
-
-        itEnd = mActiveParticles.end();
-
-        for (i = mActiveParticles.begin(); i != itEnd; )
+        // Compact the surviving particles in place, keeping their order
+        size_t numAlive = 0;
+        for (Particle* pParticle : mActiveParticles)
         {
-            pParticle = static_cast<Particle*>(*i);
             if (pParticle->mTimeToLive < timeElapsed)
             {
                 // Notify renderer
@@ -447,30 +476,27 @@ namespace Ogre {
                 if (pParticle->mParticleType == Particle::Visual)
                 {
                     // Destroy this one
-                    mFreeParticles.splice(mFreeParticles.end(), mActiveParticles, i++);
+                    mFreeParticles.push_back(pParticle);
                 }
                 else
                 {
                     // For now, it can only be an emitted emitter
-                    pParticleEmitter = static_cast<ParticleEmitter*>(*i);
+                    ParticleEmitter* pParticleEmitter = static_cast<ParticleEmitter*>(pParticle);
                     std::list<ParticleEmitter*>* fee = findFreeEmittedEmitter(pParticleEmitter->getName());
                     fee->push_back(pParticleEmitter);
 
                     // Also erase from mActiveEmittedEmitters
                     removeFromActiveEmittedEmitters (pParticleEmitter);
-
-                    // And erase from mActiveParticles
-                    i = mActiveParticles.erase( i );
                 }
             }
             else
             {
                 // Decrement TTL
                 pParticle->mTimeToLive -= timeElapsed;
-                ++i;
+                mActiveParticles[numAlive++] = pParticle;
             }
-
         }
+        mActiveParticles.resize(numAlive);
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_triggerEmitters(Real timeElapsed)
@@ -615,17 +641,71 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    bool ParticleSystem::_updateParticleArrays(Real timeElapsed)
+    {
+        // small enough to stay in the cache between the affectors
+        static const size_t BLOCK_SIZE = 1024;
+        static const size_t GRAIN_SIZE = 4096;
+
+        // without affectors copying to arrays and back costs more than it saves
+        if (mAffectors.empty())
+            return false;
+
+        uint32 components = ParticleArrays::PAC_POSITION | ParticleArrays::PAC_DIRECTION;
+        for (auto a : mAffectors)
+        {
+            uint32 affectorComponents = a->_getParticleArrayComponents();
+            if (!affectorComponents)
+                return false;
+            components |= affectorComponents;
+        }
+
+        size_t count = mActiveParticles.size();
+        mParticleArrays.resize(count, components);
+
+        Particle* const* particles = mActiveParticles.data();
+        auto updateRange = [&](size_t begin, size_t end)
+        {
+            for (size_t blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE)
+            {
+                size_t blockEnd = std::min(blockBegin + BLOCK_SIZE, end);
+                mParticleArrays.gather(particles, blockBegin, blockEnd, mDefaultWidth, mDefaultHeight);
+
+                // Affectors first, motion last, as in the serial update
+                for (auto a : mAffectors)
+                    a->_affectParticleArrays(this, timeElapsed, mParticleArrays, blockBegin, blockEnd);
+                applyMotion(mParticleArrays, blockBegin, blockEnd, timeElapsed);
+
+                mParticleArrays.scatter(particles, blockBegin, blockEnd);
+            }
+        };
+
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+        if (mParallelUpdate && queue && count > GRAIN_SIZE)
+            queue->parallelFor(count, GRAIN_SIZE, updateRange);
+        else
+            updateRange(0, count);
+
+        // Notify renderer
+        mRenderer->_notifyParticleMoved(mActiveParticles);
+        return true;
+    }
+    //-----------------------------------------------------------------------
     void ParticleSystem::increasePool(size_t size)
     {
         size_t oldSize = mParticlePool.size();
+        if (size <= oldSize)
+            return;
 
         // Increase size
         mParticlePool.resize(size);
 
-        // Create new particles
+        // Create new particles in one block, so they are close in memory
+        Particle* block = OGRE_NEW Particle[size - oldSize];
+        mParticleBlocks.push_back(block);
         for( size_t i = oldSize; i < size; i++ )
         {
-            mParticlePool[i] = OGRE_NEW Particle();
+            mParticlePool[i] = block + (i - oldSize);
         }
 
         if (mIsRendererConfigured)
@@ -644,9 +724,7 @@ namespace Ogre {
     Particle* ParticleSystem::getParticle(size_t index) 
     {
         assert (index < mActiveParticles.size() && "Index out of bounds!");
-        ActiveParticleList::iterator i = mActiveParticles.begin();
-        std::advance(i, index);
-        return *i;
+        return mActiveParticles[index];
     }
     //-----------------------------------------------------------------------
     Particle* ParticleSystem::createParticle(void)
@@ -655,8 +733,9 @@ namespace Ogre {
         if (!mFreeParticles.empty())
         {
             // Fast creation (don't use superclass since emitter will init)
-            p = mFreeParticles.front();
-            mActiveParticles.splice(mActiveParticles.end(), mFreeParticles, mFreeParticles.begin());
+            p = mFreeParticles.back();
+            mFreeParticles.pop_back();
+            mActiveParticles.push_back(p);
         }
 
         return p;
@@ -980,8 +1059,8 @@ namespace Ogre {
 
         // reset active and free lists
         mActiveParticles.clear();
-        mFreeParticles.clear();
-        mFreeParticles.insert(mFreeParticles.end(), mParticlePool.begin(), mParticlePool.end());
+        // reversed, so the pool is used front to back
+        mFreeParticles.assign(mParticlePool.rbegin(), mParticlePool.rend());
 
         // Add active emitted emitters to free list
         addActiveEmittedEmittersToFreeList();
@@ -1019,9 +1098,9 @@ namespace Ogre {
         {
             this->increasePool(size);
 
-            // Add new items to the queue
-            mFreeParticles.insert(mFreeParticles.end(), mParticlePool.begin() + currSize,
-                                  mParticlePool.end());
+            // Add new items to the stack, to be used before the older free ones
+            mFreeParticles.insert(mFreeParticles.end(), mParticlePool.rbegin(),
+                                  mParticlePool.rend() - currSize);
 
             // Tell the renderer, if already configured
             if (mRenderer && mIsRendererConfigured)
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
 #include "OgrePixelFormatDescriptions.h"
+#include "OgreOptimisedUtil.h"
 
 namespace {
 #include "OgrePixelConversions.h"
@@ -686,6 +687,80 @@ namespace Ogre {
         bulkPixelConversion(src, dst);
     }
     //-----------------------------------------------------------------------
+    /// Pixel count above which bulkPixelConversion splits the rows over the WorkQueue
+    static const size_t PARALLEL_CONVERSION_PIXELS = 256 * 1024;
+    /// Approximate number of pixels per parallel chunk, below the threshold above
+    static const size_t PARALLEL_CONVERSION_GRAIN_PIXELS = 32 * 1024;
+    //-----------------------------------------------------------------------
+    /** Convert the common format pairs whose components map one to one with
+        the vectorised OptimisedUtil routines, row by row.
+        @return false if the pair is not handled
+    */
+    static bool doVectorisedConversion(const PixelBox &src, const PixelBox &dst)
+    {
+        enum Routine { HALF_TO_FLOAT, FLOAT_TO_HALF, BYTE_TO_FLOAT, FLOAT_TO_BYTE, RGB_TO_RGBA };
+        Routine routine;
+        size_t components;
+
+        switch (FMTCONVERTERID(src.format, dst.format))
+        {
+        case FMTCONVERTERID(PF_FLOAT16_R, PF_FLOAT32_R): routine = HALF_TO_FLOAT; components = 1; break;
+        case FMTCONVERTERID(PF_FLOAT16_GR, PF_FLOAT32_GR): routine = HALF_TO_FLOAT; components = 2; break;
+        case FMTCONVERTERID(PF_FLOAT16_RGB, PF_FLOAT32_RGB): routine = HALF_TO_FLOAT; components = 3; break;
+        case FMTCONVERTERID(PF_FLOAT16_RGBA, PF_FLOAT32_RGBA): routine = HALF_TO_FLOAT; components = 4; break;
+        case FMTCONVERTERID(PF_FLOAT32_R, PF_FLOAT16_R): routine = FLOAT_TO_HALF; components = 1; break;
+        case FMTCONVERTERID(PF_FLOAT32_GR, PF_FLOAT16_GR): routine = FLOAT_TO_HALF; components = 2; break;
+        case FMTCONVERTERID(PF_FLOAT32_RGB, PF_FLOAT16_RGB): routine = FLOAT_TO_HALF; components = 3; break;
+        case FMTCONVERTERID(PF_FLOAT32_RGBA, PF_FLOAT16_RGBA): routine = FLOAT_TO_HALF; components = 4; break;
+        case FMTCONVERTERID(PF_L8, PF_FLOAT32_R):
+        case FMTCONVERTERID(PF_R8, PF_FLOAT32_R): routine = BYTE_TO_FLOAT; components = 1; break;
+        case FMTCONVERTERID(PF_BYTE_RGB, PF_FLOAT32_RGB): routine = BYTE_TO_FLOAT; components = 3; break;
+        case FMTCONVERTERID(PF_BYTE_RGBA, PF_FLOAT32_RGBA): routine = BYTE_TO_FLOAT; components = 4; break;
+        case FMTCONVERTERID(PF_FLOAT32_R, PF_L8):
+        case FMTCONVERTERID(PF_FLOAT32_R, PF_R8): routine = FLOAT_TO_BYTE; components = 1; break;
+        case FMTCONVERTERID(PF_FLOAT32_RGB, PF_BYTE_RGB): routine = FLOAT_TO_BYTE; components = 3; break;
+        case FMTCONVERTERID(PF_FLOAT32_RGBA, PF_BYTE_RGBA): routine = FLOAT_TO_BYTE; components = 4; break;
+        case FMTCONVERTERID(PF_BYTE_RGB, PF_BYTE_RGBA):
+        case FMTCONVERTERID(PF_BYTE_BGR, PF_BYTE_BGRA): routine = RGB_TO_RGBA; components = 1; break;
+        default:
+            return false;
+        }
+
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
+        const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
+        const size_t count = src.getWidth() * components;
+        for (size_t z = 0; z < src.getDepth(); z++)
+        {
+            for (size_t y = 0; y < src.getHeight(); y++)
+            {
+                const uint8* srcptr = src.data + ((src.left + (src.top + y) * src.rowPitch +
+                                                   (src.front + z) * src.slicePitch) * srcPixelSize);
+                uint8* dstptr = dst.data + ((dst.left + (dst.top + y) * dst.rowPitch +
+                                             (dst.front + z) * dst.slicePitch) * dstPixelSize);
+                switch (routine)
+                {
+                case HALF_TO_FLOAT:
+                    util->convertHalfToFloat((const uint16*)srcptr, (float*)dstptr, count);
+                    break;
+                case FLOAT_TO_HALF:
+                    util->convertFloatToHalf((const float*)srcptr, (uint16*)dstptr, count);
+                    break;
+                case BYTE_TO_FLOAT:
+                    util->convertUnormByteToFloat(srcptr, (float*)dstptr, count);
+                    break;
+                case FLOAT_TO_BYTE:
+                    util->convertFloatToUnormByte((const float*)srcptr, dstptr, count);
+                    break;
+                case RGB_TO_RGBA:
+                    util->expandRGB8ToRGBA8(srcptr, dstptr, count);
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
     void PixelUtil::bulkPixelConversion(const PixelBox &src, const PixelBox &dst)
     {
         OgreAssert(src.getSize() == dst.getSize(), "src and dst must be of same size");
@@ -750,6 +825,30 @@ namespace Ogre {
             }
             return;
         }
+        // Split large images into bands of rows and convert them on the WorkQueue.
+        // The bands stay below the threshold, so they are not split again.
+        const size_t numRows = src.getHeight() * src.getDepth();
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+        if (queue && src.getWidth() * numRows >= PARALLEL_CONVERSION_PIXELS && numRows > 1)
+        {
+            const size_t height = src.getHeight();
+            const size_t grainSize = std::max<size_t>(1, PARALLEL_CONVERSION_GRAIN_PIXELS / src.getWidth());
+            queue->parallelFor(numRows, grainSize, [&](size_t begin, size_t end) {
+                // one box per slice touched by the band
+                while (begin < end)
+                {
+                    uint32 z = uint32(begin / height);
+                    uint32 top = uint32(begin % height);
+                    uint32 bottom = uint32(std::min(end - z * height, height));
+                    Box srcBox(src.left, src.top + top, src.front + z, src.right, src.top + bottom, src.front + z + 1);
+                    Box dstBox(dst.left, dst.top + top, dst.front + z, dst.right, dst.top + bottom, dst.front + z + 1);
+                    bulkPixelConversion(src.getSubVolume(srcBox, false), dst.getSubVolume(dstBox, false));
+                    begin = z * height + bottom;
+                }
+            });
+            return;
+        }
+
         // Converting to PF_X8R8G8B8 is exactly the same as converting to
         // PF_A8R8G8B8. (same with PF_X8B8G8R8 and PF_A8B8G8R8)
         if(dst.format == PF_X8R8G8B8 || dst.format == PF_X8B8G8R8)
@@ -773,6 +872,10 @@ namespace Ogre {
             return;
         }
 
+        // Is there a vectorised conversion?
+        if(doVectorisedConversion(src, dst))
+            return;
+
 // NB VC6 can't handle the templates required for optimised conversion, tough
 #if OGRE_COMPILER != OGRE_COMPILER_MSVC || OGRE_COMP_VER >= 1300
         // Is there a specialized, inlined, conversion?
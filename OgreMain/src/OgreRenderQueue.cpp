@@ -39,6 +39,7 @@ namespace Ogre {
         : mSplitPassesByLightingType(false)
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
+        , mSortKeys(false)
         , mRenderableListener(0)
     {
         // Create the 'main' queue up-front since we'll always need that
@@ -165,6 +166,7 @@ namespace Ogre {
             mGroups[groupID].reset(new RenderQueueGroup(this, mSplitPassesByLightingType,
                                                         mSplitNoShadowPasses,
                                                         mShadowCastersCannotBeReceivers));
+            mGroups[groupID]->setSortKeysEnabled(mSortKeys);
         }
 
         return mGroups[groupID].get();
@@ -219,6 +221,22 @@ namespace Ogre {
         return mShadowCastersCannotBeReceivers;
     }
     //-----------------------------------------------------------------------
+    void RenderQueue::setSortKeysEnabled(bool enabled)
+    {
+        mSortKeys = enabled;
+
+        for (size_t i = 0; i < RENDER_QUEUE_COUNT; ++i)
+        {
+            if(mGroups[i])
+                mGroups[i]->setSortKeysEnabled(enabled);
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool RenderQueue::getSortKeysEnabled(void) const
+    {
+        return mSortKeys;
+    }
+    //-----------------------------------------------------------------------
     void RenderQueue::merge( const RenderQueue* rhs )
     {
         for (size_t i = 0; i < RENDER_QUEUE_COUNT; ++i)
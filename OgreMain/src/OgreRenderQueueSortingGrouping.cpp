@@ -34,6 +34,8 @@ namespace Ogre {
         RenderablePass, uint32> QueuedRenderableCollection::msRadixSorter1;
     RadixSort<QueuedRenderableCollection::RenderablePassList,
         RenderablePass, float> QueuedRenderableCollection::msRadixSorter2;
+    RadixSort<QueuedRenderableCollection::KeyedRenderablePassList,
+        QueuedRenderableCollection::KeyedRenderablePass, uint64> QueuedRenderableCollection::msRadixSorterKey;
 
 
     //-----------------------------------------------------------------------
@@ -251,6 +253,16 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void RenderPriorityGroup::setSortKeysEnabled(bool enabled)
+    {
+        mSolidsBasic.setSortKeysEnabled(enabled);
+        mSolidsDecal.setSortKeysEnabled(enabled);
+        mSolidsDiffuseSpecular.setSortKeysEnabled(enabled);
+        mSolidsNoShadowReceive.setSortKeysEnabled(enabled);
+        mTransparentsUnsorted.setSortKeysEnabled(enabled);
+        mTransparents.setSortKeysEnabled(enabled);
+    }
+    //-----------------------------------------------------------------------
     void RenderPriorityGroup::sort(const Camera* cam)
     {
         mSolidsBasic.sort(cam);
@@ -272,7 +284,7 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     QueuedRenderableCollection::QueuedRenderableCollection(void)
-        :mOrganisationMode(0)
+        :mOrganisationMode(0), mUseSortKeys(false)
     {
     }
 
@@ -289,6 +301,9 @@ namespace Ogre {
 
         // Clear sorted list
         mSortedDescending.clear();
+
+        // the keyed lists and mSortedAdded are kept for comparison on the next sort
+        mAdded.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
@@ -305,6 +320,12 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::sort(const Camera* cam)
     {
+        if (mUseSortKeys)
+        {
+            sortKeyed(cam);
+            return;
+        }
+
         // ascending and descending sort both set bit 1
         // We always sort descending, because the only difference is in the
         // acceptVisitor method, where we iterate in reverse in ascending mode
@@ -341,8 +362,108 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::sortByKey(KeyedRenderablePassList& list)
+    {
+        // same tipping point as for the two pass radix sort in sort()
+        if (list.size() > 2000)
+            msRadixSorterKey.sort(list, RadixSortFunctorKey());
+        else
+            std::stable_sort(list.begin(), list.end());
+    }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::sortKeyed(const Camera* cam)
+    {
+        struct SamePair
+        {
+            bool operator()(const RenderablePass& a, const RenderablePass& b) const
+            {
+                return a.renderable == b.renderable && a.pass == b.pass;
+            }
+        };
+
+        // the same pairs as last time? e.g. static scene with an unchanged view
+        bool sameAdded = mAdded.size() == mSortedAdded.size() &&
+            std::equal(mAdded.begin(), mAdded.end(), mSortedAdded.begin(), SamePair());
+
+        if (mOrganisationMode & OM_PASS_GROUP)
+        {
+            // group by hash, then by the order the passes were first added in
+            // should two passes share a hash
+            bool rebuild = !sameAdded || mKeyedGrouped.size() != mAdded.size();
+            for (size_t i = 0; !rebuild && i < mKeyedGrouped.size(); ++i)
+            {
+                const KeyedRenderablePass& e = mKeyedGrouped[i];
+                rebuild = uint32(e.key >> 32) != e.rp.pass->getHash();
+            }
+
+            if (rebuild)
+            {
+                mKeyedGrouped.clear();
+                std::map<const Pass*, uint32> passIndices;
+                for (RenderablePassList::iterator i = mAdded.begin(); i != mAdded.end(); ++i)
+                {
+                    uint32 passIndex =
+                        passIndices.emplace(i->pass, uint32(passIndices.size())).first->second;
+                    uint64 key = (uint64(i->pass->getHash()) << 32) | passIndex;
+                    mKeyedGrouped.push_back(KeyedRenderablePass(key, *i));
+                }
+                sortByKey(mKeyedGrouped);
+            }
+        }
+        else
+        {
+            mKeyedGrouped.clear();
+        }
+
+        // ascending and descending sort both set bit 1
+        if (mOrganisationMode & OM_SORT_DESCENDING)
+        {
+            // start from the order of the last sort if possible, which is already
+            // sorted or nearly so if the renderables and the camera moved little
+            if (!sameAdded || mKeyedDescending.size() != mAdded.size())
+            {
+                mKeyedDescending.clear();
+                for (RenderablePassList::iterator i = mAdded.begin(); i != mAdded.end(); ++i)
+                    mKeyedDescending.push_back(KeyedRenderablePass(0, *i));
+            }
+
+            bool sorted = true;
+            uint64 prevKey = 0;
+            for (KeyedRenderablePassList::iterator i = mKeyedDescending.begin();
+                 i != mKeyedDescending.end(); ++i)
+            {
+                // map the float to an uint32 of the same order, then invert so far
+                // objects come first
+                float depth = static_cast<float>(i->rp.renderable->getSquaredViewDepth(cam));
+                uint32 bits;
+                memcpy(&bits, &depth, sizeof(float));
+                bits ^= (bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+
+                i->key = (uint64(~bits) << 32) | i->rp.pass->getHash();
+                sorted = sorted && prevKey <= i->key;
+                prevKey = i->key;
+            }
+
+            if (!sorted)
+                sortByKey(mKeyedDescending);
+        }
+        else
+        {
+            mKeyedDescending.clear();
+        }
+
+        if (!sameAdded)
+            mSortedAdded = mAdded;
+    }
+    //-----------------------------------------------------------------------
     void QueuedRenderableCollection::addRenderable(Pass* pass, Renderable* rend)
     {
+        if (mUseSortKeys)
+        {
+            mAdded.push_back(RenderablePass(rend, pass));
+            return;
+        }
+
         // ascending and descending sort both set bit 1
         if (mOrganisationMode & OM_SORT_DESCENDING)
         {
@@ -386,7 +507,10 @@ namespace Ogre {
         switch(om)
         {
         case OM_PASS_GROUP:
-            acceptVisitorGrouped(visitor);
+            if (mUseSortKeys)
+                acceptVisitorKeyedGrouped(visitor);
+            else
+                acceptVisitorGrouped(visitor);
             break;
         case OM_SORT_DESCENDING:
             acceptVisitorDescending(visitor);
@@ -413,9 +537,35 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::acceptVisitorKeyedGrouped(
+        QueuedRenderableVisitor* visitor) const
+    {
+        KeyedRenderablePassList::const_iterator i = mKeyedGrouped.begin();
+        while (i != mKeyedGrouped.end())
+        {
+            // the pairs of a pass are consecutive
+            Pass* pass = i->rp.pass;
+            mVisitedGroup.clear();
+            for (; i != mKeyedGrouped.end() && i->rp.pass == pass; ++i)
+                mVisitedGroup.push_back(i->rp.renderable);
+
+            visitor->visit(pass, mVisitedGroup);
+        }
+    }
+    //-----------------------------------------------------------------------
     void QueuedRenderableCollection::acceptVisitorDescending(
         QueuedRenderableVisitor* visitor) const
     {
+        if (mUseSortKeys)
+        {
+            for (KeyedRenderablePassList::const_iterator i = mKeyedDescending.begin();
+                 i != mKeyedDescending.end(); ++i)
+            {
+                visitor->visit(const_cast<RenderablePass*>(&i->rp));
+            }
+            return;
+        }
+
         // List is already in descending order, so iterate forward
         RenderablePassList::const_iterator i, iend;
 
@@ -429,6 +579,16 @@ namespace Ogre {
     void QueuedRenderableCollection::acceptVisitorAscending(
         QueuedRenderableVisitor* visitor) const
     {
+        if (mUseSortKeys)
+        {
+            for (KeyedRenderablePassList::const_reverse_iterator i = mKeyedDescending.rbegin();
+                 i != mKeyedDescending.rend(); ++i)
+            {
+                visitor->visit(const_cast<RenderablePass*>(&i->rp));
+            }
+            return;
+        }
+
         // List is in descending order, so iterate in reverse
         RenderablePassList::const_reverse_iterator i, iend;
 
@@ -442,6 +602,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
     {
+        mAdded.insert( mAdded.end(), rhs.mAdded.begin(), rhs.mAdded.end() );
+
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
 
         PassGroupRenderableMap::const_iterator srcGroup;
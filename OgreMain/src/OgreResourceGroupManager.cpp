@@ -27,6 +27,10 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
+#include "OgreWorkQueue.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreTextureUnitState.h"
 
 namespace Ogre {
 
@@ -55,7 +59,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mCurrentGroup(0), mParallelLoading(false)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -289,6 +293,10 @@ namespace Ogre {
 
         fireResourceGroupLoadStarted(name, resourceCount);
 
+        // Do the CPU side work up front, leaving only the final load below
+        if (loadMainResources && mParallelLoading)
+            prepareResourcesParallel(name, grp);
+
         // Now load for real
         if (loadMainResources)
         {
@@ -347,6 +355,94 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::prepareResourcesParallel(const String& name, ResourceGroup* grp)
+    {
+        WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+        if (!queue)
+            return;
+
+        // Gather the resources to prepare, following material -> texture dependencies
+        std::vector<ResourcePtr> toPrepare;
+        std::set<Resource*> added;
+        auto addResource = [&](const ResourcePtr& res)
+        {
+            if (res && !res->isManuallyLoaded() &&
+                res->getLoadingState() == Resource::LOADSTATE_UNLOADED && added.insert(res.get()).second)
+                toPrepare.push_back(res);
+        };
+
+        for (auto& oi : grp->loadResourceOrderMap)
+        {
+            for (auto& res : oi.second)
+            {
+                Material* mat = dynamic_cast<Material*>(res.get());
+                if (!mat)
+                {
+                    addResource(res);
+                    continue;
+                }
+
+                if (mat->getLoadingState() == Resource::LOADSTATE_UNLOADED)
+                {
+                    // Compiling depends on the RenderSystem, so the material itself is
+                    // prepared when loaded. The textures it needs can go in parallel.
+                    mat->compile();
+                    for (auto tech : mat->getSupportedTechniques())
+                    {
+                        for (auto pass : tech->getPasses())
+                        {
+                            for (auto tus : pass->getTextureUnitStates())
+                            {
+                                if (tus->getContentType() != TextureUnitState::CONTENT_NAMED)
+                                    continue;
+
+                                for (unsigned int f = 0; f < tus->getNumFrames(); ++f)
+                                {
+                                    const TexturePtr& tex = tus->_getTexturePtr(f);
+                                    if (tex && tex->getLoadingState() == Resource::LOADSTATE_UNLOADED)
+                                    {
+                                        tex->setGamma(tus->getGamma());
+                                        addResource(tex);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        fireResourceGroupPrepareStarted(name, toPrepare.size());
+
+        // Report progress between batches, listeners are called on this thread only
+        static const size_t BATCH_SIZE = 64;
+        for (size_t begin = 0; begin < toPrepare.size(); begin += BATCH_SIZE)
+        {
+            size_t end = std::min(begin + BATCH_SIZE, toPrepare.size());
+            queue->parallelFor(end - begin, 1, [&](size_t b, size_t e) {
+                for (size_t i = begin + b; i < begin + e; ++i)
+                {
+                    try
+                    {
+                        toPrepare[i]->prepare(true);
+                    }
+                    catch (std::exception&)
+                    {
+                        // loading it below will report the error
+                    }
+                }
+            });
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                fireResourcePrepareStarted(toPrepare[i]);
+                fireResourcePrepareEnded();
+            }
+        }
+
+        fireResourceGroupPrepareEnded(name);
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
         LogManager::getSingleton().logMessage("Unloading resource group " + name);
@@ -1014,7 +1110,8 @@ namespace Ogre {
                         if (mLoadingListener)
                             mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
 
-                        if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                        if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024 &&
+                           !dynamic_cast<MemoryDataStream*>(stream.get()))
                         {
                             DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
                             su->parseScript(cachedCopy, grp->name);
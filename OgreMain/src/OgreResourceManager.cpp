@@ -69,10 +69,15 @@ namespace Ogre {
         bool isManual, ManualResourceLoader* loader, 
         const NameValuePairList* params)
     {
+        // Most calls find an existing resource, which does not need the manager mutex
+        ResourcePtr res = getResourceByName(name, group);
+        if (res)
+            return ResourceCreateOrRetrieveResult(res, false);
+
         // Lock for the whole get / insert
-            OGRE_LOCK_AUTO_MUTEX;
+        OGRE_LOCK_AUTO_MUTEX;
 
-        ResourcePtr res = getResourceByName(name, group);
+        res = getResourceByName(name, group);
         bool created = false;
         if (!res)
         {
@@ -109,7 +114,8 @@ namespace Ogre {
             OGRE_LOCK_AUTO_MUTEX;
 
             std::pair<ResourceMap::iterator, bool> result;
-        if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+        bool inGlobalPool = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup());
+        if(inGlobalPool)
         {
             result = mResources.emplace(res->getName(), res);
         }
@@ -132,7 +138,8 @@ namespace Ogre {
             }
 
             // Try to do the addition again, no seconds attempts to resolve collisions are allowed
-            if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+            inGlobalPool = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup());
+            if(inGlobalPool)
             {
                 result = mResources.emplace(res->getName(), res);
             }
@@ -157,6 +164,8 @@ namespace Ogre {
                 StringConverter::toString((long) (res->getHandle())) +
                 " already exists.", "ResourceManager::add");
         }
+
+        addToLookup(res, inGlobalPool);
     }
     //-----------------------------------------------------------------------
     void ResourceManager::removeImpl(const ResourcePtr& res )
@@ -165,13 +174,11 @@ namespace Ogre {
 
         OGRE_LOCK_AUTO_MUTEX;
 
-        if(ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(res->getGroup()))
+        // names are unique in the global pool, so this is where a global resource is
+        ResourceMap::iterator globalIt = mResources.find(res->getName());
+        if (globalIt != mResources.end() && globalIt->second == res)
         {
-            ResourceMap::iterator nameIt = mResources.find(res->getName());
-            if (nameIt != mResources.end())
-            {
-                mResources.erase(nameIt);
-            }
+            mResources.erase(globalIt);
         }
         else
         {
@@ -196,6 +203,7 @@ namespace Ogre {
         {
             mResourcesByHandle.erase(handleIt);
         }
+        removeFromLookup(res);
         // Tell resource group manager
         ResourceGroupManager::getSingleton()._notifyResourceRemoved(res);
     }
@@ -325,6 +333,7 @@ namespace Ogre {
     {
             OGRE_LOCK_AUTO_MUTEX;
 
+        clearLookup();
         mResources.clear();
         mResourcesWithGroup.clear();
         mResourcesByHandle.clear();
@@ -359,67 +368,119 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ResourcePtr ResourceManager::getResourceByName(const String& name, const String& groupName /* = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME */)
     {
-        OGRE_LOCK_AUTO_MUTEX;
-
-        // resource should be in global pool
-        bool isGlobal = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(groupName);
+        bool autodetect = groupName == ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME;
+        // autodetect includes the global pool. For other groups the entries tell, as they
+        // keep the pool of their group, so the lookup does not wait for the ResourceGroupManager.
+        bool isGlobal = autodetect;
+        bool poolKnown = autodetect;
 
-        if(isGlobal)
+        // the same name may be used once in the global pool and once per grouped pool
+        ResourcePtr globalRes, groupedRes;
         {
-            ResourceMap::iterator it = mResources.find(name);
-            if( it != mResources.end())
-            {
-                return it->second;
-            }
-        }
+            uint32 hash = FastHash(name.c_str(), name.size());
+            ResourceLookupShard& shard = getLookupShard(hash);
+            OGRE_LOCK_MUTEX(shard.mutex);
 
-        // look in all grouped pools
-        if (groupName == ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME)
-        {
-            ResourceWithGroupMap::iterator iter = mResourcesWithGroup.begin();
-            ResourceWithGroupMap::iterator iterE = mResourcesWithGroup.end();
-            for ( ; iter != iterE ; ++iter )
+            auto range = shard.byName.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
             {
-                ResourceMap::iterator resMapIt = iter->second.find(name);
+                const ResourceLookupEntry& entry = it->second;
+                ResourcePtr res = entry.resource.lock();
+                if (!res || res->getName() != name)
+                    continue;
 
-                if( resMapIt != iter->second.end())
+                bool inGroup = entry.group == groupName;
+                if (inGroup)
                 {
-                    return resMapIt->second;
+                    isGlobal = entry.inGlobalPool;
+                    poolKnown = true;
                 }
+
+                if (entry.inGlobalPool)
+                    globalRes = res;
+                else if (autodetect || inGroup)
+                    groupedRes = res;
             }
         }
-        else if (!isGlobal)
-        {
-            // look in the grouped pool
-            ResourceWithGroupMap::iterator itGroup = mResourcesWithGroup.find(groupName);
-            if( itGroup != mResourcesWithGroup.end())
-            {
-                ResourceMap::iterator it = itGroup->second.find(name);
 
-                if( it != itGroup->second.end())
-                {
-                    return it->second;
-                }
-            }
+        // Only needed if the group has no resource of this name. A miss also throws for
+        // unknown groups, like it always did.
+#if OGRE_RESOURCEMANAGER_STRICT
+        if (!poolKnown)
+#else
+        if (!poolKnown && !globalRes)
+#endif
+            isGlobal = ResourceGroupManager::getSingleton().isResourceGroupInGlobalPool(groupName);
+
+        if (isGlobal && globalRes)
+            return globalRes;
+
+        // look in all grouped pools or in the given one
+        if (groupedRes)
+            return groupedRes;
 
 #if !OGRE_RESOURCEMANAGER_STRICT
-            // fall back to global
-            ResourceMap::iterator it = mResources.find(name);
-            if( it != mResources.end())
-            {
-                return it->second;
-            }
+        // fall back to global
+        if (!isGlobal && !autodetect)
+            return globalRes;
 #endif
-        }
     
         return ResourcePtr();
     }
     //-----------------------------------------------------------------------
     ResourcePtr ResourceManager::getByHandle(ResourceHandle handle)
     {
-        OGRE_LOCK_AUTO_MUTEX;
-        ResourceHandleMap::iterator it = mResourcesByHandle.find(handle);
-        return it == mResourcesByHandle.end() ? ResourcePtr() : it->second;
+        ResourceLookupShard& shard = getLookupShard(uint32(handle));
+        OGRE_LOCK_MUTEX(shard.mutex);
+        auto it = shard.byHandle.find(handle);
+        return it == shard.byHandle.end() ? ResourcePtr() : ResourcePtr(it->second.lock());
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::addToLookup(const ResourcePtr& res, bool inGlobalPool)
+    {
+        const String& name = res->getName();
+        uint32 hash = FastHash(name.c_str(), name.size());
+        ResourceLookupEntry entry = {res, res->getGroup(), inGlobalPool};
+        {
+            ResourceLookupShard& shard = getLookupShard(hash);
+            OGRE_LOCK_MUTEX(shard.mutex);
+            shard.byName.emplace(hash, entry);
+        }
+        ResourceLookupShard& shard = getLookupShard(uint32(res->getHandle()));
+        OGRE_LOCK_MUTEX(shard.mutex);
+        shard.byHandle.emplace(res->getHandle(), res);
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::removeFromLookup(const ResourcePtr& res)
+    {
+        const String& name = res->getName();
+        uint32 hash = FastHash(name.c_str(), name.size());
+        {
+            ResourceLookupShard& shard = getLookupShard(hash);
+            OGRE_LOCK_MUTEX(shard.mutex);
+            auto range = shard.byName.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second.resource.lock() == res)
+                {
+                    shard.byName.erase(it);
+                    break;
+                }
+            }
+        }
+        ResourceLookupShard& shard = getLookupShard(uint32(res->getHandle()));
+        OGRE_LOCK_MUTEX(shard.mutex);
+        shard.byHandle.erase(res->getHandle());
+    }
+    //-----------------------------------------------------------------------
+    void ResourceManager::clearLookup(void)
+    {
+        for (ResourceLookupShard& shard : mLookupShards)
+        {
+            OGRE_LOCK_MUTEX(shard.mutex);
+            shard.byName.clear();
+            shard.byHandle.clear();
+        }
     }
     //-----------------------------------------------------------------------
     ResourceHandle ResourceManager::getNextHandle(void)
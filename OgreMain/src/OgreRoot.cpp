@@ -96,7 +96,7 @@ namespace Ogre {
 
     //-----------------------------------------------------------------------
     Root::Root(const String& pluginFileName, const String& configFileName,
-        const String& logFileName)
+        const String& logFileName, WorkQueue* workQueue)
       : mQueuedEnd(false)
       , mNextFrame(0)
       , mFrameSmoothingTime(0.0f)
@@ -141,19 +141,26 @@ namespace Ogre {
         mResourceGroupManager.reset(new ResourceGroupManager());
 
         // WorkQueue (note: users can replace this if they want)
-        DefaultWorkQueue* defaultQ = OGRE_NEW DefaultWorkQueue("Root");
-        // never process responses in main thread for longer than 10ms by default
-        defaultQ->setResponseProcessingTimeLimit(10);
-        // match threads to hardware
-        int threadCount = OGRE_THREAD_HARDWARE_CONCURRENCY;
-        // but clamp it at 2 by default - we dont scale much beyond that currently
-        // yet it helps on android where it needlessly burns CPU
-        threadCount = Math::Clamp(threadCount, 1, 2);
-        defaultQ->setWorkerThreadCount(threadCount);
-
-        // only allow workers to access rendersystem if threadsupport is 1
-        defaultQ->setWorkersCanAccessRenderSystem(OGRE_THREAD_SUPPORT == 1);
-        mWorkQueue.reset(defaultQ);
+        if (workQueue)
+        {
+            mWorkQueue.reset(workQueue);
+        }
+        else
+        {
+            DefaultWorkQueue* defaultQ = OGRE_NEW DefaultWorkQueue("Root");
+            // never process responses in main thread for longer than 10ms by default
+            defaultQ->setResponseProcessingTimeLimit(10);
+            // match threads to hardware
+            int threadCount = OGRE_THREAD_HARDWARE_CONCURRENCY;
+            // but clamp it at 2 by default - we dont scale much beyond that currently
+            // yet it helps on android where it needlessly burns CPU
+            threadCount = Math::Clamp(threadCount, 1, 2);
+            defaultQ->setWorkerThreadCount(threadCount);
+
+            // only allow workers to access rendersystem if threadsupport is 1
+            defaultQ->setWorkersCanAccessRenderSystem(OGRE_THREAD_SUPPORT == 1);
+            mWorkQueue.reset(defaultQ);
+        }
 
         // ResourceBackgroundQueue
         mResourceBackgroundQueue.reset(new ResourceBackgroundQueue());
@@ -47,6 +47,7 @@ THE SOFTWARE.
 #include "OgreLodListener.h"
 #include "OgreUnifiedHighLevelGpuProgram.h"
 #include "OgreDefaultDebugDrawer.h"
+#include "OgreOptimisedUtil.h"
 
 // This class implements the most basic scene manager
 
@@ -54,6 +55,51 @@ THE SOFTWARE.
 
 namespace Ogre {
 //-----------------------------------------------------------------------
+struct SceneManager::SoftwareBlendBatch
+{
+    /// A buffer kept locked until the blends are done
+    struct LockedBuffer
+    {
+        HardwareVertexBufferSharedPtr buffer;
+        void* data;
+        bool write;
+    };
+    /// A blend, with the offset of its blend matrices
+    struct Blend
+    {
+        Mesh::SoftwareVertexBlendData data;
+        size_t firstMatrix;
+    };
+    /// A range of vertices of a blend, the unit of parallel work
+    struct Range
+    {
+        size_t blend;
+        size_t begin;
+        size_t end;
+    };
+
+    bool collecting;
+    std::vector<Blend> blends;
+    std::vector<const Affine3*> matrices;
+    std::map<HardwareVertexBuffer*, LockedBuffer> lockedBuffers;
+    std::vector<Range> ranges;
+
+    SoftwareBlendBatch() : collecting(false) {}
+
+    /// Whether the vertex data uses a buffer locked for writing, or any locked buffer if write is set
+    bool usesLockedBuffer(const VertexData* vertexData, bool write) const
+    {
+        for (const auto& binding : vertexData->vertexBufferBinding->getBindings())
+        {
+            std::map<HardwareVertexBuffer*, LockedBuffer>::const_iterator i =
+                lockedBuffers.find(binding.second.get());
+            if (i != lockedBuffers.end() && (write || i->second.write))
+                return true;
+        }
+        return false;
+    }
+};
+//-----------------------------------------------------------------------
 SceneManager::SceneManager(const String& name) :
 mName(name),
 mLastRenderQueueInvocationCustom(false),
@@ -78,6 +124,15 @@ mLightsDirtyCounter(0),
 mMovableNameGenerator("Ogre/MO"),
 mShadowRenderer(this),
 mDisplayNodes(false),
+mParallelCulling(false),
+mFlatTransformUpdate(false),
+mSceneGraphChanged(true),
+mParallelSoftwareAnimation(false),
+mSoftwareBlendBatch(new SoftwareBlendBatch()),
+mRaySceneQueryBVH(false),
+mIntersectionSceneQueryBroadphase(false),
+mMovableObjectsChangeCount(0),
+mMovableObjectsMoveCount(0),
 mShowBoundingBoxes(false),
 mActiveCompositorChain(0),
 mLateMaterialResolving(false),
@@ -89,7 +144,8 @@ mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
 mLastLightHash(0),
-mGpuParamsDirty((uint16)GPV_ALL)
+mGpuParamsDirty((uint16)GPV_ALL),
+mGpuParamDeduplication(false)
 {
     Root *root = Root::getSingletonPtr();
     if (root)
@@ -1370,8 +1426,10 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
             // Parse the scene and tag visibles
             firePreFindVisibleObjects(vp);
+            _beginSoftwareVertexBlends();
             _findVisibleObjects(camera, &(camVisObjIt->second),
                 mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+            _endSoftwareVertexBlends();
             firePostFindVisibleObjects(vp);
 
             mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -1603,24 +1661,527 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // Process queued needUpdate calls 
     Node::processQueuedUpdates();
 
-    // Cascade down the graph updating transforms & world bounds
-    // In this implementation, just update from the root
-    // Smarter SceneManager subclasses may choose to update only
-    //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+    if (mFlatTransformUpdate)
+    {
+        updateSceneGraphFlat();
+    }
+    else
+    {
+        // Cascade down the graph updating transforms & world bounds
+        // In this implementation, just update from the root
+        // Smarter SceneManager subclasses may choose to update only
+        //   certain scene graph branches
+        getRootSceneNode()->_update(true, false);
+    }
+    ++mMovableObjectsMoveCount;
 
     firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphFlat()
+{
+    TransformHierarchy& h = mTransformHierarchy;
+
+    if (mSceneGraphChanged)
+    {
+        // Breadth first, so that each depth level is a contiguous range
+        h.nodes.assign(1, getRootSceneNode());
+        h.parents.assign(1, 0);
+        h.levels.assign(1, 0);
+        for (size_t begin = 0; begin < h.nodes.size();)
+        {
+            size_t end = h.nodes.size();
+            for (size_t i = begin; i < end; ++i)
+            {
+                for (auto child : h.nodes[i]->getChildren())
+                {
+                    h.nodes.push_back(static_cast<SceneNode*>(child));
+                    h.parents.push_back(uint32(i));
+                }
+            }
+            h.levels.push_back(end);
+            begin = end;
+        }
+        mSceneGraphChanged = false;
+    }
+
+    size_t numNodes = h.nodes.size();
+    size_t stride = numNodes;
+    h.states.resize(numNodes);
+    h.inherit.resize(numNodes);
+    h.local.resize(10 * stride);
+    h.derived.resize(10 * stride);
+    h.dirty.clear();
+    h.dirtyLevels.clear();
+
+    enum
+    {
+        VISITED = 1,
+        UPDATE_SELF = 2,
+        UPDATE_CHILDREN = 4
+    };
+
+    float* local = h.local.data();
+    float* derived = h.derived.data();
+
+    // Select the nodes the recursive Node::_update would visit, and gather the
+    // transforms of the ones to recompute
+    for (size_t l = 0; l + 1 < h.levels.size(); ++l)
+    {
+        h.dirtyLevels.push_back(h.dirty.size());
+        for (size_t i = h.levels[l]; i < h.levels[l + 1]; ++i)
+        {
+            SceneNode* n = h.nodes[i];
+            uchar state = VISITED;
+            if (i != 0)
+            {
+                uchar parentState = h.states[h.parents[i]];
+                if (parentState & UPDATE_CHILDREN)
+                {
+                    state |= UPDATE_SELF | UPDATE_CHILDREN;
+                }
+                else if (!(parentState & VISITED) || !h.nodes[h.parents[i]]->mChildrenToUpdate.count(n))
+                {
+                    h.states[i] = 0;
+                    continue;
+                }
+            }
+            if (n->mNeedParentUpdate)
+                state |= UPDATE_SELF;
+            if (n->mNeedChildUpdate)
+                state |= UPDATE_CHILDREN;
+            h.states[i] = state;
+
+            if ((state & UPDATE_SELF) && i != 0)
+            {
+                h.dirty.push_back(uint32(i));
+                h.inherit[i] = uchar(n->mInheritOrientation) | uchar(n->mInheritScale) << 1;
+                for (int c = 0; c < 3; ++c)
+                {
+                    local[c * stride + i] = n->mPosition[c];
+                    local[(3 + c) * stride + i] = n->mScale[c];
+                }
+                for (int c = 0; c < 4; ++c)
+                    local[(6 + c) * stride + i] = n->mOrientation[c];
+                continue;
+            }
+
+            // The root has nothing to inherit from
+            if (state & UPDATE_SELF)
+                n->_updateFromParent();
+
+            // Children may read this one as their parent
+            for (int c = 0; c < 3; ++c)
+            {
+                derived[c * stride + i] = n->mDerivedPosition[c];
+                derived[(3 + c) * stride + i] = n->mDerivedScale[c];
+            }
+            for (int c = 0; c < 4; ++c)
+                derived[(6 + c) * stride + i] = n->mDerivedOrientation[c];
+        }
+    }
+    h.dirtyLevels.push_back(h.dirty.size());
+
+#if OGRE_NODE_INHERIT_TRANSFORM || OGRE_DOUBLE_PRECISION
+    // Shear or doubles are not supported by the batched update
+    for (uint32 i : h.dirty)
+        h.nodes[i]->_updateFromParent();
+#else
+    WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+
+    // Each level only depends on the previous one
+    for (size_t l = 0; l + 1 < h.dirtyLevels.size(); ++l)
+    {
+        const uint32* indices = h.dirty.data() + h.dirtyLevels[l];
+        size_t count = h.dirtyLevels[l + 1] - h.dirtyLevels[l];
+        if (count == 0)
+            continue;
+
+        auto updateRange = [&](size_t begin, size_t end)
+        {
+            OptimisedUtil::getImplementation()->calculateDerivedTransforms(
+                local, derived, stride, h.parents.data(), h.inherit.data(), indices + begin, end - begin);
+        };
+
+        if (queue)
+            queue->parallelFor(count, 512, updateRange);
+        else
+            updateRange(0, count);
+    }
+
+    // Write back, raising the same notifications as Node::_updateFromParent
+    for (uint32 i : h.dirty)
+    {
+        SceneNode* n = h.nodes[i];
+        n->mDerivedPosition = Vector3(derived[i], derived[stride + i], derived[2 * stride + i]);
+        n->mDerivedScale = Vector3(derived[3 * stride + i], derived[4 * stride + i], derived[5 * stride + i]);
+        n->mDerivedOrientation = Quaternion(derived[6 * stride + i], derived[7 * stride + i],
+                                            derived[8 * stride + i], derived[9 * stride + i]);
+        n->mCachedTransformOutOfDate = true;
+        n->mNeedParentUpdate = false;
+
+        for (auto o : n->mObjectsByName)
+            o->_notifyMoved();
+
+        if (n->mListener)
+            n->mListener->nodeUpdated(n);
+    }
+#endif
+
+    // Bounds and update flags, children first
+    for (size_t i = numNodes; i-- > 0;)
+    {
+        if (!(h.states[i] & VISITED))
+            continue;
+
+        SceneNode* n = h.nodes[i];
+        n->mParentNotified = false;
+        n->mChildrenToUpdate.clear();
+        n->mNeedChildUpdate = false;
+        n->_updateBounds();
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
     Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    for (size_t i = 0; i < mPrecomputedCulling.numCameras; ++i)
+    {
+        if (mPrecomputedCulling.cameras[i].camera == cam)
+        {
+            queueVisibleNodes(cam, mPrecomputedCulling.nodes, mPrecomputedCulling.cameras[i].visibilities.data(),
+                              visibleBounds, onlyShadowCasters);
+            return;
+        }
+    }
+
+    if (mParallelCulling)
+    {
+        findVisibleObjectsParallel(cam, visibleBounds, onlyShadowCasters);
+        return;
+    }
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
 
 }
 //-----------------------------------------------------------------------
+size_t SceneManager::getCullingPlanes(const Camera* cam, Vector4* planes)
+{
+    // Frustum updates its planes lazily, so this must happen on the calling thread
+    const Frustum* frustum = cam->getCullingFrustum() ? cam->getCullingFrustum() : cam;
+    const Plane* frustumPlanes = frustum->getFrustumPlanes();
+    size_t numPlanes = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        // Skip far plane if infinite view frustum
+        if (i == FRUSTUM_PLANE_FAR && frustum->getFarClipDistance() == 0)
+            continue;
+        planes[numPlanes++] = Vector4(frustumPlanes[i].normal.x, frustumPlanes[i].normal.y,
+                                      frustumPlanes[i].normal.z, frustumPlanes[i].d);
+    }
+    return numPlanes;
+}
+//-----------------------------------------------------------------------
+void SceneManager::gatherCullingBoxes(const Vector4* planes, size_t numPlanes)
+{
+    // Flatten the scene graph in the order SceneNode::_findVisibleObjects would visit it.
+    // Testing every node instead of descending only into visible ones yields the same
+    // result, as the bounds of a node contain the bounds of its children.
+    std::vector<SceneNode*>& nodes = mCullingData.nodes;
+    std::vector<Node*>& stack = mCullingData.stack;
+    nodes.clear();
+    stack.assign(1, getRootSceneNode());
+    while (!stack.empty())
+    {
+        Node* node = stack.back();
+        stack.pop_back();
+        nodes.push_back(static_cast<SceneNode*>(node));
+        stack.insert(stack.end(), node->getChildren().rbegin(), node->getChildren().rend());
+    }
+
+    size_t numNodes = nodes.size();
+    mCullingData.boxes.resize(6 * numNodes);
+    mCullingData.visibilities.resize(numNodes);
+    float* centres = mCullingData.boxes.data();
+    float* halfSizes = centres + 3 * numNodes;
+
+    auto gatherRange = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            // Null and infinite boxes are marked by a negative half size
+            const AxisAlignedBox& aabb = nodes[i]->_getWorldAABB();
+            Vector3 centre = Vector3::ZERO;
+            Vector3 halfSize(aabb.isInfinite() ? -2 : -1);
+            if (aabb.isFinite())
+            {
+                centre = aabb.getCenter();
+                halfSize = aabb.getHalfSize();
+            }
+            for (int j = 0; j < 3; ++j)
+            {
+                centres[j * numNodes + i] = centre[j];
+                halfSizes[j * numNodes + i] = halfSize[j];
+            }
+        }
+
+        if (planes)
+            cullBoxes(planes, numPlanes, mCullingData.visibilities.data(), begin, end);
+    };
+
+    // Chunks are a multiple of the SIMD width
+    if (Root* root = Root::getSingletonPtr())
+        root->getWorkQueue()->parallelFor(numNodes, CULLING_GRAIN_SIZE, gatherRange);
+    else
+        gatherRange(0, numNodes);
+}
+//-----------------------------------------------------------------------
+void SceneManager::cullBoxes(const Vector4* planes, size_t numPlanes, char* visibilities, size_t begin,
+                             size_t end) const
+{
+    size_t numNodes = mCullingData.nodes.size();
+    const float* centres = mCullingData.boxes.data();
+    const float* halfSizes = centres + 3 * numNodes;
+
+    OptimisedUtil::getImplementation()->calculateBoxVisibility(
+        planes, numPlanes, centres + begin, halfSizes + begin, numNodes, visibilities + begin, end - begin);
+
+    // Null boxes are always invisible, infinite boxes always visible
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (halfSizes[i] < 0)
+            visibilities[i] = halfSizes[i] < -1.5f;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::findVisibleObjectsParallel(
+    Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+    Vector4 planes[6];
+    size_t numPlanes = getCullingPlanes(cam, planes);
+    gatherCullingBoxes(planes, numPlanes);
+    queueVisibleNodes(cam, mCullingData.nodes, mCullingData.visibilities.data(), visibleBounds,
+                      onlyShadowCasters);
+}
+//-----------------------------------------------------------------------
+size_t SceneManager::_precomputeCulling(Camera* const* cameras, size_t count, bool reuseUnchanged)
+{
+    gatherCullingBoxes(NULL, 0);
+
+    // The visibilities only depend on the boxes and the planes
+    PrecomputedCulling& pc = mPrecomputedCulling;
+    bool boxesUnchanged = reuseUnchanged && pc.boxes == mCullingData.boxes;
+    pc.nodes = mCullingData.nodes;
+    pc.boxes = mCullingData.boxes;
+    if (pc.cameras.size() < count)
+        pc.cameras.resize(count);
+    pc.numCameras = count;
+
+    std::vector<size_t> outdated;
+    for (size_t c = 0; c < count; ++c)
+    {
+        CameraCulling& cc = pc.cameras[c];
+        Vector4 planes[6];
+        size_t numPlanes = getCullingPlanes(cameras[c], planes);
+        if (boxesUnchanged && cc.camera == cameras[c] && cc.numPlanes == numPlanes &&
+            std::equal(planes, planes + numPlanes, cc.planes))
+            continue;
+
+        cc.camera = cameras[c];
+        cc.numPlanes = numPlanes;
+        std::copy(planes, planes + numPlanes, cc.planes);
+        cc.visibilities.resize(pc.nodes.size());
+        outdated.push_back(c);
+    }
+
+    // Split the work into chunks of all cameras, so even a single camera runs in parallel
+    size_t numNodes = pc.nodes.size();
+    size_t numChunks = (numNodes + CULLING_GRAIN_SIZE - 1) / CULLING_GRAIN_SIZE;
+    auto cullChunks = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            CameraCulling& cc = pc.cameras[outdated[i / numChunks]];
+            size_t first = (i % numChunks) * CULLING_GRAIN_SIZE;
+            cullBoxes(cc.planes, cc.numPlanes, cc.visibilities.data(), first,
+                      std::min(first + CULLING_GRAIN_SIZE, numNodes));
+        }
+    };
+    if (Root* root = Root::getSingletonPtr())
+        root->getWorkQueue()->parallelFor(outdated.size() * numChunks, 1, cullChunks);
+    else
+        cullChunks(0, outdated.size() * numChunks);
+
+    return outdated.size();
+}
+//-----------------------------------------------------------------------
+void SceneManager::_clearPrecomputedCulling()
+{
+    // keep the results, they may be reused the next time
+    mPrecomputedCulling.numCameras = 0;
+}
+//-----------------------------------------------------------------------
+void SceneManager::queueVisibleNodes(Camera* cam, const std::vector<SceneNode*>& nodes,
+                                     const char* visibilities, VisibleObjectsBoundsInfo* visibleBounds,
+                                     bool onlyShadowCasters)
+{
+    // Feed the survivors into the render queue, in traversal order. Like the recursion,
+    // a node is drawn by the debug drawer after all of its children, so the nodes are
+    // kept on a stack until the next node is not part of their subtree.
+    RenderQueue* queue = getRenderQueue();
+    std::vector<size_t>& pending = mCullingData.pendingDebugNodes;
+    pending.clear();
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (mDebugDrawer)
+        {
+            while (!pending.empty() && nodes[pending.back()] != nodes[i]->getParent())
+            {
+                if (visibilities[pending.back()])
+                    mDebugDrawer->drawSceneNode(nodes[pending.back()]);
+                pending.pop_back();
+            }
+            pending.push_back(i);
+        }
+
+        if (!visibilities[i])
+            continue;
+
+        for (MovableObject* mo : nodes[i]->getAttachedObjects())
+            queue->processVisibleObject(mo, cam, onlyShadowCasters, visibleBounds);
+    }
+
+    for (; !pending.empty(); pending.pop_back())
+    {
+        if (visibilities[pending.back()])
+            mDebugDrawer->drawSceneNode(nodes[pending.back()]);
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::_beginSoftwareVertexBlends()
+{
+    mSoftwareBlendBatch->collecting = mParallelSoftwareAnimation;
+}
+//-----------------------------------------------------------------------
+bool SceneManager::_queueSoftwareVertexBlend(const VertexData* sourceVertexData,
+    const VertexData* targetVertexData, const Affine3* const* blendMatrices,
+    size_t numMatrices, bool blendNormals)
+{
+    SoftwareBlendBatch& batch = *mSoftwareBlendBatch;
+    if (!batch.collecting)
+        return false;
+
+    // A buffer must not be written by one blend while used by another one, e.g.
+    // if an Entity is blended twice
+    if (batch.usesLockedBuffer(sourceVertexData, false) || batch.usesLockedBuffer(targetVertexData, true))
+        applySoftwareVertexBlends();
+
+    SoftwareBlendBatch::Blend blend;
+    blend.firstMatrix = batch.matrices.size();
+    batch.matrices.insert(batch.matrices.end(), blendMatrices, blendMatrices + numMatrices);
+
+    // Shared source buffers are only locked once for all blends
+    Mesh::prepareSoftwareVertexBlend(sourceVertexData, targetVertexData, blendNormals,
+        [&batch](const HardwareVertexBufferSharedPtr& buf, HardwareBuffer::LockOptions options) {
+            SoftwareBlendBatch::LockedBuffer& locked = batch.lockedBuffers[buf.get()];
+            if (!locked.buffer)
+            {
+                locked.data = buf->lock(options);
+                locked.buffer = buf;
+                locked.write = options != HardwareBuffer::HBL_READ_ONLY;
+            }
+            return locked.data;
+        }, blend.data);
+
+    batch.blends.push_back(blend);
+    return true;
+}
+//-----------------------------------------------------------------------
+void SceneManager::_endSoftwareVertexBlends()
+{
+    applySoftwareVertexBlends();
+    mSoftwareBlendBatch->collecting = false;
+}
+//-----------------------------------------------------------------------
+void SceneManager::_flushSoftwareVertexBlends(const VertexData* vertexData)
+{
+    SoftwareBlendBatch& batch = *mSoftwareBlendBatch;
+    if (vertexData && !batch.blends.empty() && batch.usesLockedBuffer(vertexData, true))
+        applySoftwareVertexBlends();
+}
+//-----------------------------------------------------------------------
+void SceneManager::applySoftwareVertexBlends()
+{
+    SoftwareBlendBatch& batch = *mSoftwareBlendBatch;
+
+    // Split large meshes, so that all threads get a similar amount of vertices
+    static const size_t rangeSize = 1024;
+    batch.ranges.clear();
+    for (size_t i = 0; i < batch.blends.size(); ++i)
+    {
+        size_t numVertices = batch.blends[i].data.numVertices;
+        for (size_t begin = 0; begin < numVertices; begin += rangeSize)
+        {
+            SoftwareBlendBatch::Range range = {i, begin, std::min(begin + rangeSize, numVertices)};
+            batch.ranges.push_back(range);
+        }
+    }
+
+    auto blendRanges = [&batch](size_t begin, size_t end)
+    {
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const SoftwareBlendBatch::Range& range = batch.ranges[i];
+            const SoftwareBlendBatch::Blend& blend = batch.blends[range.blend];
+            const Mesh::SoftwareVertexBlendData& data = blend.data;
+            size_t first = range.begin;
+            util->softwareVertexSkinning(
+                rawOffsetPointer(data.srcPos, first * data.srcPosStride),
+                rawOffsetPointer(data.destPos, first * data.destPosStride),
+                data.srcNorm ? rawOffsetPointer(data.srcNorm, first * data.srcNormStride) : 0,
+                data.destNorm ? rawOffsetPointer(data.destNorm, first * data.destNormStride) : 0,
+                rawOffsetPointer(data.blendWeight, first * data.blendWeightStride),
+                rawOffsetPointer(data.blendIndex, first * data.blendIndexStride),
+                batch.matrices.data() + blend.firstMatrix,
+                data.srcPosStride, data.destPosStride,
+                data.srcNormStride, data.destNormStride,
+                data.blendWeightStride, data.blendIndexStride,
+                data.numWeightsPerVertex,
+                range.end - first);
+        }
+    };
+
+    // Buffers are unlocked on this thread in any case, as that might upload them
+    auto unlockBuffers = [&batch]()
+    {
+        for (auto& locked : batch.lockedBuffers)
+        {
+            if (locked.second.buffer)
+                locked.second.buffer->unlock();
+        }
+        batch.lockedBuffers.clear();
+        batch.blends.clear();
+        batch.matrices.clear();
+    };
+
+    try
+    {
+        if (Root* root = Root::getSingletonPtr())
+            root->getWorkQueue()->parallelFor(batch.ranges.size(), 1, blendRanges);
+        else
+            blendRanges(0, batch.ranges.size());
+    }
+    catch (...)
+    {
+        unlockBuffers();
+        throw;
+    }
+    unlockBuffers();
+}
+//-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
     RenderQueueInvocationSequence* invocationSequence = 
@@ -3712,6 +4273,7 @@ MovableObject* SceneManager::createMovableObject(const String& name,
 
         MovableObject* newObj = factory->createInstance(name, this, params);
         objectMap->map[name] = newObj;
+        ++mMovableObjectsChangeCount;
         return newObj;
     }
 
@@ -3743,6 +4305,7 @@ void SceneManager::destroyMovableObject(const String& name, const String& typeNa
         {
             factory->destroyInstance(mi->second);
             objectMap->map.erase(mi);
+            ++mMovableObjectsChangeCount;
         }
     }
 }
@@ -3771,6 +4334,7 @@ void SceneManager::destroyAllMovableObjectsByType(const String& typeName)
             }
         }
         objectMap->map.clear();
+        ++mMovableObjectsChangeCount;
     }
 }
 //---------------------------------------------------------------------
@@ -3804,7 +4368,7 @@ void SceneManager::destroyAllMovableObjects(void)
         }
         coll->map.clear();
     }
-
+    ++mMovableObjectsChangeCount;
 }
 //---------------------------------------------------------------------
 MovableObject* SceneManager::getMovableObject(const String& name, const String& typeName) const
@@ -3881,6 +4445,7 @@ void SceneManager::injectMovableObject(MovableObject* m)
             OGRE_LOCK_MUTEX(objectMap->mutex);
 
         objectMap->map[m->getName()] = m;
+        ++mMovableObjectsChangeCount;
     }
 }
 //---------------------------------------------------------------------
@@ -3894,6 +4459,7 @@ void SceneManager::extractMovableObject(const String& name, const String& typeNa
         {
             // no delete
             objectMap->map.erase(mi);
+            ++mMovableObjectsChangeCount;
         }
     }
 
@@ -3911,7 +4477,73 @@ void SceneManager::extractAllMovableObjectsByType(const String& typeName)
             OGRE_LOCK_MUTEX(objectMap->mutex);
         // no deletion
         objectMap->map.clear();
+        ++mMovableObjectsChangeCount;
+    }
+}
+//---------------------------------------------------------------------
+bool SceneManager::updateMovableObjectBounds(MovableObjectBounds& b)
+{
+    // Keep the objects and only take their new bounds, unless the set of objects
+    // changed or the bounds of an object became finite or stopped being so
+    bool rebuild = b.changeCount != mMovableObjectsChangeCount;
+    for (size_t i = 0; i < b.objects.size() && !rebuild; ++i)
+    {
+        b.boxes[i] = b.objects[i]->getWorldBoundingBox();
+        rebuild = !b.boxes[i].isFinite();
+    }
+    for (size_t i = 0; i < b.others.size() && !rebuild; ++i)
+        rebuild = b.others[i]->getWorldBoundingBox().isFinite();
+
+    if (rebuild)
+    {
+        b.objects.clear();
+        b.boxes.clear();
+        b.others.clear();
+        for (const auto& factIt : Root::getSingleton().getMovableObjectFactories())
+        {
+            for (const auto& objIt : getMovableObjects(factIt.first))
+            {
+                const AxisAlignedBox& box = objIt.second->getWorldBoundingBox();
+                if (box.isFinite())
+                {
+                    b.objects.push_back(objIt.second);
+                    b.boxes.push_back(box);
+                }
+                else
+                    b.others.push_back(objIt.second);
+            }
+        }
     }
+
+    b.changeCount = mMovableObjectsChangeCount;
+    b.moveCount = mMovableObjectsMoveCount;
+    return rebuild;
+}
+//---------------------------------------------------------------------
+const SceneManager::MovableObjectBVH& SceneManager::_getMovableObjectBVH()
+{
+    MovableObjectBVH& h = mMovableObjectBVH;
+    if (h.changeCount == mMovableObjectsChangeCount && h.moveCount == mMovableObjectsMoveCount)
+        return h;
+
+    if (updateMovableObjectBounds(h))
+        h.bvh.build(h.boxes.data(), h.boxes.size());
+    else
+        h.bvh.refit(h.boxes.data());
+    return h;
+}
+//---------------------------------------------------------------------
+const SceneManager::MovableObjectBroadphase& SceneManager::_getMovableObjectBroadphase()
+{
+    MovableObjectBroadphase& b = mMovableObjectBroadphase;
+    if (b.changeCount == mMovableObjectsChangeCount && b.moveCount == mMovableObjectsMoveCount)
+        return b;
+
+    if (updateMovableObjectBounds(b))
+        b.sweepAndPrune.build(b.boxes.data(), b.boxes.size());
+    else
+        b.sweepAndPrune.update(b.boxes.data());
+    return b;
 }
 //---------------------------------------------------------------------
 void SceneManager::_injectRenderWithPass(Pass *pass, Renderable *rend, bool shadowDerivation,
@@ -4083,15 +4715,22 @@ void SceneManager::updateGpuProgramParameters(const Pass* pass)
 
     if (pass->isProgrammable())
     {
-        pass->_updateAutoParams(mAutoParamDataSource.get(), mGpuParamsDirty);
+        // values of these variabilities may be skipped, if they did not change since
+        // the last upload. Programs are rebound with all params dirty for every pass.
+        uint16 skippable = mGpuParamDeduplication && mGpuParamsDirty != (uint16)GPV_ALL
+                               ? uint16(GPV_PER_OBJECT | GPV_LIGHTS)
+                               : 0;
 
         for (int i = 0; i < GPT_COUNT; i++)
         {
             GpuProgramType t = (GpuProgramType)i;
             if (pass->hasGpuProgram(t))
             {
-                mDestRenderSystem->bindGpuProgramParameters(t, pass->getGpuProgramParameters(t),
-                                                            mGpuParamsDirty);
+                const GpuProgramParametersSharedPtr& params = pass->getGpuProgramParameters(t);
+                uint16 changed = params->_updateAutoParams(mAutoParamDataSource.get(), mGpuParamsDirty);
+                uint16 mask = mGpuParamsDirty & ~(skippable & ~changed);
+                if (mask)
+                    mDestRenderSystem->bindGpuProgramParameters(t, params, mask);
             }
         }
     }
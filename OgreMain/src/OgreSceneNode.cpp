@@ -67,6 +67,9 @@ namespace Ogre {
     {
         Node::setParent(parent);
 
+        if (mCreator)
+            mCreator->_notifySceneGraphChanged();
+
         if (parent)
         {
             SceneNode* sceneParent = static_cast<SceneNode*>(parent);
@@ -194,6 +194,7 @@ namespace Ogre {
     {
         mSortByDistance = false;
         mMaxResults = 0;
+        mTriangleIntersection = false;
     }
     //-----------------------------------------------------------------------
     RaySceneQuery::~RaySceneQuery()
@@ -252,6 +253,40 @@ namespace Ogre {
         return mResult;
     }
     //-----------------------------------------------------------------------
+    void RaySceneQuery::executeBatch(const Ray* rays, size_t count, RaySceneQueryResultEntry* results)
+    {
+        // Run the query for each ray in turn, keeping the state of this query
+        Ray ray = mRay;
+        bool sort = mSortByDistance;
+        ushort maxResults = mMaxResults;
+        RaySceneQueryResult lastResults;
+        lastResults.swap(mResult);
+
+        mSortByDistance = true;
+        mMaxResults = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            mRay = rays[i];
+            RaySceneQueryResult& result = execute();
+            if (!result.empty())
+                results[i] = result[0];
+            else
+            {
+                results[i].distance = Math::POS_INFINITY;
+                results[i].movable = NULL;
+                results[i].worldFragment = NULL;
+                results[i].subMesh = NULL;
+                results[i].triangle = 0;
+                results[i].barycentricCoords = Vector3::ZERO;
+            }
+        }
+
+        mRay = ray;
+        mSortByDistance = sort;
+        mMaxResults = maxResults;
+        mResult.swap(lastResults);
+    }
+    //-----------------------------------------------------------------------
     RaySceneQueryResult& RaySceneQuery::getLastResults(void)
     {
         return mResult;
@@ -270,6 +305,9 @@ namespace Ogre {
         dets.distance = distance;
         dets.movable = obj;
         dets.worldFragment = NULL;
+        dets.subMesh = NULL;
+        dets.triangle = 0;
+        dets.barycentricCoords = Vector3::ZERO;
         mResult.push_back(dets);
         // Continue
         return true;
@@ -282,11 +320,22 @@ namespace Ogre {
         dets.distance = distance;
         dets.movable = NULL;
         dets.worldFragment = fragment;
+        dets.subMesh = NULL;
+        dets.triangle = 0;
+        dets.barycentricCoords = Vector3::ZERO;
         mResult.push_back(dets);
         // Continue
         return true;
     }
     //-----------------------------------------------------------------------
+    bool RaySceneQuery::queryResultEntry(const RaySceneQueryResultEntry& result)
+    {
+        // Add to internal list
+        mResult.push_back(result);
+        // Continue
+        return true;
+    }
+    //-----------------------------------------------------------------------
     /*
     PyramidSceneQuery::PyramidSceneQuery(SceneManager* mgr) : RegionSceneQuery(mgr)
     {
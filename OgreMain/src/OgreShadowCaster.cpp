@@ -111,270 +111,182 @@ namespace Ogre {
         return true;
     }
     // ------------------------------------------------------------------------
-    void ShadowCaster::generateShadowVolume(EdgeData* edgeData, 
-        const HardwareIndexBufferSharedPtr& indexBuffer, size_t& indexBufferUsedSize, 
-        const Light* light, ShadowRenderableList& shadowRenderables, unsigned long flags)
+    bool ShadowCaster::useMcGuireDarkCap(const EdgeData* edgeData, const Light* light) const
     {
-        // Edge groups should be 1:1 with shadow renderables
-        assert(edgeData->edgeGroups.size() == shadowRenderables.size());
-
-        Light::LightTypes lightType = light->getType();
-
         // Whether to use the McGuire method, a triangle fan covering all silhouette
         // This won't work properly with multiple separate edge groups (should be one fan per group, not implemented)
         // or when light position is too close to light cap bound.
-        bool useMcGuire = edgeData->edgeGroups.size() <= 1 && 
-            (lightType == Light::LT_DIRECTIONAL || isBoundOkForMcGuire(getLightCapBounds(), light->getDerivedPosition()));
-        EdgeData::EdgeGroupList::const_iterator egi, egiend;
-        ShadowRenderableList::const_iterator si;
-
-        // pre-count the size of index data we need since it makes a big perf difference
-        // to GL in particular if we lock a smaller area of the index buffer
-        size_t preCountIndexes = 0;
+        return edgeData->edgeGroups.size() <= 1 &&
+               (light->getType() == Light::LT_DIRECTIONAL ||
+                isBoundOkForMcGuire(getLightCapBounds(), light->getDerivedPosition()));
+    }
+    // ------------------------------------------------------------------------
+    namespace
+    {
+        typedef ShadowCaster::ShadowRenderableList ShadowRenderableList;
+        typedef std::vector<std::pair<size_t, size_t> > ShadowVolumeCounts;
 
-        si = shadowRenderables.begin();
-        egiend = edgeData->edgeGroups.end();
-        for (egi = edgeData->edgeGroups.begin(); egi != egiend; ++egi, ++si)
+        /// Counts the indexes of a shadow volume without storing them
+        struct ShadowIndexCounter
         {
-            const EdgeData::EdgeGroup& eg = *egi;
-            bool  firstDarkCapTri = true;
-
-            EdgeData::EdgeList::const_iterator i, iend;
-            iend = eg.edges.end();
-            for (i = eg.edges.begin(); i != iend; ++i)
-            {
-                const EdgeData::Edge& edge = *i;
+            size_t count;
+            ShadowIndexCounter() : count(0) {}
+            void push_back(unsigned short) { ++count; }
+            size_t size() const { return count; }
+        };
+
+        /// Writes the indexes of a shadow volume to locked index buffer memory
+        struct ShadowIndexWriter
+        {
+            unsigned short* dest;
+            size_t count;
+            ShadowIndexWriter(void* d) : dest(static_cast<unsigned short*>(d)), count(0) {}
+            void push_back(unsigned short i) { dest[count++] = i; }
+            size_t size() const { return count; }
+        };
+
+        /** Emits the indexes of the shadow volume to idx, which is a std::vector or one
+            of the sinks above, and the index counts of every edge group to counts. */
+        template <typename IndexSink>
+        void emitShadowVolume(const EdgeData* edgeData, const char* lightFacings, const Light* light,
+                              bool useMcGuire, const ShadowRenderableList& shadowRenderables,
+                              unsigned long flags, IndexSink& idx, ShadowVolumeCounts& counts)
+        {
+            Light::LightTypes lightType = light->getType();
 
-                // Silhouette edge, when two tris has opposite light facing, or
-                // degenerate edge where only tri 1 is valid and the tri light facing
-                char lightFacing = edgeData->triangleLightFacings[edge.triIndex[0]];
-                if ((edge.degenerate && lightFacing) ||
-                    (!edge.degenerate && (lightFacing != edgeData->triangleLightFacings[edge.triIndex[1]])))
-                {
+            // Edge groups should be 1:1 with shadow renderables
+            assert(edgeData->edgeGroups.size() == shadowRenderables.size());
 
-                    preCountIndexes += 3;
+            counts.resize(shadowRenderables.size());
 
-                    // Are we extruding to infinity?
-                    if (!(lightType == Light::LT_DIRECTIONAL &&
-                        flags & SRF_EXTRUDE_TO_INFINITY))
-                    {
-                        preCountIndexes += 3;
-                    }
+            // Iterate over the groups and form renderables for each based on their
+            // lightFacing
+            ShadowRenderableList::const_iterator si = shadowRenderables.begin();
+            for (size_t g = 0; g < edgeData->edgeGroups.size(); ++g, ++si)
+            {
+                const EdgeData::EdgeGroup& eg = edgeData->edgeGroups[g];
+                size_t groupStart = idx.size();
+                // original number of verts (without extruded copy)
+                size_t originalVertexCount = eg.vertexData->vertexCount;
+                bool  firstDarkCapTri = true;
+                unsigned short darkCapStart = 0;
+
+                EdgeData::EdgeList::const_iterator i, iend;
+                iend = eg.edges.end();
+                for (i = eg.edges.begin(); i != iend; ++i)
+                {
+                    const EdgeData::Edge& edge = *i;
 
-                    if(useMcGuire)
+                    // Silhouette edge, when two tris has opposite light facing, or
+                    // degenerate edge where only tri 1 is valid and the tri light facing
+                    char lightFacing = lightFacings[edge.triIndex[0]];
+                    if ((edge.degenerate && lightFacing) ||
+                        (!edge.degenerate && (lightFacing != lightFacings[edge.triIndex[1]])))
                     {
-                        // Do dark cap tri
-                        // Use McGuire et al method, a triangle fan covering all silhouette
-                        // edges and one point (taken from the initial tri)
-                        if (flags & SRF_INCLUDE_DARK_CAP)
+                        size_t v0 = edge.vertIndex[0];
+                        size_t v1 = edge.vertIndex[1];
+                        if (!lightFacing)
                         {
-                            if (firstDarkCapTri)
-                            {
-                                firstDarkCapTri = false;
-                            }
-                            else
-                            {
-                                preCountIndexes += 3;
-                            }
+                            // Inverse edge indexes when t1 is light away
+                            std::swap(v0, v1);
                         }
-                    }
-                }
 
-            }
+                        /* Note edge(v0, v1) run anticlockwise along the edge from
+                        the light facing tri so to point shadow volume tris outward,
+                        light cap indexes have to be backwards
+
+                        We emit 2 tris if light is a point light, 1 if light 
+                        is directional, because directional lights cause all
+                        points to converge to a single point at infinity.
+
+                        First side tri = near1, near0, far0
+                        Second tri = far0, far1, near1
+
+                        'far' indexes are 'near' index + originalVertexCount
+                        because 'far' verts are in the second half of the 
+                        buffer
+                        */
+                        assert(v1 < 65536 && v0 < 65536 && (v0 + originalVertexCount) < 65536 &&
+                            "Vertex count exceeds 16-bit index limit!");
+                        idx.push_back(static_cast<unsigned short>(v1));
+                        idx.push_back(static_cast<unsigned short>(v0));
+                        idx.push_back(static_cast<unsigned short>(v0 + originalVertexCount));
+
+                        // Are we extruding to infinity?
+                        if (!(lightType == Light::LT_DIRECTIONAL &&
+                            flags & SRF_EXTRUDE_TO_INFINITY))
+                        {
+                            // additional tri to make quad
+                            idx.push_back(static_cast<unsigned short>(v0 + originalVertexCount));
+                            idx.push_back(static_cast<unsigned short>(v1 + originalVertexCount));
+                            idx.push_back(static_cast<unsigned short>(v1));
+                        }
 
-            if(useMcGuire)
-            {
-                // Do light cap
-                if (flags & SRF_INCLUDE_LIGHT_CAP) 
-                {
-                    // Iterate over the triangles which are using this vertex set
-                    EdgeData::TriangleList::const_iterator ti, tiend;
-                    EdgeData::TriangleLightFacingList::const_iterator lfi;
-                    ti = edgeData->triangles.begin() + eg.triStart;
-                    tiend = ti + eg.triCount;
-                    lfi = edgeData->triangleLightFacings.begin() + eg.triStart;
-                    for ( ; ti != tiend; ++ti, ++lfi)
-                    {
-                        assert(ti->vertexSet == eg.vertexSet);
-                        // Check it's light facing
-                        if (*lfi)
+                        if(useMcGuire)
                         {
-                            preCountIndexes += 3;
+                            // Do dark cap tri
+                            // Use McGuire et al method, a triangle fan covering all silhouette
+                            // edges and one point (taken from the initial tri)
+                            if (flags & SRF_INCLUDE_DARK_CAP)
+                            {
+                                if (firstDarkCapTri)
+                                {
+                                    darkCapStart = static_cast<unsigned short>(v0 + originalVertexCount);
+                                    firstDarkCapTri = false;
+                                }
+                                else
+                                {
+                                    idx.push_back(darkCapStart);
+                                    idx.push_back(static_cast<unsigned short>(v1 + originalVertexCount));
+                                    idx.push_back(static_cast<unsigned short>(v0 + originalVertexCount));
+                                }
+
+                            }
                         }
                     }
 
                 }
-            }
-            else
-            {
-                // Do both caps
-                int increment = ((flags & SRF_INCLUDE_DARK_CAP) ? 3 : 0) + ((flags & SRF_INCLUDE_LIGHT_CAP) ? 3 : 0);
-                if(increment != 0)
-                {
-                    // Iterate over the triangles which are using this vertex set
-                    EdgeData::TriangleList::const_iterator ti, tiend;
-                    EdgeData::TriangleLightFacingList::const_iterator lfi;
-                    ti = edgeData->triangles.begin() + eg.triStart;
-                    tiend = ti + eg.triCount;
-                    lfi = edgeData->triangleLightFacings.begin() + eg.triStart;
-                    for ( ; ti != tiend; ++ti, ++lfi)
-                    {
-                        assert(ti->vertexSet == eg.vertexSet);
-                        // Check it's light facing
-                        if (*lfi)
-                            preCountIndexes += increment;
-                    }
-                }
-            }
-        }
-        // End pre-count
-        
-        //Check if index buffer is to small 
-        if (preCountIndexes > indexBuffer->getNumIndexes())
-        {
-            LogManager::getSingleton().logWarning(
-                "shadow index buffer size to small. Auto increasing buffer size to" +
-                StringConverter::toString(sizeof(unsigned short) * preCountIndexes));
 
-            SceneManager* pManager = Root::getSingleton()._getCurrentSceneManager();
-            if (pManager)
-            {
-                pManager->setShadowIndexBufferSize(preCountIndexes);
-            }
-            
-            //Check that the index buffer size has actually increased
-            if (preCountIndexes > indexBuffer->getNumIndexes())
-            {
-                //increasing index buffer size has failed
-                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
-                    "Lock request out of bounds.",
-                    "ShadowCaster::generateShadowVolume");
-            }
-        }
-        else if(indexBufferUsedSize + preCountIndexes > indexBuffer->getNumIndexes())
-        {
-            indexBufferUsedSize = 0;
-        }
-
-        // Lock index buffer for writing, just enough length as we need
-        HardwareBufferLockGuard indexLock(indexBuffer,
-            sizeof(unsigned short) * indexBufferUsedSize, sizeof(unsigned short) * preCountIndexes,
-            indexBufferUsedSize == 0 ? HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NO_OVERWRITE);
-        unsigned short* pIdx = static_cast<unsigned short*>(indexLock.pData);
-        size_t numIndices = indexBufferUsedSize;
-        
-        // Iterate over the groups and form renderables for each based on their
-        // lightFacing
-        si = shadowRenderables.begin();
-        egiend = edgeData->edgeGroups.end();
-        for (egi = edgeData->edgeGroups.begin(); egi != egiend; ++egi, ++si)
-        {
-            const EdgeData::EdgeGroup& eg = *egi;
-            // Initialise the index start for this shadow renderable
-            IndexData* indexData = (*si)->getRenderOperationForUpdate()->indexData;
-
-            if (indexData->indexBuffer != indexBuffer)
-            {
-                (*si)->rebindIndexBuffer(indexBuffer);
-                indexData = (*si)->getRenderOperationForUpdate()->indexData;
-            }
-
-            indexData->indexStart = numIndices;
-            // original number of verts (without extruded copy)
-            size_t originalVertexCount = eg.vertexData->vertexCount;
-            bool  firstDarkCapTri = true;
-            unsigned short darkCapStart = 0;
-
-            EdgeData::EdgeList::const_iterator i, iend;
-            iend = eg.edges.end();
-            for (i = eg.edges.begin(); i != iend; ++i)
-            {
-                const EdgeData::Edge& edge = *i;
-
-                // Silhouette edge, when two tris has opposite light facing, or
-                // degenerate edge where only tri 1 is valid and the tri light facing
-                char lightFacing = edgeData->triangleLightFacings[edge.triIndex[0]];
-                if ((edge.degenerate && lightFacing) ||
-                    (!edge.degenerate && (lightFacing != edgeData->triangleLightFacings[edge.triIndex[1]])))
+                if(!useMcGuire)
                 {
-                    size_t v0 = edge.vertIndex[0];
-                    size_t v1 = edge.vertIndex[1];
-                    if (!lightFacing)
-                    {
-                        // Inverse edge indexes when t1 is light away
-                        std::swap(v0, v1);
-                    }
-
-                    /* Note edge(v0, v1) run anticlockwise along the edge from
-                    the light facing tri so to point shadow volume tris outward,
-                    light cap indexes have to be backwards
-
-                    We emit 2 tris if light is a point light, 1 if light 
-                    is directional, because directional lights cause all
-                    points to converge to a single point at infinity.
-
-                    First side tri = near1, near0, far0
-                    Second tri = far0, far1, near1
-
-                    'far' indexes are 'near' index + originalVertexCount
-                    because 'far' verts are in the second half of the 
-                    buffer
-                    */
-                    assert(v1 < 65536 && v0 < 65536 && (v0 + originalVertexCount) < 65536 &&
-                        "Vertex count exceeds 16-bit index limit!");
-                    *pIdx++ = static_cast<unsigned short>(v1);
-                    *pIdx++ = static_cast<unsigned short>(v0);
-                    *pIdx++ = static_cast<unsigned short>(v0 + originalVertexCount);
-                    numIndices += 3;
-
-                    // Are we extruding to infinity?
-                    if (!(lightType == Light::LT_DIRECTIONAL &&
-                        flags & SRF_EXTRUDE_TO_INFINITY))
+                    // Do dark cap
+                    if (flags & SRF_INCLUDE_DARK_CAP) 
                     {
-                        // additional tri to make quad
-                        *pIdx++ = static_cast<unsigned short>(v0 + originalVertexCount);
-                        *pIdx++ = static_cast<unsigned short>(v1 + originalVertexCount);
-                        *pIdx++ = static_cast<unsigned short>(v1);
-                        numIndices += 3;
-                    }
-
-                    if(useMcGuire)
-                    {
-                        // Do dark cap tri
-                        // Use McGuire et al method, a triangle fan covering all silhouette
-                        // edges and one point (taken from the initial tri)
-                        if (flags & SRF_INCLUDE_DARK_CAP)
+                        // Iterate over the triangles which are using this vertex set
+                        EdgeData::TriangleList::const_iterator ti, tiend;
+                        ti = edgeData->triangles.begin() + eg.triStart;
+                        tiend = ti + eg.triCount;
+                        const char* lfi = lightFacings + eg.triStart;
+                        for ( ; ti != tiend; ++ti, ++lfi)
                         {
-                            if (firstDarkCapTri)
-                            {
-                                darkCapStart = static_cast<unsigned short>(v0 + originalVertexCount);
-                                firstDarkCapTri = false;
-                            }
-                            else
+                            const EdgeData::Triangle& t = *ti;
+                            assert(t.vertexSet == eg.vertexSet);
+                            // Check it's light facing
+                            if (*lfi)
                             {
-                                *pIdx++ = darkCapStart;
-                                *pIdx++ = static_cast<unsigned short>(v1 + originalVertexCount);
-                                *pIdx++ = static_cast<unsigned short>(v0 + originalVertexCount);
-                                numIndices += 3;
+                                assert(t.vertIndex[0] < 65536 && t.vertIndex[1] < 65536 &&
+                                    t.vertIndex[2] < 65536 && 
+                                    "16-bit index limit exceeded!");
+                                idx.push_back(static_cast<unsigned short>(t.vertIndex[1] + originalVertexCount));
+                                idx.push_back(static_cast<unsigned short>(t.vertIndex[0] + originalVertexCount));
+                                idx.push_back(static_cast<unsigned short>(t.vertIndex[2] + originalVertexCount));
                             }
-
                         }
+
                     }
                 }
 
-            }
+                // the separate light cap, if any, follows the volume
+                size_t lightCapStart = idx.size();
 
-            if(!useMcGuire)
-            {
-                // Do dark cap
-                if (flags & SRF_INCLUDE_DARK_CAP) 
+                // Do light cap
+                if (flags & SRF_INCLUDE_LIGHT_CAP) 
                 {
                     // Iterate over the triangles which are using this vertex set
                     EdgeData::TriangleList::const_iterator ti, tiend;
-                    EdgeData::TriangleLightFacingList::const_iterator lfi;
                     ti = edgeData->triangles.begin() + eg.triStart;
                     tiend = ti + eg.triCount;
-                    lfi = edgeData->triangleLightFacings.begin() + eg.triStart;
+                    const char* lfi = lightFacings + eg.triStart;
                     for ( ; ti != tiend; ++ti, ++lfi)
                     {
                         const EdgeData::Triangle& t = *ti;
@@ -385,68 +297,142 @@ namespace Ogre {
                             assert(t.vertIndex[0] < 65536 && t.vertIndex[1] < 65536 &&
                                 t.vertIndex[2] < 65536 && 
                                 "16-bit index limit exceeded!");
-                            *pIdx++ = static_cast<unsigned short>(t.vertIndex[1] + originalVertexCount);
-                            *pIdx++ = static_cast<unsigned short>(t.vertIndex[0] + originalVertexCount);
-                            *pIdx++ = static_cast<unsigned short>(t.vertIndex[2] + originalVertexCount);
-                            numIndices += 3;
+                            idx.push_back(static_cast<unsigned short>(t.vertIndex[0]));
+                            idx.push_back(static_cast<unsigned short>(t.vertIndex[1]));
+                            idx.push_back(static_cast<unsigned short>(t.vertIndex[2]));
                         }
                     }
 
+                    // separate light cap?
+                    if (!(*si)->isLightCapSeparate())
+                        lightCapStart = idx.size();
                 }
+
+                counts[g].first = lightCapStart - groupStart;
+                counts[g].second = idx.size() - lightCapStart;
             }
+        }
 
-            // Do light cap
-            if (flags & SRF_INCLUDE_LIGHT_CAP) 
+        /// Makes room for numIndexes at indexBufferUsedSize, growing or restarting the buffer
+        void reserveShadowIndexes(const HardwareIndexBufferSharedPtr& indexBuffer,
+                                  size_t& indexBufferUsedSize, size_t numIndexes)
+        {
+            //Check if index buffer is to small 
+            if (numIndexes > indexBuffer->getNumIndexes())
             {
-                // separate light cap?
-                if ((*si)->isLightCapSeparate())
-                {
-                    // update index count for this shadow renderable
-                    indexData->indexCount = numIndices - indexData->indexStart;
+                LogManager::getSingleton().logWarning(
+                    "shadow index buffer size to small. Auto increasing buffer size to" +
+                    StringConverter::toString(sizeof(unsigned short) * numIndexes));
 
-                    // get light cap index data for update
-                    indexData = (*si)->getLightCapRenderable()->getRenderOperationForUpdate()->indexData;
-                    // start indexes after the current total
-                    indexData->indexStart = numIndices;
+                SceneManager* pManager = Root::getSingleton()._getCurrentSceneManager();
+                if (pManager)
+                {
+                    pManager->setShadowIndexBufferSize(numIndexes);
+                }
+                
+                //Check that the index buffer size has actually increased
+                if (numIndexes > indexBuffer->getNumIndexes())
+                {
+                    //increasing index buffer size has failed
+                    OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Lock request out of bounds.",
+                        "ShadowCaster::generateShadowVolume");
                 }
+            }
+            else if(indexBufferUsedSize + numIndexes > indexBuffer->getNumIndexes())
+            {
+                indexBufferUsedSize = 0;
+            }
+        }
 
-                // Iterate over the triangles which are using this vertex set
-                EdgeData::TriangleList::const_iterator ti, tiend;
-                EdgeData::TriangleLightFacingList::const_iterator lfi;
-                ti = edgeData->triangles.begin() + eg.triStart;
-                tiend = ti + eg.triCount;
-                lfi = edgeData->triangleLightFacings.begin() + eg.triStart;
-                for ( ; ti != tiend; ++ti, ++lfi)
+        /// Points the shadow renderables at their indexes, which start at indexBufferUsedSize
+        void updateShadowIndexRanges(const ShadowVolumeCounts& counts,
+                                     const HardwareIndexBufferSharedPtr& indexBuffer,
+                                     size_t& indexBufferUsedSize, ShadowRenderableList& shadowRenderables,
+                                     unsigned long flags)
+        {
+            size_t start = indexBufferUsedSize;
+            for (size_t g = 0; g < shadowRenderables.size(); ++g)
+            {
+                ShadowRenderable* sr = shadowRenderables[g];
+                IndexData* indexData = sr->getRenderOperationForUpdate()->indexData;
+
+                if (indexData->indexBuffer != indexBuffer)
                 {
-                    const EdgeData::Triangle& t = *ti;
-                    assert(t.vertexSet == eg.vertexSet);
-                    // Check it's light facing
-                    if (*lfi)
-                    {
-                        assert(t.vertIndex[0] < 65536 && t.vertIndex[1] < 65536 &&
-                            t.vertIndex[2] < 65536 && 
-                            "16-bit index limit exceeded!");
-                        *pIdx++ = static_cast<unsigned short>(t.vertIndex[0]);
-                        *pIdx++ = static_cast<unsigned short>(t.vertIndex[1]);
-                        *pIdx++ = static_cast<unsigned short>(t.vertIndex[2]);
-                        numIndices += 3;
-                    }
+                    sr->rebindIndexBuffer(indexBuffer);
+                    indexData = sr->getRenderOperationForUpdate()->indexData;
                 }
 
+                indexData->indexStart = start;
+                indexData->indexCount = counts[g].first;
+                start += counts[g].first;
+
+                if ((flags & SRF_INCLUDE_LIGHT_CAP) && sr->isLightCapSeparate())
+                {
+                    indexData = sr->getLightCapRenderable()->getRenderOperationForUpdate()->indexData;
+                    indexData->indexStart = start;
+                    indexData->indexCount = counts[g].second;
+                    start += counts[g].second;
+                }
             }
+            indexBufferUsedSize = start;
+        }
+    }
+    // ------------------------------------------------------------------------
+    void ShadowCaster::generateShadowVolume(EdgeData* edgeData, 
+        const HardwareIndexBufferSharedPtr& indexBuffer, size_t& indexBufferUsedSize, 
+        const Light* light, ShadowRenderableList& shadowRenderables, unsigned long flags)
+    {
+        bool useMcGuire = useMcGuireDarkCap(edgeData, light);
+        const char* lightFacings = edgeData->triangleLightFacings.data();
+        ShadowVolumeCounts counts;
 
-            // update index count for current index data (either this shadow renderable or its light cap)
-            indexData->indexCount = numIndices - indexData->indexStart;
+        // pre-count the size of index data we need since it makes a big perf difference
+        // to GL in particular if we lock a smaller area of the index buffer
+        ShadowIndexCounter counter;
+        emitShadowVolume(edgeData, lightFacings, light, useMcGuire, shadowRenderables, flags, counter, counts);
+        size_t numIndexes = counter.count;
+        reserveShadowIndexes(indexBuffer, indexBufferUsedSize, numIndexes);
 
+        // write the indexes straight into the locked range
+        {
+            HardwareBufferLockGuard indexLock(indexBuffer,
+                sizeof(unsigned short) * indexBufferUsedSize, sizeof(unsigned short) * numIndexes,
+                indexBufferUsedSize == 0 ? HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NO_OVERWRITE);
+            ShadowIndexWriter writer(indexLock.pData);
+            emitShadowVolume(edgeData, lightFacings, light, useMcGuire, shadowRenderables, flags, writer, counts);
+            assert(writer.count == numIndexes);
         }
 
-        // In debug mode, check we didn't overrun the index buffer
-        assert(numIndices == indexBufferUsedSize + preCountIndexes);
-        assert(numIndices <= indexBuffer->getNumIndexes() &&
-            "Index buffer overrun while generating shadow volume!! "
-            "You must increase the size of the shadow index buffer.");
+        updateShadowIndexRanges(counts, indexBuffer, indexBufferUsedSize, shadowRenderables, flags);
+    }
+    // ------------------------------------------------------------------------
+    void ShadowCaster::buildShadowVolume(const EdgeData* edgeData, const char* lightFacings,
+        const Light* light, bool useMcGuire, const ShadowRenderableList& shadowRenderables,
+        unsigned long flags, ShadowVolumeIndexes& volume)
+    {
+        volume.indexes.clear();
+        emitShadowVolume(edgeData, lightFacings, light, useMcGuire, shadowRenderables, flags,
+                         volume.indexes, volume.counts);
+    }
+    // ------------------------------------------------------------------------
+    void ShadowCaster::uploadShadowVolume(const ShadowVolumeIndexes& volume,
+        const HardwareIndexBufferSharedPtr& indexBuffer, size_t& indexBufferUsedSize,
+        ShadowRenderableList& shadowRenderables, unsigned long flags)
+    {
+        size_t numIndexes = volume.indexes.size();
+        reserveShadowIndexes(indexBuffer, indexBufferUsedSize, numIndexes);
+
+        // Lock index buffer for writing, just enough length as we need
+        // since it makes a big perf difference to GL in particular
+        {
+            HardwareBufferLockGuard indexLock(indexBuffer,
+                sizeof(unsigned short) * indexBufferUsedSize, sizeof(unsigned short) * numIndexes,
+                indexBufferUsedSize == 0 ? HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NO_OVERWRITE);
+            memcpy(indexLock.pData, volume.indexes.data(), sizeof(unsigned short) * numIndexes);
+        }
 
-        indexBufferUsedSize = numIndices;
+        updateShadowIndexRanges(volume.counts, indexBuffer, indexBufferUsedSize, shadowRenderables, flags);
     }
     // ------------------------------------------------------------------------
     void ShadowCaster::extrudeVertices(
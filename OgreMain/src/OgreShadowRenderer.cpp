@@ -65,7 +65,10 @@ mShadowTextureFadeStart(0.7),
 mShadowTextureFadeEnd(0.9),
 mShadowTextureSelfShadow(false),
 mShadowTextureConfigDirty(true),
-mShadowCasterRenderBackFaces(true)
+mShadowCasterRenderBackFaces(true),
+mParallelShadowCasterCulling(false),
+mShadowCasterCullingCache(false),
+mShadowVolumeCache(false)
 {
     mShadowCasterQueryListener.reset(new ShadowCasterSceneQueryListener(mSceneManager));
 
@@ -877,8 +880,16 @@ void SceneManager::ShadowRenderer::prepareShadowTextures(Camera* cam, Viewport*
             // Fire shadow caster update, callee can alter camera settings
             mSceneManager->fireShadowTexturesPreCaster(light, texCam, j);
 
-            // Update target
-            shadowRTT->update();
+            if (mParallelShadowCasterCulling)
+            {
+                // defer the update until all shadow cameras are set up
+                mPendingShadowTargets.push_back({light, shadowRTT, texCam});
+            }
+            else
+            {
+                // Update target
+                shadowRTT->update();
+            }
 
             ++si; // next shadow texture
             ++ci; // next camera
@@ -889,12 +900,38 @@ void SceneManager::ShadowRenderer::prepareShadowTextures(Camera* cam, Viewport*
         shadowTextureIndex += textureCountPerLight;
     }
 
+    if (!mPendingShadowTargets.empty())
+    {
+        updatePendingShadowTargets();
+    }
+
     mSceneManager->fireShadowTexturesUpdated(std::min(lightList->size(), mShadowTextures.size()));
 
     ShadowTextureManager::getSingleton().clearUnused();
 
 }
 //---------------------------------------------------------------------
+void SceneManager::ShadowRenderer::updatePendingShadowTargets()
+{
+    // Moving the shadow cameras changed the scene graph
+    mSceneManager->_updateSceneGraph(mPendingShadowTargets[0].camera);
+
+    mPendingShadowCameras.clear();
+    for (const PendingShadowTarget& t : mPendingShadowTargets)
+        mPendingShadowCameras.push_back(t.camera);
+    mSceneManager->_precomputeCulling(mPendingShadowCameras.data(), mPendingShadowCameras.size(),
+                                      mShadowCasterCullingCache);
+
+    for (const PendingShadowTarget& t : mPendingShadowTargets)
+    {
+        mShadowTextureCurrentCasterLightList[0] = t.light;
+        t.target->update();
+    }
+
+    mSceneManager->_clearPrecomputedCulling();
+    mPendingShadowTargets.clear();
+}
+//---------------------------------------------------------------------
 void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* light,
     const Camera* camera, bool calcScissor)
 {
@@ -1003,15 +1040,11 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
     const PlaneBoundedVolume& nearClipVol =
         light->_getNearClipVolume(camera);
 
-    // Now iterate over the casters and render
-    ShadowCasterList::const_iterator si, siend;
-    siend = casters.end();
-
-
-    // Now iterate over the casters and render
-    for (si = casters.begin(); si != siend; ++si)
+    // Work out how to render each caster
+    mShadowVolumeSettings.resize(casters.size());
+    for (size_t i = 0; i < casters.size(); ++i)
     {
-        ShadowCaster* caster = *si;
+        ShadowCaster* caster = casters[i];
         bool zfailAlgo = camera->isCustomNearClipPlaneEnabled();
         unsigned long flags = 0;
 
@@ -1021,8 +1054,6 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
         {
             // we have to limit shadow extrusion to avoid cliping by far clip plane 
             extrudeDist = std::min(caster->getPointExtrusionDistance(light), mShadowDirLightExtrudeDist); 
-            // Set autoparams for finite point light extrusion
-            mSceneManager->mAutoParamDataSource->setShadowPointLightExtrusionDistance(extrudeDist);
         }
 
         Real darkCapExtrudeDist = extrudeDist;
@@ -1078,6 +1109,43 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
 
         }
 
+        ShadowVolumeSettings& settings = mShadowVolumeSettings[i];
+        settings.flags = flags;
+        settings.extrudeDist = extrudeDist;
+        settings.zfailAlgo = zfailAlgo;
+    }
+
+    if (mShadowVolumeCache)
+    {
+        // Update the light and the caster transforms before they are accessed concurrently
+        light->getAs4DVector();
+        for (ShadowCaster* caster : casters)
+        {
+            if (MovableObject* mo = dynamic_cast<MovableObject*>(caster))
+                mo->_getParentNodeFullTransform();
+        }
+
+        Root::getSingleton().getWorkQueue()->parallelFor(
+            casters.size(), 16, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    casters[i]->_prepareShadowVolume(light, mShadowVolumeSettings[i].flags);
+            });
+    }
+
+    // Now iterate over the casters and render
+    for (size_t i = 0; i < casters.size(); ++i)
+    {
+        ShadowCaster* caster = casters[i];
+        bool zfailAlgo = mShadowVolumeSettings[i].zfailAlgo;
+        unsigned long flags = mShadowVolumeSettings[i].flags;
+        Real extrudeDist = mShadowVolumeSettings[i].extrudeDist;
+
+        if (light->getType() != Light::LT_DIRECTIONAL)
+        {
+            // Set autoparams for finite point light extrusion
+            mSceneManager->mAutoParamDataSource->setShadowPointLightExtrusionDistance(extrudeDist);
+        }
+
         // Get shadow renderables
         const ShadowCaster::ShadowRenderableList& shadowRenderables =
             caster->getShadowVolumeRenderableList(mShadowTechnique,
@@ -75,6 +75,9 @@ namespace Ogre {
 
         serializer.importSkeleton(stream, this);
 
+        if (static_cast<SkeletonManager*>(getCreator())->getCompressAnimations())
+            compressAllAnimations();
+
         // Load any linked skeletons
         LinkedSkeletonAnimSourceList::iterator i;
         for (i = mLinkedSkeletonAnimSourceList.begin(); 
@@ -237,16 +240,10 @@ namespace Ogre {
             // tolerate state entries for animations we're not aware of
             if (anim)
             {
-              if(animState->hasBlendMask())
-              {
+                // The cursor of the state speeds up the keyframe search, as time mostly advances
                 anim->apply(this, animState->getTimePosition(), animState->getWeight() * weightFactor,
-                  animState->getBlendMask(), linked ? linked->scale : 1.0f);
-              }
-              else
-              {
-                anim->apply(this, animState->getTimePosition(), 
-                  animState->getWeight() * weightFactor, linked ? linked->scale : 1.0f);
-              }
+                  animState->getBlendMask(), linked ? linked->scale : 1.0f,
+                  animState->_getKeyFrameCursor());
             }
         }
 
@@ -676,6 +673,15 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void Skeleton::compressAllAnimations(Real tolerance)
+    {
+        AnimationList::iterator ai;
+        for (ai = mAnimationsList.begin(); ai != mAnimationsList.end(); ++ai)
+        {
+            ai->second->compressNodeTracks(tolerance);
+        }
+    }
+    //---------------------------------------------------------------------
     void Skeleton::addLinkedSkeletonAnimationSource(const String& skelName, 
         Real scale)
     {
@@ -41,7 +41,7 @@ namespace Ogre
         assert( msSingleton );  return ( *msSingleton );  
     }
     //-----------------------------------------------------------------------
-    SkeletonManager::SkeletonManager()
+    SkeletonManager::SkeletonManager() : mCompressAnimations(false)
     {
         mLoadOrder = 300.0f;
         mResourceType = "Skeleton";
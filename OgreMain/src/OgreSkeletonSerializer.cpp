@@ -288,6 +288,16 @@ namespace Ogre {
     void SkeletonSerializer::writeAnimationTrack(const Skeleton* pSkel, 
         const NodeAnimationTrack* track)
     {
+        if (track->isCompressed())
+        {
+            // Compressed tracks hold no keyframe objects, write a decompressed copy
+            Animation copy(track->getParent()->getName(), track->getParent()->getLength());
+            NodeAnimationTrack* keyFrameTrack = track->_clone(&copy);
+            keyFrameTrack->decompress();
+            writeAnimationTrack(pSkel, keyFrameTrack);
+            return;
+        }
+
         writeChunkHeader(SKELETON_ANIMATION_TRACK, calcAnimationTrackSize(pSkel, track));
 
         // unsigned short boneIndex     : Index of bone to apply to
@@ -405,6 +415,14 @@ namespace Ogre {
     size_t SkeletonSerializer::calcAnimationTrackSize(const Skeleton* pSkel, 
         const NodeAnimationTrack* pTrack)
     {
+        if (pTrack->isCompressed())
+        {
+            Animation copy(pTrack->getParent()->getName(), pTrack->getParent()->getLength());
+            NodeAnimationTrack* keyFrameTrack = pTrack->_clone(&copy);
+            keyFrameTrack->decompress();
+            return calcAnimationTrackSize(pSkel, keyFrameTrack);
+        }
+
         size_t size = SSTREAM_OVERHEAD_SIZE;
 
         // unsigned short boneIndex     : Index of bone to apply to
@@ -0,0 +1,80 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreSweepAndPrune.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------
+    void SweepAndPrune::build(const AxisAlignedBox* boxes, size_t count)
+    {
+        mEntries.resize(count);
+        if (count == 0)
+            return;
+
+        // Sort along the axis the centres spread most, to compare as few boxes as possible
+        Vector3 mean = Vector3::ZERO, meanSquared = Vector3::ZERO;
+        for (size_t i = 0; i < count; ++i)
+        {
+            assert(boxes[i].isFinite() && "only finite boxes are supported");
+            Vector3 centre = boxes[i].getCenter();
+            mean += centre;
+            meanSquared += centre * centre;
+        }
+        mean /= Real(count);
+        Vector3 variance = meanSquared / Real(count) - mean * mean;
+        mAxis = variance.x > variance.y ? (variance.x > variance.z ? 0 : 2) : (variance.y > variance.z ? 1 : 2);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            mEntries[i].minimum = boxes[i].getMinimum();
+            mEntries[i].maximum = boxes[i].getMaximum();
+            mEntries[i].index = uint32(i);
+        }
+        const int axis = mAxis;
+        std::sort(mEntries.begin(), mEntries.end(),
+                  [axis](const Entry& a, const Entry& b) { return a.minimum[axis] < b.minimum[axis]; });
+    }
+    //-----------------------------------------------------------------------
+    void SweepAndPrune::update(const AxisAlignedBox* boxes)
+    {
+        const int axis = mAxis;
+        for (size_t i = 0; i < mEntries.size(); ++i)
+        {
+            Entry entry = mEntries[i];
+            assert(boxes[entry.index].isFinite() && "only finite boxes are supported");
+            entry.minimum = boxes[entry.index].getMinimum();
+            entry.maximum = boxes[entry.index].getMaximum();
+
+            // Insertion sort, the boxes before i are sorted already
+            size_t j = i;
+            for (; j > 0 && entry.minimum[axis] < mEntries[j - 1].minimum[axis]; --j)
+                mEntries[j] = mEntries[j - 1];
+            mEntries[j] = entry;
+        }
+    }
+}
@@ -221,18 +221,37 @@ namespace Ogre {
 
         // Create the texture
         createInternalResources();
+
+        // Generate the mipmaps on the CPU if the hardware cannot
+        std::vector<Image> mipmappedImages;
+        ConstImagePtrList mipmappedImagePtrs;
+        if ((mUsage & TU_AUTOMIPMAP) && !mMipmapsHardwareGenerated && mNumMipmaps > 0 &&
+            imageMips == 0 && PixelUtil::isAccessible(mSrcFormat))
+        {
+            mipmappedImages.reserve(images.size());
+            for (const Image* img : images)
+            {
+                mipmappedImages.push_back(*img);
+                mipmappedImages.back().generateMipmaps(
+                    mHwGamma, TextureManager::getSingleton().getSoftwareMipmapFilter());
+                mipmappedImagePtrs.push_back(&mipmappedImages.back());
+            }
+            imageMips = mipmappedImages[0].getNumMipmaps();
+        }
+        const ConstImagePtrList& srcImages = mipmappedImagePtrs.empty() ? images : mipmappedImagePtrs;
+
         // Check if we're loading one image with multiple faces
         // or a vector of images representing the faces
         size_t faces;
         bool multiImage; // Load from multiple images?
-        if(images.size() > 1)
+        if(srcImages.size() > 1)
         {
-            faces = images.size();
+            faces = srcImages.size();
             multiImage = true;
         }
         else
         {
-            faces = images[0]->getNumFaces();
+            faces = srcImages[0]->getNumFaces();
             multiImage = false;
         }
         
@@ -245,9 +264,9 @@ namespace Ogre {
             // Say what we're doing
             Log::Stream str = LogManager::getSingleton().stream();
             str << "Texture '" << mName << "': Loading " << faces << " faces"
-                << "(" << PixelUtil::getFormatName(images[0]->getFormat()) << ","
-                << images[0]->getWidth() << "x" << images[0]->getHeight() << "x"
-                << images[0]->getDepth() << ")";
+                << "(" << PixelUtil::getFormatName(srcImages[0]->getFormat()) << ","
+                << srcImages[0]->getWidth() << "x" << srcImages[0]->getHeight() << "x"
+                << srcImages[0]->getDepth() << ")";
             if (!(mMipmapsHardwareGenerated && mNumMipmaps == 0))
             {
                 str << " with " << mNumMipmaps;
@@ -278,7 +297,7 @@ namespace Ogre {
         // imageMips == 0 if the image has no custom mipmaps, otherwise contains the number of custom mips
         for(size_t mip = 0; mip <= std::min(mNumMipmaps, imageMips); ++mip)
         {
-            for(size_t i = 0; i < std::max(faces, images.size()); ++i)
+            for(size_t i = 0; i < std::max(faces, srcImages.size()); ++i)
             {
                 PixelBox src;
                 size_t face = (mDepth == 1) ? i : 0; // depth = 1, then cubemap face else 3d/ array layer
@@ -289,7 +308,7 @@ namespace Ogre {
                 if(multiImage)
                 {
                     // Load from multiple images
-                    src = images[i]->getPixelBox(0, mip);
+                    src = srcImages[i]->getPixelBox(0, mip);
                     // set dst layer
                     if(mDepth > 1)
                     {
@@ -300,7 +319,7 @@ namespace Ogre {
                 else
                 {
                     // Load from faces of images[0]
-                    src = images[0]->getPixelBox(i, mip);
+                    src = srcImages[0]->getPixelBox(i, mip);
                 }
 
                 // Allow reinterpreting luminance as alpha
@@ -310,7 +329,7 @@ namespace Ogre {
                 if(mGamma != 1.0f) {
                     // Apply gamma correction
                     // Do not overwrite original image but do gamma correction in temporary buffer
-                    Image tmp(src.format, src.getWidth(), getHeight(), src.getDepth());
+                    Image tmp(src.format, src.getWidth(), src.getHeight(), src.getDepth());
                     PixelBox corrected = tmp.getPixelBox();
                     PixelUtil::bulkPixelConversion(src, corrected);
 
@@ -44,6 +44,7 @@ namespace Ogre {
          : mPreferredIntegerBitDepth(0)
          , mPreferredFloatBitDepth(0)
          , mDefaultNumMipmaps(MIP_UNLIMITED)
+         , mSoftwareMipmapFilter(Image::FILTER_BOX)
     {
         mResourceType = "Texture";
         mLoadOrder = 75.0f;
@@ -29,7 +29,53 @@ THE SOFTWARE.
 #include "OgreWorkQueue.h"
 #include "OgreTimer.h"
 
+#include <exception>
+#include <thread>
+
 namespace Ogre {
+    namespace
+    {
+        /// Shared state of a parallelFor call
+        struct ParallelForJob
+        {
+            const WorkQueue::RangeFunction* func;
+            size_t count;
+            size_t grainSize;
+            size_t numChunks;
+            std::atomic<size_t> nextChunk;
+            std::atomic<size_t> pendingChunks;
+            std::atomic<bool> failed;
+            std::exception_ptr error;
+
+            ParallelForJob(const WorkQueue::RangeFunction* f, size_t c, size_t grain)
+                : func(f), count(c), grainSize(grain), numChunks((c + grain - 1) / grain),
+                  nextChunk(0), pendingChunks(numChunks), failed(false)
+            {
+            }
+
+            /// grab chunks until none are left
+            void process()
+            {
+                size_t chunk;
+                while ((chunk = nextChunk.fetch_add(1)) < numChunks)
+                {
+                    size_t begin = chunk * grainSize;
+                    try
+                    {
+                        (*func)(begin, std::min(begin + grainSize, count));
+                    }
+                    catch (...)
+                    {
+                        // only keep the first error, the caller rethrows it
+                        if (!failed.exchange(true))
+                            error = std::current_exception();
+                    }
+                    --pendingChunks;
+                }
+            }
+        };
+        typedef SharedPtr<ParallelForJob> ParallelForJobPtr;
+    }
     //---------------------------------------------------------------------
     uint16 WorkQueue::getChannel(const String& channelName)
     {
@@ -43,6 +89,13 @@ namespace Ogre {
         return i->second;
     }
     //---------------------------------------------------------------------
+    void WorkQueue::parallelFor(size_t count, size_t grainSize, const RangeFunction& func)
+    {
+        grainSize = std::max<size_t>(grainSize, 1);
+        for (size_t begin = 0; begin < count; begin += grainSize)
+            func(begin, std::min(begin + grainSize, count));
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
         : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
     {
@@ -81,6 +134,8 @@ namespace Ogre {
         , mIdleThreadRunning(false)
         , mIdleProcessed(0)
     {
+        mParallelForChannel = getChannel("Ogre/ParallelFor");
+        addRequestHandler(mParallelForChannel, &mParallelForHandler);
     }
     //---------------------------------------------------------------------
     const String& DefaultWorkQueueBase::getName() const
@@ -494,6 +549,44 @@ namespace Ogre {
         return mAcceptRequests;
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::parallelFor(size_t count, size_t grainSize, const RangeFunction& func)
+    {
+        if (count == 0)
+            return;
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        ParallelForJobPtr job = std::make_shared<ParallelForJob>(&func, count, grainSize);
+
+#if OGRE_THREAD_SUPPORT
+        // ask the workers to help out. Late helpers will find no chunks left and return
+        // immediately, so they can never touch func after we returned.
+        if (mIsRunning && !mPaused)
+        {
+            size_t numHelpers = std::min(job->numChunks, mWorkerThreadCount + 1) - 1;
+            for (size_t i = 0; i < numHelpers; ++i)
+                addRequest(mParallelForChannel, 0, job);
+        }
+#endif
+
+        job->process();
+
+#if OGRE_THREAD_SUPPORT
+        // wait for the chunks that are still being processed by the workers
+        while (job->pendingChunks.load() > 0)
+            std::this_thread::yield();
+#endif
+
+        if (job->failed)
+            std::rethrow_exception(job->error);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Response* DefaultWorkQueueBase::ParallelForHandler::handleRequest(const Request* req,
+                                                                                 const WorkQueue* srcQ)
+    {
+        any_cast<ParallelForJobPtr>(req->getData())->process();
+        return OGRE_NEW Response(req, true, Any());
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::_processNextRequest()
     {
         if(processIdleRequests()){
@@ -0,0 +1,967 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "OgreTimer.h"
+
+#include <exception>
+#include <thread>
+
+namespace Ogre
+{
+    /// Either a request or a part of a parallelFor range
+    struct WorkStealingWorkQueue::Task : public UtilityAlloc
+    {
+        Request* request;
+        ParallelForJob* job;
+        size_t begin;
+        size_t end;
+
+        Task(Request* r) : request(r), job(0), begin(0), end(0) {}
+        Task(ParallelForJob* j, size_t b, size_t e) : request(0), job(j), begin(b), end(e) {}
+    };
+    //---------------------------------------------------------------------
+    /// Shared state of a parallelFor call, lives on the stack of the caller
+    struct WorkStealingWorkQueue::ParallelForJob
+    {
+        const RangeFunction* func;
+        size_t grainSize;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> failed;
+        std::exception_ptr error;
+
+        ParallelForJob(const RangeFunction* f, size_t grain, size_t count)
+            : func(f), grainSize(grain), remaining(count), failed(false)
+        {
+        }
+
+        void run(size_t begin, size_t end)
+        {
+            for (size_t b = begin; b < end; b += grainSize)
+            {
+                try
+                {
+                    (*func)(b, std::min(b + grainSize, end));
+                }
+                catch (...)
+                {
+                    // only keep the first error, the caller rethrows it
+                    if (!failed.exchange(true))
+                        error = std::current_exception();
+                }
+            }
+            // last access, the caller may return as soon as this reaches zero
+            remaining.fetch_sub(end - begin);
+        }
+    };
+    //---------------------------------------------------------------------
+    /** Lock-free multi-producer multi-consumer FIFO queue.
+    @remarks
+        Each cell carries a sequence number telling producers and consumers
+        whether it is free or holds a task of the current lap. Tasks that do
+        not fit into the cells go to a locked overflow list of the same queue,
+        so they keep their priority.
+    */
+    class WorkStealingWorkQueue::TaskQueue : public UtilityAlloc
+    {
+        static const size_t CAPACITY = 4096; // power of two
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            Task* task;
+        };
+        Cell mCells[CAPACITY];
+        char mPad0[64];
+        std::atomic<size_t> mPushPos;
+        char mPad1[64];
+        std::atomic<size_t> mPopPos;
+
+        std::deque<Task*> mOverflow; // Guarded by mOverflowMutex
+        std::atomic<size_t> mOverflowCount;
+        OGRE_WQ_MUTEX(mOverflowMutex);
+
+        bool tryPush(Task* task)
+        {
+            size_t pos = mPushPos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = mCells[pos & (CAPACITY - 1)];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+                if (diff == 0)
+                {
+                    if (mPushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.task = task;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    pos = mPushPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        Task* tryPop()
+        {
+            size_t pos = mPopPos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = mCells[pos & (CAPACITY - 1)];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos + 1);
+                if (diff == 0)
+                {
+                    if (mPopPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        Task* task = cell.task;
+                        cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+                        return task;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return 0; // empty
+                }
+                else
+                {
+                    pos = mPopPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    public:
+        TaskQueue() : mPushPos(0), mPopPos(0), mOverflowCount(0)
+        {
+            for (size_t i = 0; i < CAPACITY; ++i)
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        void push(Task* task)
+        {
+            if (tryPush(task))
+                return;
+
+            OGRE_WQ_LOCK_MUTEX(mOverflowMutex);
+            mOverflow.push_back(task);
+            ++mOverflowCount;
+        }
+
+        Task* pop()
+        {
+            Task* task = tryPop();
+            if (task || mOverflowCount.load() == 0)
+                return task;
+
+            OGRE_WQ_LOCK_MUTEX(mOverflowMutex);
+            if (mOverflow.empty())
+                return 0;
+            task = mOverflow.front();
+            mOverflow.pop_front();
+            --mOverflowCount;
+            return task;
+        }
+    };
+    //---------------------------------------------------------------------
+    /** Worker thread state, with its Chase-Lev work stealing deque.
+    @remarks
+        Only the owning thread pushes and pops at the bottom of the deque,
+        any thread may steal from the top.
+    */
+    struct WorkStealingWorkQueue::Worker
+    {
+        static const int64 CAPACITY = 1024; // power of two
+
+        /// Thread entry point, the Worker itself is not copyable
+        struct Func OGRE_THREAD_WORKER_INHERIT
+        {
+            Worker* worker;
+            Func(Worker* w) : worker(w) {}
+            void operator()() { worker->queue->threadMain(worker); }
+            void operator()() const { worker->queue->threadMain(worker); }
+            void run() { worker->queue->threadMain(worker); }
+        };
+
+        WorkStealingWorkQueue* queue;
+        std::thread::id threadId;
+#if OGRE_THREAD_SUPPORT
+        OGRE_THREAD_TYPE* thread;
+#endif
+        std::atomic<int64> top;
+        char pad[64];
+        std::atomic<int64> bottom;
+        std::atomic<Task*> tasks[CAPACITY];
+
+        Worker(WorkStealingWorkQueue* q) : queue(q), top(0), bottom(0) {}
+
+        bool push(Task* task)
+        {
+            int64 b = bottom.load(std::memory_order_relaxed);
+            int64 t = top.load(std::memory_order_acquire);
+            if (b - t >= CAPACITY)
+                return false;
+            tasks[b & (CAPACITY - 1)].store(task, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        Task* pop()
+        {
+            int64 b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 t = top.load(std::memory_order_relaxed);
+            Task* task = 0;
+            if (t <= b)
+            {
+                task = tasks[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+                if (t == b)
+                {
+                    // last task, race against thieves
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed))
+                        task = 0;
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        Task* steal()
+        {
+            int64 t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 b = bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return 0;
+            Task* task = tasks[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return 0; // lost the race, the caller tries elsewhere
+            return task;
+        }
+    };
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::WorkStealingWorkQueue(const String& name)
+        : mName(name)
+        , mWorkerThreadCount(std::max<int>(int(OGRE_THREAD_HARDWARE_CONCURRENCY) - 1, 1))
+        , mResponseTimeLimitMS(8)
+        , mIsRunning(false)
+        , mPaused(false)
+        , mAcceptRequests(true)
+        , mShuttingDown(false)
+        , mRequestCount(0)
+        , mNumWorkersStarted(0)
+        , mForkQueue(OGRE_NEW TaskQueue())
+        , mPendingTasks(0)
+        , mNumSleeping(0)
+        , mIdleRunning(false)
+    {
+        for (int p = 0; p < WQP_COUNT; ++p)
+            mRequestQueues[p] = OGRE_NEW TaskQueue();
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::~WorkStealingWorkQueue()
+    {
+        shutdown();
+
+        // requests that were never processed
+        Task* task;
+        for (int p = 0; p < WQP_COUNT; ++p)
+        {
+            while ((task = mRequestQueues[p]->pop()))
+            {
+                OGRE_DELETE task->request;
+                OGRE_DELETE task;
+            }
+            OGRE_DELETE mRequestQueues[p];
+        }
+        for (std::deque<Task*>::iterator i = mIdleQueue.begin(); i != mIdleQueue.end(); ++i)
+        {
+            OGRE_DELETE (*i)->request;
+            OGRE_DELETE *i;
+        }
+        OGRE_DELETE mForkQueue;
+
+        for (std::deque<Response*>::iterator i = mResponseQueue.begin(); i != mResponseQueue.end(); ++i)
+        {
+            OGRE_DELETE *i;
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::startup(bool forceRestart)
+    {
+        if (mIsRunning)
+        {
+            if (forceRestart)
+                shutdown();
+            else
+                return;
+        }
+
+        mShuttingDown = false;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') initialising on thread " <<
+            OGRE_THREAD_CURRENT_ID << " with " << mWorkerThreadCount << " workers.";
+
+#if OGRE_THREAD_SUPPORT
+        mNumWorkersStarted = 0;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+            mWorkers.push_back(OGRE_NEW_T(Worker, MEMCATEGORY_GENERAL)(this));
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+        {
+            Worker::Func func(mWorkers[i]);
+            OGRE_THREAD_CREATE(t, func);
+            mWorkers[i]->thread = t;
+        }
+
+        // the workers must know each other before any work is done
+        while (mNumWorkersStarted.load() < mWorkers.size())
+            std::this_thread::yield();
+#endif
+
+        mIsRunning = true;
+
+        // pick up requests added before startup
+        notifyWorkers();
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::shutdown()
+    {
+        if (!mIsRunning)
+            return;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') shutting down on thread " <<
+            OGRE_THREAD_CURRENT_ID << ".";
+
+        mShuttingDown = true;
+        abortAllRequests();
+
+#if OGRE_THREAD_SUPPORT
+        {
+            OGRE_WQ_LOCK_MUTEX(mSleepMutex);
+            OGRE_THREAD_NOTIFY_ALL(mSleepCondition);
+        }
+
+        for (size_t i = 0; i < mWorkers.size(); ++i)
+        {
+            mWorkers[i]->thread->join();
+            OGRE_THREAD_DESTROY(mWorkers[i]->thread);
+        }
+        for (size_t i = 0; i < mWorkers.size(); ++i)
+        {
+            OGRE_DELETE_T(mWorkers[i], Worker, MEMCATEGORY_GENERAL);
+        }
+        mWorkers.clear();
+#endif
+
+        mIsRunning = false;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::setChannelPriority(uint16 channel, Priority priority)
+    {
+        OGRE_WQ_LOCK_MUTEX(mChannelMutex);
+        mChannelPriorities[channel] = priority;
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::Priority WorkStealingWorkQueue::getChannelPriority(uint16 channel) const
+    {
+        OGRE_WQ_LOCK_MUTEX(mChannelMutex);
+        std::map<uint16, Priority>::const_iterator i = mChannelPriorities.find(channel);
+        return i != mChannelPriorities.end() ? i->second : WQP_NORMAL;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::addRequestHandler(uint16 channel, RequestHandler* rh)
+    {
+        OGRE_WQ_LOCK_MUTEX(mChannelMutex);
+
+        HandlerHolderList& handlers = mRequestHandlers[channel];
+        for (HandlerHolderList::iterator i = handlers.begin(); i != handlers.end(); ++i)
+        {
+            if ((*i)->handler == rh)
+                return;
+        }
+        handlers.push_back(std::make_shared<HandlerHolder>(rh));
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::removeRequestHandler(uint16 channel, RequestHandler* rh)
+    {
+        HandlerHolderPtr holder;
+        {
+            OGRE_WQ_LOCK_MUTEX(mChannelMutex);
+
+            std::map<uint16, HandlerHolderList>::iterator i = mRequestHandlers.find(channel);
+            if (i == mRequestHandlers.end())
+                return;
+
+            HandlerHolderList& handlers = i->second;
+            for (HandlerHolderList::iterator j = handlers.begin(); j != handlers.end(); ++j)
+            {
+                if ((*j)->handler == rh)
+                {
+                    holder = *j;
+                    handlers.erase(j);
+                    break;
+                }
+            }
+        }
+
+        if (holder)
+        {
+            // disconnect and wait for the requests being processed by it to finish
+            holder->handler = 0;
+            while (holder->users.load() > 0)
+                std::this_thread::yield();
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::addResponseHandler(uint16 channel, ResponseHandler* rh)
+    {
+        ResponseHandlerList& handlers = mResponseHandlers[channel];
+        if (std::find(handlers.begin(), handlers.end(), rh) == handlers.end())
+            handlers.push_back(rh);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::removeResponseHandler(uint16 channel, ResponseHandler* rh)
+    {
+        std::map<uint16, ResponseHandlerList>::iterator i = mResponseHandlers.find(channel);
+        if (i != mResponseHandlers.end())
+            i->second.remove(rh);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::RequestID WorkStealingWorkQueue::addRequest(uint16 channel, uint16 requestType,
+        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread)
+    {
+        if (!mAcceptRequests || mShuttingDown)
+            return 0;
+
+        RequestID rid = ++mRequestCount;
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+
+#if OGRE_THREAD_SUPPORT
+        if (!forceSynchronous)
+        {
+            queueRequest(req, idleThread);
+            return rid;
+        }
+#endif
+        processRequestResponse(req, true);
+        return rid;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::queueRequest(Request* req, bool idleThread)
+    {
+        {
+            RequestShard& shard = getShard(req->getID());
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            RequestEntry entry = {req, false};
+            shard.requests[req->getID()] = entry;
+        }
+
+        Task* task = OGRE_NEW Task(req);
+        if (idleThread)
+        {
+            {
+                OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+                mIdleQueue.push_back(task);
+            }
+            notifyWorkers();
+            return;
+        }
+
+        pushTask(mRequestQueues[getChannelPriority(req->getChannel())], task);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::pushTask(TaskQueue* queue, Task* task)
+    {
+        ++mPendingTasks;
+        queue->push(task);
+        notifyWorkers();
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::pushLocalTask(Worker* worker, Task* task)
+    {
+        ++mPendingTasks;
+        if (!worker->push(task))
+        {
+            --mPendingTasks;
+            return false;
+        }
+        notifyWorkers();
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::notifyWorkers()
+    {
+#if OGRE_THREAD_SUPPORT
+        // sleepers register under the lock before checking for work, so
+        // either they see the new task or we see them
+        if (mNumSleeping.load() > 0)
+        {
+            OGRE_WQ_LOCK_MUTEX(mSleepMutex);
+            OGRE_THREAD_NOTIFY_ONE(mSleepCondition);
+        }
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::setPaused(bool pause)
+    {
+        mPaused = pause;
+#if OGRE_THREAD_SUPPORT
+        if (!pause)
+        {
+            OGRE_WQ_LOCK_MUTEX(mSleepMutex);
+            OGRE_THREAD_NOTIFY_ALL(mSleepCondition);
+        }
+#endif
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::Worker* WorkStealingWorkQueue::getCurrentWorker() const
+    {
+        std::thread::id id = std::this_thread::get_id();
+        for (size_t i = 0; i < mWorkers.size(); ++i)
+        {
+            if (mWorkers[i]->threadId == id)
+                return mWorkers[i];
+        }
+        return 0;
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::Task* WorkStealingWorkQueue::findRangeTask(Worker* self)
+    {
+        Task* task = self ? self->pop() : 0;
+        if (!task)
+            task = mForkQueue->pop();
+
+        // steal, starting with the next worker to spread the thieves
+        size_t numWorkers = mWorkers.size();
+        size_t first = self ? size_t(std::find(mWorkers.begin(), mWorkers.end(), self) - mWorkers.begin()) + 1 : 0;
+        for (size_t i = 0; !task && i < numWorkers; ++i)
+        {
+            Worker* victim = mWorkers[(first + i) % numWorkers];
+            if (victim != self)
+                task = victim->steal();
+        }
+
+        if (task)
+            --mPendingTasks;
+        return task;
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::Task* WorkStealingWorkQueue::findRequestTask()
+    {
+        if (mPaused)
+            return 0;
+
+        Task* task = 0;
+        for (int p = 0; !task && p < WQP_COUNT; ++p)
+            task = mRequestQueues[p]->pop();
+
+        if (task)
+            --mPendingTasks;
+        return task;
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::Task* WorkStealingWorkQueue::findIdleTask()
+    {
+        if (mPaused)
+            return 0;
+
+        OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+        if (mIdleRunning || mIdleQueue.empty())
+            return 0;
+
+        Task* task = mIdleQueue.front();
+        mIdleQueue.pop_front();
+        mIdleRunning = true;
+        return task;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::threadMain(Worker* worker)
+    {
+#if OGRE_THREAD_SUPPORT
+        worker->threadId = std::this_thread::get_id();
+        ++mNumWorkersStarted;
+        while (mNumWorkersStarted.load() < mWorkers.size())
+            std::this_thread::yield();
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "')::Worker - thread " <<
+            OGRE_THREAD_CURRENT_ID << " starting.";
+
+        while (!mShuttingDown)
+        {
+            // fork/join work first, someone is waiting for it
+            Task* task = findRangeTask(worker);
+            if (task)
+            {
+                runRangeTask(worker, task);
+                continue;
+            }
+
+            task = findRequestTask();
+            if (task)
+            {
+                runRequestTask(task);
+                continue;
+            }
+
+            task = findIdleTask();
+            if (task)
+            {
+                runRequestTask(task);
+                OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+                mIdleRunning = false;
+                continue;
+            }
+
+            // nothing to do, sleep until notified
+            OGRE_WQ_LOCK_MUTEX_NAMED(mSleepMutex, sleepLock);
+            ++mNumSleeping;
+            bool idleWork;
+            {
+                OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+                idleWork = !mIdleRunning && !mIdleQueue.empty();
+            }
+            if (!mShuttingDown && !idleWork && (mPaused || mPendingTasks.load() == 0))
+                OGRE_THREAD_WAIT(mSleepCondition, mSleepMutex, sleepLock);
+            --mNumSleeping;
+        }
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "')::Worker - thread " <<
+            OGRE_THREAD_CURRENT_ID << " stopped.";
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::runRangeTask(Worker* self, Task* task)
+    {
+        ParallelForJob* job = task->job;
+        size_t begin = task->begin;
+        size_t end = task->end;
+        OGRE_DELETE task;
+
+        // keep one grain for ourselves, offer the upper halves to thieves
+        while (self && end - begin > job->grainSize)
+        {
+            // at least one grain on either side, also for ragged ranges
+            size_t numChunks = (end - begin + job->grainSize - 1) / job->grainSize;
+            size_t mid = begin + std::max<size_t>(1, numChunks / 2) * job->grainSize;
+            Task* fork = OGRE_NEW Task(job, mid, end);
+            if (!pushLocalTask(self, fork))
+            {
+                OGRE_DELETE fork;
+                break;
+            }
+            end = mid;
+        }
+
+        job->run(begin, end);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::parallelFor(size_t count, size_t grainSize, const RangeFunction& func)
+    {
+        grainSize = std::max<size_t>(grainSize, 1);
+
+#if OGRE_THREAD_SUPPORT
+        if (!mIsRunning || mPaused || mWorkers.empty() || count <= grainSize)
+        {
+            WorkQueue::parallelFor(count, grainSize, func);
+            return;
+        }
+
+        ParallelForJob job(&func, grainSize, count);
+        Worker* self = getCurrentWorker();
+        if (self)
+        {
+            runRangeTask(self, OGRE_NEW Task(&job, 0, count));
+        }
+        else
+        {
+            // we own no deque, so hand out one part per worker up front and
+            // let them split it further
+            size_t numChunks = (count + grainSize - 1) / grainSize;
+            size_t numParts = std::min(numChunks, mWorkers.size() + 1);
+            size_t partEnd = numChunks / numParts * grainSize;
+            for (size_t p = 1; p < numParts; ++p)
+            {
+                size_t begin = numChunks * p / numParts * grainSize;
+                size_t end = std::min(numChunks * (p + 1) / numParts * grainSize, count);
+                pushTask(mForkQueue, OGRE_NEW Task(&job, begin, end));
+            }
+            job.run(0, partEnd);
+        }
+
+        // help with fork/join work until all parts are done
+        while (job.remaining.load() > 0)
+        {
+            Task* task = findRangeTask(self);
+            if (task)
+                runRangeTask(self, task);
+            else
+                std::this_thread::yield();
+        }
+
+        if (job.failed)
+            std::rethrow_exception(job.error);
+#else
+        WorkQueue::parallelFor(count, grainSize, func);
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::runRequestTask(Task* task)
+    {
+        Request* req = task->request;
+        OGRE_DELETE task;
+
+        {
+            RequestShard& shard = getShard(req->getID());
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            shard.requests[req->getID()].running = true;
+        }
+
+        processRequestResponse(req, false);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::processRequestResponse(Request* r, bool synchronous)
+    {
+        Response* response = processRequest(r);
+
+        {
+            RequestShard& shard = getShard(r->getID());
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            shard.requests.erase(r->getID());
+        }
+
+        if (!response)
+        {
+            if (!r->getAborted())
+            {
+                LogManager::getSingleton().stream(LML_WARNING) <<
+                    "WorkStealingWorkQueue('" << mName << "') warning: no handler processed request "
+                    << r->getID() << ", channel " << r->getChannel() << ", type " << r->getType();
+            }
+            OGRE_DELETE r;
+            return;
+        }
+
+        if (!response->succeeded())
+        {
+            // Failed, should we retry?
+            const Request* req = response->getRequest();
+            if (req->getRetryCount() && !mShuttingDown)
+            {
+                Request* retry = OGRE_NEW Request(req->getChannel(), req->getType(), req->getData(),
+                                                  req->getRetryCount() - 1, req->getID());
+                // discard response (this also deletes request)
+                OGRE_DELETE response;
+#if OGRE_THREAD_SUPPORT
+                queueRequest(retry, false);
+#else
+                processRequestResponse(retry, synchronous);
+#endif
+                return;
+            }
+        }
+
+        if (synchronous)
+        {
+            processResponse(response);
+            OGRE_DELETE response;
+            return;
+        }
+
+        if (response->getRequest()->getAborted())
+        {
+            // destroy response user data
+            response->abortRequest();
+        }
+        // no need to wake anybody, responses are processed by the main thread
+        OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+        mResponseQueue.push_back(response);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Response* WorkStealingWorkQueue::processRequest(Request* r)
+    {
+        HandlerHolderList handlers;
+        {
+            OGRE_WQ_LOCK_MUTEX(mChannelMutex);
+            std::map<uint16, HandlerHolderList>::iterator i = mRequestHandlers.find(r->getChannel());
+            if (i != mRequestHandlers.end())
+                handlers = i->second;
+        }
+
+        Response* response = 0;
+        for (HandlerHolderList::reverse_iterator i = handlers.rbegin(); i != handlers.rend() && !response; ++i)
+        {
+            // a removed handler is only destroyed once its users are gone
+            HandlerHolder& holder = **i;
+            ++holder.users;
+            RequestHandler* handler = holder.handler;
+            if (handler && handler->canHandleRequest(r, this))
+                response = handler->handleRequest(r, this);
+            --holder.users;
+        }
+        return response;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::processResponses()
+    {
+        unsigned long msStart = Root::getSingleton().getTimer()->getMilliseconds();
+
+        // keep going until we run out of responses or out of time
+        while (true)
+        {
+            Response* response = 0;
+            {
+                OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+                if (mResponseQueue.empty())
+                    break;
+                response = mResponseQueue.front();
+                mResponseQueue.pop_front();
+            }
+
+            processResponse(response);
+            OGRE_DELETE response;
+
+            // time limit
+            if (mResponseTimeLimitMS &&
+                Root::getSingleton().getTimer()->getMilliseconds() - msStart > mResponseTimeLimitMS)
+                break;
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::processResponse(Response* r)
+    {
+        std::map<uint16, ResponseHandlerList>::iterator i = mResponseHandlers.find(r->getRequest()->getChannel());
+        if (i == mResponseHandlers.end())
+            return;
+
+        ResponseHandlerList& handlers = i->second;
+        for (ResponseHandlerList::reverse_iterator j = handlers.rbegin(); j != handlers.rend(); ++j)
+        {
+            if ((*j)->canHandleResponse(r, this))
+                (*j)->handleResponse(r, this);
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequest(RequestID id)
+    {
+        {
+            RequestShard& shard = getShard(id);
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            std::map<RequestID, RequestEntry>::iterator i = shard.requests.find(id);
+            if (i != shard.requests.end())
+                i->second.request->abortRequest();
+        }
+
+        OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+        for (std::deque<Response*>::iterator i = mResponseQueue.begin(); i != mResponseQueue.end(); ++i)
+        {
+            if ((*i)->getRequest()->getID() == id)
+            {
+                (*i)->abortRequest();
+                break;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::abortPendingRequest(RequestID id)
+    {
+        RequestShard& shard = getShard(id);
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        std::map<RequestID, RequestEntry>::iterator i = shard.requests.find(id);
+        if (i == shard.requests.end() || i->second.running)
+            return false;
+
+        i->second.request->abortRequest();
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequestsByChannel(uint16 channel)
+    {
+        for (size_t s = 0; s < NUM_SHARDS; ++s)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[s].mutex);
+            std::map<RequestID, RequestEntry>& requests = mShards[s].requests;
+            for (std::map<RequestID, RequestEntry>::iterator i = requests.begin(); i != requests.end(); ++i)
+            {
+                if (i->second.request->getChannel() == channel)
+                    i->second.request->abortRequest();
+            }
+        }
+
+        OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+        for (std::deque<Response*>::iterator i = mResponseQueue.begin(); i != mResponseQueue.end(); ++i)
+        {
+            if ((*i)->getRequest()->getChannel() == channel)
+                (*i)->abortRequest();
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortPendingRequestsByChannel(uint16 channel)
+    {
+        for (size_t s = 0; s < NUM_SHARDS; ++s)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[s].mutex);
+            std::map<RequestID, RequestEntry>& requests = mShards[s].requests;
+            for (std::map<RequestID, RequestEntry>::iterator i = requests.begin(); i != requests.end(); ++i)
+            {
+                if (!i->second.running && i->second.request->getChannel() == channel)
+                    i->second.request->abortRequest();
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortAllRequests()
+    {
+        for (size_t s = 0; s < NUM_SHARDS; ++s)
+        {
+            OGRE_WQ_LOCK_MUTEX(mShards[s].mutex);
+            std::map<RequestID, RequestEntry>& requests = mShards[s].requests;
+            for (std::map<RequestID, RequestEntry>::iterator i = requests.begin(); i != requests.end(); ++i)
+                i->second.request->abortRequest();
+        }
+
+        OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+        for (std::deque<Response*>::iterator i = mResponseQueue.begin(); i != mResponseQueue.end(); ++i)
+            (*i)->abortRequest();
+    }
+}
@@ -57,6 +57,13 @@ OctreeIntersectionSceneQuery::~OctreeIntersectionSceneQuery()
 //---------------------------------------------------------------------
 void OctreeIntersectionSceneQuery::execute(IntersectionSceneQueryListener* listener)
 {
+    // sort and sweep beats searching the octree for each object
+    if (mParentSceneMgr->getIntersectionSceneQueryBroadphaseEnabled())
+    {
+        DefaultIntersectionSceneQuery::execute(listener);
+        return;
+    }
+
     typedef std::pair<MovableObject *, MovableObject *> MovablePair;
     typedef std::set
         < std::pair<MovableObject *, MovableObject *> > MovableSet;
@@ -128,6 +128,16 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        uint32 _getParticleArrayComponents(void) const
+        {
+            return ParticleArrays::PAC_COLOUR | ParticleArrays::PAC_TIME_TO_LIVE;
+        }
+
+        /** See ParticleAffector. */
+        void _affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                   ParticleArrays& arrays, size_t begin, size_t end);
+
         /** Sets the colour adjustment to be made per second to particles. 
         @param red, green, blue, alpha
             Sets the adjustment to be made to each of the colour components per second. These
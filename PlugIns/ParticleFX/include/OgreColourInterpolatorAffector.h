@@ -73,6 +73,16 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        uint32 _getParticleArrayComponents(void) const
+        {
+            return ParticleArrays::PAC_COLOUR | ParticleArrays::PAC_TIME_TO_LIVE;
+        }
+
+        /** See ParticleAffector. */
+        void _affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                   ParticleArrays& arrays, size_t begin, size_t end);
+
         void setColourAdjust(size_t index, ColourValue colour);
         ColourValue getColourAdjust(size_t index) const;
         
@@ -87,6 +97,9 @@ namespace Ogre {
         ColourValue             mColourAdj[MAX_STAGES];
         Real                    mTimeAdj[MAX_STAGES];
 
+        /// Sets colour from the stages, given the fraction of the particle's life that has passed
+        void interpolate(Real particle_time, ColourValue& colour) const;
+
     };
 }
 
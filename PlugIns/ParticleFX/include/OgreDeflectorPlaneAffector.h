@@ -81,6 +81,16 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        uint32 _getParticleArrayComponents(void) const
+        {
+            return ParticleArrays::PAC_POSITION | ParticleArrays::PAC_DIRECTION;
+        }
+
+        /** See ParticleAffector. */
+        void _affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                   ParticleArrays& arrays, size_t begin, size_t end);
+
         /** Sets the plane point of the deflector plane. */
         void setPlanePoint(const Vector3& pos);
 
@@ -112,6 +122,9 @@ namespace Ogre {
 
         /// bounce factor (0.5 means 50 percent)
         Real mBounce;
+
+        /// Bounces a single particle off the plane if it passes through it this frame
+        void deflect(Vector3& position, Vector3& direction, Real planeDistance, Real timeElapsed) const;
     };
     /** @} */
     /** @} */
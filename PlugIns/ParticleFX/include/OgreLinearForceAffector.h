@@ -85,6 +85,16 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        uint32 _getParticleArrayComponents(void) const
+        {
+            return ParticleArrays::PAC_DIRECTION;
+        }
+
+        /** See ParticleAffector. */
+        void _affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                   ParticleArrays& arrays, size_t begin, size_t end);
+
 
         /** Sets the force vector to apply to the particles in a system. */
         void setForceVector(const Vector3& force);
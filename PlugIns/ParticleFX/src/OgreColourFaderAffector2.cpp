@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+#include <xmmintrin.h>
+#endif
 
 
 namespace Ogre {
@@ -111,6 +116,38 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void ColourFaderAffector2::_affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                                     ParticleArrays& arrays, size_t begin, size_t end)
+    {
+        // Scale adjustments by time
+        auto dc1 = ColourValue(mRedAdj1, mGreenAdj1, mBlueAdj1, mAlphaAdj1) * timeElapsed;
+        auto dc2 = ColourValue(mRedAdj2, mGreenAdj2, mBlueAdj2, mAlphaAdj2) * timeElapsed;
+
+        const Real* ttl = arrays.timeToLive.data();
+        for (int c = 0; c < 4; ++c)
+        {
+            Real* colour = arrays.colour[c].data();
+            size_t i = begin;
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+            __m128 adj1 = _mm_set1_ps(dc1[c]);
+            __m128 adj2 = _mm_set1_ps(dc2[c]);
+            __m128 stateChange = _mm_set1_ps(StateChangeVal);
+            __m128 zero = _mm_setzero_ps();
+            __m128 one = _mm_set1_ps(1);
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 first = _mm_cmpgt_ps(_mm_loadu_ps(ttl + i), stateChange);
+                __m128 adj = _mm_or_ps(_mm_and_ps(first, adj1), _mm_andnot_ps(first, adj2));
+                // same as ColourValue::saturate
+                __m128 v = _mm_add_ps(_mm_loadu_ps(colour + i), adj);
+                _mm_storeu_ps(colour + i, _mm_min_ps(one, _mm_max_ps(zero, v)));
+            }
+#endif
+            for (; i < end; ++i)
+                colour[i] = Math::saturate(colour[i] + (ttl[i] > StateChangeVal ? dc1[c] : dc2[c]));
+        }
+    }
+    //-----------------------------------------------------------------------
     void ColourFaderAffector2::setAdjust1(float red, float green, float blue, float alpha)
     {
         mRedAdj1 = red;
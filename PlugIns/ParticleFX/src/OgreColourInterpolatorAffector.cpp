@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+#include <xmmintrin.h>
+#endif
 
 
 namespace Ogre {
@@ -78,28 +83,91 @@ namespace Ogre {
     {
         for (auto p : pSystem->_getActiveParticles())
         {
-            const Real      life_time       = p->mTotalTimeToLive;
-            Real            particle_time   = 1.0f - (p->mTimeToLive / life_time);
+            interpolate(1.0f - (p->mTimeToLive / p->mTotalTimeToLive), p->mColour);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ColourInterpolatorAffector::_affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                                           ParticleArrays& arrays, size_t begin, size_t end)
+    {
+        const Real* ttl = arrays.timeToLive.data();
+        const Real* totalTtl = arrays.totalTimeToLive.data();
+        Real* col[4] = {arrays.colour[0].data(), arrays.colour[1].data(), arrays.colour[2].data(),
+                        arrays.colour[3].data()};
+        size_t i = begin;
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 stageTime[MAX_STAGES];
+        __m128 stageColour[MAX_STAGES][4];
+        for (int s = 0; s < MAX_STAGES; ++s)
+        {
+            stageTime[s] = _mm_set1_ps(mTimeAdj[s]);
+            for (int c = 0; c < 4; ++c)
+                stageColour[s][c] = _mm_set1_ps(mColourAdj[s][c]);
+        }
+        auto select = [](__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        };
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 t = _mm_sub_ps(one, _mm_div_ps(_mm_loadu_ps(ttl + i), _mm_loadu_ps(totalTtl + i)));
+            __m128 c[4];
+            for (int k = 0; k < 4; ++k)
+                c[k] = _mm_loadu_ps(col[k] + i);
 
-            if (particle_time <= mTimeAdj[0])
+            // interpolate picks the first matching stage, so apply them last to first
+            for (int s = MAX_STAGES - 2; s >= 0; --s)
             {
-                p->mColour = mColourAdj[0];
-            } else
-            if (particle_time >= mTimeAdj[MAX_STAGES - 1])
+                __m128 mask = _mm_and_ps(_mm_cmpge_ps(t, stageTime[s]), _mm_cmplt_ps(t, stageTime[s + 1]));
+                if (!_mm_movemask_ps(mask))
+                    continue;
+                __m128 u = _mm_div_ps(_mm_sub_ps(t, stageTime[s]), _mm_sub_ps(stageTime[s + 1], stageTime[s]));
+                __m128 v = _mm_sub_ps(one, u);
+                for (int k = 0; k < 4; ++k)
+                {
+                    __m128 lerp = _mm_add_ps(_mm_mul_ps(stageColour[s][k], v), _mm_mul_ps(stageColour[s + 1][k], u));
+                    c[k] = select(mask, lerp, c[k]);
+                }
+            }
+            __m128 last = _mm_cmpge_ps(t, stageTime[MAX_STAGES - 1]);
+            __m128 first = _mm_cmple_ps(t, stageTime[0]);
+            for (int k = 0; k < 4; ++k)
             {
-                p->mColour = mColourAdj[MAX_STAGES-1];
-            } else
+                c[k] = select(last, stageColour[MAX_STAGES - 1][k], c[k]);
+                _mm_storeu_ps(col[k] + i, select(first, stageColour[0][k], c[k]));
+            }
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            ColourValue colour(col[0][i], col[1][i], col[2][i], col[3][i]);
+            interpolate(1.0f - (ttl[i] / totalTtl[i]), colour);
+            for (int k = 0; k < 4; ++k)
+                col[k][i] = colour[k];
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ColourInterpolatorAffector::interpolate(Real particle_time, ColourValue& colour) const
+    {
+        if (particle_time <= mTimeAdj[0])
+        {
+            colour = mColourAdj[0];
+        } else
+        if (particle_time >= mTimeAdj[MAX_STAGES - 1])
+        {
+            colour = mColourAdj[MAX_STAGES-1];
+        } else
+        {
+            for (int i=0;i<MAX_STAGES-1;i++)
             {
-                for (int i=0;i<MAX_STAGES-1;i++)
+                if (particle_time >= mTimeAdj[i] && particle_time < mTimeAdj[i + 1])
                 {
-                    if (particle_time >= mTimeAdj[i] && particle_time < mTimeAdj[i + 1])
-                    {
-                        particle_time -= mTimeAdj[i];
-                        particle_time /= (mTimeAdj[i+1]-mTimeAdj[i]);
-
-                        p->mColour = Math::lerp(mColourAdj[i], mColourAdj[i+1], particle_time);
-                        break;
-                    }
+                    particle_time -= mTimeAdj[i];
+                    particle_time /= (mTimeAdj[i+1]-mTimeAdj[i]);
+
+                    colour = Math::lerp(mColourAdj[i], mColourAdj[i+1], particle_time);
+                    break;
                 }
             }
         }
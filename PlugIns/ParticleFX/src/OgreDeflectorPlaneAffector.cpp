@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreParticle.h"
 #include "OgreStringConverter.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+#include <xmmintrin.h>
+#endif
 
 
 namespace Ogre {
@@ -66,24 +71,95 @@ namespace Ogre {
     {
         // precalculate distance of plane from origin
         Real planeDistance = - mPlaneNormal.dotProduct(mPlanePoint) / Math::Sqrt(mPlaneNormal.dotProduct(mPlaneNormal));
-        Vector3 directionPart;
 
         for (auto p : pSystem->_getActiveParticles())
         {
-            Vector3 direction(p->mDirection * timeElapsed);
-            if (mPlaneNormal.dotProduct(p->mPosition + direction) + planeDistance <= 0.0)
+            deflect(p->mPosition, p->mDirection, planeDistance, timeElapsed);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void DeflectorPlaneAffector::_affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                                       ParticleArrays& arrays, size_t begin, size_t end)
+    {
+        // precalculate distance of plane from origin
+        Real planeDistance = - mPlaneNormal.dotProduct(mPlanePoint) / Math::Sqrt(mPlaneNormal.dotProduct(mPlaneNormal));
+
+        Real* pos[3] = {arrays.position[0].data(), arrays.position[1].data(), arrays.position[2].data()};
+        Real* dir[3] = {arrays.direction[0].data(), arrays.direction[1].data(), arrays.direction[2].data()};
+        size_t i = begin;
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+        // the same operations in the same order as deflect, four particles at a time
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 t = _mm_set1_ps(timeElapsed);
+        const __m128 pd = _mm_set1_ps(planeDistance);
+        const __m128 bounce = _mm_set1_ps(mBounce);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        const __m128 n[3] = {_mm_set1_ps(mPlaneNormal.x), _mm_set1_ps(mPlaneNormal.y),
+                             _mm_set1_ps(mPlaneNormal.z)};
+        auto dot = [&zero](const __m128* a, const __m128* b)
+        {
+            __m128 r = _mm_add_ps(zero, _mm_mul_ps(a[0], b[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a[1], b[1]));
+            return _mm_add_ps(r, _mm_mul_ps(a[2], b[2]));
+        };
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 p[3], d[3], step[3], moved[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                p[c] = _mm_loadu_ps(pos[c] + i);
+                d[c] = _mm_loadu_ps(dir[c] + i);
+                step[c] = _mm_mul_ps(d[c], t);
+                moved[c] = _mm_add_ps(p[c], step[c]);
+            }
+            __m128 a = _mm_add_ps(dot(n, p), pd);
+            __m128 hit = _mm_and_ps(_mm_cmple_ps(_mm_add_ps(dot(n, moved), pd), zero),
+                                    _mm_cmpgt_ps(a, zero));
+            if (!_mm_movemask_ps(hit))
+                continue;
+
+            __m128 scale = _mm_div_ps(_mm_xor_ps(a, signBit), dot(step, n));
+            __m128 reflect = _mm_mul_ps(two, dot(d, n));
+            for (int c = 0; c < 3; ++c)
             {
-                Real a = mPlaneNormal.dotProduct(p->mPosition) + planeDistance;
-                if (a > 0.0)
-                {
-                    // for intersection point
-                    directionPart = direction * (- a / direction.dotProduct( mPlaneNormal ));
-                    // set new position
-                    p->mPosition = (p->mPosition + ( directionPart )) + (((directionPart) - direction) * mBounce);
-
-                    // reflect direction vector
-                    p->mDirection = (p->mDirection - (2.0f * p->mDirection.dotProduct( mPlaneNormal ) * mPlaneNormal)) * mBounce;
-                }
+                __m128 part = _mm_mul_ps(step[c], scale);
+                __m128 newPos = _mm_add_ps(_mm_add_ps(p[c], part), _mm_mul_ps(_mm_sub_ps(part, step[c]), bounce));
+                __m128 newDir = _mm_mul_ps(_mm_sub_ps(d[c], _mm_mul_ps(reflect, n[c])), bounce);
+                _mm_storeu_ps(pos[c] + i, _mm_or_ps(_mm_and_ps(hit, newPos), _mm_andnot_ps(hit, p[c])));
+                _mm_storeu_ps(dir[c] + i, _mm_or_ps(_mm_and_ps(hit, newDir), _mm_andnot_ps(hit, d[c])));
+            }
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            Vector3 position(pos[0][i], pos[1][i], pos[2][i]);
+            Vector3 direction(dir[0][i], dir[1][i], dir[2][i]);
+            deflect(position, direction, planeDistance, timeElapsed);
+            for (int c = 0; c < 3; ++c)
+            {
+                pos[c][i] = position[c];
+                dir[c][i] = direction[c];
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void DeflectorPlaneAffector::deflect(Vector3& position, Vector3& direction, Real planeDistance,
+                                         Real timeElapsed) const
+    {
+        Vector3 step(direction * timeElapsed);
+        if (mPlaneNormal.dotProduct(position + step) + planeDistance <= 0.0)
+        {
+            Real a = mPlaneNormal.dotProduct(position) + planeDistance;
+            if (a > 0.0)
+            {
+                // for intersection point
+                Vector3 directionPart = step * (- a / step.dotProduct( mPlaneNormal ));
+                // set new position
+                position = (position + ( directionPart )) + (((directionPart) - step) * mBounce);
+
+                // reflect direction vector
+                direction = (direction - (2.0f * direction.dotProduct( mPlaneNormal ) * mPlaneNormal)) * mBounce;
             }
         }
     }
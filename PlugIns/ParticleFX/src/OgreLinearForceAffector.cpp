@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreParticle.h"
 #include "OgreStringConverter.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+#include <xmmintrin.h>
+#endif
 
 
 namespace Ogre {
@@ -68,27 +73,57 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void LinearForceAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Vector3 scaledVector = Vector3::ZERO;
-
-        // Precalc scaled force for optimisation
         if (mForceApplication == FA_ADD)
         {
             // Scale force by time
-            scaledVector = mForceVector * timeElapsed;
+            Vector3 scaledVector = mForceVector * timeElapsed;
+            for (auto p : pSystem->_getActiveParticles())
+            {
+                p->mDirection += scaledVector;
+            }
         }
+        else // FA_AVERAGE
+        {
+            for (auto p : pSystem->_getActiveParticles())
+            {
+                p->mDirection = (p->mDirection + mForceVector) / 2;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void LinearForceAffector::_affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                                    ParticleArrays& arrays, size_t begin, size_t end)
+    {
+        // Scale force by time
+        Vector3 scaledVector = mForceVector * timeElapsed;
 
-        for (auto p : pSystem->_getActiveParticles())
+        for (int c = 0; c < 3; ++c)
         {
+            Real* dir = arrays.direction[c].data();
+            size_t i = begin;
             if (mForceApplication == FA_ADD)
             {
-                p->mDirection += scaledVector;
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+                __m128 force = _mm_set1_ps(scaledVector[c]);
+                for (; i + 4 <= end; i += 4)
+                    _mm_storeu_ps(dir + i, _mm_add_ps(_mm_loadu_ps(dir + i), force));
+#endif
+                for (; i < end; ++i)
+                    dir[i] += scaledVector[c];
             }
             else // FA_AVERAGE
             {
-                p->mDirection = (p->mDirection + mForceVector) / 2;
+                // halving is exact, so this matches the division of _affectParticles
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+                __m128 force = _mm_set1_ps(mForceVector[c]);
+                __m128 half = _mm_set1_ps(0.5f);
+                for (; i + 4 <= end; i += 4)
+                    _mm_storeu_ps(dir + i, _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(dir + i), force), half));
+#endif
+                for (; i < end; ++i)
+                    dir[i] = (dir[i] + mForceVector[c]) * Real(0.5);
             }
         }
-        
     }
     //-----------------------------------------------------------------------
     void LinearForceAffector::setForceVector(const Vector3& force)
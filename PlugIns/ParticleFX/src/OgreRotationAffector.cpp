@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+#include <xmmintrin.h>
+#endif
 
 
 namespace Ogre {
@@ -88,19 +93,25 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RotationAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Real ds;
-
-        // Rotation adjustments by time
-        ds = timeElapsed;
-
-        Radian NewRotation;
-
         for (auto p : pSystem->_getActiveParticles())
         {
-            NewRotation = p->mRotation + (ds * p->mRotationSpeed);
-            p->setRotation( NewRotation );
+            p->setRotation( p->mRotation + (timeElapsed * p->mRotationSpeed) );
         }
-
+    }
+    //-----------------------------------------------------------------------
+    void RotationAffector::_affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                                 ParticleArrays& arrays, size_t begin, size_t end)
+    {
+        Real* rotation = arrays.rotation.data();
+        const Real* speed = arrays.rotationSpeed.data();
+        size_t i = begin;
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+        __m128 t = _mm_set1_ps(timeElapsed);
+        for (; i + 4 <= end; i += 4)
+            _mm_storeu_ps(rotation + i, _mm_add_ps(_mm_loadu_ps(rotation + i), _mm_mul_ps(t, _mm_loadu_ps(speed + i))));
+#endif
+        for (; i < end; ++i)
+            rotation[i] += timeElapsed * speed[i];
     }
     //-----------------------------------------------------------------------
     const Radian& RotationAffector::getRotationSpeedRangeStart(void) const
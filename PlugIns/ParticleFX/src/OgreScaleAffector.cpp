@@ -29,6 +29,11 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+#include <xmmintrin.h>
+#endif
 
 
 namespace Ogre {
@@ -56,33 +61,48 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ScaleAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Real ds;
-
         // Scale adjustments by time
-        ds = mScaleAdj * timeElapsed;
+        Real ds = mScaleAdj * timeElapsed;
 
-        Real NewWide, NewHigh;
+        // Size of the particles without own dimensions after this step
+        Real defaultWide = std::max(pSystem->getDefaultWidth() + ds, Real(0));
+        Real defaultHigh = std::max(pSystem->getDefaultHeight() + ds, Real(0));
 
         for (auto p : pSystem->_getActiveParticles())
         {
             if( p->hasOwnDimensions() == false )
             {
-                NewWide = pSystem->getDefaultWidth() + ds;
-                NewHigh = pSystem->getDefaultHeight() + ds;
-
+                p->setDimensions( defaultWide, defaultHigh );
             }
             else
             {
-                NewWide = p->getOwnWidth()  + ds;
-                NewHigh = p->getOwnHeight() + ds;
+                p->setDimensions( std::max(p->getOwnWidth() + ds, Real(0)),
+                                  std::max(p->getOwnHeight() + ds, Real(0)) );
             }
-            if (NewWide < 0)
-                NewWide = 0;
-            if (NewHigh < 0)
-                NewHigh = 0;
-            p->setDimensions( NewWide, NewHigh ); 
         }
+    }
+    //-----------------------------------------------------------------------
+    void ScaleAffector::_affectParticleArrays(ParticleSystem* pSystem, Real timeElapsed,
+                                              ParticleArrays& arrays, size_t begin, size_t end)
+    {
+        // Scale adjustments by time
+        Real ds = mScaleAdj * timeElapsed;
 
+        // particles without own dimensions hold the default ones, and get their own now
+        for (auto dimension : {&arrays.width, &arrays.height})
+        {
+            Real* size = dimension->data();
+            size_t i = begin;
+#if __OGRE_HAVE_SSE && OGRE_DOUBLE_PRECISION == 0
+            __m128 adj = _mm_set1_ps(ds);
+            __m128 zero = _mm_setzero_ps();
+            for (; i + 4 <= end; i += 4)
+                _mm_storeu_ps(size + i, _mm_max_ps(zero, _mm_add_ps(_mm_loadu_ps(size + i), adj)));
+#endif
+            for (; i < end; ++i)
+                size[i] = std::max(size[i] + ds, Real(0));
+        }
+        std::fill(arrays.ownDimensions.begin() + begin, arrays.ownDimensions.begin() + end, 1);
     }
     //-----------------------------------------------------------------------
     void ScaleAffector::setAdjust( Real rate )
@@ -171,11 +171,26 @@ namespace Ogre {
     //---------------------------------------------------------------------
     Codec::DecodeResult STBIImageCodec::decode(const DataStreamPtr& input) const
     {
-        String contents = input->getAsString();
+        String contents;
+        const uchar* data;
+        size_t size;
+        if (MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(input.get()))
+        {
+            // parse in place
+            data = memStream->getCurrentPtr();
+            size = memStream->size() - memStream->tell();
+            memStream->seek(memStream->size());
+        }
+        else
+        {
+            contents = input->getAsString();
+            data = (const uchar*)contents.data();
+            size = contents.size();
+        }
 
         int width, height, components;
-        stbi_uc* pixelData = stbi_load_from_memory((const uchar*)contents.data(),
-                static_cast<int>(contents.size()), &width, &height, &components, 0);
+        stbi_uc* pixelData = stbi_load_from_memory(data,
+                static_cast<int>(size), &width, &height, &components, 0);
 
         if (!pixelData)
         {
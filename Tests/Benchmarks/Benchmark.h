@@ -0,0 +1,72 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Benchmark_H__
+#define __Benchmark_H__
+
+#include "OgreRoot.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreFileSystemLayer.h"
+
+#include <iostream>
+
+/** A throughput measurement of the Benchmark_Ogre target.
+@remarks
+    Benchmarks are kept out of the unit tests, as their timings are only
+    meaningful in an optimised build on an otherwise idle machine.
+*/
+struct Benchmark
+{
+    typedef void (*Function)();
+    Benchmark(const char* name, Function function);
+};
+
+/// Defines a benchmark and registers it with Benchmark_Ogre
+#define OGRE_BENCHMARK(name)                                                                       \
+    static void name##Benchmark();                                                                 \
+    static Benchmark name##Registration(#name, name##Benchmark);                                   \
+    static void name##Benchmark()
+
+/// Root without a RenderSystem, set up like the RootWithoutRenderSystemFixture of the unit tests
+class BenchmarkRoot
+{
+public:
+    /** Create the Root.
+    @param workQueue The WorkQueue to use, started right away. NULL for the default one.
+    @param loadResources Whether to add the resource locations of resources.cfg
+    */
+    BenchmarkRoot(Ogre::WorkQueue* workQueue = NULL, bool loadResources = false);
+    ~BenchmarkRoot();
+
+    Ogre::Root* getRoot() const { return mRoot; }
+private:
+    Ogre::FileSystemLayer* mFSLayer;
+    Ogre::Root* mRoot;
+    Ogre::HardwareBufferManager* mHBM;
+};
+
+#endif
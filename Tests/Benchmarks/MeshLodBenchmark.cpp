@@ -0,0 +1,80 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreLodConfig.h"
+#include "OgreMeshLodGenerator.h"
+#include "OgreMeshManager.h"
+#include "OgrePixelCountLodStrategy.h"
+#include "OgreTimer.h"
+#include "OgreWorkQueue.h"
+
+#include <climits>
+
+using namespace Ogre;
+
+namespace
+{
+unsigned long generateLodLevels(MeshPtr mesh)
+{
+    LodConfig config(mesh, PixelCountLodStrategy::getSingletonPtr());
+    config.createGeneratedLodLevel(10, 0.1);
+    config.createGeneratedLodLevel(9, 0.2);
+    config.createGeneratedLodLevel(8, 0.3);
+    config.advanced.useVertexNormals = true;
+
+    Timer timer;
+    MeshLodGenerator::getSingleton().generateLodLevels(config);
+    return timer.getMicroseconds();
+}
+}
+
+// Lod generation with the collapse costs computed on the calling thread only and with the work queue
+OGRE_BENCHMARK(ParallelCollapseCosts)
+{
+    BenchmarkRoot root(NULL, true);
+    MeshLodGenerator generator;
+    MeshPtr mesh = MeshManager::getSingleton().load("Sinbad.mesh", RGN_AUTODETECT);
+    WorkQueue* queue = root.getRoot()->getWorkQueue();
+
+    // best of a few runs, the first one also warms up the caches
+    const int runs = 5;
+    unsigned long serial = ULONG_MAX, parallel = ULONG_MAX;
+    for (int i = 0; i < runs; ++i)
+    {
+        // a paused queue runs parallelFor on the calling thread
+        queue->setPaused(true);
+        serial = std::min(serial, generateLodLevels(mesh));
+        queue->setPaused(false);
+        parallel = std::min(parallel, generateLodLevels(mesh));
+    }
+
+    std::cout << mesh->getName() << ": " << serial << "us serial, " << parallel << "us parallel, speedup "
+              << serial / float(std::max<unsigned long>(parallel, 1)) << std::endl;
+    mesh->unload();
+}
@@ -0,0 +1,60 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgrePixelFormat.h"
+#include "OgreTimer.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include <cstdlib>
+
+using namespace Ogre;
+
+// Throughput of the common pixel conversions on a 2048x2048 image
+OGRE_BENCHMARK(PixelConversion)
+{
+    BenchmarkRoot root(OGRE_NEW DefaultWorkQueue("Benchmark"));
+
+    const uint32 size = 2048;
+    std::vector<uint8> src(size * size * 16), dst(size * size * 16);
+    srand(0);
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = (uint8)rand();
+
+    PixelFormat formats[][2] = {{PF_FLOAT16_RGBA, PF_FLOAT32_RGBA}, {PF_FLOAT32_RGBA, PF_FLOAT16_RGBA},
+                                {PF_BYTE_RGBA, PF_FLOAT32_RGBA},    {PF_FLOAT32_RGBA, PF_BYTE_RGBA},
+                                {PF_BYTE_RGB, PF_BYTE_RGBA},        {PF_A8R8G8B8, PF_A8B8G8R8}};
+    for (auto& pair : formats)
+    {
+        Timer timer;
+        PixelUtil::bulkPixelConversion(PixelBox(size, size, 1, pair[0], src.data()),
+                                       PixelBox(size, size, 1, pair[1], dst.data()));
+        unsigned long us = std::max<unsigned long>(1, timer.getMicroseconds());
+        std::cout << PixelUtil::getFormatName(pair[0]) << "->" << PixelUtil::getFormatName(pair[1]) << ": "
+                  << size * size / float(us) << " MPixel/s" << std::endl;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreMaterialManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreStringConverter.h"
+#include "OgreTextureManager.h"
+#include "OgreTimer.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Ogre;
+
+// Throughput of name lookups of existing resources from several threads
+OGRE_BENCHMARK(ResourceLookup)
+{
+    BenchmarkRoot root;
+    DefaultTextureManager texMgr;
+    auto& matMgr = MaterialManager::getSingleton();
+    ResourceGroupManager::getSingleton().createResourceGroup("Grouped", false);
+
+    const int numResources = 1000;
+    const int numLookups = 100000;
+    StringVector matNames, texNames;
+    for (int i = 0; i < numResources; ++i)
+    {
+        matNames.push_back("Lookup/Material" + StringConverter::toString(i));
+        texNames.push_back("Lookup/Texture" + StringConverter::toString(i) + ".png");
+        matMgr.create(matNames.back(), RGN_DEFAULT);
+        texMgr.create(texNames.back(), "Grouped");
+    }
+
+    const String matGroups[] = {RGN_DEFAULT, RGN_AUTODETECT};
+    const String texGroups[] = {"Grouped", RGN_AUTODETECT};
+    for (unsigned numThreads = 1; numThreads <= std::max(4u, std::thread::hardware_concurrency());
+         numThreads *= 2)
+    {
+        std::atomic<int> found(0);
+        std::vector<std::thread> threads;
+        Timer timer;
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                int n = 0;
+                for (int i = 0; i < numLookups; ++i)
+                {
+                    int idx = (i * 7919 + t) % numResources;
+                    // alternate between lookups in the given and in all groups
+                    if (matMgr.getByName(matNames[idx], matGroups[i % 2]) &&
+                        texMgr.getByName(texNames[idx], texGroups[i % 2]))
+                        n++;
+                }
+                found += n;
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        unsigned long us = std::max<unsigned long>(1, timer.getMicroseconds());
+
+        std::cout << numThreads << " threads: " << numThreads * numLookups * 2 / float(us)
+                  << " M lookups/s" << (found == int(numThreads * numLookups) ? "" : " (lookups failed)")
+                  << std::endl;
+    }
+}
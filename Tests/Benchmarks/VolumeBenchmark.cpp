@@ -0,0 +1,169 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreSceneManager.h"
+#include "OgreTimer.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeChunk.h"
+#include "OgreVolumeGridSource.h"
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+namespace
+{
+/// Editable grid source filled with a sphere
+class SphereGridSource : public GridSource
+{
+    std::vector<float> mData;
+public:
+    SphereGridSource(size_t size) : GridSource(true, true, false)
+    {
+        mWidth = mHeight = mDepth = size;
+        mPosXScale = mPosYScale = mPosZScale = (Real)1.0;
+        mVolumeSpaceToWorldSpaceFactor = (Real)1.0;
+        mData.resize(mWidth * mHeight * mDepth);
+        float center = size / 2.0f;
+        for (size_t z = 0; z < mDepth; ++z)
+            for (size_t y = 0; y < mHeight; ++y)
+                for (size_t x = 0; x < mWidth; ++x)
+                    setVolumeGridValue(int(x), int(y), int(z),
+                                       center * 0.6f - Vector3(x - center, y - center, z - center).length());
+    }
+
+    float getVolumeGridValue(size_t x, size_t y, size_t z) const
+    {
+        x = std::min(x, mWidth - 1);
+        y = std::min(y, mHeight - 1);
+        z = std::min(z, mDepth - 1);
+        return mData[(z * mHeight + y) * mWidth + x];
+    }
+
+    void setVolumeGridValue(int x, int y, int z, float value)
+    {
+        mData[(z * mHeight + y) * mWidth + x] = value;
+    }
+};
+
+size_t countChunks(const Chunk* root, size_t levels)
+{
+    size_t count = 0;
+    for (size_t level = 0; level < levels; ++level)
+    {
+        Chunk::VecChunk chunks;
+        root->getChunksOfLevel(level, chunks);
+        count += chunks.size();
+    }
+    return count;
+}
+}
+
+// Meshing throughput of a noisy sphere with a varying amount of chunks in flight
+OGRE_BENCHMARK(VolumeLoad)
+{
+    BenchmarkRoot root;
+    SceneManager* sceneMgr = root.getRoot()->createSceneManager();
+
+    CSGSphereSource sphere((Real)20.0, Vector3((Real)32.0));
+    Real frequencies[] = {(Real)0.1};
+    Real amplitudes[] = {(Real)3.0};
+    CSGNoiseSource noise(&sphere, frequencies, amplitudes, 1, 42);
+
+    ChunkParameters parameters;
+    parameters.sceneManager = sceneMgr;
+    parameters.src = &noise;
+    parameters.baseError = (Real)1.8;
+    parameters.errorMultiplicator = (Real)0.9;
+    parameters.skirtFactor = (Real)0.7;
+
+    const size_t levels = 4;
+    const size_t budgets[] = {0, 1, 3, 8};
+    for (size_t i = 0; i < sizeof(budgets) / sizeof(budgets[0]); ++i)
+    {
+        parameters.maxChunksInFlight = budgets[i];
+        Chunk* volume = OGRE_NEW Chunk();
+        Timer timer;
+        volume->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, Vector3((Real)64.0), levels, &parameters);
+        unsigned long us = std::max<unsigned long>(1, timer.getMicroseconds());
+
+        size_t numChunks = countChunks(volume, levels);
+        std::cout << numChunks << " chunks, at most ";
+        if (budgets[i])
+            std::cout << budgets[i];
+        else
+            std::cout << "unlimited";
+        std::cout << " in flight: " << us << "us, " << numChunks * 1000000.0 / us << " chunks/s" << std::endl;
+        OGRE_DELETE volume;
+    }
+}
+
+// Cost of a local edit with and without keeping the octrees of the chunks
+OGRE_BENCHMARK(VolumeUpdateRegion)
+{
+    BenchmarkRoot root;
+    SceneManager* sceneMgr = root.getRoot()->createSceneManager();
+
+    ChunkParameters parameters;
+    parameters.sceneManager = sceneMgr;
+    parameters.baseError = (Real)0.9;
+    parameters.errorMultiplicator = (Real)0.9;
+    parameters.skirtFactor = (Real)0.7;
+
+    const size_t levels = 4;
+    const Vector3 to((Real)64.0);
+    const char* names[] = {"rebuilding the octrees", "keeping the octrees"};
+    for (int keepOctrees = 0; keepOctrees < 2; ++keepOctrees)
+    {
+        SphereGridSource source(64);
+        parameters.src = &source;
+        parameters.keepOctrees = keepOctrees != 0;
+        Chunk* volume = OGRE_NEW Chunk();
+        volume->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, to, levels, &parameters);
+
+        // carve a few holes into the surface, one region update each
+        const int numEdits = 8;
+        CSGDifferenceSource difference;
+        Real radius = (Real)4.0;
+        unsigned long us = 0;
+        for (int i = 0; i < numEdits; ++i)
+        {
+            Radian angle(Math::TWO_PI * i / numEdits);
+            Vector3 center((Real)32.0 + (Real)19.0 * Math::Cos(angle), (Real)32.0 + (Real)19.0 * Math::Sin(angle), (Real)32.0);
+            CSGSphereSource sphere(radius, center);
+            source.combineWithSource(&difference, &sphere, center, radius * (Real)1.5);
+
+            Timer timer;
+            volume->updateRegion(center - radius * (Real)1.5, center + radius * (Real)1.5);
+            us += timer.getMicroseconds();
+        }
+
+        std::cout << "region update " << names[keepOctrees] << ": " << us / numEdits << "us per edit" << std::endl;
+        OGRE_DELETE volume;
+    }
+}
@@ -0,0 +1,98 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreTimer.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Ogre;
+
+namespace
+{
+struct CountingHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+{
+    std::atomic<size_t> responses;
+
+    CountingHandler() : responses(0) {}
+
+    WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        return OGRE_NEW WorkQueue::Response(req, true, req->getData());
+    }
+
+    void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) { ++responses; }
+};
+}
+
+// Scheduling overhead of the WorkStealingWorkQueue compared with the DefaultWorkQueue
+OGRE_BENCHMARK(WorkQueueScheduling)
+{
+    const int numRequests = 20000;
+    const size_t numItems = 1 << 20;
+
+    const char* names[] = {"DefaultWorkQueue", "WorkStealingWorkQueue"};
+    for (int q = 0; q < 2; ++q)
+    {
+        WorkQueue* queue = q == 0 ? static_cast<WorkQueue*>(OGRE_NEW DefaultWorkQueue("Default"))
+                                  : OGRE_NEW WorkStealingWorkQueue("Stealing");
+        BenchmarkRoot root(queue);
+
+        CountingHandler handler;
+        uint16 channel = queue->getChannel("Benchmark");
+        queue->addRequestHandler(channel, &handler);
+        queue->addResponseHandler(channel, &handler);
+
+        Timer timer;
+        for (int i = 0; i < numRequests; ++i)
+            queue->addRequest(channel, 0, i);
+        while (handler.responses < size_t(numRequests))
+        {
+            queue->processResponses();
+            std::this_thread::yield();
+        }
+        unsigned long requestTime = std::max<unsigned long>(1, timer.getMicroseconds());
+
+        std::vector<float> data(numItems, 1.0f);
+        timer.reset();
+        queue->parallelFor(numItems, 1024, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                data[i] = Math::Sqrt(data[i] * 4.0f);
+        });
+        unsigned long forTime = std::max<unsigned long>(1, timer.getMicroseconds());
+
+        std::cout << names[q] << ": " << numRequests * 1000.0 / requestTime << " requests/ms, parallelFor "
+                  << numItems / float(forTime) << " M items/s" << std::endl;
+
+        queue->removeRequestHandler(channel, &handler);
+        queue->removeResponseHandler(channel, &handler);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreConfigFile.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreLogManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreWorkQueue.h"
+
+using namespace Ogre;
+
+namespace
+{
+typedef std::vector<std::pair<String, Benchmark::Function> > BenchmarkList;
+BenchmarkList& getBenchmarks()
+{
+    static BenchmarkList benchmarks;
+    return benchmarks;
+}
+}
+//--------------------------------------------------------------------------
+Benchmark::Benchmark(const char* name, Function function)
+{
+    getBenchmarks().push_back(std::make_pair(String(name), function));
+}
+//--------------------------------------------------------------------------
+BenchmarkRoot::BenchmarkRoot(WorkQueue* workQueue, bool loadResources)
+{
+    mFSLayer = OGRE_NEW_T(FileSystemLayer, MEMCATEGORY_GENERAL)(OGRE_VERSION_NAME);
+    mRoot = OGRE_NEW Root("", "", "", workQueue);
+    mHBM = OGRE_NEW DefaultHardwareBufferManager();
+    MaterialManager::getSingleton().initialise();
+    mRoot->getWorkQueue()->startup();
+
+    if (!loadResources)
+        return;
+
+    ConfigFile cf;
+    cf.load(mFSLayer->getConfigFilePath("resources.cfg"));
+    for (const auto& section : cf.getSettingsBySection())
+    {
+        for (const auto& setting : section.second)
+            ResourceGroupManager::getSingleton().addResourceLocation(setting.second, setting.first, section.first);
+    }
+}
+//--------------------------------------------------------------------------
+BenchmarkRoot::~BenchmarkRoot()
+{
+    OGRE_DELETE mRoot;
+    OGRE_DELETE mHBM;
+    OGRE_DELETE_T(mFSLayer, FileSystemLayer, MEMCATEGORY_GENERAL);
+}
+//--------------------------------------------------------------------------
+// Runs all benchmarks, or those whose name contains one of the arguments
+int main(int argc, char** argv)
+{
+    // keep the log out of the results
+    LogManager logMgr;
+    logMgr.createLog("Benchmark_Ogre.log", true, false, true);
+
+    for (const auto& benchmark : getBenchmarks())
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i)
+            selected = selected || benchmark.first.find(argv[i]) != String::npos;
+        if (!selected)
+            continue;
+
+        std::cout << "[ BENCHMARK ] " << benchmark.first << std::endl;
+        benchmark.second();
+    }
+
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include "OgreMeshLodGenerator.h"
 #include "OgrePixelCountLodStrategy.h"
 #include "OgreLodCollapseCostQuadric.h"
+#include "OgreLodCollapseCostCurvature.h"
 #include "OgreRenderWindow.h"
 #include "OgreLodConfigSerializer.h"
 #include "OgreWorkQueue.h"
@@ -188,6 +189,110 @@ TEST_F(MeshLodTests,QuadricError)
     gen.generateLodLevels(config, LodCollapseCostPtr(new LodCollapseCostQuadric()));
 }
 //--------------------------------------------------------------------------
+TEST(LodCollapseCostHeap, MatchesMultimap)
+{
+    // The heap must hand out the vertices in the same order as a multimap of the costs.
+    typedef std::multimap<Real, LodData::Vertex*> ReferenceHeap;
+    std::vector<LodData::Vertex> vertices(500);
+    std::vector<ReferenceHeap::iterator> positions(vertices.size());
+    LodData::CollapseCostHeap heap;
+    ReferenceHeap reference;
+    srand(42);
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        Real cost = Real(rand() % 50); // many equal costs
+        heap.push(&vertices[i], cost);
+        positions[i] = reference.emplace(cost, &vertices[i]);
+    }
+    for (size_t i = 0; i < vertices.size(); i += 3)
+    {
+        Real cost = Real(rand() % 50);
+        heap.update(&vertices[i], cost);
+        reference.erase(positions[i]);
+        positions[i] = reference.emplace(cost, &vertices[i]);
+    }
+    for (size_t i = 1; i < vertices.size(); i += 7)
+    {
+        heap.erase(&vertices[i]);
+        reference.erase(positions[i]);
+        EXPECT_EQ(heap.getCost(&vertices[i]), LodData::UNINITIALIZED_COLLAPSE_COST);
+    }
+    ASSERT_EQ(heap.size(), reference.size());
+    while (!heap.empty())
+    {
+        EXPECT_EQ(heap.topCost(), reference.begin()->first);
+        ASSERT_EQ(heap.top(), reference.begin()->second);
+        heap.erase(heap.top());
+        reference.erase(reference.begin());
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshLodTests,ParallelCollapseCosts)
+{
+    // The work queue of Root only runs once a window was created, so the first
+    // run computes the collapse costs on this thread only.
+    MeshLodGenerator& gen = MeshLodGenerator::getSingleton();
+    LodConfig config;
+    setTestLodConfig(config);
+    config.advanced.useCompression = false;
+    gen.generateLodLevels(config);
+
+    LodConfig config2;
+    setTestLodConfig(config2);
+    config2.advanced.useCompression = false;
+    mRoot->getWorkQueue()->startup();
+    gen.generateLodLevels(config2);
+
+    ASSERT_EQ(config.levels.size(), config2.levels.size());
+    for (size_t i = 0; i < config.levels.size(); i++)
+    {
+        EXPECT_EQ(config.levels[i].outSkipped, config2.levels[i].outSkipped);
+        EXPECT_EQ(config.levels[i].outUniqueVertexCount, config2.levels[i].outUniqueVertexCount);
+    }
+}
+//--------------------------------------------------------------------------
+namespace
+{
+struct CountingCollapseCost : public LodCollapseCostCurvature
+{
+    size_t usedVertices;
+    size_t initCalls;
+    CountingCollapseCost() : usedVertices(0), initCalls(0) {}
+    void initCollapseCosts(LodData* data)
+    {
+        for (size_t i = 0; i < data->mVertexList.size(); i++)
+            usedVertices += !data->mVertexList[i].edges.empty();
+        LodCollapseCostCurvature::initCollapseCosts(data);
+    }
+    void initVertexCollapseCost(LodData* data, LodData::Vertex* vertex)
+    {
+        ++initCalls;
+        LodCollapseCostCurvature::initVertexCollapseCost(data, vertex);
+    }
+};
+}
+TEST_F(MeshLodTests,InitVertexCollapseCostOverride)
+{
+    // the parallel cost computation still goes through the per vertex hook
+    mRoot->getWorkQueue()->startup();
+    MeshLodGenerator& gen = MeshLodGenerator::getSingleton();
+    LodConfig config, reference;
+    setTestLodConfig(config);
+    setTestLodConfig(reference);
+    config.advanced.useCompression = reference.advanced.useCompression = false;
+    config.advanced.outsideWeight = reference.advanced.outsideWeight = 0;
+
+    CountingCollapseCost* cost = new CountingCollapseCost;
+    gen.generateLodLevels(config, LodCollapseCostPtr(cost));
+    EXPECT_GT(cost->initCalls, 0u);
+    EXPECT_EQ(cost->initCalls, cost->usedVertices);
+
+    gen.generateLodLevels(reference);
+    ASSERT_EQ(config.levels.size(), reference.levels.size());
+    for (size_t i = 0; i < config.levels.size(); i++)
+        EXPECT_EQ(config.levels[i].outUniqueVertexCount, reference.levels[i].outUniqueVertexCount);
+}
+//--------------------------------------------------------------------------
 void MeshLodTests::setTestLodConfig(LodConfig& config)
 {
     config.mesh = mMesh;
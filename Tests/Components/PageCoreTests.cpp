@@ -37,6 +37,10 @@ THE SOFTWARE.
 #include "OgreStaticPluginLoader.h"
 #include "OgrePaging.h"
 #include "OgreLogManager.h"
+#include "OgreCamera.h"
+#include "OgreSceneNode.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMaterialManager.h"
 
 using namespace Ogre;
 
@@ -117,3 +121,132 @@ TEST_F(PageCoreTests,SimpleCreateSaveLoadWorld)
 }
 //--------------------------------------------------------------------------
 
+TEST_F(PageCoreTests, PageCache)
+{
+    PageCache cache(4096);
+
+    // compressible data survives the round trip and takes less space
+    std::vector<uchar> data(3000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = uchar((i % 97) ^ (i / 500));
+    cache.add("a", "Group", data.data(), data.size());
+    EXPECT_EQ(1u, cache.getEntryCount());
+    EXPECT_LT(cache.getSize(), data.size());
+
+    DataStreamPtr stream = cache.get("a", "Group");
+    ASSERT_TRUE(stream);
+    ASSERT_EQ(data.size(), stream->size());
+    std::vector<uchar> read(data.size());
+    stream->read(read.data(), read.size());
+    EXPECT_EQ(data, read);
+    // the same file in another group is another page
+    EXPECT_FALSE(cache.get("a", "OtherGroup"));
+
+    // random data needs more room, the least recently used page goes first
+    std::vector<uchar> noise(1500);
+    for (size_t i = 0; i < noise.size(); ++i)
+        noise[i] = uchar(Math::UnitRandom() * 255);
+    cache.add("b", "Group", noise.data(), noise.size());
+    cache.add("c", "Group", noise.data(), noise.size());
+    EXPECT_TRUE(cache.get("b", "Group"));
+    cache.add("d", "Group", noise.data(), noise.size());
+    EXPECT_FALSE(cache.get("a", "Group"));
+    EXPECT_FALSE(cache.get("c", "Group"));
+    EXPECT_TRUE(cache.get("b", "Group"));
+    EXPECT_TRUE(cache.get("d", "Group"));
+    EXPECT_LE(cache.getSize(), cache.getBudget());
+
+    cache.remove("b", "Group");
+    EXPECT_FALSE(cache.get("b", "Group"));
+    cache.setBudget(0);
+    EXPECT_EQ(0u, cache.getEntryCount());
+    EXPECT_EQ(0u, cache.getSize());
+}
+//--------------------------------------------------------------------------
+TEST_F(PageCoreTests, ReloadPageFromCache)
+{
+    mPageManager->getPageCache().setBudget(1024 * 1024);
+
+    // keep the page file out of the working directory
+    String pagePath = mFSLayer->getWritablePath("PageCache/");
+    FileSystemLayer::createDirectory(pagePath);
+    ResourceGroupManager::getSingleton().addResourceLocation(pagePath, "FileSystem", "PageCache", false, false);
+    mPageManager->setPageResourceGroup("PageCache");
+
+    PagedWorld* world = mPageManager->createWorld("CachedWorld");
+    PagedWorldSection* section = world->createSection("Grid2D", mSceneMgr, "Section");
+    Page* p = section->loadOrCreatePage(Vector3::ZERO);
+    PageID id = p->getID();
+    p->createContentCollection("Simple");
+    p->save();
+
+    // reading the file doesn't cache it yet, unloading the page does
+    section->unloadPage(id);
+    section->loadPage(id, true);
+    EXPECT_EQ(0u, mPageManager->getPageCache().getEntryCount());
+    section->unloadPage(id);
+    EXPECT_TRUE(mPageManager->getPageCache().contains("CachedWorld_Section00000000.page", "PageCache"));
+
+    // the reload after the file is gone comes from the cache
+    FileSystemLayer::removeFile(pagePath + "CachedWorld_Section00000000.page");
+    section->loadPage(id, true);
+    ASSERT_TRUE(section->getPage(id));
+    EXPECT_EQ(1u, section->getPage(id)->getContentCollectionCount());
+
+    mPageManager->destroyWorld(world);
+    FileSystemLayer::removeDirectory(pagePath);
+}
+//--------------------------------------------------------------------------
+TEST_F(PageCoreTests, PrefetchAlongCameraPath)
+{
+    PagedWorld* world = mPageManager->createWorld("PrefetchWorld");
+    PagedWorldSection* section = world->createSection("Grid2D", mSceneMgr, "Section");
+    Grid2DPageStrategyData* data = static_cast<Grid2DPageStrategyData*>(section->getStrategyData());
+    data->setCellSize(100);
+    data->setLoadRadius(100);
+    data->setHoldRadius(200);
+    data->setPrefetchTime(1);
+
+    // cameras need a buffer manager and the default material, there is no render system
+    DefaultHardwareBufferManager* bufferMgr = OGRE_NEW DefaultHardwareBufferManager();
+    MaterialManager::getSingleton().initialise();
+    Camera* cam = mSceneMgr->createCamera("PrefetchCam");
+    SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    node->attachObject(cam);
+    // a second view which stays still, far away from the first one
+    Camera* staticCam = mSceneMgr->createCamera("StaticCam");
+    mSceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 2000))->attachObject(staticCam);
+
+    // fly along +X at 1000 units per second, ten cells ahead after the prefetch time
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        node->setPosition(frame * 100.0f, 0, 0);
+        section->frameStart(0.1f);
+        section->getStrategy()->notifyCamera(cam, section);
+        section->getStrategy()->notifyCamera(staticCam, section);
+    }
+    EXPECT_NEAR(1000, data->getCameraVelocity(cam).x, 100);
+    EXPECT_EQ(Vector3::ZERO, data->getCameraVelocity(staticCam));
+    EXPECT_TRUE(section->getPage(data->calculatePageID(12, 0)));
+    // nothing is prefetched behind the camera
+    EXPECT_FALSE(section->getPage(data->calculatePageID(-3, 0)));
+
+    // after stopping, pages prefetched outside the hold range stay for the prefetch time
+    for (int frame = 0; frame < 15; ++frame)
+    {
+        section->frameStart(0.1f);
+        section->getStrategy()->notifyCamera(cam, section);
+        mRoot->_fireFrameRenderingQueued();
+        section->frameEnd(0.1f);
+        if (frame == 7)
+            EXPECT_TRUE(section->getPage(data->calculatePageID(12, 0)));
+    }
+    EXPECT_FALSE(section->getPage(data->calculatePageID(12, 0)));
+    EXPECT_TRUE(section->getPage(data->calculatePageID(7, 0)));
+
+    mPageManager->destroyWorld(world);
+    mSceneMgr->destroyCamera(cam);
+    mSceneMgr->destroyCamera(staticCam);
+    OGRE_DELETE bufferMgr;
+}
+//--------------------------------------------------------------------------
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "RootWithoutRenderSystemFixture.h"
 #include "OgreShaderGenerator.h"
 #include "OgreShaderProgramManager.h"
+#include "OgreShaderProgram.h"
 
 #include "OgreShaderFFPTransform.h"
 #include "OgreShaderFFPColour.h"
@@ -95,6 +96,44 @@ TEST_F(RTShaderSystem, MaterialSerializer)
     EXPECT_TRUE(ser.getQueuedAsString().find("colour_stage") != String::npos);
 }
 
+TEST_F(RTShaderSystem, ShaderCache)
+{
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+    FileSystemLayer fsLayer("RTShaderSystemTests");
+    String cachePath = fsLayer.getWritablePath("RTShaderCache/");
+    FileSystemLayer::createDirectory(cachePath);
+    shaderGen.setShaderCachePath(cachePath);
+
+    // generated sources are written to the cache path
+    auto mat = MaterialManager::getSingleton().create("TestMat", RGN_DEFAULT);
+    shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme");
+    shaderGen.validateMaterial("MyScheme", mat->getName(), mat->getGroup());
+    auto vs = mat->getTechniques()[1]->getPasses()[0]->getVertexProgram();
+    EXPECT_TRUE(FileSystemLayer::fileExists(cachePath + vs->getName() + ".glsl"));
+
+    // compiled programs are kept across runs
+    auto microcode = gpuProgMgr->createMicrocode(4);
+    microcode->write("code", 4);
+    gpuProgMgr->addMicrocodeToCache(42, microcode);
+    shaderGen.saveShaderCache();
+    EXPECT_TRUE(FileSystemLayer::fileExists(cachePath + "RTShaderMicrocode.cache"));
+
+    // and merged with the programs already in the cache
+    gpuProgMgr->removeMicrocodeFromCache(42);
+    gpuProgMgr->addMicrocodeToCache(43, gpuProgMgr->createMicrocode(2));
+    shaderGen.setShaderCachePath("");
+    shaderGen.setShaderCachePath(cachePath);
+    ASSERT_TRUE(gpuProgMgr->isMicrocodeAvailableInCache(42));
+    EXPECT_EQ(4u, gpuProgMgr->getMicrocodeFromCache(42)->size());
+    EXPECT_TRUE(gpuProgMgr->isMicrocodeAvailableInCache(43));
+
+    FileSystemLayer::removeFile(cachePath + "RTShaderMicrocode.cache");
+    FileSystemLayer::removeFile(cachePath + "RTShaderIndex.cache");
+    FileSystemLayer::removeFile(cachePath + vs->getName() + ".glsl");
+    FileSystemLayer::removeFile(cachePath + mat->getTechniques()[1]->getPasses()[0]->getFragmentProgram()->getName() + ".glsl");
+    shaderGen.setShaderCachePath("");
+}
+
 TEST_F(RTShaderSystem, TargetRenderState)
 {
     auto mat = MaterialManager::getSingleton().create("TestMat", RGN_DEFAULT);
@@ -113,6 +152,125 @@ TEST_F(RTShaderSystem, TargetRenderState)
     EXPECT_TRUE(pass->hasGpuProgram(GPT_FRAGMENT_PROGRAM));
 }
 
+TEST_F(RTShaderSystem, ParallelValidation)
+{
+    mRoot->getWorkQueue()->startup();
+
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+
+    std::vector<MaterialPtr> mats;
+    for (int i = 0; i < 32; ++i)
+    {
+        auto mat = MaterialManager::getSingleton().create(StringUtil::format("TestMat%d", i), RGN_DEFAULT);
+        auto pass = mat->getTechniques()[0]->getPasses()[0];
+        pass->setLightingEnabled(i % 2);
+        pass->setVertexColourTracking(i % 3 ? TVC_NONE : TVC_DIFFUSE);
+        pass->setSpecular(ColourValue(i % 4 ? 0.0f : 1.0f, 0, 0));
+        pass->setAlphaRejectFunction(i % 5 ? CMPF_ALWAYS_PASS : CMPF_GREATER);
+        pass->setFog(i % 7 == 0, FOG_LINEAR);
+
+        EXPECT_TRUE(shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
+        mats.push_back(mat);
+    }
+
+    auto getPrograms = [&mats]() {
+        StringVector programs;
+        for (auto& mat : mats)
+        {
+            auto pass = mat->getTechniques()[1]->getPasses()[0];
+            for (auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+            {
+                programs.push_back(pass->getGpuProgram(type)->getName());
+                programs.push_back(pass->getGpuProgram(type)->getSource());
+            }
+        }
+        return programs;
+    };
+
+    shaderGen.validateScheme("MyScheme");
+    StringVector sequential = getPrograms();
+
+    shaderGen.invalidateScheme("MyScheme");
+    shaderGen.setParallelValidationEnabled(true);
+    shaderGen.validateScheme("MyScheme");
+
+    EXPECT_EQ(sequential, getPrograms());
+}
+
+TEST_F(RTShaderSystem, ProgramIndex)
+{
+    using namespace RTShader;
+    auto& shaderGen = ShaderGenerator::getSingleton();
+    auto& progMgr = ProgramManager::getSingleton();
+
+    struct IndexedRenderState : public TargetRenderState
+    {
+        explicit IndexedRenderState(unsigned int colourStages)
+        {
+            auto& shaderGen = ShaderGenerator::getSingleton();
+            addSubRenderStateInstance(shaderGen.createSubRenderState<FFPTransform>());
+            auto colour = shaderGen.createSubRenderState<FFPColour>();
+            colour->setResolveStageFlags(colourStages);
+            addSubRenderStateInstance(colour);
+        }
+        Program* getCpuProgram(GpuProgramType type) { return getProgramSet()->getCpuProgram(type); }
+        // function invocations are only added when the programs are generated
+        bool generated() { return !getCpuProgram(GPT_FRAGMENT_PROGRAM)->getEntryPointFunction()->getAtomInstances().empty(); }
+    };
+
+    std::vector<Pass*> passes;
+    for (int i = 0; i < 4; ++i)
+        passes.push_back(MaterialManager::getSingleton()
+                             .create(StringUtil::format("TestMat%d", i), RGN_DEFAULT)
+                             ->getTechniques()[0]
+                             ->getPasses()[0]);
+
+    IndexedRenderState first(0);
+    first.acquirePrograms(passes[0]);
+    EXPECT_TRUE(first.generated());
+    EXPECT_EQ(1u, progMgr.getProgramIndexSize());
+
+    // an equal render state skips generation and gets the same programs
+    IndexedRenderState second(0);
+    second.acquirePrograms(passes[1]);
+    EXPECT_FALSE(second.generated());
+    EXPECT_EQ(passes[0]->getVertexProgram(), passes[1]->getVertexProgram());
+    EXPECT_EQ(passes[0]->getFragmentProgram(), passes[1]->getFragmentProgram());
+    // with the parameters only resolved while adding the invocations
+    EXPECT_TRUE(second.getCpuProgram(GPT_VERTEX_PROGRAM)->getParameterByAutoType(GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX));
+
+    // a different one does not
+    IndexedRenderState other(FFPColour::SF_VS_INPUT_DIFFUSE);
+    other.acquirePrograms(passes[2]);
+    EXPECT_TRUE(other.generated());
+    EXPECT_EQ(2u, progMgr.getProgramIndexSize());
+    EXPECT_NE(passes[0]->getVertexProgram(), passes[2]->getVertexProgram());
+
+    // the index is kept in the shader cache path across runs
+    FileSystemLayer fsLayer("RTShaderSystemTests");
+    String cachePath = fsLayer.getWritablePath("RTShaderCache/");
+    FileSystemLayer::createDirectory(cachePath);
+    shaderGen.setShaderCachePath(cachePath);
+    shaderGen.saveShaderCache();
+    EXPECT_TRUE(FileSystemLayer::fileExists(cachePath + "RTShaderIndex.cache"));
+
+    progMgr.clearProgramIndex();
+    shaderGen.setShaderCachePath("");
+    shaderGen.setShaderCachePath(cachePath);
+    EXPECT_EQ(2u, progMgr.getProgramIndexSize());
+
+    IndexedRenderState reloaded(0);
+    reloaded.acquirePrograms(passes[3]);
+    EXPECT_FALSE(reloaded.generated());
+    EXPECT_EQ(passes[0]->getVertexProgram()->getName(), passes[3]->getVertexProgram()->getName());
+    EXPECT_EQ(passes[0]->getFragmentProgram()->getName(), passes[3]->getFragmentProgram()->getName());
+
+    FileSystemLayer::removeFile(cachePath + "RTShaderIndex.cache");
+    FileSystemLayer::removeFile(cachePath + passes[3]->getVertexProgram()->getName() + ".glsl");
+    FileSystemLayer::removeFile(cachePath + passes[3]->getFragmentProgram()->getName() + ".glsl");
+    shaderGen.setShaderCachePath("");
+}
+
 TEST_F(RTShaderSystem, FunctionInvocationOrder)
 {
     using namespace RTShader;
@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "OgreRoot.h"
 #include "OgreTerrain.h"
+#include "OgreTerrainGroup.h"
 #include "OgreFileSystemLayer.h"
 
 #include "OgreBuildSettings.h"
@@ -122,3 +123,334 @@ TEST_F(TerrainTests, create)
     OGRE_DELETE t;
 }
 //--------------------------------------------------------------------------
+// the X_Y aligned point used for the height deltas
+static Vector3 getPointXY(const Terrain* t, long x, long y)
+{
+    Vector3 p;
+    t->getPoint(x, y, &p);
+    switch (t->getAlignment())
+    {
+    case Terrain::ALIGN_X_Z:
+        return Vector3(p.x, -p.z, p.y);
+    case Terrain::ALIGN_Y_Z:
+        return Vector3(-p.z, p.y, p.x);
+    default:
+        return p;
+    }
+}
+//--------------------------------------------------------------------------
+// the height deltas of the whole terrain, as computed one vertex at a time before
+static std::vector<float> calculateHeightDeltasPerVertex(const Terrain* t)
+{
+    long size = t->getSize();
+    std::vector<float> deltas(size * size, 0.0f);
+    for (int targetLevel = 1; targetLevel < t->getNumLodLevels(); ++targetLevel)
+    {
+        long step = 1L << targetLevel;
+        long right = size + (size % step ? step - size % step : 0);
+        for (long j = 0; j < right - step; j += step)
+        {
+            for (long i = 0; i < right - step; i += step)
+            {
+                Vector3 v0 = getPointXY(t, i, j), v1 = getPointXY(t, i + step, j);
+                Vector3 v2 = getPointXY(t, i, j + step), v3 = getPointXY(t, i + step, j + step);
+                bool backwardTri = (j / step) % 2 != 0;
+                Vector4 t1 = backwardTri ? Math::calculateFaceNormalWithoutNormalize(v1, v3, v2)
+                                         : Math::calculateFaceNormalWithoutNormalize(v0, v1, v3);
+                Vector4 t2 = backwardTri ? Math::calculateFaceNormalWithoutNormalize(v0, v1, v2)
+                                         : Math::calculateFaceNormalWithoutNormalize(v0, v3, v2);
+
+                long yubound = (j == size - step ? step : step - 1);
+                long xubound = (i == size - step ? step : step - 1);
+                for (long y = 0; y <= yubound; y++)
+                {
+                    for (long x = 0; x <= xubound; x++)
+                    {
+                        long fx = i + x, fy = j + y;
+                        if (fx % step == 0 && fy % step == 0)
+                            continue;
+
+                        Real ypct = (Real)y / (Real)step;
+                        Real xpct = (Real)x / (Real)step;
+                        Vector3 actualPos = getPointXY(t, fx, fy);
+                        const Vector4& tri = ((xpct > ypct && !backwardTri) || (xpct > (1 - ypct) && backwardTri)) ? t1 : t2;
+                        Real interp_h = (-tri.x * actualPos.x - tri.y * actualPos.y - tri.w) / tri.z;
+
+                        long halfStep = step / 2;
+                        if (((fx % step) == halfStep && (fy % halfStep) == 0) ||
+                            ((fy % step) == halfStep && (fx % halfStep) == 0))
+                            deltas[fx + fy * size] = interp_h - actualPos.z;
+                    }
+                }
+            }
+        }
+    }
+    return deltas;
+}
+//--------------------------------------------------------------------------
+// the normals of a terrain without neighbours, as computed one vertex at a time before
+static std::vector<uchar> calculateNormalsPerVertex(const Terrain* t)
+{
+    static const int offsetX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    static const int offsetY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    long size = t->getSize();
+    std::vector<uchar> normals(size * size * 3);
+    for (long y = 0; y < size; ++y)
+    {
+        for (long x = 0; x < size; ++x)
+        {
+            Vector3 centre, adjacent[8];
+            t->getPoint(x, y, &centre);
+            for (int i = 0; i < 8; ++i)
+            {
+                t->getPoint(Math::Clamp<long>(x + offsetX[i], 0, size - 1),
+                            Math::Clamp<long>(y + offsetY[i], 0, size - 1), &adjacent[i]);
+            }
+            Vector3 normal = Vector3::ZERO;
+            for (int i = 0; i < 8; ++i)
+                normal += Math::calculateBasicFaceNormal(centre, adjacent[i], adjacent[(i + 1) % 8]);
+            normal.normalise();
+
+            uchar* store = &normals[((size - y - 1) * size + x) * 3];
+            store[0] = static_cast<uint8>((normal.x + 1.0f) * 0.5f * 255.0f);
+            store[1] = static_cast<uint8>((normal.y + 1.0f) * 0.5f * 255.0f);
+            store[2] = static_cast<uint8>((normal.z + 1.0f) * 0.5f * 255.0f);
+        }
+    }
+    return normals;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, DerivedData)
+{
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 513;
+    imp.worldSize = 1000;
+    imp.inputScale = 200;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+
+    Rect full(0, 0, imp.terrainSize, imp.terrainSize);
+    std::vector<float> deltas[2];
+    std::vector<uchar> normals[2], lightmaps[2];
+    for (int run = 0; run < 2; ++run)
+    {
+        // the second run computes the same data on the WorkQueue threads
+        if (run == 1)
+            mRoot->getWorkQueue()->startup();
+
+        Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+        ASSERT_TRUE(t->prepare(imp));
+
+        t->calculateHeightDeltas(full);
+        deltas[run].assign(t->getDeltaData(), t->getDeltaData() + imp.terrainSize * imp.terrainSize);
+
+        Rect normalRect, lightmapRect;
+        PixelBox* normalBox = t->calculateNormals(full, normalRect);
+        normals[run].assign(normalBox->data, normalBox->data + normalBox->getConsecutiveSize());
+        PixelBox* lightmapBox = t->calculateLightmap(full, Rect(), lightmapRect);
+        lightmaps[run].assign(lightmapBox->data, lightmapBox->data + lightmapBox->getConsecutiveSize());
+
+        if (run == 0)
+        {
+            // interior normals are unit length and face up
+            for (uint32 y = 1; y < normalBox->getHeight() - 1; ++y)
+            {
+                for (uint32 x = 1; x < normalBox->getWidth() - 1; ++x)
+                {
+                    ColourValue c = normalBox->getColourAt(x, y, 0);
+                    Vector3 n(c.r * 2 - 1, c.g * 2 - 1, c.b * 2 - 1);
+                    EXPECT_NEAR(n.length(), 1, 0.02);
+                    EXPECT_GT(n.y, 0);
+                }
+            }
+
+            // the shadows match casting each ray on its own, away from the borders
+            // where the quad walk of rayIntersects can leave the terrain early
+            const Vector3& lightVec = TerrainGlobalOptions::getSingleton().getLightMapDirection();
+            Real heightPad = (t->getMaxHeight() - t->getMinHeight()) * 1.0e-3f;
+            uint32 size = lightmapBox->getWidth();
+            int mismatches = 0, samples = 0;
+            for (uint32 y = 1; y < size - 1; y += 3)
+            {
+                for (uint32 x = 1; x < size - 1; x += 3)
+                {
+                    float tx = (float)x / (float)(size - 1);
+                    float ty = (float)y / (float)(size - 1);
+                    Vector3 wpos;
+                    t->getPosition(tx, ty, t->getHeightAtTerrainPosition(tx, ty) + heightPad, &wpos);
+                    bool shadowed = t->rayIntersects(Ray(wpos, -lightVec)).first;
+                    // the lightmap rows are stored top down
+                    bool lit = lightmapBox->data[(size - 1 - y) * size + x] != 0;
+                    mismatches += shadowed == lit ? 1 : 0;
+                    ++samples;
+                }
+            }
+            EXPECT_LE(mismatches, samples / 1000);
+        }
+
+        OGRE_FREE(normalBox->data, MEMCATEGORY_GENERAL);
+        OGRE_DELETE normalBox;
+        OGRE_FREE(lightmapBox->data, MEMCATEGORY_GENERAL);
+        OGRE_DELETE lightmapBox;
+        OGRE_DELETE t;
+    }
+
+    EXPECT_EQ(deltas[0], deltas[1]);
+    EXPECT_EQ(normals[0], normals[1]);
+    EXPECT_EQ(lightmaps[0], lightmaps[1]);
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, DerivedDataMatchesPerVertex)
+{
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 513;
+    imp.worldSize = 1000;
+    imp.inputScale = 200;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+
+    const Terrain::Alignment alignments[] = {Terrain::ALIGN_X_Z, Terrain::ALIGN_X_Y, Terrain::ALIGN_Y_Z};
+    for (auto align : alignments)
+    {
+        imp.terrainAlign = align;
+        Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+        ASSERT_TRUE(t->prepare(imp));
+
+        Rect full(0, 0, imp.terrainSize, imp.terrainSize);
+        t->calculateHeightDeltas(full);
+        std::vector<float> expectedDeltas = calculateHeightDeltasPerVertex(t);
+        EXPECT_TRUE(std::equal(expectedDeltas.begin(), expectedDeltas.end(), t->getDeltaData()));
+
+        Rect normalRect;
+        PixelBox* normalBox = t->calculateNormals(full, normalRect);
+        std::vector<uchar> expectedNormals = calculateNormalsPerVertex(t);
+        EXPECT_TRUE(std::equal(expectedNormals.begin(), expectedNormals.end(), normalBox->data));
+
+        OGRE_FREE(normalBox->data, MEMCATEGORY_GENERAL);
+        OGRE_DELETE normalBox;
+        OGRE_DELETE t;
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, RayIntersects)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 513;
+    imp.worldSize = 1000;
+    imp.inputScale = 200;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+    ASSERT_TRUE(t->prepare(imp));
+
+    // rays coming down steeply and grazing rays both end on the surface
+    Real top = t->getMaxHeight() + 10;
+    Vector3 directions[] = {Vector3(0.1, -1, 0.2), Vector3(1, -0.05, 0.3), Vector3(-0.4, -0.02, -1)};
+    for (int i = 0; i < 100; ++i)
+    {
+        Vector3 origin(Math::RangeRandom(-450, 450), top, Math::RangeRandom(-450, 450));
+        Ray ray(origin, directions[i % 3].normalisedCopy());
+        std::pair<bool, Vector3> hit = t->rayIntersects(ray);
+        if (!hit.first)
+            continue;
+        EXPECT_NEAR(t->getHeightAtWorldPosition(hit.second), hit.second.y, 0.5);
+    }
+
+    // edits are picked up once the area is marked dirty: raise a low vertex close to
+    // the top and graze it with a ray that passed above everything around it before
+    long px = 16, pz = 16;
+    for (long z = 16; z < 500; z += 16)
+        for (long x = 16; x < 500; x += 16)
+            if (t->getHeightAtPoint(x, z) < t->getHeightAtPoint(px, pz))
+                px = x, pz = z;
+    float height = t->getMaxHeight() - 0.1f;
+    ASSERT_GT(height - t->getHeightAtPoint(px, pz), 10);
+    *t->getHeightData(px, pz) = height;
+    t->dirtyRect(Rect(px, pz, px + 1, pz + 1));
+
+    Vector3 start, point;
+    t->getPoint(px - 3, pz, height - 1, &start);
+    t->getPoint(px, pz, height - 1, &point);
+    std::pair<bool, Vector3> hit = t->rayIntersects(Ray(start, (point - start).normalisedCopy()));
+    ASSERT_TRUE(hit.first);
+    EXPECT_LT(hit.second.distance(point), t->getWorldSize() / (t->getSize() - 1));
+
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+// places terrains which were only prepared, as loading them would require GPU access
+class PreparedTerrainGroup : public TerrainGroup
+{
+public:
+    PreparedTerrainGroup(SceneManager* sm) : TerrainGroup(sm, Terrain::ALIGN_X_Z, 129, 1000) {}
+
+    void addPreparedTerrain(long x, long y, Terrain* t)
+    {
+        t->setPosition(getTerrainSlotPosition(x, y));
+        getTerrainSlot(x, y, true)->instance = t;
+    }
+};
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, GroupRayIntersectsBatch)
+{
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    img.resize(129, 129);
+
+    PreparedTerrainGroup group(mSceneMgr);
+    for (long y = 0; y < 2; ++y)
+    {
+        for (long x = 0; x < 2; ++x)
+        {
+            Terrain::ImportData imp;
+            imp.inputImage = &img;
+            imp.terrainSize = 129;
+            imp.worldSize = 1000;
+            imp.inputScale = 200;
+            imp.minBatchSize = 33;
+            imp.maxBatchSize = 65;
+            Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+            ASSERT_TRUE(t->prepare(imp));
+            group.addPreparedTerrain(x, y, t);
+        }
+    }
+
+    // enough rays for several work queue tasks, many of them crossing from one terrain to the next
+    Vector3 directions[] = {Vector3(0.1, -1, 0.2), Vector3(1, -0.05, -0.3), Vector3(-0.4, -0.02, -1),
+                            Vector3(0.7, -0.1, -0.7)};
+    std::vector<Ray> rays;
+    for (int i = 0; i < 400; ++i)
+    {
+        Vector3 origin(Math::RangeRandom(-500, 1500), 250, Math::RangeRandom(-1500, 500));
+        rays.push_back(Ray(origin, directions[i % 4].normalisedCopy()));
+    }
+
+    TerrainGroup::RayResultList results;
+    group.rayIntersects(rays, results);
+    ASSERT_EQ(rays.size(), results.size());
+
+    std::set<Terrain*> terrainsHit;
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+        TerrainGroup::RayResult expected = group.rayIntersects(rays[i]);
+        EXPECT_EQ(expected.hit, results[i].hit);
+        EXPECT_EQ(expected.terrain, results[i].terrain);
+        EXPECT_EQ(expected.position, results[i].position);
+        if (results[i].hit)
+            terrainsHit.insert(results[i].terrain);
+    }
+    EXPECT_EQ(4u, terrainsHit.size());
+}
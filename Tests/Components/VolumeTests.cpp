@@ -0,0 +1,327 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeGridSource.h"
+#include "OgreVolumeChunk.h"
+#include "OgreSceneManager.h"
+#include "OgreWorkQueue.h"
+#include "OgreEntity.h"
+#include "OgreMesh.h"
+#include "OgreSubMesh.h"
+#include "OgreHardwareBufferManager.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <algorithm>
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+namespace
+{
+/// Grid source filled with a sphere, for comparing the batched and the single evaluation.
+class SphereGridSource : public GridSource
+{
+    std::vector<float> mData;
+public:
+    SphereGridSource(bool trilinear, size_t size = 16) : GridSource(trilinear, trilinear, false)
+    {
+        mWidth = mHeight = mDepth = size;
+        mPosXScale = mPosYScale = mPosZScale = (Real)1.0;
+        mVolumeSpaceToWorldSpaceFactor = (Real)1.0;
+        mData.resize(mWidth * mHeight * mDepth);
+        float center = size / 2.0f;
+        for (size_t z = 0; z < mDepth; ++z)
+            for (size_t y = 0; y < mHeight; ++y)
+                for (size_t x = 0; x < mWidth; ++x)
+                    setVolumeGridValue(int(x), int(y), int(z),
+                                       center * 0.6f - Vector3(x - center, y - center, z - center).length());
+    }
+
+    float getVolumeGridValue(size_t x, size_t y, size_t z) const
+    {
+        x = std::min(x, mWidth - 1);
+        y = std::min(y, mHeight - 1);
+        z = std::min(z, mDepth - 1);
+        return mData[(z * mHeight + y) * mWidth + x];
+    }
+
+    void setVolumeGridValue(int x, int y, int z, float value)
+    {
+        mData[(z * mHeight + y) * mWidth + x] = value;
+    }
+};
+
+void createPositions(size_t count, Real extent, std::vector<Real>& x, std::vector<Real>& y, std::vector<Real>& z)
+{
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = Math::RangeRandom(1, extent);
+        y[i] = Math::RangeRandom(1, extent);
+        z[i] = Math::RangeRandom(1, extent);
+    }
+}
+
+void expectBatchMatches(const Source& src, size_t count, Real extent)
+{
+    std::vector<Real> x, y, z;
+    createPositions(count, extent, x, y, z);
+
+    std::vector<Real> values(count);
+    std::vector<Vector4> results(count);
+    src.getValues(&x[0], &y[0], &z[0], &values[0], count);
+    src.getValuesAndGradients(&x[0], &y[0], &z[0], &results[0], count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Vector3 position(x[i], y[i], z[i]);
+        Vector4 expected = src.getValueAndGradient(position);
+        EXPECT_NEAR(values[i], src.getValue(position), 1e-4);
+        EXPECT_NEAR(results[i].x, expected.x, 1e-4);
+        EXPECT_NEAR(results[i].y, expected.y, 1e-4);
+        EXPECT_NEAR(results[i].z, expected.z, 1e-4);
+        EXPECT_NEAR(results[i].w, expected.w, 1e-4);
+    }
+}
+
+/// Gathers the amount of indices of all chunks of all levels.
+std::vector<size_t> getIndexCounts(const Chunk* root, size_t levels)
+{
+    std::vector<size_t> counts;
+    for (size_t level = 0; level < levels; ++level)
+    {
+        Chunk::VecChunk chunks;
+        root->getChunksOfLevel(level, chunks);
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            RenderOperation op;
+            const_cast<Chunk*>(chunks[i])->getRenderOperation(op);
+            counts.push_back(op.indexData ? op.indexData->indexCount : 0);
+        }
+    }
+    return counts;
+}
+
+/// Gathers the vertices of all chunks of all levels.
+std::vector<float> getVertices(const Chunk* root, size_t levels)
+{
+    std::vector<float> vertices;
+    for (size_t level = 0; level < levels; ++level)
+    {
+        Chunk::VecChunk chunks;
+        root->getChunksOfLevel(level, chunks);
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            RenderOperation op;
+            const_cast<Chunk*>(chunks[i])->getRenderOperation(op);
+            if (!op.vertexData)
+                continue;
+            const HardwareVertexBufferSharedPtr& buffer = op.vertexData->vertexBufferBinding->getBuffer(0);
+            size_t offset = vertices.size();
+            vertices.resize(offset + buffer->getSizeInBytes() / sizeof(float));
+            buffer->readData(0, buffer->getSizeInBytes(), &vertices[offset]);
+        }
+    }
+    return vertices;
+}
+
+/// Gathers the vertex counts of the octree visualizations attached below a node.
+void getOctreeGridVertexCounts(SceneNode* node, std::vector<size_t>& counts)
+{
+    for (size_t i = 0; i < node->numAttachedObjects(); ++i)
+    {
+        MovableObject* object = node->getAttachedObject(i);
+        if (object->getMovableType() == "Entity" && StringUtil::startsWith(object->getName(), "VolumeOctreeGrid", false))
+            counts.push_back(static_cast<Entity*>(object)->getMesh()->getSubMesh(0)->vertexData->vertexCount);
+    }
+    for (size_t i = 0; i < node->numChildren(); ++i)
+        getOctreeGridVertexCounts(static_cast<SceneNode*>(node->getChild(i)), counts);
+}
+}
+typedef RootWithoutRenderSystemFixture VolumeChunkTests;
+//--------------------------------------------------------------------------
+TEST(VolumeSource, BatchedCSG)
+{
+    CSGSphereSource sphere((Real)5.0, Vector3((Real)8.0));
+    CSGSphereSource hole((Real)1.5, Vector3((Real)10.0));
+    CSGPlaneSource plane((Real)7.0, Vector3::UNIT_Y);
+    CSGScaleSource scaledHole(&hole, (Real)1.2);
+    CSGDifferenceSource difference(&sphere, &scaledHole);
+    CSGIntersectionSource intersection(&difference, &plane);
+    CSGNegateSource negated(&hole);
+    CSGUnionSource unionSource(&intersection, &negated);
+
+    Real frequencies[] = {(Real)1.01, (Real)0.48};
+    Real amplitudes[] = {(Real)0.25, (Real)0.5};
+    CSGNoiseSource noise(&unionSource, frequencies, amplitudes, 2, 42);
+
+    // Not a multiple of the batch size on purpose
+    expectBatchMatches(unionSource, 300, 15);
+    expectBatchMatches(noise, 300, 15);
+}
+//--------------------------------------------------------------------------
+TEST(VolumeSource, BatchedGrid)
+{
+    SphereGridSource trilinear(true);
+    SphereGridSource nearest(false);
+    expectBatchMatches(trilinear, 300, 14);
+    expectBatchMatches(nearest, 300, 14);
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeChunkTests, ParallelLoad)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    mRoot->getWorkQueue()->startup();
+
+    CSGSphereSource sphere((Real)20.0, Vector3((Real)32.0));
+    Real frequencies[] = {(Real)0.1};
+    Real amplitudes[] = {(Real)3.0};
+    CSGNoiseSource noise(&sphere, frequencies, amplitudes, 1, 42);
+
+    ChunkParameters parameters;
+    parameters.sceneManager = sceneMgr;
+    parameters.src = &noise;
+    parameters.baseError = (Real)1.8;
+    parameters.errorMultiplicator = (Real)0.9;
+    parameters.skirtFactor = (Real)0.7;
+
+    const size_t levels = 4;
+    std::vector<size_t> reference;
+    for (size_t maxChunksInFlight = 0; maxChunksInFlight < 4; maxChunksInFlight += 3)
+    {
+        parameters.maxChunksInFlight = maxChunksInFlight;
+        Chunk* volume = OGRE_NEW Chunk();
+        volume->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, Vector3((Real)64.0), levels, &parameters);
+
+        // The budget only changes how many chunks are meshed at once, not the result.
+        std::vector<size_t> counts = getIndexCounts(volume, levels);
+        if (reference.empty())
+            reference = counts;
+        EXPECT_EQ(counts, reference);
+        EXPECT_FALSE(counts.empty());
+        OGRE_DELETE volume;
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeChunkTests, UpdateRegion)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+
+    // The same edit on a volume keeping its octrees, one rebuilding them and a fresh load
+    SphereGridSource keptSource(true, 64), rebuiltSource(true, 64), freshSource(true, 64);
+    ChunkParameters parameters;
+    parameters.sceneManager = sceneMgr;
+    parameters.baseError = (Real)0.9;
+    parameters.errorMultiplicator = (Real)0.9;
+    parameters.skirtFactor = (Real)0.7;
+
+    const size_t levels = 4;
+    const Vector3 to((Real)64.0);
+    parameters.src = &keptSource;
+    parameters.keepOctrees = true;
+    Chunk* kept = OGRE_NEW Chunk();
+    kept->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, to, levels, &parameters);
+    parameters.src = &rebuiltSource;
+    parameters.keepOctrees = false;
+    Chunk* rebuilt = OGRE_NEW Chunk();
+    rebuilt->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, to, levels, &parameters);
+
+    Vector3 center((Real)32.0, (Real)32.0, (Real)51.0);
+    Real radius = (Real)4.0;
+    CSGSphereSource sphere(radius, center);
+    CSGDifferenceSource difference;
+    keptSource.combineWithSource(&difference, &sphere, center, radius * (Real)1.5);
+    rebuiltSource.combineWithSource(&difference, &sphere, center, radius * (Real)1.5);
+    freshSource.combineWithSource(&difference, &sphere, center, radius * (Real)1.5);
+
+    kept->updateRegion(center - radius * (Real)1.5, center + radius * (Real)1.5);
+    rebuilt->updateRegion(center - radius * (Real)1.5, center + radius * (Real)1.5);
+
+    parameters.src = &freshSource;
+    Chunk* fresh = OGRE_NEW Chunk();
+    fresh->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, to, levels, &parameters);
+
+    std::vector<size_t> freshCounts = getIndexCounts(fresh, levels);
+    EXPECT_EQ(getIndexCounts(kept, levels), freshCounts);
+    EXPECT_EQ(getIndexCounts(rebuilt, levels), freshCounts);
+
+    OGRE_DELETE fresh;
+    OGRE_DELETE rebuilt;
+    OGRE_DELETE kept;
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeChunkTests, UpdateRegionBorder)
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+
+    // Edit just below a chunk border, the chunks and cells behind it read the changed samples, too.
+    SphereGridSource keptSource(true, 64), freshSource(true, 64);
+    ChunkParameters parameters;
+    parameters.sceneManager = sceneMgr;
+    parameters.baseError = (Real)0.9;
+    parameters.errorMultiplicator = (Real)0.9;
+    parameters.skirtFactor = (Real)0.7;
+    parameters.createOctreeVisualization = true;
+
+    const size_t levels = 4;
+    const Vector3 to((Real)64.0);
+    parameters.src = &keptSource;
+    parameters.keepOctrees = true;
+    SceneNode* keptNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    Chunk* kept = OGRE_NEW Chunk();
+    kept->load(keptNode, Vector3::ZERO, to, levels, &parameters);
+
+    Vector3 center((Real)43.5, (Real)32.0, (Real)47.4);
+    Real radius = (Real)2.0;
+    CSGSphereSource sphere(radius, center);
+    CSGDifferenceSource difference;
+    keptSource.combineWithSource(&difference, &sphere, center, radius * (Real)1.5);
+    freshSource.combineWithSource(&difference, &sphere, center, radius * (Real)1.5);
+    kept->updateRegion(center - radius * (Real)1.5, center + radius * (Real)1.5);
+
+    parameters.src = &freshSource;
+    SceneNode* freshNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    Chunk* fresh = OGRE_NEW Chunk();
+    fresh->load(freshNode, Vector3::ZERO, to, levels, &parameters);
+
+    EXPECT_EQ(getIndexCounts(kept, levels), getIndexCounts(fresh, levels));
+    EXPECT_EQ(getVertices(kept, levels), getVertices(fresh, levels));
+
+    // The octree visualization shows the updated cells
+    std::vector<size_t> keptGrids, freshGrids;
+    getOctreeGridVertexCounts(keptNode, keptGrids);
+    getOctreeGridVertexCounts(freshNode, freshGrids);
+    EXPECT_EQ(keptGrids, freshGrids);
+
+    OGRE_DELETE fresh;
+    OGRE_DELETE kept;
+}
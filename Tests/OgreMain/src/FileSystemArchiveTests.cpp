@@ -311,3 +311,33 @@ TEST_F(FileSystemArchiveTests,CreateAndRemoveFile)
     EXPECT_TRUE(!mArch->exists(fileName));
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,MemoryMappedRead)
+{
+    FileSystemArchiveFactory::setUseMemoryMapping(true);
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+    DataStreamPtr stream2 = mArch->open("rootfile2.txt");
+    FileSystemArchiveFactory::setUseMemoryMapping(false);
+
+    // accessible in place
+    MemoryDataStream* mapped = dynamic_cast<MemoryDataStream*>(stream.get());
+    ASSERT_TRUE(mapped);
+    EXPECT_EQ(mFileSizeRoot1, stream->size());
+    EXPECT_EQ(String("this is line 1"), String((const char*)mapped->getPtr(), 14));
+    EXPECT_FALSE(stream->isWriteable());
+
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 1 in file 2"), stream2->getLine());
+    EXPECT_EQ(String("this is line 2 in file 1"), stream->getLine());
+    EXPECT_EQ(mapped->getCurrentPtr(), mapped->getPtr() + stream->tell());
+
+    String rest = stream->getAsString();
+    EXPECT_EQ(mFileSizeRoot1 - 50, rest.size());
+    EXPECT_TRUE(stream->eof());
+
+    stream->close();
+    EXPECT_FALSE(mapped->getPtr());
+
+    // writing still goes through the regular streams
+    EXPECT_FALSE(dynamic_cast<MemoryDataStream*>(mArch->open("rootfile.txt", false).get()));
+}
+//--------------------------------------------------------------------------
@@ -26,10 +26,13 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include <gtest/gtest.h>
+#include <atomic>
 
 #include "OgreRoot.h"
 #include "OgreSceneNode.h"
 #include "OgreEntity.h"
+#include "OgreSubEntity.h"
+#include "OgreSubMesh.h"
 #include "OgreCamera.h"
 #include "RootWithoutRenderSystemFixture.h"
 #include "OgreStaticPluginLoader.h"
@@ -44,14 +47,32 @@ THE SOFTWARE.
 #include "OgreMeshManager.h"
 #include "OgreMesh.h"
 #include "OgreSkeletonManager.h"
+#include "OgreSkeleton.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
 #include "OgreCompositorManager.h"
 #include "OgreTextureManager.h"
 #include "OgreFileSystem.h"
 #include "OgreArchiveManager.h"
+#include "OgreWorkQueue.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticleSystemRenderer.h"
+#include "OgreParticleAffector.h"
+#include "OgreParticleAffectorFactory.h"
+#include "OgreParticle.h"
+#include "OgreControllerManager.h"
+#include "OgreOptimisedUtil.h"
 
 #include "OgreHighLevelGpuProgram.h"
+#include "OgreAutoParamDataSource.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreShadowCaster.h"
+#include "OgreLight.h"
 
 #include <random>
+#include <thread>
 using std::minstd_rand;
 
 using namespace Ogre;
@@ -90,6 +111,70 @@ TEST(SceneManager,removeAndDestroyAllChildren)
     sm->getRootSceneNode()->removeAndDestroyAllChildren();
 }
 
+static void expectSameDerivedTransforms(SceneNode* a, SceneNode* b)
+{
+    EXPECT_TRUE(a->_getDerivedPosition().positionEquals(b->_getDerivedPosition(), 1e-4));
+    EXPECT_TRUE(a->_getDerivedScale().positionEquals(b->_getDerivedScale(), 1e-4));
+    EXPECT_TRUE(a->_getDerivedOrientation().orientationEquals(b->_getDerivedOrientation(), 1e-5));
+    ASSERT_EQ(a->numChildren(), b->numChildren());
+    for (unsigned short i = 0; i < a->numChildren(); ++i)
+        expectSameDerivedTransforms(static_cast<SceneNode*>(a->getChild(i)),
+                                    static_cast<SceneNode*>(b->getChild(i)));
+}
+
+TEST(SceneManager, FlatTransformUpdate)
+{
+    Root root("");
+    root.getWorkQueue()->startup();
+
+    SceneManager* recursive = root.createSceneManager();
+    SceneManager* flat = root.createSceneManager();
+    flat->setFlatTransformUpdateEnabled(true);
+
+    // the same random hierarchy in both scene managers
+    minstd_rand rng;
+    auto rand = [&rng]() { return float(rng()) / rng.max(); };
+    std::vector<std::pair<SceneNode*, SceneNode*>> nodes = {
+        {recursive->getRootSceneNode(), flat->getRootSceneNode()}};
+    for (int n = 0; n < 2000; ++n)
+    {
+        auto parent = nodes[rng() % nodes.size()];
+        Vector3 pos(rand(), rand(), rand());
+        Vector3 scale(rand() + 0.5f, rand() + 0.5f, rand() + 0.5f);
+        Quaternion q(Radian(rand() * Math::TWO_PI), Vector3(rand(), rand(), rand() + 0.1f).normalisedCopy());
+        bool inheritOrientation = rng() % 4 != 0;
+        bool inheritScale = rng() % 4 != 0;
+
+        nodes.push_back({parent.first->createChildSceneNode(pos, q), parent.second->createChildSceneNode(pos, q)});
+        for (SceneNode* node : {nodes.back().first, nodes.back().second})
+        {
+            node->setScale(scale);
+            node->setInheritOrientation(inheritOrientation);
+            node->setInheritScale(inheritScale);
+        }
+    }
+
+    recursive->_updateSceneGraph(NULL);
+    flat->_updateSceneGraph(NULL);
+    expectSameDerivedTransforms(recursive->getRootSceneNode(), flat->getRootSceneNode());
+
+    // partial updates and changes of the structure
+    for (int n = 0; n < 50; ++n)
+    {
+        auto node = nodes[1 + rng() % (nodes.size() - 1)];
+        node.first->translate(Vector3::UNIT_X);
+        node.second->translate(Vector3::UNIT_X);
+    }
+    nodes[1].first->getParent()->removeChild(nodes[1].first);
+    nodes[1].second->getParent()->removeChild(nodes[1].second);
+    nodes[2].first->addChild(nodes[1].first);
+    nodes[2].second->addChild(nodes[1].second);
+
+    recursive->_updateSceneGraph(NULL);
+    flat->_updateSceneGraph(NULL);
+    expectSameDerivedTransforms(recursive->getRootSceneNode(), flat->getRootSceneNode());
+}
+
 static void createRandomEntityClones(Entity* ent, size_t cloneCount, const Vector3& min,
                                      const Vector3& max, SceneManager* mgr)
 {
@@ -171,6 +256,60 @@ TEST_F(SceneQueryTest,Intersection)
     // printf("\n");
 }
 
+namespace
+{
+typedef std::set<std::pair<MovableObject*, MovableObject*> > MovablePairSet;
+MovablePairSet getMovablePairs(IntersectionSceneQuery* query)
+{
+    MovablePairSet ret;
+    for (const auto& p : query->execute().movables2movables)
+    {
+        // the order within a pair is not defined
+        EXPECT_TRUE(ret.insert(std::minmax(p.first, p.second)).second);
+    }
+    return ret;
+}
+}
+
+TEST_F(SceneQueryTest, IntersectionBroadphase)
+{
+    IntersectionSceneQuery* intersectionQuery = mSceneMgr->createIntersectionQuery();
+
+    auto compare = [&]() {
+        mSceneMgr->setIntersectionSceneQueryBroadphaseEnabled(false);
+        MovablePairSet expected = getMovablePairs(intersectionQuery);
+        mSceneMgr->setIntersectionSceneQueryBroadphaseEnabled(true);
+        EXPECT_EQ(expected, getMovablePairs(intersectionQuery));
+        return expected.size();
+    };
+
+    EXPECT_EQ(51u, compare());
+
+    // sort the moved objects into place
+    minstd_rand rng;
+    for (const auto& it : mSceneMgr->getMovableObjects("Entity"))
+    {
+        if (it.second->getParentSceneNode() && rng() % 4 == 0)
+            it.second->getParentSceneNode()->translate(Vector3(rng() % 401, rng() % 401, rng() % 401) - 200);
+    }
+    mSceneMgr->_updateSceneGraph(mCamera);
+    compare();
+
+    // masks apply to both objects
+    intersectionQuery->setQueryMask(1);
+    mSceneMgr->getEntity("0")->setQueryFlags(2);
+    mSceneMgr->getEntity("391")->setQueryFlags(2);
+    compare();
+    intersectionQuery->setQueryMask(0xFFFFFFFF);
+
+    // sort again after destroying and creating objects
+    mSceneMgr->destroyEntity("72");
+    mSceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(
+        mSceneMgr->createEntity("new", "sphere.mesh"));
+    mSceneMgr->_updateSceneGraph(mCamera);
+    compare();
+}
+
 TEST_F(SceneQueryTest, Ray) {
     RaySceneQuery* rayQuery = mSceneMgr->createRayQuery(mCamera->getCameraToViewportRay(0.5, 0.5));
     rayQuery->setSortByDistance(true, 2);
@@ -181,6 +320,833 @@ TEST_F(SceneQueryTest, Ray) {
     ASSERT_EQ("397", results[1].movable->getName());
 }
 
+namespace
+{
+std::vector<Ray> createRaysToEntities(SceneManager* sceneMgr, const Vector3& origin, size_t count)
+{
+    minstd_rand rng;
+    std::vector<Ray> rays;
+    const SceneManager::MovableObjectMap& entities = sceneMgr->getMovableObjects("Entity");
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto it = entities.begin();
+        std::advance(it, rng() % entities.size());
+        Vector3 target = it->second->getWorldBoundingBox().getCenter();
+        target += Vector3(rng() % 201, rng() % 201, rng() % 201) - 100;
+        rays.push_back(Ray(origin, (target - origin).normalisedCopy()));
+    }
+    return rays;
+}
+
+std::vector<MovableObject*> getSortedMovables(const RaySceneQueryResult& results)
+{
+    std::vector<MovableObject*> ret;
+    for (const auto& r : results)
+        ret.push_back(r.movable);
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+}
+
+TEST_F(SceneQueryTest, RayBVH) {
+    mRoot->getWorkQueue()->startup();
+    RaySceneQuery* rayQuery = mSceneMgr->createRayQuery(Ray());
+    std::vector<Ray> rays = createRaysToEntities(mSceneMgr, Vector3(0, 0, 5000), 200);
+
+    auto compare = [&]() {
+        for (const Ray& ray : rays)
+        {
+            rayQuery->setRay(ray);
+            for (ushort maxResults : {0, 1})
+            {
+                rayQuery->setSortByDistance(maxResults != 0, maxResults);
+                mSceneMgr->setRaySceneQueryBVHEnabled(false);
+                RaySceneQueryResult expected = rayQuery->execute();
+                mSceneMgr->setRaySceneQueryBVHEnabled(true);
+                RaySceneQueryResult& results = rayQuery->execute();
+                ASSERT_EQ(getSortedMovables(expected), getSortedMovables(results));
+                if (maxResults == 1 && !results.empty())
+                    EXPECT_FLOAT_EQ(expected[0].distance, results[0].distance);
+            }
+        }
+
+        std::vector<RaySceneQueryResultEntry> batch(rays.size());
+        rayQuery->executeBatch(rays.data(), rays.size(), batch.data());
+        rayQuery->setSortByDistance(true, 1);
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            rayQuery->setRay(rays[i]);
+            RaySceneQueryResult& results = rayQuery->execute();
+            ASSERT_EQ(results.empty() ? NULL : results[0].movable, batch[i].movable);
+        }
+    };
+
+    compare();
+
+    // refit to moved objects
+    for (const auto& it : mSceneMgr->getMovableObjects("Entity"))
+    {
+        if (it.second->getParentSceneNode())
+            it.second->getParentSceneNode()->translate(Vector3(50, -20, 30));
+    }
+    mSceneMgr->_updateSceneGraph(mCamera);
+    compare();
+
+    // rebuild after destroying and creating objects
+    mSceneMgr->destroyEntity("397");
+    mSceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 2000))->attachObject(
+        mSceneMgr->createEntity("new", "sphere.mesh"));
+    mSceneMgr->_updateSceneGraph(mCamera);
+    compare();
+}
+
+TEST_F(SceneQueryTest, RayTriangles) {
+    RaySceneQuery* rayQuery = mSceneMgr->createRayQuery(Ray());
+    rayQuery->setTriangleIntersectionEnabled(true);
+    rayQuery->setSortByDistance(true, 1);
+
+    // world space triangles of all entities
+    struct Triangle
+    {
+        Vector3 corners[3];
+        MovableObject* movable;
+    };
+    std::vector<Triangle> triangles;
+    for (const auto& it : mSceneMgr->getMovableObjects("Entity"))
+    {
+        Entity* ent = static_cast<Entity*>(it.second);
+        if (!ent->isInScene())
+            continue;
+        SubMesh* sm = ent->getMesh()->getSubMesh(0);
+        VertexData* vertexData = sm->useSharedVertices ? ent->getMesh()->sharedVertexData : sm->vertexData;
+        const VertexElement* posElem = vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        HardwareVertexBufferSharedPtr vbuf = vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+        HardwareBufferLockGuard vertexLock(vbuf, HardwareBuffer::HBL_READ_ONLY);
+        HardwareBufferLockGuard indexLock(sm->indexData->indexBuffer, HardwareBuffer::HBL_READ_ONLY);
+        const uint16* indexes = static_cast<const uint16*>(indexLock.pData);
+        for (size_t i = 0; i < sm->indexData->indexCount; i += 3)
+        {
+            Triangle tri;
+            for (int c = 0; c < 3; ++c)
+            {
+                float* pos;
+                posElem->baseVertexPointerToElement(
+                    static_cast<uchar*>(vertexLock.pData) + indexes[i + c] * vbuf->getVertexSize(), &pos);
+                tri.corners[c] = ent->_getParentNodeFullTransform() * Vector3(pos[0], pos[1], pos[2]);
+            }
+            tri.movable = ent;
+            triangles.push_back(tri);
+        }
+    }
+
+    int numHits = 0;
+    for (const Ray& ray : createRaysToEntities(mSceneMgr, Vector3(0, 0, 5000), 100))
+    {
+        Real expected = Math::POS_INFINITY;
+        MovableObject* expectedMovable = NULL;
+        for (const Triangle& tri : triangles)
+        {
+            std::pair<bool, Real> hit = Math::intersects(ray, tri.corners[0], tri.corners[1], tri.corners[2]);
+            if (hit.first && hit.second < expected)
+            {
+                expected = hit.second;
+                expectedMovable = tri.movable;
+            }
+        }
+
+        rayQuery->setRay(ray);
+        RaySceneQueryResult& results = rayQuery->execute();
+        if (!expectedMovable)
+        {
+            EXPECT_TRUE(results.empty());
+            continue;
+        }
+        numHits++;
+        ASSERT_EQ(1u, results.size());
+        EXPECT_EQ(expectedMovable, results[0].movable);
+        EXPECT_NEAR(expected, results[0].distance, 1e-2);
+        EXPECT_EQ(static_cast<Entity*>(expectedMovable)->getMesh()->getSubMesh(0), results[0].subMesh);
+
+        // the barycentric coordinates lead to the hit point
+        Triangle tri;
+        for (const Triangle& t : triangles)
+        {
+            if (t.movable == results[0].movable)
+            {
+                tri = (&t)[results[0].triangle];
+                break;
+            }
+        }
+        const Vector3& bc = results[0].barycentricCoords;
+        Vector3 point = tri.corners[0] * bc.x + tri.corners[1] * bc.y + tri.corners[2] * bc.z;
+        EXPECT_LT(point.distance(ray.getPoint(results[0].distance)), 1e-2);
+    }
+    EXPECT_GT(numHits, 50);
+
+    // same results with the hierarchy
+    for (const Ray& ray : createRaysToEntities(mSceneMgr, Vector3(0, 0, 5000), 100))
+    {
+        rayQuery->setRay(ray);
+        mSceneMgr->setRaySceneQueryBVHEnabled(false);
+        RaySceneQueryResult expected = rayQuery->execute();
+        mSceneMgr->setRaySceneQueryBVHEnabled(true);
+        RaySceneQueryResult& results = rayQuery->execute();
+        ASSERT_EQ(expected.size(), results.size());
+        if (!expected.empty())
+        {
+            EXPECT_EQ(expected[0].movable, results[0].movable);
+            EXPECT_EQ(expected[0].triangle, results[0].triangle);
+        }
+    }
+}
+
+struct QueuedRenderableCollector : public RenderQueue::RenderableListener
+{
+    std::vector<Renderable*> queued;
+    bool renderableQueued(Renderable* rend, uint8 groupID, ushort priority, Technique** ppTech,
+                          RenderQueue* pQueue)
+    {
+        queued.push_back(rend);
+        return false; // there are no supported techniques without a RenderSystem
+    }
+};
+
+TEST_F(SceneQueryTest, ParallelCulling)
+{
+    mRoot->getWorkQueue()->startup();
+
+    QueuedRenderableCollector recursive, parallel;
+    VisibleObjectsBoundsInfo recursiveBounds, parallelBounds;
+
+    mSceneMgr->getRenderQueue()->setRenderableListener(&recursive);
+    mSceneMgr->_findVisibleObjects(mCamera, &recursiveBounds, false);
+
+    mSceneMgr->setParallelCullingEnabled(true);
+    mSceneMgr->getRenderQueue()->setRenderableListener(&parallel);
+    mSceneMgr->_findVisibleObjects(mCamera, &parallelBounds, false);
+    mSceneMgr->getRenderQueue()->setRenderableListener(NULL);
+
+    EXPECT_FALSE(recursive.queued.empty());
+    EXPECT_LT(recursive.queued.size(), 501u);
+    EXPECT_EQ(recursive.queued, parallel.queued);
+    EXPECT_EQ(recursiveBounds.aabb, parallelBounds.aabb);
+}
+
+TEST(WorkQueue, ParallelForEmptyRange)
+{
+    Root root("");
+    root.getWorkQueue()->startup();
+
+    bool called = false;
+    root.getWorkQueue()->parallelFor(0, 16, [&](size_t begin, size_t end) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST_F(SceneQueryTest, PrecomputedCulling)
+{
+    mRoot->getWorkQueue()->startup();
+
+    std::vector<Camera*> cameras;
+    for (int i = 0; i < 4; ++i)
+    {
+        Camera* cam = mSceneMgr->createCamera(StringConverter::toString(i));
+        SceneNode* node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+        node->attachObject(cam);
+        node->setPosition(Vector3(i * 1000 - 1500, 0, 0));
+        node->setDirection(Vector3(i % 2 ? 1 : -1, 0, 0));
+        cameras.push_back(cam);
+    }
+    mSceneMgr->_updateSceneGraph(mCamera);
+
+    std::vector<QueuedRenderableCollector> recursive(cameras.size()), precomputed(cameras.size());
+    VisibleObjectsBoundsInfo bounds;
+    for (size_t i = 0; i < cameras.size(); ++i)
+    {
+        mSceneMgr->getRenderQueue()->setRenderableListener(&recursive[i]);
+        mSceneMgr->_findVisibleObjects(cameras[i], &bounds, true);
+    }
+
+    EXPECT_EQ(mSceneMgr->_precomputeCulling(cameras.data(), cameras.size(), true), cameras.size());
+    for (size_t i = 0; i < cameras.size(); ++i)
+    {
+        mSceneMgr->getRenderQueue()->setRenderableListener(&precomputed[i]);
+        mSceneMgr->_findVisibleObjects(cameras[i], &bounds, true);
+        EXPECT_FALSE(recursive[i].queued.empty());
+        EXPECT_EQ(recursive[i].queued, precomputed[i].queued);
+    }
+    mSceneMgr->getRenderQueue()->setRenderableListener(NULL);
+    mSceneMgr->_clearPrecomputedCulling();
+
+    // nothing changed
+    EXPECT_EQ(mSceneMgr->_precomputeCulling(cameras.data(), cameras.size(), true), 0u);
+    mSceneMgr->_clearPrecomputedCulling();
+
+    // a camera moved
+    cameras[1]->getParentSceneNode()->yaw(Degree(90));
+    mSceneMgr->_updateSceneGraph(mCamera);
+    EXPECT_EQ(mSceneMgr->_precomputeCulling(cameras.data(), cameras.size(), true), cameras.size());
+    mSceneMgr->_clearPrecomputedCulling();
+    EXPECT_EQ(mSceneMgr->_precomputeCulling(cameras.data(), cameras.size(), true), 0u);
+    mSceneMgr->_clearPrecomputedCulling();
+
+    // an object moved
+    mSceneMgr->getEntity("501")->getParentSceneNode()->translate(Vector3(10, 0, 0));
+    mSceneMgr->_updateSceneGraph(mCamera);
+    EXPECT_EQ(mSceneMgr->_precomputeCulling(cameras.data(), cameras.size(), true), cameras.size());
+    mSceneMgr->_clearPrecomputedCulling();
+}
+
+namespace
+{
+struct DepthRenderable : public Renderable
+{
+    MaterialPtr material;
+    Real depth;
+    const MaterialPtr& getMaterial(void) const { return material; }
+    void getRenderOperation(RenderOperation& op) {}
+    void getWorldTransforms(Matrix4* xform) const { *xform = Matrix4::IDENTITY; }
+    Real getSquaredViewDepth(const Camera* cam) const { return depth; }
+    const LightList& getLights(void) const { return lights; }
+    LightList lights;
+};
+
+struct RecordingVisitor : public QueuedRenderableVisitor
+{
+    std::vector<Renderable*> sorted;
+    std::vector<const Pass*> passes;
+    std::map<const Pass*, RenderableList> groups;
+    void visit(RenderablePass* rp) { sorted.push_back(rp->renderable); }
+    void visit(const Pass* p, RenderableList& rs)
+    {
+        passes.push_back(p);
+        groups[p] = rs;
+    }
+};
+}
+
+typedef RootWithoutRenderSystemFixture RenderQueueTests;
+TEST_F(RenderQueueTests, SortKeys)
+{
+    std::vector<Pass*> passes;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto mat = MaterialManager::getSingleton().create(StringConverter::toString(i), RGN_DEFAULT);
+        auto tech = mat->createTechnique();
+        passes.push_back(tech->createPass());
+        passes.push_back(tech->createPass());
+    }
+
+    // above the threshold for radix sorting
+    std::vector<DepthRenderable> rends(3000);
+    for (auto& r : rends)
+        r.depth = Math::RangeRandom(0, 1000);
+
+    QueuedRenderableCollection classic, keyed;
+    keyed.setSortKeysEnabled(true);
+    for (auto* c : {&classic, &keyed})
+    {
+        c->addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+        c->addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    }
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        if (frame == 2)
+        {
+            // some renderables moved
+            for (size_t i = 0; i < rends.size(); i += 7)
+                rends[i].depth = Math::RangeRandom(0, 1000);
+        }
+
+        for (auto* c : {&classic, &keyed})
+        {
+            c->clear();
+            for (size_t i = 0; i < rends.size(); ++i)
+                c->addRenderable(passes[i % passes.size()], &rends[i]);
+            c->sort(NULL);
+        }
+
+        RecordingVisitor expected, actual;
+        classic.acceptVisitor(&expected, QueuedRenderableCollection::OM_PASS_GROUP);
+        keyed.acceptVisitor(&actual, QueuedRenderableCollection::OM_PASS_GROUP);
+        EXPECT_EQ(actual.passes.size(), passes.size()); // each pass visited once
+        EXPECT_EQ(actual.groups, expected.groups);
+        // passes sharing a hash keep the order they were added in, whatever their address
+        std::vector<const Pass*> byHash(passes.begin(), passes.end());
+        std::stable_sort(byHash.begin(), byHash.end(),
+                         [](const Pass* a, const Pass* b) { return a->getHash() < b->getHash(); });
+        EXPECT_EQ(byHash, actual.passes);
+
+        classic.acceptVisitor(&expected, QueuedRenderableCollection::OM_SORT_DESCENDING);
+        keyed.acceptVisitor(&actual, QueuedRenderableCollection::OM_SORT_DESCENDING);
+        EXPECT_EQ(actual.sorted, expected.sorted);
+    }
+}
+
+typedef RootWithoutRenderSystemFixture SoftwareSkinningTests;
+static void expectBlended(const VertexData* src, const VertexData* dst, const Affine3* boneMatrices,
+                          const Mesh::IndexMap& indexMap)
+{
+    // compare with a scalar blend of the same matrices
+    const Affine3* blendMatrices[256];
+    Mesh::prepareMatricesForVertexBlend(blendMatrices, boneMatrices, indexMap);
+
+    HardwareBufferLockGuard locks[6];
+    size_t numLocks = 0;
+    Mesh::SoftwareVertexBlendData data;
+    Mesh::prepareSoftwareVertexBlend(src, dst, true,
+        [&](const HardwareVertexBufferSharedPtr& buf, HardwareBuffer::LockOptions) {
+            locks[numLocks].lock(buf, HardwareBuffer::HBL_READ_ONLY);
+            return locks[numLocks++].pData;
+        }, data);
+
+    for (size_t v = 0; v < data.numVertices; ++v)
+    {
+        const float* srcPos = rawOffsetPointer(data.srcPos, v * data.srcPosStride);
+        const float* destPos = rawOffsetPointer(data.destPos, v * data.destPosStride);
+        const float* weights = rawOffsetPointer(data.blendWeight, v * data.blendWeightStride);
+        const unsigned char* indices = rawOffsetPointer(data.blendIndex, v * data.blendIndexStride);
+
+        Vector3 expected = Vector3::ZERO;
+        for (size_t w = 0; w < data.numWeightsPerVertex; ++w)
+            expected += weights[w] * (*blendMatrices[indices[w]] * Vector3(srcPos));
+        ASSERT_TRUE(expected.positionEquals(Vector3(destPos), 1e-3f));
+    }
+}
+
+TEST_F(SoftwareSkinningTests, BatchedBlend)
+{
+    mRoot->getWorkQueue()->startup();
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    sceneMgr->setParallelSoftwareAnimationEnabled(true);
+
+    std::vector<Entity*> entities;
+    for (int i = 0; i < 8; ++i)
+    {
+        Entity* entity = sceneMgr->createEntity("robot.mesh");
+        entity->getAnimationState("Walk")->setEnabled(true);
+        entity->getAnimationState("Walk")->setTimePosition(0.1f * i);
+        sceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(entity);
+        entities.push_back(entity);
+    }
+
+    sceneMgr->_beginSoftwareVertexBlends();
+    for (Entity* entity : entities)
+        entity->_updateAnimation();
+    sceneMgr->_endSoftwareVertexBlends();
+
+    for (Entity* entity : entities)
+    {
+        for (SubEntity* se : entity->getSubEntities())
+        {
+            ASSERT_TRUE(se->_getSkelAnimVertexData());
+            expectBlended(se->getSubMesh()->vertexData, se->_getSkelAnimVertexData(),
+                          entity->_getBoneMatrices(), se->getSubMesh()->blendIndexToBoneIndexMap);
+        }
+    }
+}
+
+TEST_F(SoftwareSkinningTests, BatchedBlendWithPose)
+{
+    mRoot->getWorkQueue()->startup();
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    sceneMgr->setParallelSoftwareAnimationEnabled(true);
+
+    // move a few vertices of the robot with a pose, which is applied before skinning
+    MeshPtr mesh = MeshManager::getSingleton().load("robot.mesh", "General")->clone("robotPose.mesh");
+    const Vector3 offset(0, 10, 0);
+    Pose* pose = mesh->createPose(1, "Up");
+    for (size_t v = 0; v < 10; ++v)
+        pose->addVertex(v, offset);
+    Animation* anim = mesh->createAnimation("Up", 1);
+    anim->createVertexTrack(1, VAT_POSE)->createVertexPoseKeyFrame(0)->addPoseReference(0, 1);
+
+    std::vector<Entity*> entities;
+    for (int i = 0; i < 8; ++i)
+    {
+        Entity* entity = sceneMgr->createEntity("robotPose.mesh");
+        entity->getAnimationState("Walk")->setEnabled(true);
+        entity->getAnimationState("Walk")->setTimePosition(0.1f * i);
+        entity->getAnimationState("Up")->setEnabled(i % 2);
+        sceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(entity);
+        entities.push_back(entity);
+    }
+
+    sceneMgr->_beginSoftwareVertexBlends();
+    for (Entity* entity : entities)
+        entity->_updateAnimation();
+    // animating again writes the temporary buffers held by the queued blend
+    entities[1]->getAnimationState("Walk")->addTime(0.05f);
+    entities[1]->_updateAnimation();
+    sceneMgr->_endSoftwareVertexBlends();
+
+    for (Entity* entity : entities)
+    {
+        SubEntity* se = entity->getSubEntity(0);
+        const VertexData* posed = se->_getSoftwareVertexAnimVertexData();
+        ASSERT_TRUE(posed);
+        expectBlended(posed, se->_getSkelAnimVertexData(), entity->_getBoneMatrices(),
+                      se->getSubMesh()->blendIndexToBoneIndexMap);
+
+        // the pose was applied to the source of the blend
+        const VertexData* orig = se->getSubMesh()->vertexData;
+        const VertexElement* posElem = orig->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        HardwareBufferLockGuard origLock(orig->vertexBufferBinding->getBuffer(posElem->getSource()),
+                                         HardwareBuffer::HBL_READ_ONLY);
+        HardwareBufferLockGuard posedLock(posed->vertexBufferBinding->getBuffer(posElem->getSource()),
+                                          HardwareBuffer::HBL_READ_ONLY);
+        float *origPos, *posedPos;
+        posElem->baseVertexPointerToElement(origLock.pData, &origPos);
+        posElem->baseVertexPointerToElement(posedLock.pData, &posedPos);
+        Vector3 expected = Vector3(origPos) + (entity->getAnimationState("Up")->getEnabled() ? offset : Vector3::ZERO);
+        EXPECT_TRUE(expected.positionEquals(Vector3(posedPos), 1e-3f));
+    }
+}
+
+TEST(OptimisedUtil, CalculateLightFacing)
+{
+    std::minstd_rand rng;
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    // not a multiple of the SIMD width
+    aligned_vector<Vector4> normals(1003);
+    for (auto& n : normals)
+        n = Vector4(dist(rng), dist(rng), dist(rng), dist(rng));
+    Vector4 lightPos(dist(rng), dist(rng), dist(rng), 1);
+
+    std::vector<char> facings(normals.size());
+    OptimisedUtil::getImplementation()->calculateLightFacing(lightPos, normals.data(), facings.data(),
+                                                             normals.size());
+
+    for (size_t i = 0; i < normals.size(); ++i)
+    {
+        // same order of additions as the SIMD versions
+        const Vector4& n = normals[i];
+        float dp = (n.x * lightPos.x + n.z * lightPos.z) + (n.y * lightPos.y + n.w * lightPos.w);
+        ASSERT_EQ(dp > 0, facings[i] != 0);
+    }
+}
+
+namespace
+{
+// index ranges of the volumes and separate light caps, as rendered
+std::vector<unsigned short> getShadowVolumeIndexes(const ShadowCaster::ShadowRenderableList& renderables)
+{
+    std::vector<unsigned short> ret;
+    for (ShadowRenderable* sr : renderables)
+    {
+        for (ShadowRenderable* r : {sr, sr->getLightCapRenderable()})
+        {
+            if (!r)
+                continue;
+            IndexData* indexData = r->getRenderOperationForUpdate()->indexData;
+            HardwareBufferLockGuard lock(indexData->indexBuffer, HardwareBuffer::HBL_READ_ONLY);
+            const unsigned short* idx = static_cast<const unsigned short*>(lock.pData);
+            ret.insert(ret.end(), idx + indexData->indexStart,
+                       idx + indexData->indexStart + indexData->indexCount);
+            ret.push_back(0xFFFF); // separator
+        }
+    }
+    return ret;
+}
+}
+
+typedef RootWithoutRenderSystemFixture ShadowVolumeTests;
+TEST_F(ShadowVolumeTests, Cache)
+{
+    mRoot->getWorkQueue()->startup();
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+
+    Light* light = sceneMgr->createLight();
+    SceneNode* lightNode = sceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(100, 200, 300));
+    lightNode->attachObject(light);
+
+    Entity* entity = sceneMgr->createEntity("ogrehead.mesh");
+    SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode();
+    node->attachObject(entity);
+    sceneMgr->_updateSceneGraph(NULL);
+
+    HardwareIndexBufferSharedPtr indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, 100000, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE, false);
+    size_t usedSize = 0;
+    unsigned long flags = SRF_INCLUDE_LIGHT_CAP | SRF_INCLUDE_DARK_CAP;
+
+    auto getVolume = [&]() {
+        return getShadowVolumeIndexes(entity->getShadowVolumeRenderableList(
+            SHADOWTYPE_STENCIL_ADDITIVE, light, &indexBuffer, &usedSize, false, 1000, flags));
+    };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        sceneMgr->setShadowVolumeCacheEnabled(false);
+        std::vector<unsigned short> expected = getVolume();
+        EXPECT_GT(expected.size(), entity->getMesh()->getNumSubMeshes());
+
+        sceneMgr->setShadowVolumeCacheEnabled(true);
+        entity->_prepareShadowVolume(light, flags);
+        EXPECT_EQ(expected, getVolume());
+        // cached
+        EXPECT_EQ(expected, getVolume());
+
+        if (i == 0)
+            lightNode->translate(Vector3(-300, 0, 0));
+        else
+            node->yaw(Degree(60));
+        sceneMgr->_updateSceneGraph(NULL);
+    }
+}
+
+typedef RootWithoutRenderSystemFixture AnimationTests;
+TEST_F(AnimationTests, CompressedNodeTracks)
+{
+    SkeletonPtr skel = static_pointer_cast<Skeleton>(SkeletonManager::getSingleton().load("robot.skeleton", "General"));
+    Animation* anim = skel->getAnimation("Walk");
+    std::unique_ptr<Animation> compressed(anim->clone("WalkCompressed"));
+    compressed->compressNodeTracks();
+
+    uint cursor = 0;
+    for (Real time = 0; time < anim->getLength() * 2; time += 0.01f)
+    {
+        TimeIndex timeIndex = anim->_getTimeIndex(time);
+        TimeIndex cachedIndex = compressed->_getTimeIndex(time, cursor);
+        EXPECT_EQ(timeIndex.getKeyIndex(), cachedIndex.getKeyIndex());
+
+        for (const auto& it : anim->_getNodeTrackList())
+        {
+            NodeAnimationTrack* track = compressed->getNodeTrack(it.first);
+            ASSERT_TRUE(track->isCompressed());
+            EXPECT_EQ(track->getNumKeyFrames(), 0);
+
+            TransformKeyFrame expected(0, time), actual(0, time);
+            it.second->getInterpolatedKeyFrame(timeIndex, &expected);
+            track->getInterpolatedKeyFrame(cachedIndex, &actual);
+            // rotations are quantised to 16 bit per component
+            EXPECT_LT((expected.getRotation() - actual.getRotation()).Norm(), 1e-4f);
+            EXPECT_TRUE(expected.getTranslate().positionEquals(actual.getTranslate(), 1e-3f));
+            EXPECT_TRUE(expected.getScale().positionEquals(actual.getScale(), 1e-3f));
+        }
+    }
+
+    // editing restores the keyframes
+    NodeAnimationTrack* track = compressed->getNodeTrack(anim->_getNodeTrackList().begin()->first);
+    track->createNodeKeyFrame(anim->getLength() * 0.5f + 0.001f);
+    EXPECT_FALSE(track->isCompressed());
+    EXPECT_EQ(track->getNumKeyFrames(), anim->_getNodeTrackList().begin()->second->getNumKeyFrames() + 1);
+}
+
+TEST_F(AnimationTests, CompressedConstantRotation)
+{
+    Animation anim("Constant", 3);
+    NodeAnimationTrack* track = anim.createNodeTrack(0);
+    Quaternion q(Degree(30), Vector3::UNIT_Y);
+    // the same rotation with the opposite sign, and one within the tolerance
+    Quaternion rotations[] = {q, -q, q * Quaternion(Degree(0.001f), Vector3::UNIT_X), q};
+    for (int i = 0; i < 4; ++i)
+        track->createNodeKeyFrame(i)->setRotation(rotations[i]);
+
+    track->compress(1e-4f);
+    track->decompress();
+
+    // a constant channel keeps the first rotation only
+    ASSERT_EQ(track->getNumKeyFrames(), 4);
+    for (int i = 1; i < 4; ++i)
+        EXPECT_EQ(track->getNodeKeyFrame(i)->getRotation(), track->getNodeKeyFrame(0)->getRotation());
+}
+
+TEST_F(AnimationTests, CompressedKeyFramesAtTime)
+{
+    Animation anim("Compressed", 2);
+    NodeAnimationTrack* track = anim.createNodeTrack(0);
+    track->createNodeKeyFrame(0);
+    track->createNodeKeyFrame(1);
+    track->compress();
+
+    // there are no keyframe objects to point to
+    KeyFrame *k1, *k2;
+    EXPECT_THROW(track->getKeyFramesAtTime(TimeIndex(0.5f), &k1, &k2), InvalidStateException);
+
+    track->decompress();
+    EXPECT_EQ(0.5f, track->getKeyFramesAtTime(TimeIndex(0.5f), &k1, &k2));
+    EXPECT_EQ(track->getKeyFrame(0), k1);
+    EXPECT_EQ(track->getKeyFrame(1), k2);
+}
+
+namespace
+{
+// slows particles down and fades them, counting the particles it was applied to
+struct DragAffector : public ParticleAffector
+{
+    std::atomic<size_t> numAffected;
+    DragAffector(ParticleSystem* psys) : ParticleAffector(psys), numAffected(0) { mType = "Drag"; }
+
+    void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) override
+    {
+        for (auto p : pSystem->_getActiveParticles())
+        {
+            p->mDirection *= 1 - timeElapsed;
+            p->mColour.a = p->mTimeToLive / p->mTotalTimeToLive;
+        }
+    }
+    uint32 _getParticleArrayComponents() const override
+    {
+        return ParticleArrays::PAC_DIRECTION | ParticleArrays::PAC_COLOUR | ParticleArrays::PAC_TIME_TO_LIVE;
+    }
+    void _affectParticleArrays(ParticleSystem*, Real timeElapsed, ParticleArrays& arrays, size_t begin,
+                               size_t end) override
+    {
+        numAffected += end - begin;
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+                arrays.direction[c][i] *= 1 - timeElapsed;
+            arrays.colour[3][i] = arrays.timeToLive[i] / arrays.totalTimeToLive[i];
+        }
+    }
+};
+
+struct DragAffectorFactory : public ParticleAffectorFactory
+{
+    String getName() const override { return "Drag"; }
+    ParticleAffector* createAffector(ParticleSystem* psys) override
+    {
+        ParticleAffector* a = new DragAffector(psys);
+        mAffectors.push_back(a);
+        return a;
+    }
+};
+
+// records the particle lists it is handed
+struct RecordingRenderer : public ParticleSystemRenderer
+{
+    const std::vector<Particle*>* rendered = nullptr;
+    const std::vector<Particle*>* moved = nullptr;
+
+    const String& getType() const override
+    {
+        static const String type = "Recording";
+        return type;
+    }
+    void _updateRenderQueue(RenderQueue*, std::vector<Particle*>& particles, bool) override
+    {
+        rendered = &particles;
+    }
+    void _notifyParticleMoved(std::vector<Particle*>& particles) override { moved = &particles; }
+    void _setMaterial(MaterialPtr&) override {}
+    void _notifyCurrentCamera(Camera*) override {}
+    void _notifyAttached(Node*, bool) override {}
+    void _notifyParticleQuota(size_t) override {}
+    void _notifyDefaultDimensions(Real, Real) override {}
+    void setRenderQueueGroup(uint8) override {}
+    void setRenderQueueGroupAndPriority(uint8, ushort) override {}
+    void setKeepParticlesInLocalSpace(bool) override {}
+    SortMode _getSortMode() const override { return SM_DIRECTION; }
+    void visitRenderables(Renderable::Visitor*, bool) override {}
+};
+
+struct RecordingRendererFactory : public ParticleSystemRendererFactory
+{
+    const String& getType() const override
+    {
+        static const String type = "Recording";
+        return type;
+    }
+    ParticleSystemRenderer* createInstance(const String&) override { return new RecordingRenderer(); }
+    void destroyInstance(ParticleSystemRenderer* ptr) override { delete ptr; }
+};
+}
+
+typedef RootWithoutRenderSystemFixture ParticleSystemTests;
+TEST_F(ParticleSystemTests, ParallelUpdate)
+{
+    mRoot->getWorkQueue()->startup();
+    DragAffectorFactory factory;
+    // normally done by Root::initialise
+    ControllerManager controllers;
+    ParticleSystemManager::getSingleton()._initialise();
+    ParticleSystemManager::getSingleton().addAffectorFactory(&factory);
+
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    ParticleSystem* systems[2];
+    for (int s = 0; s < 2; ++s)
+    {
+        systems[s] = sceneMgr->createParticleSystem(20000);
+        systems[s]->addAffector("Drag");
+        systems[s]->setParallelUpdateEnabled(s == 1);
+        sceneMgr->getRootSceneNode()->attachObject(systems[s]);
+        // allocates the pool
+        systems[s]->_update(0);
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            Particle* p = systems[s]->createParticle();
+            ASSERT_TRUE(p);
+            p->mPosition = Vector3(i, 0, 0);
+            p->mDirection = Vector3(0, i % 7, 1);
+            p->mTimeToLive = p->mTotalTimeToLive = 0.05f + (i % 10) * 0.1f;
+        }
+        EXPECT_EQ(systems[s]->createParticle(), nullptr);
+    }
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        for (auto ps : systems)
+            ps->_update(0.1f);
+
+        ASSERT_EQ(systems[0]->getNumParticles(), systems[1]->getNumParticles());
+        ASSERT_LT(systems[0]->getNumParticles(), 20000u - frame * 2000);
+        for (size_t i = 0; i < systems[0]->getNumParticles(); ++i)
+        {
+            Particle* a = systems[0]->getParticle(i);
+            Particle* b = systems[1]->getParticle(i);
+            ASSERT_EQ(a->mPosition, b->mPosition);
+            ASSERT_EQ(a->mDirection, b->mDirection);
+            ASSERT_EQ(a->mColour, b->mColour);
+        }
+    }
+
+    // both systems went through the array path for every particle
+    size_t numAffected = static_cast<DragAffector*>(systems[0]->getAffector(0))->numAffected;
+    EXPECT_GT(numAffected, 20000u);
+    EXPECT_EQ(static_cast<DragAffector*>(systems[1]->getAffector(0))->numAffected, numAffected);
+
+    // expired particles are reused
+    EXPECT_TRUE(systems[1]->createParticle());
+
+    // destroys the time controllers of the systems
+    mRoot->destroySceneManager(sceneMgr);
+}
+
+TEST_F(ParticleSystemTests, RendererGetsActiveParticles)
+{
+    RecordingRendererFactory factory;
+    // normally done by Root::initialise
+    ControllerManager controllers;
+    ParticleSystemManager::getSingleton()._initialise();
+    ParticleSystemManager::getSingleton().addRendererFactory(&factory);
+
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    ParticleSystem* ps = sceneMgr->createParticleSystem(100);
+    ps->setRenderer("Recording");
+    sceneMgr->getRootSceneNode()->attachObject(ps);
+    // allocates the pool
+    ps->_update(0);
+
+    for (int i = 0; i < 10; ++i)
+        ps->createParticle()->mTimeToLive = 1;
+    ps->_update(0.1f);
+
+    RenderQueue queue;
+    ps->_updateRenderQueue(&queue);
+
+    // the renderer works on the active particles directly rather than a copy
+    RecordingRenderer* renderer = static_cast<RecordingRenderer*>(ps->getRenderer());
+    EXPECT_EQ(renderer->moved, &ps->_getActiveParticles());
+    EXPECT_EQ(renderer->rendered, &ps->_getActiveParticles());
+    EXPECT_EQ(ps->_getActiveParticles().size(), 10u);
+
+    mRoot->destroySceneManager(sceneMgr);
+}
+
 TEST(MaterialSerializer, Basic)
 {
     Root root;
@@ -268,6 +1234,89 @@ TEST(Image, Combine)
     STBIImageCodec::shutdown();
 }
 
+TEST(Image, GenerateMipmaps)
+{
+    // 1 pixel checkerboard
+    Image img(PF_BYTE_RGBA, 64, 32);
+    for (uint32 y = 0; y < 32; y++)
+        for (uint32 x = 0; x < 64; x++)
+            img.setColourAt((x + y) % 2 ? ColourValue::White : ColourValue::Black, x, y, 0);
+
+    Image linear(img);
+    linear.generateMipmaps();
+    ASSERT_EQ(linear.getNumMipmaps(), 6u);
+    EXPECT_EQ(linear.getPixelBox(0, 6).getWidth(), 1u);
+    EXPECT_EQ(linear.getPixelBox(0, 6).getHeight(), 1u);
+    for (uint32 mip = 1; mip <= 6; mip++)
+    {
+        uchar* pixel = linear.getPixelBox(0, mip).data;
+        EXPECT_NEAR(pixel[0], 128, 1);
+        EXPECT_EQ(pixel[3], 255);
+    }
+
+    // half the light in linear space
+    Image gamma(img);
+    gamma.generateMipmaps(true);
+    EXPECT_NEAR(gamma.getPixelBox(0, 1).data[0], 188, 1);
+    EXPECT_NEAR(gamma.getPixelBox(0, 6).data[0], 188, 1);
+
+    // constant images stay constant, for every filter and dimension
+    const Image::Filter filters[] = {Image::FILTER_BOX, Image::FILTER_TRIANGLE, Image::FILTER_BICUBIC,
+                                     Image::FILTER_KAISER, Image::FILTER_LANCZOS};
+    for (auto filter : filters)
+    {
+        Image volume(PF_FLOAT32_RGBA, 7, 4, 5);
+        volume.setTo(ColourValue(0.25, 0.5, 0.75, 1));
+        volume.generateMipmaps(false, filter);
+        ASSERT_EQ(volume.getNumMipmaps(), 2u);
+        PixelBox last = volume.getPixelBox(0, 2);
+        EXPECT_EQ(last.getWidth(), 1u);
+        EXPECT_EQ(last.getHeight(), 1u);
+        EXPECT_EQ(last.getDepth(), 1u);
+        ColourValue c;
+        PixelUtil::unpackColour(&c, PF_FLOAT32_RGBA, volume.getPixelBox(0, 1).data);
+        EXPECT_NEAR(c.r, 0.25, 1e-5);
+        PixelUtil::unpackColour(&c, PF_FLOAT32_RGBA, last.data);
+        EXPECT_NEAR(c.g, 0.5, 1e-5);
+        EXPECT_NEAR(c.b, 0.75, 1e-5);
+    }
+}
+
+TEST(Image, GenerateMipmapsAlphaCoverage)
+{
+    Image img(PF_BYTE_RGBA, 128, 128);
+    uint32 seed = 1;
+    for (uint32 y = 0; y < 128; y++)
+    {
+        for (uint32 x = 0; x < 128; x++)
+        {
+            seed = seed * 1664525 + 1013904223;
+            img.setColourAt(ColourValue(1, 1, 1, (seed >> 8) / float(1 << 24)), x, y, 0);
+        }
+    }
+
+    auto getCoverage = [](const Image& img, uint32 mip) {
+        PixelBox box = img.getPixelBox(0, mip);
+        size_t count = 0, numPixels = box.getWidth() * box.getHeight();
+        for (size_t i = 0; i < numPixels; i++)
+            count += box.data[i * 4 + 3] > 0.7 * 255;
+        return float(count) / numPixels;
+    };
+
+    float coverage = getCoverage(img, 0);
+    EXPECT_NEAR(coverage, 0.3, 0.02);
+
+    Image plain(img);
+    plain.generateMipmaps();
+    Image preserved(img);
+    preserved.generateMipmaps(false, Image::FILTER_BOX, 0.7);
+    for (uint32 mip = 1; mip <= 4; mip++)
+        EXPECT_NEAR(getCoverage(preserved, mip), coverage, 0.02) << "mip " << mip;
+
+    // averaged noise thins out without
+    EXPECT_LT(getCoverage(plain, 4), 0.1);
+}
+
 struct UsePreviousResourceLoadingListener : public ResourceLoadingListener
 {
     bool resourceCollision(Resource *resource, ResourceManager *resourceManager) { return false; }
@@ -322,6 +1371,110 @@ TEST_F(ResourceLoading, CollsionDeleteExisting)
     EXPECT_TRUE(mat->clone("Collision"));
 }
 
+struct CountingResourceGroupListener : public ResourceGroupListener
+{
+    size_t prepareStarted = 0, prepareEnded = 0, loadStarted = 0;
+    std::vector<String> prepared;
+    void resourceLoadStarted(const ResourcePtr& res)
+    {
+        // already prepared on a worker thread
+        EXPECT_NE(res->getLoadingState(), Resource::LOADSTATE_UNLOADED);
+        loadStarted++;
+    }
+    void resourceGroupPrepareStarted(const String&, size_t) { prepareStarted++; }
+    void resourcePrepareStarted(const ResourcePtr& res) { prepared.push_back(res->getName()); }
+    void resourcePrepareEnded() { prepareEnded++; }
+};
+
+TEST_F(ResourceLoading, ParallelLoad)
+{
+    mRoot->getWorkQueue()->startup();
+    auto& rgm = ResourceGroupManager::getSingleton();
+    auto location = rgm.findResourceFileInfo(RGN_DEFAULT, "robot.mesh")->front().archive->getName();
+    rgm.addResourceLocation(location, "FileSystem", "Parallel");
+    rgm.declareResource("robot.mesh", "Mesh", "Parallel");
+    rgm.declareResource("robot.skeleton", "Skeleton", "Parallel");
+    rgm.initialiseResourceGroup("Parallel");
+
+    CountingResourceGroupListener listener;
+    rgm.addResourceGroupListener(&listener);
+    rgm.setParallelLoadingEnabled(true);
+    rgm.loadResourceGroup("Parallel");
+    rgm.removeResourceGroupListener(&listener);
+
+    EXPECT_EQ(listener.prepareStarted, 1u);
+    EXPECT_EQ(listener.prepared.size(), 2u);
+    EXPECT_EQ(listener.prepareEnded, 2u);
+    EXPECT_EQ(listener.loadStarted, 2u);
+
+    MeshPtr mesh = MeshManager::getSingleton().getByName("robot.mesh", "Parallel");
+    ASSERT_TRUE(mesh);
+    EXPECT_TRUE(mesh->isLoaded());
+    EXPECT_TRUE(mesh->getSkeleton());
+    EXPECT_TRUE(mesh->getSkeleton()->isLoaded());
+}
+
+TEST_F(ResourceLoading, ConcurrentLookup)
+{
+    DefaultTextureManager texMgr;
+    auto& matMgr = MaterialManager::getSingleton();
+    auto& rgm = ResourceGroupManager::getSingleton();
+    rgm.createResourceGroup("Global", true);
+    rgm.createResourceGroup("Grouped", false);
+
+    // same name in the global and in a grouped pool
+    MaterialPtr global = matMgr.create("Lookup", "Global");
+    MaterialPtr grouped = matMgr.create("Lookup", "Grouped");
+    EXPECT_EQ(matMgr.getByName("Lookup", "Global"), global);
+    EXPECT_EQ(matMgr.getByName("Lookup", "Grouped"), grouped);
+    EXPECT_EQ(matMgr.getByHandle(grouped->getHandle()), grouped);
+    matMgr.remove(grouped);
+    EXPECT_FALSE(matMgr.getByHandle(grouped->getHandle()));
+#if OGRE_RESOURCEMANAGER_STRICT
+    EXPECT_FALSE(matMgr.getByName("Lookup", "Grouped"));
+#else
+    EXPECT_EQ(matMgr.getByName("Lookup", "Grouped"), global);
+#endif
+    EXPECT_EQ(grouped.use_count(), 1);
+
+    // look up existing resources from several threads
+    const int numResources = 1000;
+    const int numLookups = 10000;
+    StringVector matNames, texNames;
+    for (int i = 0; i < numResources; ++i)
+    {
+        matNames.push_back("Lookup/Material" + StringConverter::toString(i));
+        texNames.push_back("Lookup/Texture" + StringConverter::toString(i) + ".png");
+        matMgr.create(matNames.back(), RGN_DEFAULT);
+        texMgr.create(texNames.back(), "Grouped");
+    }
+
+    const unsigned numThreads = std::max(4u, std::thread::hardware_concurrency());
+    const String matGroups[] = {RGN_DEFAULT, RGN_AUTODETECT};
+    const String texGroups[] = {"Grouped", RGN_AUTODETECT};
+    std::atomic<int> found(0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            int n = 0;
+            for (int i = 0; i < numLookups; ++i)
+            {
+                int idx = (i * 7919 + t) % numResources;
+                // alternate between lookups in the given and in all groups
+                if (matMgr.getByName(matNames[idx], matGroups[i % 2]) &&
+                    texMgr.getByName(texNames[idx], texGroups[i % 2]))
+                    n++;
+            }
+            found += n;
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(found, int(numThreads * numLookups));
+}
+
 typedef RootWithoutRenderSystemFixture TextureTests;
 TEST_F(TextureTests, Blank)
 {
@@ -360,6 +1513,59 @@ TEST(GpuSharedParameters, align)
     EXPECT_EQ(params.getConstantDefinition("d").logicalIndex, 48);
 }
 
+TEST(GpuProgramParameters, AutoParamChanges)
+{
+    GpuNamedConstantsPtr constants(new GpuNamedConstants());
+    const char* names[] = {"world", "worldArray", "ambient", "fog"};
+    GpuConstantType types[] = {GCT_MATRIX_4X4, GCT_MATRIX_3X4, GCT_FLOAT4, GCT_FLOAT4};
+    for (int i = 0; i < 4; i++)
+    {
+        GpuConstantDefinition def;
+        def.constType = types[i];
+        def.elementSize = GpuConstantDefinition::getElementSize(types[i], false);
+        def.physicalIndex = constants->floatBufferSize;
+        def.logicalIndex = def.physicalIndex;
+        constants->floatBufferSize += def.elementSize;
+        constants->map[names[i]] = def;
+    }
+
+    GpuProgramParameters params;
+    params._setNamedConstants(constants);
+    params.setNamedAutoConstant("ambient", GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR);
+    params.setNamedAutoConstant("world", GpuProgramParameters::ACT_WORLD_MATRIX);
+    params.setNamedAutoConstant("fog", GpuProgramParameters::ACT_FOG_COLOUR);
+    params.setNamedAutoConstant("worldArray", GpuProgramParameters::ACT_WORLD_MATRIX_ARRAY_3x4, 1);
+
+    AutoParamDataSource source;
+    Affine3 world = Affine3::IDENTITY;
+    source.setWorldMatrices(&world, 1);
+    source.setAmbientLightColour(ColourValue::Red);
+    source.setFog(FOG_NONE, ColourValue::Blue, 0, 0, 1);
+
+    EXPECT_EQ(params._updateAutoParams(&source, GPV_ALL), GPV_GLOBAL | GPV_PER_OBJECT);
+    EXPECT_EQ(*params.getFloatPointer(constants->map["ambient"].physicalIndex), 1.0f);
+
+    // the same object again: nothing changed
+    EXPECT_EQ(params._updateAutoParams(&source, GPV_PER_OBJECT), 0);
+
+    // only per object constants are updated for the next object
+    world.setTrans(Vector3(1, 2, 3));
+    source.setWorldMatrices(&world, 1);
+    source.setAmbientLightColour(ColourValue::Green);
+    EXPECT_EQ(params._updateAutoParams(&source, GPV_PER_OBJECT), GPV_PER_OBJECT);
+    EXPECT_EQ(params.getFloatPointer(constants->map["world"].physicalIndex)[3], 1.0f);
+    EXPECT_EQ(params.getFloatPointer(constants->map["worldArray"].physicalIndex)[3], 1.0f);
+    EXPECT_EQ(*params.getFloatPointer(constants->map["ambient"].physicalIndex), 1.0f);
+
+    // changing the bindings rebuilds the update plan
+    params.clearNamedAutoConstant("world");
+    world.setTrans(Vector3(4, 5, 6));
+    source.setWorldMatrices(&world, 1);
+    EXPECT_EQ(params._updateAutoParams(&source, GPV_ALL), GPV_GLOBAL | GPV_PER_OBJECT);
+    EXPECT_EQ(params.getFloatPointer(constants->map["world"].physicalIndex)[3], 1.0f);
+    EXPECT_EQ(params.getFloatPointer(constants->map["worldArray"].physicalIndex)[3], 4.0f);
+}
+
 typedef RootWithoutRenderSystemFixture HighLevelGpuProgramTest;
 TEST_F(HighLevelGpuProgramTest, resolveIncludes)
 {
@@ -26,6 +26,8 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "PixelFormatTests.h"
+#include "OgreRoot.h"
+#include "Threading/OgreDefaultWorkQueue.h"
 #include <cstdlib>
 #include <iomanip>
 
@@ -227,6 +229,55 @@ TEST_F(PixelFormatTests,BulkConversion)
     testCase(PF_X8B8G8R8, PF_A8B8G8R8);
     testCase(PF_X8B8G8R8, PF_B8G8R8A8);
     testCase(PF_X8B8G8R8, PF_R8G8B8A8);
+
+    // vectorised conversions
+    testCase(PF_FLOAT16_R, PF_FLOAT32_R);
+    testCase(PF_FLOAT16_GR, PF_FLOAT32_GR);
+    testCase(PF_FLOAT16_RGB, PF_FLOAT32_RGB);
+    testCase(PF_FLOAT16_RGBA, PF_FLOAT32_RGBA);
+    testCase(PF_FLOAT32_R, PF_FLOAT16_R);
+    testCase(PF_FLOAT32_GR, PF_FLOAT16_GR);
+    testCase(PF_FLOAT32_RGB, PF_FLOAT16_RGB);
+    testCase(PF_FLOAT32_RGBA, PF_FLOAT16_RGBA);
+    testCase(PF_R8, PF_FLOAT32_R);
+    testCase(PF_L8, PF_FLOAT32_R);
+    testCase(PF_BYTE_RGB, PF_FLOAT32_RGB);
+    testCase(PF_BYTE_RGBA, PF_FLOAT32_RGBA);
+    testCase(PF_FLOAT32_R, PF_R8);
+    testCase(PF_FLOAT32_R, PF_L8);
+    testCase(PF_FLOAT32_RGB, PF_BYTE_RGB);
+    testCase(PF_FLOAT32_RGBA, PF_BYTE_RGBA);
+    testCase(PF_BYTE_RGB, PF_BYTE_RGBA);
+    testCase(PF_BYTE_BGR, PF_BYTE_BGRA);
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,ParallelConversion)
+{
+    // large enough to be split over the WorkQueue, converting a sub volume spanning two slices
+    WorkQueue* queue = OGRE_NEW DefaultWorkQueue("PixelFormat");
+    Root root("", "", "Ogre.log", queue);
+    queue->startup();
+
+    const uint32 width = 600, height = 300, depth = 3;
+    std::vector<uint8> src(width * height * depth * PixelUtil::getNumElemBytes(PF_FLOAT16_RGBA));
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = mRandomData[i % mSize];
+
+    PixelFormat formats[][2] = {{PF_FLOAT16_RGBA, PF_FLOAT32_RGBA}, {PF_BYTE_RGB, PF_A8R8G8B8}};
+    for (auto& pair : formats)
+    {
+        size_t dstSize = width * height * depth * PixelUtil::getNumElemBytes(pair[1]);
+        std::vector<uint8> dst1(dstSize, 0x56), dst2(dstSize, 0x56);
+        PixelBox srcBox(width, height, depth, pair[0], src.data());
+        Box sub(10, 20, 1, width - 10, height, 3);
+
+        PixelUtil::bulkPixelConversion(srcBox.getSubVolume(sub),
+                                       PixelBox(width, height, depth, pair[1], dst1.data()).getSubVolume(sub));
+        naiveBulkPixelConversion(srcBox.getSubVolume(sub),
+                                 PixelBox(width, height, depth, pair[1], dst2.data()).getSubVolume(sub));
+
+        EXPECT_TRUE(dst1 == dst2) << PixelUtil::getFormatName(pair[0]) << "->" << PixelUtil::getFormatName(pair[1]);
+    }
 }
 //--------------------------------------------------------------------------
 
@@ -0,0 +1,240 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRoot.h"
+#include "OgreTimer.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+
+#include <thread>
+
+using namespace Ogre;
+
+namespace
+{
+struct RecordingHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+{
+    std::mutex mutex;
+    std::vector<int> processed;
+    std::atomic<size_t> responses;
+
+    RecordingHandler() : responses(0) {}
+
+    WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        processed.push_back(any_cast<int>(req->getData()));
+        return OGRE_NEW WorkQueue::Response(req, true, req->getData());
+    }
+
+    void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) { ++responses; }
+};
+
+void waitForResponses(WorkQueue* queue, RecordingHandler& handler, size_t count)
+{
+    Timer timer;
+    while (handler.responses < count && timer.getMilliseconds() < 10000)
+    {
+        queue->processResponses();
+        std::this_thread::yield();
+    }
+}
+}
+
+TEST(WorkStealingWorkQueue, Requests)
+{
+    Root root("", "", "Ogre.log", OGRE_NEW WorkStealingWorkQueue("Test"));
+    WorkQueue* queue = root.getWorkQueue();
+    queue->startup();
+
+    RecordingHandler handler;
+    uint16 channel = queue->getChannel("Test");
+    queue->addRequestHandler(channel, &handler);
+    queue->addResponseHandler(channel, &handler);
+
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_NE(queue->addRequest(channel, 0, i), 0u);
+    waitForResponses(queue, handler, 1000);
+
+    EXPECT_EQ(handler.responses, 1000u);
+    std::sort(handler.processed.begin(), handler.processed.end());
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(handler.processed[i], i);
+
+    queue->removeRequestHandler(channel, &handler);
+    queue->removeResponseHandler(channel, &handler);
+}
+
+TEST(WorkStealingWorkQueue, Priorities)
+{
+    WorkStealingWorkQueue* queue = OGRE_NEW WorkStealingWorkQueue("Test");
+    queue->setWorkerThreadCount(1);
+    Root root("", "", "Ogre.log", queue);
+    queue->startup();
+
+    RecordingHandler handler;
+    uint16 low = queue->getChannel("Low");
+    uint16 high = queue->getChannel("High");
+    queue->setChannelPriority(low, WorkStealingWorkQueue::WQP_LOW);
+    queue->setChannelPriority(high, WorkStealingWorkQueue::WQP_HIGH);
+    queue->addRequestHandler(low, &handler);
+    queue->addRequestHandler(high, &handler);
+    queue->addResponseHandler(low, &handler);
+    queue->addResponseHandler(high, &handler);
+
+    queue->setPaused(true);
+    queue->addRequest(low, 0, 0);
+    queue->addRequest(low, 0, 1);
+    WorkQueue::RequestID aborted = queue->addRequest(low, 0, 2);
+    queue->addRequest(high, 0, 3);
+    EXPECT_TRUE(queue->abortPendingRequest(aborted));
+    queue->setPaused(false);
+    waitForResponses(queue, handler, 3);
+
+    // aborted requests are not handled by default
+    ASSERT_EQ(handler.processed.size(), 3u);
+    EXPECT_EQ(handler.processed[0], 3);
+    EXPECT_EQ(handler.processed[1], 0);
+    EXPECT_EQ(handler.processed[2], 1);
+
+    // nothing is pending any more
+    queue->processResponses();
+    EXPECT_FALSE(queue->abortPendingRequest(aborted));
+}
+
+TEST(WorkStealingWorkQueue, OverflowKeepsPriority)
+{
+    WorkStealingWorkQueue* queue = OGRE_NEW WorkStealingWorkQueue("Test");
+    queue->setWorkerThreadCount(1);
+    Root root("", "", "Ogre.log", queue);
+    queue->startup();
+
+    RecordingHandler handler;
+    uint16 low = queue->getChannel("Low");
+    uint16 high = queue->getChannel("High");
+    queue->setChannelPriority(low, WorkStealingWorkQueue::WQP_LOW);
+    queue->setChannelPriority(high, WorkStealingWorkQueue::WQP_HIGH);
+    queue->addRequestHandler(low, &handler);
+    queue->addRequestHandler(high, &handler);
+    queue->addResponseHandler(low, &handler);
+    queue->addResponseHandler(high, &handler);
+
+    // more high priority requests than fit into their lock-free queue
+    const int numHigh = 5000;
+    queue->setPaused(true);
+    for (int i = 0; i < numHigh; ++i)
+        queue->addRequest(high, 0, i);
+    queue->addRequest(low, 0, -1);
+    queue->setPaused(false);
+    waitForResponses(queue, handler, numHigh + 1);
+
+    ASSERT_EQ(handler.processed.size(), size_t(numHigh + 1));
+    EXPECT_EQ(handler.processed.back(), -1);
+
+    queue->removeRequestHandler(low, &handler);
+    queue->removeRequestHandler(high, &handler);
+    queue->removeResponseHandler(low, &handler);
+    queue->removeResponseHandler(high, &handler);
+}
+
+TEST(WorkStealingWorkQueue, ParallelFor)
+{
+    Root root("", "", "Ogre.log", OGRE_NEW WorkStealingWorkQueue("Test"));
+    WorkQueue* queue = root.getWorkQueue();
+    queue->startup();
+
+    std::vector<int> visits(100000);
+    queue->parallelFor(visits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            visits[i]++;
+        // nested ranges are split onto the same workers
+        std::atomic<size_t> inner(0);
+        queue->parallelFor(256, 16, [&](size_t b, size_t e) { inner += e - b; });
+        EXPECT_EQ(inner, 256u);
+    });
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), int(visits.size()));
+
+    EXPECT_THROW(queue->parallelFor(1000, 10,
+                                    [](size_t begin, size_t end) {
+                                        if (begin <= 500 && 500 < end)
+                                            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "test");
+                                    }),
+                 InvalidParametersException);
+}
+
+TEST(WorkStealingWorkQueue, ParallelForOnWorker)
+{
+    // ranges that are not a multiple of the grain size, split on a worker thread
+    struct RangeHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+    {
+        std::atomic<size_t> visited;
+        std::atomic<size_t> responses;
+        RangeHandler() : visited(0), responses(0) {}
+
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+        {
+            size_t count = any_cast<size_t>(req->getData());
+            const_cast<WorkQueue*>(srcQ)->parallelFor(count, 1024, [&](size_t begin, size_t end) {
+                visited += end - begin;
+            });
+            return OGRE_NEW WorkQueue::Response(req, true, Any());
+        }
+
+        void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) { ++responses; }
+    };
+
+    Root root("", "", "Ogre.log", OGRE_NEW WorkStealingWorkQueue("Test"));
+    WorkQueue* queue = root.getWorkQueue();
+    queue->startup();
+
+    RangeHandler handler;
+    uint16 channel = queue->getChannel("Ranges");
+    queue->addRequestHandler(channel, &handler);
+    queue->addResponseHandler(channel, &handler);
+
+    size_t counts[] = {1500, 1025, 2047, 3000, 5121};
+    size_t total = 0;
+    for (size_t count : counts)
+    {
+        queue->addRequest(channel, 0, count);
+        total += count;
+    }
+
+    Timer timer;
+    while (handler.responses < 5 && timer.getMilliseconds() < 10000)
+    {
+        queue->processResponses();
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(handler.responses, 5u);
+    EXPECT_EQ(handler.visited, total);
+
+    queue->removeRequestHandler(channel, &handler);
+    queue->removeResponseHandler(channel, &handler);
+}
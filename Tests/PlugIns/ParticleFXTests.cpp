@@ -0,0 +1,162 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreParticleSystem.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreParticle.h"
+#include "OgreControllerManager.h"
+
+#include "OgreLinearForceAffector.h"
+#include "OgreColourFaderAffector.h"
+#include "OgreColourFaderAffector2.h"
+#include "OgreColourInterpolatorAffector.h"
+#include "OgreScaleAffector.h"
+#include "OgreRotationAffector.h"
+#include "OgreDeflectorPlaneAffector.h"
+
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+typedef RootWithoutRenderSystemFixture ParticleFXTests;
+
+// the array path of every affector must give the same result as the per particle one
+TEST_F(ParticleFXTests, AffectParticleArrays)
+{
+    // normally done by Root::initialise
+    ControllerManager controllers;
+    ParticleSystemManager::getSingleton()._initialise();
+
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    // not a multiple of the SIMD width, so the scalar remainder runs too
+    const size_t count = 103;
+    ParticleSystem* ps = sceneMgr->createParticleSystem(count);
+    sceneMgr->getRootSceneNode()->attachObject(ps);
+    // allocates the pool
+    ps->_update(0);
+
+    std::vector<Particle> initial;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Particle* p = ps->createParticle();
+        ASSERT_TRUE(p);
+        p->mPosition = Vector3(Real(i % 13) - 6, i * 0.1f, -Real(i % 5));
+        p->mDirection = Vector3(Real(i % 3) - 1, Real(i % 11) - 5, 0.5f * (i % 7) - 1);
+        p->mColour = ColourValue((i % 10) * 0.11f, 1 - (i % 9) * 0.1f, 0.5f, (i % 4) * 0.3f);
+        p->mTotalTimeToLive = Real(1 + i % 3);
+        p->mTimeToLive = p->mTotalTimeToLive * (i % 20) / 19;
+        p->mRotation = Radian(i * 0.01f);
+        p->mRotationSpeed = Radian(Real(i % 5) - 2);
+        if (i % 3 == 0)
+            p->setDimensions(i * 0.01f, 1);
+        initial.push_back(*p);
+    }
+
+    LinearForceAffector force(ps), average(ps);
+    force.setForceVector(Vector3(1, -9.81f, 0.5f));
+    average.setForceVector(Vector3(1, -9.81f, 0.5f));
+    average.setForceApplication(LinearForceAffector::FA_AVERAGE);
+
+    ColourFaderAffector fader(ps);
+    fader.setAdjust(0.3f, -0.7f, 1.5f, -0.2f);
+
+    ColourFaderAffector2 fader2(ps);
+    fader2.setAdjust1(0.3f, -0.7f, 1.5f, -0.2f);
+    fader2.setAdjust2(-1, 0.4f, 0, 0.9f);
+    fader2.setStateChange(1);
+
+    ColourInterpolatorAffector interpolator(ps);
+    interpolator.setTimeAdjust(0, 0.1f);
+    interpolator.setColourAdjust(0, ColourValue::Red);
+    interpolator.setTimeAdjust(1, 0.4f);
+    interpolator.setColourAdjust(1, ColourValue::Green);
+    interpolator.setTimeAdjust(2, 0.7f);
+    interpolator.setColourAdjust(2, ColourValue(0.2f, 0.4f, 0.6f, 0.8f));
+
+    ScaleAffector scale(ps);
+    scale.setAdjust(-1.5f);
+
+    RotationAffector rotation(ps);
+
+    DeflectorPlaneAffector deflector(ps);
+    deflector.setPlanePoint(Vector3(0, 3, 0));
+    deflector.setPlaneNormal(Vector3(0.3f, 1, 0.2f).normalisedCopy());
+    deflector.setBounce(0.5f);
+
+    ParticleAffector* affectors[] = {&force, &average, &fader, &fader2, &interpolator, &scale, &rotation, &deflector};
+    const Real timeElapsed = 0.5f;
+    for (auto a : affectors)
+    {
+        SCOPED_TRACE(a->getType());
+        auto& particles = ps->_getActiveParticles();
+        ASSERT_EQ(particles.size(), count);
+
+        a->_affectParticles(ps, timeElapsed);
+        std::vector<Particle> expected;
+        for (size_t i = 0; i < count; ++i)
+        {
+            expected.push_back(*particles[i]);
+            *particles[i] = initial[i];
+        }
+
+        ParticleArrays arrays;
+        arrays.resize(count, a->_getParticleArrayComponents());
+        arrays.gather(particles.data(), 0, count, ps->getDefaultWidth(), ps->getDefaultHeight());
+        a->_affectParticleArrays(ps, timeElapsed, arrays, 0, count);
+        arrays.scatter(particles.data(), 0, count);
+
+        size_t numChanged = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Particle* p = particles[i];
+            ASSERT_EQ(p->mPosition, expected[i].mPosition) << i;
+            ASSERT_EQ(p->mDirection, expected[i].mDirection) << i;
+            ASSERT_EQ(p->mColour, expected[i].mColour) << i;
+            ASSERT_EQ(p->mRotation, expected[i].mRotation) << i;
+            ASSERT_EQ(p->hasOwnDimensions(), expected[i].hasOwnDimensions()) << i;
+            if (p->hasOwnDimensions())
+            {
+                ASSERT_EQ(p->getOwnWidth(), expected[i].getOwnWidth()) << i;
+                ASSERT_EQ(p->getOwnHeight(), expected[i].getOwnHeight()) << i;
+            }
+
+            if (p->mPosition != initial[i].mPosition || p->mDirection != initial[i].mDirection ||
+                p->mColour != initial[i].mColour || p->mRotation != initial[i].mRotation ||
+                p->hasOwnDimensions() != initial[i].hasOwnDimensions())
+                numChanged++;
+            *particles[i] = initial[i];
+        }
+        // make sure the inputs cover the interesting cases
+        EXPECT_GT(numChanged, 0u);
+    }
+
+    mRoot->destroySceneManager(sceneMgr);
+}